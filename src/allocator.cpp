@@ -15,12 +15,40 @@
 #include "allocator.h"
 
 #include <stdio.h>
+#include <string.h>
+
+#if defined __linux__ || defined __ANDROID__ || defined __APPLE__
+#include <sys/mman.h>
+#endif
+
+#if defined __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "cpu.h"
 
 namespace ncnn {
 
+Allocator::~Allocator()
+{
+}
+
+size_t Allocator::hit_count() const
+{
+    return 0;
+}
+
+size_t Allocator::idle_bytes() const
+{
+    return 0;
+}
+
 PoolAllocator::PoolAllocator()
 {
     size_compare_ratio = 192;// 0.75f * 256
+    hits = 0;
+    idle = 0;
 }
 
 PoolAllocator::~PoolAllocator()
@@ -50,6 +78,7 @@ void PoolAllocator::clear()
         ncnn::fastFree(ptr);
     }
     budgets.clear();
+    idle = 0;
 
     budgets_lock.unlock();
 }
@@ -81,6 +110,8 @@ void* PoolAllocator::fastMalloc(size_t size)
             void* ptr = it->second;
 
             budgets.erase(it);
+            hits++;
+            idle -= bs;
 
             budgets_lock.unlock();
 
@@ -127,6 +158,7 @@ void PoolAllocator::fastFree(void* ptr)
             budgets_lock.lock();
 
             budgets.push_back(std::make_pair(size, ptr));
+            idle += size;
 
             budgets_lock.unlock();
 
@@ -140,9 +172,21 @@ void PoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+size_t PoolAllocator::hit_count() const
+{
+    return hits;
+}
+
+size_t PoolAllocator::idle_bytes() const
+{
+    return idle;
+}
+
 UnlockedPoolAllocator::UnlockedPoolAllocator()
 {
     size_compare_ratio = 192;// 0.75f * 256
+    hits = 0;
+    idle = 0;
 }
 
 UnlockedPoolAllocator::~UnlockedPoolAllocator()
@@ -170,6 +214,7 @@ void UnlockedPoolAllocator::clear()
         ncnn::fastFree(ptr);
     }
     budgets.clear();
+    idle = 0;
 }
 
 void UnlockedPoolAllocator::set_size_compare_ratio(float scr)
@@ -197,6 +242,8 @@ void* UnlockedPoolAllocator::fastMalloc(size_t size)
             void* ptr = it->second;
 
             budgets.erase(it);
+            hits++;
+            idle -= bs;
 
             payouts.push_back(std::make_pair(bs, ptr));
 
@@ -225,6 +272,7 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
             payouts.erase(it);
 
             budgets.push_back(std::make_pair(size, ptr));
+            idle += size;
 
             return;
         }
@@ -234,4 +282,1090 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+size_t UnlockedPoolAllocator::hit_count() const
+{
+    return hits;
+}
+
+size_t UnlockedPoolAllocator::idle_bytes() const
+{
+    return idle;
+}
+
+// lock-free primitives for the bucket pool
+#if defined __GNUC__
+static inline void* atomic_cas_ptr(void* volatile* addr, void* oldval, void* newval)
+{
+    return __sync_val_compare_and_swap(addr, oldval, newval);
+}
+static inline size_t atomic_add_size(volatile size_t* addr, size_t delta)
+{
+    return __sync_fetch_and_add(addr, delta);
+}
+#elif defined _MSC_VER
+static inline void* atomic_cas_ptr(void* volatile* addr, void* oldval, void* newval)
+{
+    return InterlockedCompareExchangePointer(addr, newval, oldval);
+}
+static inline size_t atomic_add_size(volatile size_t* addr, size_t delta)
+{
+#ifdef _WIN64
+    return (size_t)InterlockedExchangeAdd64((LONGLONG volatile*)addr, (LONGLONG)delta);
+#else
+    return (size_t)InterlockedExchangeAdd((LONG volatile*)addr, (LONG)delta);
+#endif
+}
+#else
+// thread-unsafe branch
+static inline void* atomic_cas_ptr(void* volatile* addr, void* oldval, void* newval)
+{
+    void* tmp = *addr; if (tmp == oldval) *addr = newval; return tmp;
+}
+static inline size_t atomic_add_size(volatile size_t* addr, size_t delta)
+{
+    size_t tmp = *addr; *addr += delta; return tmp;
+}
+#endif
+
+// take the whole list at once, popping single node is prone to ABA
+static inline void* atomic_take_ptr(void* volatile* addr)
+{
+    void* head = *addr;
+    for (;;)
+    {
+        void* prev = atomic_cas_ptr(addr, head, 0);
+        if (prev == head)
+            return head;
+
+        head = prev;
+    }
+}
+
+// every buffer is prefixed with one MALLOC_ALIGN header
+// holding the free list link and the bucket index
+static inline void*& bucket_next(void* ptr)
+{
+    return *(void**)((unsigned char*)ptr - MALLOC_ALIGN);
+}
+
+static inline int& bucket_index(void* ptr)
+{
+    return *(int*)((unsigned char*)ptr - MALLOC_ALIGN + sizeof(void*));
+}
+
+static inline void bucket_release(void* ptr)
+{
+    ncnn::fastFree((unsigned char*)ptr - MALLOC_ALIGN);
+}
+
+// 16 32 48 64 80 96 112 128 160 192 224 256 320 ...
+static int size_to_bucket(size_t size)
+{
+    if (size <= 64)
+        return size == 0 ? 0 : (int)((size - 1) >> 4);
+
+    size_t s = size - 1;
+
+    int n = 6;
+    while (s >> (n + 1))
+        n++;
+
+    return 4 + (n - 6) * 4 + (int)((s - ((size_t)1 << n)) >> (n - 2));
+}
+
+static size_t bucket_to_size(int bucket)
+{
+    if (bucket < 4)
+        return (bucket + 1) * 16;
+
+    int n = 6 + (bucket - 4) / 4;
+    int q = (bucket - 4) % 4;
+
+    return ((size_t)1 << n) + ((size_t)(q + 1) << (n - 2));
+}
+
+struct BucketPoolAllocator::ThreadCache
+{
+    BucketPoolAllocator* allocator;
+    int generation;
+    void* budgets[BucketPoolAllocator::BUCKET_COUNT];
+    int counts[BucketPoolAllocator::BUCKET_COUNT];
+};
+
+#ifdef _WIN32
+static VOID WINAPI bucket_pool_fls_callback(PVOID ptr)
+{
+    BucketPoolAllocator::destroy_thread_cache(ptr);
+}
+#endif // _WIN32
+
+BucketPoolAllocator::BucketPoolAllocator()
+{
+#ifdef _WIN32
+    tls_index = FlsAlloc(bucket_pool_fls_callback);
+#else
+    pthread_key_create(&tls_key, destroy_thread_cache);
+#endif
+
+    for (int i=0; i<BUCKET_COUNT; i++)
+    {
+        budgets[i] = 0;
+    }
+
+    retained_bytes = 0;
+    retained_bytes_limit = (size_t)-1;
+    thread_cache_depth = 4;
+    generation = 0;
+    payout_count = 0;
+    hits = 0;
+}
+
+BucketPoolAllocator::~BucketPoolAllocator()
+{
+    clear();
+
+    // no more thread exit callback after this
+#ifdef _WIN32
+    FlsFree(tls_index);
+#else
+    pthread_key_delete(tls_key);
+#endif
+
+    caches_lock.lock();
+
+    std::list<ThreadCache*>::iterator it = caches.begin();
+    for (; it != caches.end(); it++)
+    {
+        flush_thread_cache(*it, true);
+        delete *it;
+    }
+    caches.clear();
+
+    caches_lock.unlock();
+
+    if (payout_count != 0)
+    {
+        fprintf(stderr, "FATAL ERROR! bucket pool allocator destroyed too early\n");
+        fprintf(stderr, "%d buffers still in use\n", payout_count);
+    }
+}
+
+void BucketPoolAllocator::set_retained_bytes_limit(size_t limit)
+{
+    retained_bytes_limit = limit;
+
+    trim_global();
+}
+
+void BucketPoolAllocator::set_thread_cache_depth(int depth)
+{
+    if (depth < 0)
+    {
+        fprintf(stderr, "invalid thread cache depth %d\n", depth);
+        return;
+    }
+
+    thread_cache_depth = depth;
+}
+
+void BucketPoolAllocator::clear()
+{
+    // other thread caches turn stale and release themselves lazily
+    NCNN_XADD(&generation, 1);
+
+#ifdef _WIN32
+    ThreadCache* tc = (ThreadCache*)FlsGetValue(tls_index);
+#else
+    ThreadCache* tc = (ThreadCache*)pthread_getspecific(tls_key);
+#endif
+    if (tc)
+    {
+        flush_thread_cache(tc, true);
+        tc->generation = generation;
+    }
+
+    for (int i=0; i<BUCKET_COUNT; i++)
+    {
+        const size_t bs = bucket_to_size(i);
+
+        void* ptr = atomic_take_ptr(&budgets[i]);
+        while (ptr)
+        {
+            void* next = bucket_next(ptr);
+            bucket_release(ptr);
+            atomic_add_size(&retained_bytes, -bs);
+            ptr = next;
+        }
+    }
+}
+
+void* BucketPoolAllocator::fastMalloc(size_t size)
+{
+    const int b = size_to_bucket(size);
+
+    if (b >= BUCKET_COUNT)
+    {
+        // too large for pooling
+        unsigned char* data = (unsigned char*)ncnn::fastMalloc(size + MALLOC_ALIGN);
+        if (!data)
+            return 0;
+
+        void* ptr = data + MALLOC_ALIGN;
+        bucket_index(ptr) = -1;
+
+        NCNN_XADD(&payout_count, 1);
+
+        return ptr;
+    }
+
+    const size_t bs = bucket_to_size(b);
+
+    ThreadCache* tc = get_thread_cache();
+
+    // thread cache first
+    void* ptr = tc->budgets[b];
+    if (ptr)
+    {
+        tc->budgets[b] = bucket_next(ptr);
+        tc->counts[b]--;
+
+        atomic_add_size(&retained_bytes, -bs);
+        atomic_add_size(&hits, 1);
+        NCNN_XADD(&payout_count, 1);
+
+        return ptr;
+    }
+
+    // then the global list, refill thread cache from the taken list
+    ptr = atomic_take_ptr(&budgets[b]);
+    if (ptr)
+    {
+        void* rest = bucket_next(ptr);
+        while (rest && tc->counts[b] < thread_cache_depth)
+        {
+            void* next = bucket_next(rest);
+            bucket_next(rest) = tc->budgets[b];
+            tc->budgets[b] = rest;
+            tc->counts[b]++;
+            rest = next;
+        }
+
+        if (rest)
+        {
+            void* tail = rest;
+            while (bucket_next(tail))
+                tail = bucket_next(tail);
+
+            push_global(b, rest, tail);
+        }
+
+        atomic_add_size(&retained_bytes, -bs);
+        atomic_add_size(&hits, 1);
+        NCNN_XADD(&payout_count, 1);
+
+        return ptr;
+    }
+
+    // new
+    unsigned char* data = (unsigned char*)ncnn::fastMalloc(bs + MALLOC_ALIGN);
+    if (!data)
+        return 0;
+
+    ptr = data + MALLOC_ALIGN;
+    bucket_index(ptr) = b;
+
+    NCNN_XADD(&payout_count, 1);
+
+    return ptr;
+}
+
+void BucketPoolAllocator::fastFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    NCNN_XADD(&payout_count, -1);
+
+    const int b = bucket_index(ptr);
+    if (b < 0)
+    {
+        bucket_release(ptr);
+        return;
+    }
+
+    const size_t bs = bucket_to_size(b);
+
+    // trim policy, release immediately when exceeding the limit
+    size_t retained = atomic_add_size(&retained_bytes, bs) + bs;
+    if (retained > retained_bytes_limit)
+    {
+        atomic_add_size(&retained_bytes, -bs);
+        bucket_release(ptr);
+        return;
+    }
+
+    ThreadCache* tc = get_thread_cache();
+
+    if (tc->counts[b] < thread_cache_depth)
+    {
+        bucket_next(ptr) = tc->budgets[b];
+        tc->budgets[b] = ptr;
+        tc->counts[b]++;
+        return;
+    }
+
+    push_global(b, ptr, ptr);
+}
+
+size_t BucketPoolAllocator::hit_count() const
+{
+    return hits;
+}
+
+size_t BucketPoolAllocator::idle_bytes() const
+{
+    return retained_bytes;
+}
+
+BucketPoolAllocator::ThreadCache* BucketPoolAllocator::get_thread_cache()
+{
+#ifdef _WIN32
+    ThreadCache* tc = (ThreadCache*)FlsGetValue(tls_index);
+#else
+    ThreadCache* tc = (ThreadCache*)pthread_getspecific(tls_key);
+#endif
+
+    if (!tc)
+    {
+        tc = new ThreadCache;
+        memset(tc, 0, sizeof(ThreadCache));
+        tc->allocator = this;
+        tc->generation = generation;
+
+#ifdef _WIN32
+        FlsSetValue(tls_index, tc);
+#else
+        pthread_setspecific(tls_key, tc);
+#endif
+
+        caches_lock.lock();
+        caches.push_back(tc);
+        caches_lock.unlock();
+
+        return tc;
+    }
+
+    if (tc->generation != generation)
+    {
+        // cleared by other thread
+        flush_thread_cache(tc, true);
+        tc->generation = generation;
+    }
+
+    return tc;
+}
+
+void BucketPoolAllocator::flush_thread_cache(ThreadCache* tc, bool release)
+{
+    for (int i=0; i<BUCKET_COUNT; i++)
+    {
+        void* ptr = tc->budgets[i];
+        if (!ptr)
+            continue;
+
+        if (release)
+        {
+            const size_t bs = bucket_to_size(i);
+
+            while (ptr)
+            {
+                void* next = bucket_next(ptr);
+                bucket_release(ptr);
+                atomic_add_size(&retained_bytes, -bs);
+                ptr = next;
+            }
+        }
+        else
+        {
+            void* tail = ptr;
+            while (bucket_next(tail))
+                tail = bucket_next(tail);
+
+            push_global(i, ptr, tail);
+        }
+
+        tc->budgets[i] = 0;
+        tc->counts[i] = 0;
+    }
+}
+
+void BucketPoolAllocator::push_global(int bucket, void* head, void* tail)
+{
+    void* old = budgets[bucket];
+    for (;;)
+    {
+        bucket_next(tail) = old;
+
+        void* prev = atomic_cas_ptr(&budgets[bucket], old, head);
+        if (prev == old)
+            break;
+
+        old = prev;
+    }
+}
+
+void BucketPoolAllocator::trim_global()
+{
+    // release large buffers first
+    for (int i=BUCKET_COUNT-1; i>=0 && retained_bytes > retained_bytes_limit; i--)
+    {
+        const size_t bs = bucket_to_size(i);
+
+        void* ptr = atomic_take_ptr(&budgets[i]);
+        while (ptr && retained_bytes > retained_bytes_limit)
+        {
+            void* next = bucket_next(ptr);
+            bucket_release(ptr);
+            atomic_add_size(&retained_bytes, -bs);
+            ptr = next;
+        }
+
+        if (ptr)
+        {
+            void* tail = ptr;
+            while (bucket_next(tail))
+                tail = bucket_next(tail);
+
+            push_global(i, ptr, tail);
+        }
+    }
+}
+
+void BucketPoolAllocator::destroy_thread_cache(void* ptr)
+{
+    ThreadCache* tc = (ThreadCache*)ptr;
+    BucketPoolAllocator* allocator = tc->allocator;
+
+    // hand over budgets to other threads
+    allocator->flush_thread_cache(tc, tc->generation != allocator->generation);
+
+    allocator->caches_lock.lock();
+    allocator->caches.remove(tc);
+    allocator->caches_lock.unlock();
+
+    delete tc;
+}
+
+HugePageAllocator::HugePageAllocator()
+{
+    arena_size = 32 * 1024 * 1024;
+    hits = 0;
+    idle = 0;
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    size_t used_count = 0;
+
+    std::map<unsigned char*, Arena*>::iterator it = arenas.begin();
+    for (; it != arenas.end(); it++)
+    {
+        used_count += it->second->used_count;
+        delete_arena(it->second);
+    }
+    arenas.clear();
+    free_ranges.clear();
+
+    if (used_count != 0)
+    {
+        fprintf(stderr, "FATAL ERROR! hugepage allocator destroyed too early\n");
+        fprintf(stderr, "%d buffers still in use\n", (int)used_count);
+    }
+}
+
+void HugePageAllocator::set_arena_size(size_t size)
+{
+    arena_size = alignSize(size, HUGEPAGE_SIZE);
+}
+
+void HugePageAllocator::clear()
+{
+    lock.lock();
+
+    std::map<unsigned char*, Arena*>::iterator it = arenas.begin();
+    while (it != arenas.end())
+    {
+        Arena* arena = it->second;
+        if (arena->used_count == 0)
+        {
+            // an unused arena is one free range
+            free_ranges.erase(std::make_pair(arena->size, arena->data));
+            idle -= arena->size;
+            delete_arena(arena);
+            arenas.erase(it++);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    lock.unlock();
+}
+
+size_t HugePageAllocator::mapped_bytes() const
+{
+    lock.lock();
+
+    size_t bytes = 0;
+    std::map<unsigned char*, Arena*>::const_iterator it = arenas.begin();
+    for (; it != arenas.end(); it++)
+    {
+        bytes += it->second->size;
+    }
+
+    lock.unlock();
+
+    return bytes;
+}
+
+size_t HugePageAllocator::hugepage_bytes() const
+{
+    lock.lock();
+
+    size_t bytes = 0;
+    std::map<unsigned char*, Arena*>::const_iterator it = arenas.begin();
+    for (; it != arenas.end(); it++)
+    {
+        if (it->second->type != 0)
+            bytes += it->second->size;
+    }
+
+    lock.unlock();
+
+    return bytes;
+}
+
+void* HugePageAllocator::fastMalloc(size_t size)
+{
+    size = alignSize(size == 0 ? 1 : size, CACHELINE_ALIGN);
+
+    lock.lock();
+
+    // best fit among all arenas, the smallest free range large enough
+    Arena* arena = 0;
+    size_t offset = 0;
+
+    std::set< std::pair<size_t, unsigned char*> >::iterator fit = free_ranges.lower_bound(std::make_pair(size, (unsigned char*)0));
+    if (fit != free_ranges.end())
+    {
+        arena = find_arena(fit->second);
+        offset = fit->second - arena->data;
+        hits++;
+    }
+    else
+    {
+        arena = new_arena(size > arena_size ? size : arena_size);
+        if (!arena)
+        {
+            lock.unlock();
+            return 0;
+        }
+
+        arenas[arena->data] = arena;
+        add_budget(arena, 0, arena->size);
+        idle += arena->size;
+    }
+
+    // carve from the front of the free range
+    std::map<size_t, size_t>::iterator best = arena->budgets.find(offset);
+    size_t remain = best->second - size;
+    remove_budget(arena, best);
+    if (remain > 0)
+        add_budget(arena, offset + size, remain);
+
+    arena->payouts[offset] = size;
+    arena->used_count++;
+    idle -= size;
+
+    lock.unlock();
+
+    return arena->data + offset;
+}
+
+void HugePageAllocator::fastFree(void* ptr)
+{
+    lock.lock();
+
+    Arena* arena = find_arena(ptr);
+
+    std::map<size_t, size_t>::iterator pit;
+    if (arena)
+        pit = arena->payouts.find((unsigned char*)ptr - arena->data);
+
+    if (!arena || pit == arena->payouts.end())
+    {
+        lock.unlock();
+
+        fprintf(stderr, "FATAL ERROR! hugepage allocator get wild %p\n", ptr);
+        return;
+    }
+
+    size_t offset = pit->first;
+    size_t size = pit->second;
+    arena->payouts.erase(pit);
+    arena->used_count--;
+    idle += size;
+
+    // merge with the following free range
+    std::map<size_t, size_t>::iterator next = arena->budgets.find(offset + size);
+    if (next != arena->budgets.end())
+    {
+        size += next->second;
+        remove_budget(arena, next);
+    }
+
+    // merge with the preceding free range
+    std::map<size_t, size_t>::iterator prev = arena->budgets.lower_bound(offset);
+    if (prev != arena->budgets.begin())
+    {
+        prev--;
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            remove_budget(arena, prev);
+        }
+    }
+
+    add_budget(arena, offset, size);
+
+    lock.unlock();
+}
+
+void HugePageAllocator::bind_arena(unsigned char* /*data*/, size_t /*size*/)
+{
+}
+
+HugePageAllocator::Arena* HugePageAllocator::find_arena(void* ptr) const
+{
+    // the last arena starting at or before ptr
+    std::map<unsigned char*, Arena*>::const_iterator it = arenas.upper_bound((unsigned char*)ptr);
+    if (it == arenas.begin())
+        return 0;
+
+    it--;
+
+    Arena* arena = it->second;
+    if ((unsigned char*)ptr >= arena->data + arena->size)
+        return 0;
+
+    return arena;
+}
+
+void HugePageAllocator::add_budget(Arena* arena, size_t offset, size_t size)
+{
+    arena->budgets[offset] = size;
+    free_ranges.insert(std::make_pair(size, arena->data + offset));
+}
+
+void HugePageAllocator::remove_budget(Arena* arena, std::map<size_t, size_t>::iterator it)
+{
+    free_ranges.erase(std::make_pair(it->second, arena->data + it->first));
+    arena->budgets.erase(it);
+}
+
+size_t HugePageAllocator::hit_count() const
+{
+    return hits;
+}
+
+size_t HugePageAllocator::idle_bytes() const
+{
+    return idle;
+}
+
+HugePageAllocator::Arena* HugePageAllocator::new_arena(size_t size)
+{
+    size = alignSize(size, HUGEPAGE_SIZE);
+
+    unsigned char* data = 0;
+    int type = 0;
+
+#if defined __linux__ || defined __ANDROID__
+#ifdef MAP_HUGETLB
+    // explicit huge pages, only if the administrator reserved some
+    data = (unsigned char*)mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data == MAP_FAILED)
+        data = 0;
+    else
+        type = 2;
+#endif // MAP_HUGETLB
+
+    if (!data)
+    {
+        // over-allocate one huge page for aligning the arena on huge page boundary
+        unsigned char* udata = (unsigned char*)mmap(0, size + HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (udata == MAP_FAILED)
+            return 0;
+
+        data = alignPtr(udata, HUGEPAGE_SIZE);
+
+        // trim the unaligned head and tail
+        if (data != udata)
+            munmap(udata, data - udata);
+        if (udata + HUGEPAGE_SIZE != data)
+            munmap(data + size, udata + HUGEPAGE_SIZE - data);
+
+#ifdef MADV_HUGEPAGE
+        if (madvise(data, size, MADV_HUGEPAGE) == 0)
+            type = 1;
+#endif // MADV_HUGEPAGE
+    }
+#elif defined _WIN32
+    // large pages need SeLockMemoryPrivilege, plain pages here
+    data = (unsigned char*)VirtualAlloc(0, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!data)
+        return 0;
+#else
+    data = (unsigned char*)ncnn::fastMalloc(size);
+    if (!data)
+        return 0;
+#endif
+
+    bind_arena(data, size);
+
+    Arena* arena = new Arena;
+    arena->data = data;
+    arena->size = size;
+    arena->type = type;
+    arena->used_count = 0;
+
+    return arena;
+}
+
+void HugePageAllocator::delete_arena(Arena* arena)
+{
+#if defined __linux__ || defined __ANDROID__
+    munmap(arena->data, arena->size);
+#elif defined _WIN32
+    VirtualFree(arena->data, 0, MEM_RELEASE);
+#else
+    ncnn::fastFree(arena->data);
+#endif
+
+    delete arena;
+}
+
+NumaAllocator::NumaAllocator(int _node) : node(_node)
+{
+    if (node < -1 || node >= get_numa_node_count())
+    {
+        fprintf(stderr, "invalid numa node %d, interleave instead\n", node);
+        node = -1;
+    }
+}
+
+int NumaAllocator::get_node() const
+{
+    return node;
+}
+
+void NumaAllocator::bind_arena(unsigned char* data, size_t size)
+{
+#if defined __linux__ && defined SYS_mbind
+    // from linux/mempolicy.h
+    const int mpol_bind = 2;
+    const int mpol_interleave = 3;
+
+    const int nodemask_bits = 1024;
+    unsigned long nodemask[nodemask_bits / (8 * sizeof(unsigned long))];
+    memset(nodemask, 0, sizeof(nodemask));
+
+    const int node_count = get_numa_node_count();
+    for (int i=0; i<node_count; i++)
+    {
+        if (node != -1 && node != i)
+            continue;
+
+        int node_id = get_numa_node_id(i);
+        if (node_id >= 0 && node_id < nodemask_bits)
+            nodemask[node_id / (8 * sizeof(unsigned long))] |= 1UL << (node_id % (8 * sizeof(unsigned long)));
+    }
+
+    // best effort, pages follow the default policy if numa is disabled in kernel
+    syscall(SYS_mbind, data, size, node == -1 ? mpol_interleave : mpol_bind, nodemask, nodemask_bits, 0);
+#else
+    (void)data;
+    (void)size;
+#endif
+}
+
+struct current_layer_t
+{
+    int index;
+    const char* name;
+};
+
+#ifdef _WIN32
+static DWORD g_current_layer_tls = TlsAlloc();
+#else
+static void destroy_current_layer(void* ptr)
+{
+    delete (current_layer_t*)ptr;
+}
+
+static pthread_key_t create_current_layer_key()
+{
+    pthread_key_t key;
+    pthread_key_create(&key, destroy_current_layer);
+    return key;
+}
+
+static pthread_key_t g_current_layer_key = create_current_layer_key();
+#endif // _WIN32
+
+static current_layer_t* get_current_layer(bool create)
+{
+#ifdef _WIN32
+    current_layer_t* cl = (current_layer_t*)TlsGetValue(g_current_layer_tls);
+#else
+    current_layer_t* cl = (current_layer_t*)pthread_getspecific(g_current_layer_key);
+#endif
+    if (!cl && create)
+    {
+        // NOTE leaks on windows thread exit, one per thread
+        cl = new current_layer_t;
+        cl->index = -1;
+        cl->name = 0;
+#ifdef _WIN32
+        TlsSetValue(g_current_layer_tls, cl);
+#else
+        pthread_setspecific(g_current_layer_key, cl);
+#endif
+    }
+
+    return cl;
+}
+
+void set_current_layer(int layer_index, const char* layer_name)
+{
+    current_layer_t* cl = get_current_layer(layer_index != -1);
+    if (!cl)
+        return;
+
+    cl->index = layer_index;
+    cl->name = layer_name;
+}
+
+int get_current_layer_index()
+{
+    current_layer_t* cl = get_current_layer(false);
+    return cl ? cl->index : -1;
+}
+
+const char* get_current_layer_name()
+{
+    current_layer_t* cl = get_current_layer(false);
+    return cl ? cl->name : 0;
+}
+
+StatisticsAllocator::StatisticsAllocator(Allocator* _allocator) : allocator(_allocator)
+{
+    layers.resize(1);
+    layers[0].name = "(none)";
+
+    current = 0;
+
+    reset();
+}
+
+StatisticsAllocator::~StatisticsAllocator()
+{
+    if (!buffers.empty())
+    {
+        fprintf(stderr, "FATAL ERROR! statistics allocator destroyed too early\n");
+        fprintf(stderr, "%d buffers still in use\n", (int)buffers.size());
+    }
+}
+
+void StatisticsAllocator::reset()
+{
+    lock.lock();
+
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        LayerStatistics& ls = layers[i];
+        ls.malloc_count = 0;
+        ls.malloc_bytes = 0;
+        ls.peak_bytes = ls.current_bytes;
+        ls.bytes_at_peak = ls.current_bytes;
+    }
+
+    memset(size_histogram, 0, sizeof(size_histogram));
+
+    peak = current;
+    mallocs = 0;
+    hits_base = allocator ? allocator->hit_count() : 0;
+
+    lock.unlock();
+}
+
+StatisticsAllocator::LayerStatistics& StatisticsAllocator::layer_statistics(int layer_index)
+{
+    if (layer_index + 1 >= (int)layers.size())
+    {
+        LayerStatistics ls = { std::string(), 0, 0, 0, 0, 0 };
+        layers.resize(layer_index + 2, ls);
+    }
+
+    return layers[layer_index + 1];
+}
+
+void* StatisticsAllocator::fastMalloc(size_t size)
+{
+    void* ptr = allocator ? allocator->fastMalloc(size) : ncnn::fastMalloc(size);
+    if (!ptr)
+        return ptr;
+
+    const int layer_index = get_current_layer_index();
+
+    lock.lock();
+
+    LayerStatistics& ls = layer_statistics(layer_index);
+    if (ls.name.empty())
+    {
+        const char* name = get_current_layer_name();
+        ls.name = name ? name : "";
+    }
+
+    BufferInfo bi = { size, layer_index };
+    buffers[ptr] = bi;
+
+    int bin = 0;
+    while (bin < 31 && (size >> (bin + 1)))
+        bin++;
+    size_histogram[bin]++;
+
+    mallocs++;
+    ls.malloc_count++;
+    ls.malloc_bytes += size;
+    ls.current_bytes += size;
+    if (ls.current_bytes > ls.peak_bytes)
+        ls.peak_bytes = ls.current_bytes;
+
+    current += size;
+    if (current > peak)
+    {
+        peak = current;
+
+        // snapshot who holds the memory at the peak
+        for (size_t i=0; i<layers.size(); i++)
+        {
+            layers[i].bytes_at_peak = layers[i].current_bytes;
+        }
+    }
+
+    lock.unlock();
+
+    return ptr;
+}
+
+void StatisticsAllocator::fastFree(void* ptr)
+{
+    lock.lock();
+
+    std::map<void*, BufferInfo>::iterator it = buffers.find(ptr);
+    if (it == buffers.end())
+    {
+        lock.unlock();
+
+        fprintf(stderr, "FATAL ERROR! statistics allocator get wild %p\n", ptr);
+        return;
+    }
+
+    const BufferInfo& bi = it->second;
+
+    layer_statistics(bi.layer_index).current_bytes -= bi.size;
+    current -= bi.size;
+
+    buffers.erase(it);
+
+    lock.unlock();
+
+    if (allocator)
+        allocator->fastFree(ptr);
+    else
+        ncnn::fastFree(ptr);
+}
+
+size_t StatisticsAllocator::hit_count() const
+{
+    return allocator ? allocator->hit_count() - hits_base : 0;
+}
+
+size_t StatisticsAllocator::idle_bytes() const
+{
+    return allocator ? allocator->idle_bytes() : 0;
+}
+
+size_t StatisticsAllocator::current_bytes() const
+{
+    return current;
+}
+
+size_t StatisticsAllocator::peak_bytes() const
+{
+    return peak;
+}
+
+size_t StatisticsAllocator::malloc_count() const
+{
+    return mallocs;
+}
+
+size_t StatisticsAllocator::miss_count() const
+{
+    const size_t hits = hit_count();
+    return mallocs > hits ? mallocs - hits : 0;
+}
+
+void StatisticsAllocator::print() const
+{
+    const size_t hits = hit_count();
+    const size_t misses = miss_count();
+    const size_t idle = idle_bytes();
+
+    lock.lock();
+
+    const size_t held = current + idle;
+
+    fprintf(stderr, "current = %.2fKB  peak = %.2fKB  idle = %.2fKB  fragmentation = %.1f%%\n",
+            current / 1024.0, peak / 1024.0, idle / 1024.0, held ? idle * 100.0 / held : 0.0);
+    fprintf(stderr, "malloc = %d  hit = %d  miss = %d  hit rate = %.1f%%\n",
+            (int)mallocs, (int)hits, (int)misses, mallocs ? hits * 100.0 / mallocs : 0.0);
+
+    fprintf(stderr, "size distribution\n");
+    for (int i=0; i<32; i++)
+    {
+        if (size_histogram[i] == 0)
+            continue;
+
+        fprintf(stderr, "    %10lu ~ %-10lu %8d\n", (unsigned long)1 << i, ((unsigned long)2 << i) - 1, (int)size_histogram[i]);
+    }
+
+    fprintf(stderr, "%-4s %-24s %8s %12s %12s %12s\n", "", "layer", "malloc", "total KB", "peak KB", "at peak KB");
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        const LayerStatistics& ls = layers[i];
+        if (ls.malloc_count == 0 && ls.current_bytes == 0)
+            continue;
+
+        fprintf(stderr, "%-4d %-24s %8d %12.2f %12.2f %12.2f\n", (int)i - 1, ls.name.c_str(),
+                (int)ls.malloc_count, ls.malloc_bytes / 1024.0, ls.peak_bytes / 1024.0, ls.bytes_at_peak / 1024.0);
+    }
+
+    lock.unlock();
+}
+
 } // namespace ncnn
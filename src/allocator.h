@@ -24,12 +24,22 @@
 
 #include <stdlib.h>
 #include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace ncnn {
 
 // the alignment of all the allocated buffers
 #define MALLOC_ALIGN    16
 
+// the alignment of buffers from HugePageAllocator, one cache line
+#define CACHELINE_ALIGN 64
+
+// the granularity of HugePageAllocator arenas, one x86 / aarch64 huge page
+#define HUGEPAGE_SIZE   (2 * 1024 * 1024)
+
 // Aligns a pointer to the specified number of bytes
 // ptr Aligned pointer
 // n Alignment size that must be a power of two
@@ -121,8 +131,15 @@ private:
 class Allocator
 {
 public:
+    virtual ~Allocator();
     virtual void* fastMalloc(size_t size) = 0;
     virtual void fastFree(void* ptr) = 0;
+
+    // pool statistics, 0 for allocators keeping no budgets
+    // count of mallocs served from kept budgets
+    virtual size_t hit_count() const;
+    // bytes of budgets kept for reuse
+    virtual size_t idle_bytes() const;
 };
 
 class PoolAllocator : public Allocator
@@ -141,12 +158,17 @@ public:
     virtual void* fastMalloc(size_t size);
     virtual void fastFree(void* ptr);
 
+    virtual size_t hit_count() const;
+    virtual size_t idle_bytes() const;
+
 private:
     Mutex budgets_lock;
     Mutex payouts_lock;
     unsigned int size_compare_ratio;// 0~256
     std::list< std::pair<size_t, void*> > budgets;
     std::list< std::pair<size_t, void*> > payouts;
+    size_t hits;
+    size_t idle;
 };
 
 class UnlockedPoolAllocator : public Allocator
@@ -165,10 +187,242 @@ public:
     virtual void* fastMalloc(size_t size);
     virtual void fastFree(void* ptr);
 
+    virtual size_t hit_count() const;
+    virtual size_t idle_bytes() const;
+
 private:
     unsigned int size_compare_ratio;// 0~256
     std::list< std::pair<size_t, void*> > budgets;
     std::list< std::pair<size_t, void*> > payouts;
+    size_t hits;
+    size_t idle;
+};
+
+// thread-safe pool allocator with size class buckets
+// sizes are rounded up to one of four steps per power of two, waste <= 25%
+// freed buffers go to a small per-thread cache first, then to a lock-free global list
+// both malloc and free are constant time, suitable for blob and workspace allocator
+class BucketPoolAllocator : public Allocator
+{
+public:
+    BucketPoolAllocator();
+    ~BucketPoolAllocator();
+
+    // max bytes kept in the pool for reuse, buffers beyond are released immediately
+    // default is unlimited
+    void set_retained_bytes_limit(size_t limit);
+
+    // max buffers per size class kept in each thread cache
+    // default count = 4
+    void set_thread_cache_depth(int depth);
+
+    // release all budgets immediately
+    // budgets cached by other threads are released on their next malloc or free
+    void clear();
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+    virtual size_t hit_count() const;
+    virtual size_t idle_bytes() const;
+
+public:
+    // 4 steps per power of two from 16 bytes up to 2G
+    enum { BUCKET_COUNT = 104 };
+
+    struct ThreadCache;
+
+    // return thread cache budgets on thread exit
+    static void destroy_thread_cache(void* ptr);
+
+private:
+    ThreadCache* get_thread_cache();
+    void flush_thread_cache(ThreadCache* tc, bool release);
+    void push_global(int bucket, void* head, void* tail);
+    void trim_global();
+
+private:
+#ifdef _WIN32
+    DWORD tls_index;
+#else
+    pthread_key_t tls_key;
+#endif
+    Mutex caches_lock;
+    std::list<ThreadCache*> caches;
+
+    void* volatile budgets[BUCKET_COUNT];
+    volatile size_t retained_bytes;
+    size_t retained_bytes_limit;
+    int thread_cache_depth;
+    volatile int generation;
+    volatile int payout_count;
+    volatile size_t hits;
+};
+
+// arena allocator backed by 2M huge pages
+// buffers are cache line aligned and packed back to back in large arenas
+// which keeps weights and blobs on few tlb entries
+// arenas are mapped with MAP_HUGETLB if reserved huge pages exist,
+// then fall back to transparent huge pages via madvise, then to plain pages
+class HugePageAllocator : public Allocator
+{
+public:
+    HugePageAllocator();
+    ~HugePageAllocator();
+
+    // bytes of each arena, rounded up to HUGEPAGE_SIZE
+    // larger buffers get a dedicated arena
+    // default size = 32M
+    void set_arena_size(size_t size);
+
+    // release all unused arenas immediately
+    void clear();
+
+    // bytes of all arenas mapped
+    size_t mapped_bytes() const;
+    // bytes of arenas backed by huge pages, explicitly or transparently
+    size_t hugepage_bytes() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+    // mallocs served without mapping a new arena
+    virtual size_t hit_count() const;
+    // bytes of free ranges in all arenas
+    virtual size_t idle_bytes() const;
+
+protected:
+    // place the pages of a new arena before they are first touched
+    virtual void bind_arena(unsigned char* data, size_t size);
+
+private:
+    struct Arena
+    {
+        unsigned char* data;
+        size_t size;
+        // 0 = plain  1 = transparent huge page  2 = hugetlb
+        int type;
+        size_t used_count;
+        // offset -> size, address ordered for coalescing
+        std::map<size_t, size_t> budgets;
+        std::map<size_t, size_t> payouts;
+    };
+
+    Arena* new_arena(size_t size);
+    void delete_arena(Arena* arena);
+
+    Arena* find_arena(void* ptr) const;
+    void add_budget(Arena* arena, size_t offset, size_t size);
+    void remove_budget(Arena* arena, std::map<size_t, size_t>::iterator it);
+
+private:
+    mutable Mutex lock;
+    // start address -> arena
+    std::map<unsigned char*, Arena*> arenas;
+    // free ranges of all arenas ordered by size then address, for best fit
+    std::set< std::pair<size_t, unsigned char*> > free_ranges;
+    size_t arena_size;
+    size_t hits;
+    size_t idle;
+};
+
+// hugepage arena allocator placing memory on one numa node, or interleaving it on all nodes
+// arena pages are bound with mbind before first touch, so the placement does not depend
+// on which thread touches them first
+// use it as blob and workspace allocator of extractors running on the node,
+// Net::use_numa_replication places weight replicas with it
+// falls back to unbound arenas where numa is not available
+class NumaAllocator : public HugePageAllocator
+{
+public:
+    // node in 0 ~ get_numa_node_count()-1, -1 interleaves pages on all nodes
+    NumaAllocator(int node = -1);
+
+    int get_node() const;
+
+protected:
+    virtual void bind_arena(unsigned char* data, size_t size);
+
+private:
+    int node;
+};
+
+// the layer being forwarded on the calling thread, used for allocation attribution
+// maintained by Net while forwarding, layer_index -1 means no layer
+void set_current_layer(int layer_index, const char* layer_name);
+int get_current_layer_index();
+const char* get_current_layer_name();
+
+// allocator wrapper collecting memory usage statistics
+// allocations are attributed to the layer being forwarded on the calling thread
+// pool hits and idle bytes are reported by the wrapped allocator,
+// wrap a pool dedicated to this wrapper for exact numbers
+class StatisticsAllocator : public Allocator
+{
+public:
+    // wrap the pool allocator, pass 0 for the plain fastMalloc
+    StatisticsAllocator(Allocator* allocator = 0);
+    ~StatisticsAllocator();
+
+    // forget all statistics, outstanding buffers are still tracked
+    void reset();
+
+    // print summary, size distribution and per-layer usage to stderr
+    void print() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+    // hits of the wrapped pool since the last reset
+    virtual size_t hit_count() const;
+    // bytes held idle by the wrapped pool
+    virtual size_t idle_bytes() const;
+
+public:
+    // bytes requested by buffers in use
+    size_t current_bytes() const;
+    // the high-water mark of current_bytes
+    size_t peak_bytes() const;
+
+    size_t malloc_count() const;
+    size_t miss_count() const;
+
+private:
+    struct BufferInfo
+    {
+        size_t size;
+        int layer_index;
+    };
+
+    struct LayerStatistics
+    {
+        std::string name;
+        size_t malloc_count;
+        size_t malloc_bytes;
+        size_t current_bytes;
+        size_t peak_bytes;
+        // bytes this layer held when the overall peak was reached
+        size_t bytes_at_peak;
+    };
+
+    LayerStatistics& layer_statistics(int layer_index);
+
+private:
+    Allocator* allocator;
+
+    mutable Mutex lock;
+    // buffers in use only
+    std::map<void*, BufferInfo> buffers;
+    // [0] for allocations outside any layer
+    std::vector<LayerStatistics> layers;
+    // count of sizes in [2^i, 2^(i+1))
+    size_t size_histogram[32];
+
+    size_t current;
+    size_t peak;
+    size_t mallocs;
+    // hit_count of the wrapped pool at the last reset
+    size_t hits_base;
 };
 
 } // namespace ncnn
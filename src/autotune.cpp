@@ -0,0 +1,276 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "autotune.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "benchmark.h"
+#include "layer.h"
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define NCNN_AUTOTUNE_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace ncnn {
+
+// strip leading and trailing spaces and the line break
+static std::string trim(const char* s)
+{
+    const char* end = s + strlen(s);
+    while (*s == ' ' || *s == '\t')
+        s++;
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r'))
+        end--;
+
+    return std::string(s, end);
+}
+
+static std::string get_cpu_model_name()
+{
+#if defined __linux__
+    // model name on x86, hardware on arm
+    FILE* fp = fopen("/proc/cpuinfo", "rb");
+    if (fp)
+    {
+        std::string model_name;
+        std::string hardware;
+
+        char line[1024];
+        while (fgets(line, 1024, fp))
+        {
+            const char* colon = strchr(line, ':');
+            if (!colon)
+                continue;
+
+            if (model_name.empty() && strncmp(line, "model name", 10) == 0)
+                model_name = trim(colon + 1);
+            else if (hardware.empty() && strncmp(line, "Hardware", 8) == 0)
+                hardware = trim(colon + 1);
+        }
+
+        fclose(fp);
+
+        if (!model_name.empty())
+            return model_name;
+        if (!hardware.empty())
+            return hardware;
+    }
+#endif // __linux__
+
+#if NCNN_AUTOTUNE_X86
+    // processor brand string
+    unsigned int brand[12];
+    unsigned int regs[4];
+#ifdef _MSC_VER
+    __cpuidex((int*)regs, 0x80000000, 0);
+#else
+    __cpuid_count(0x80000000, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    if (regs[0] >= 0x80000004)
+    {
+        for (int i=0; i<3; i++)
+        {
+#ifdef _MSC_VER
+            __cpuidex((int*)(brand + i * 4), 0x80000002 + i, 0);
+#else
+            __cpuid_count(0x80000002 + i, 0, brand[i * 4], brand[i * 4 + 1], brand[i * 4 + 2], brand[i * 4 + 3]);
+#endif
+        }
+
+        char brand_string[49];
+        memcpy(brand_string, brand, 48);
+        brand_string[48] = '\0';
+
+        return trim(brand_string);
+    }
+#endif // NCNN_AUTOTUNE_X86
+
+    return "unknown";
+}
+
+AutotuneCache::AutotuneCache()
+{
+    cpu_model = get_cpu_model_name();
+}
+
+#if NCNN_STDIO
+int AutotuneCache::load(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    lock.lock();
+
+    // cpu model <tab> signature <tab> algo num_threads
+    char line[1024];
+    while (fgets(line, 1024, fp))
+    {
+        char* tab0 = strchr(line, '\t');
+        char* tab1 = tab0 ? strchr(tab0 + 1, '\t') : 0;
+        if (!tab1)
+            continue;
+
+        int algo = 0;
+        int num_threads = 0;
+        if (sscanf(tab1 + 1, "%d %d", &algo, &num_threads) != 2)
+            continue;
+
+        choices[std::string(line, tab1)] = std::make_pair(algo, num_threads);
+    }
+
+    lock.unlock();
+
+    fclose(fp);
+
+    return 0;
+}
+
+int AutotuneCache::save(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    lock.lock();
+
+    std::map< std::string, std::pair<int, int> >::const_iterator it = choices.begin();
+    for (; it != choices.end(); it++)
+    {
+        fprintf(fp, "%s\t%d %d\n", it->first.c_str(), it->second.first, it->second.second);
+    }
+
+    lock.unlock();
+
+    fclose(fp);
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+int AutotuneCache::find(const std::string& signature, int& algo, int& num_threads) const
+{
+    lock.lock();
+
+    std::map< std::string, std::pair<int, int> >::const_iterator it = choices.find(cpu_model + '\t' + signature);
+    bool found = it != choices.end();
+    if (found)
+    {
+        algo = it->second.first;
+        num_threads = it->second.second;
+    }
+
+    lock.unlock();
+
+    return found ? 0 : -1;
+}
+
+void AutotuneCache::insert(const std::string& signature, int algo, int num_threads)
+{
+    lock.lock();
+
+    choices[cpu_model + '\t' + signature] = std::make_pair(algo, num_threads);
+
+    lock.unlock();
+}
+
+void AutotuneCache::clear()
+{
+    lock.lock();
+
+    choices.clear();
+
+    lock.unlock();
+}
+
+const std::string& AutotuneCache::get_cpu_model() const
+{
+    return cpu_model;
+}
+
+int autotune(const std::string& signature, int algo_count, autotune_run_func run, void* userdata, const Option& opt, Option& opt_tuned)
+{
+    opt_tuned = opt;
+
+    AutotuneCache* cache = opt.autotune_cache;
+
+    int algo = -1;
+    int num_threads = opt.num_threads;
+    if (cache && cache->find(signature, algo, num_threads) == 0)
+    {
+        opt_tuned.num_threads = std::min(std::max(num_threads, 1), opt.num_threads);
+        return algo;
+    }
+
+    double best_time = 0;
+
+    for (int a=0; a<algo_count; a++)
+    {
+        // all threads, then halved down to one
+        for (int nt = opt.num_threads; nt >= 1; nt /= 2)
+        {
+            Option opt_run = opt;
+            opt_run.num_threads = nt;
+
+            // warm up, and find out whether the algorithm applies
+            if (run(a, opt_run, userdata) != 0)
+                break;
+
+            double time = 0;
+            for (int i=0; i<3; i++)
+            {
+                double start = get_current_time();
+
+                run(a, opt_run, userdata);
+
+                double end = get_current_time();
+
+                if (i == 0 || end - start < time)
+                    time = end - start;
+            }
+
+            if (algo == -1 || time < best_time)
+            {
+                algo = a;
+                num_threads = nt;
+                best_time = time;
+            }
+        }
+    }
+
+    if (algo == -1)
+        return -1;
+
+    if (cache)
+        cache->insert(signature, algo, num_threads);
+
+    opt_tuned.num_threads = num_threads;
+
+    return algo;
+}
+
+} // namespace ncnn
@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_AUTOTUNE_H
+#define NCNN_AUTOTUNE_H
+
+#include <map>
+#include <string>
+#include "allocator.h"
+#include "platform.h"
+
+namespace ncnn {
+
+// kernel choices of tuned layers
+// keyed by cpu model and layer signature, that is layer parameters, input shape and thread count
+// a choice is an algorithm index private to the layer type and the thread count to run it with
+class AutotuneCache
+{
+public:
+    AutotuneCache();
+
+#if NCNN_STDIO
+    // load choices from a cache file
+    // choices of other cpu models are kept and saved back, but never used
+    // return 0 if success
+    int load(const char* path);
+
+    // save all choices to a cache file
+    // return 0 if success
+    int save(const char* path) const;
+#endif // NCNN_STDIO
+
+    // the choice of the layer signature on this cpu
+    // return 0 if found
+    int find(const std::string& signature, int& algo, int& num_threads) const;
+
+    void insert(const std::string& signature, int algo, int num_threads);
+
+    void clear();
+
+    // cpu model name choices of this machine are keyed by
+    const std::string& get_cpu_model() const;
+
+private:
+    std::string cpu_model;
+    mutable Mutex lock;
+    // cpu model, tab, signature -> algo, num_threads
+    std::map< std::string, std::pair<int, int> > choices;
+};
+
+class Option;
+
+// run the layer once with algorithm algo, returns 0 if success
+// return -1 if the algorithm does not apply, it is skipped then
+typedef int (*autotune_run_func)(int algo, const Option& opt, void* userdata);
+
+// pick the fastest of algo_count algorithms and thread counts up to opt.num_threads,
+// timing each candidate with run unless opt.autotune_cache holds a choice for signature
+// opt_tuned is opt with the chosen thread count
+// return the chosen algorithm, -1 if none applies
+int autotune(const std::string& signature, int algo_count, autotune_run_func run, void* userdata, const Option& opt, Option& opt_tuned);
+
+} // namespace ncnn
+
+#endif // NCNN_AUTOTUNE_H
@@ -13,9 +13,11 @@
 // specific language governing permissions and limitations under the License.
 
 #include "cpu.h"
+#include "allocator.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <vector>
 
 #ifdef _OPENMP
@@ -26,6 +28,24 @@
 #include <sys/syscall.h>
 #include <unistd.h>
 #include <stdint.h>
+#elif defined __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define NCNN_CPU_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
 #endif
 
 #if __APPLE__
@@ -231,6 +251,17 @@ static int get_cpucount()
 #else
 #ifdef _OPENMP
     return omp_get_max_threads();
+#elif defined __linux__
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (count < 1)
+        count = 1;
+
+    return count;
+#elif defined _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwNumberOfProcessors;
 #else
     return 1;
 #endif // _OPENMP
@@ -484,6 +515,450 @@ int set_cpu_powersave(int powersave)
 #endif
 }
 
+int set_cpu_thread_affinity(const std::vector<int>& cpuids)
+{
+    if (cpuids.empty())
+        return -1;
+
+#ifdef __ANDROID__
+    return set_sched_affinity(cpuids);
+#elif defined __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int i=0; i<(int)cpuids.size(); i++)
+    {
+        CPU_SET(cpuids[i], &mask);
+    }
+
+    int ret = sched_setaffinity(0, sizeof(mask), &mask);
+    if (ret)
+    {
+        fprintf(stderr, "sched_setaffinity error %d\n", ret);
+        return -1;
+    }
+
+    return 0;
+#elif defined _WIN32
+    DWORD_PTR mask = 0;
+    for (int i=0; i<(int)cpuids.size(); i++)
+    {
+        mask |= (DWORD_PTR)1 << cpuids[i];
+    }
+
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+    {
+        fprintf(stderr, "SetThreadAffinityMask error %d\n", (int)GetLastError());
+        return -1;
+    }
+
+    return 0;
+#else
+    // thread affinity not supported on ios
+    return -1;
+#endif
+}
+
+#if defined __linux__
+// parse a sysfs list like "0-3,8-11"
+static int read_sysfs_list(const char* path, std::vector<int>& ids)
+{
+    ids.clear();
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    char line[4096];
+    char* s = fgets(line, 4096, fp);
+    fclose(fp);
+
+    if (!s)
+        return -1;
+
+    while (*s)
+    {
+        int first = 0;
+        int last = 0;
+        int nconsumed = 0;
+        if (sscanf(s, "%d-%d%n", &first, &last, &nconsumed) == 2)
+        {
+        }
+        else if (sscanf(s, "%d%n", &first, &nconsumed) == 1)
+        {
+            last = first;
+        }
+        else
+        {
+            break;
+        }
+
+        for (int i=first; i<=last; i++)
+        {
+            ids.push_back(i);
+        }
+
+        s += nconsumed;
+        if (*s != ',')
+            break;
+
+        s++;
+    }
+
+    return ids.empty() ? -1 : 0;
+}
+#endif // __linux__
+
+// node ids and their cpus, a single node holding all cpus when numa is not available
+// detected on first use, not at startup
+static Mutex g_numa_topology_lock;
+static int g_numa_node_count = 0;
+static std::vector<int> g_numa_node_ids;
+static std::vector< std::vector<int> > g_numa_node_cpuids;
+
+static int detect_numa_topology()
+{
+#if defined __linux__
+    std::vector<int> node_ids;
+    read_sysfs_list("/sys/devices/system/node/online", node_ids);
+
+    for (size_t i=0; i<node_ids.size(); i++)
+    {
+        char path[256];
+        sprintf(path, "/sys/devices/system/node/node%d/cpulist", node_ids[i]);
+
+        std::vector<int> cpuids;
+        if (read_sysfs_list(path, cpuids) != 0)
+        {
+            // memory only node
+            continue;
+        }
+
+        g_numa_node_ids.push_back(node_ids[i]);
+        g_numa_node_cpuids.push_back(cpuids);
+    }
+#endif // __linux__
+
+    if (g_numa_node_ids.empty())
+    {
+        std::vector<int> cpuids(g_cpucount);
+        for (int i=0; i<g_cpucount; i++)
+        {
+            cpuids[i] = i;
+        }
+
+        g_numa_node_ids.push_back(0);
+        g_numa_node_cpuids.push_back(cpuids);
+    }
+
+    return g_numa_node_ids.size();
+}
+
+static void init_numa_topology()
+{
+    g_numa_topology_lock.lock();
+
+    if (g_numa_node_count == 0)
+        g_numa_node_count = detect_numa_topology();
+
+    g_numa_topology_lock.unlock();
+}
+
+int get_numa_node_count()
+{
+    init_numa_topology();
+
+    return g_numa_node_count;
+}
+
+int get_numa_node_id(int node)
+{
+    init_numa_topology();
+
+    if (node < 0 || node >= (int)g_numa_node_ids.size())
+        return -1;
+
+    return g_numa_node_ids[node];
+}
+
+int get_numa_node_cpuids(int node, std::vector<int>& cpuids)
+{
+    init_numa_topology();
+
+    if (node < 0 || node >= (int)g_numa_node_ids.size())
+    {
+        fprintf(stderr, "invalid numa node %d\n", node);
+        return -1;
+    }
+
+    cpuids = g_numa_node_cpuids[node];
+
+    return 0;
+}
+
+int get_cpu_numa_node(int cpuid)
+{
+    init_numa_topology();
+
+    for (size_t i=0; i<g_numa_node_cpuids.size(); i++)
+    {
+        const std::vector<int>& cpuids = g_numa_node_cpuids[i];
+        for (size_t j=0; j<cpuids.size(); j++)
+        {
+            if (cpuids[j] == cpuid)
+                return i;
+        }
+    }
+
+    return -1;
+}
+
+int get_current_cpu()
+{
+#if defined __ANDROID__ || defined __linux__
+    unsigned int cpu = 0;
+    if (syscall(__NR_getcpu, &cpu, 0, 0) != 0)
+        return -1;
+
+    return cpu;
+#elif defined _WIN32
+    return GetCurrentProcessorNumber();
+#else
+    return -1;
+#endif
+}
+
+int set_numa_node_affinity(int node)
+{
+    std::vector<int> cpuids;
+    if (get_numa_node_cpuids(node, cpuids) != 0)
+        return -1;
+
+    return set_cpu_thread_affinity(cpuids);
+}
+
+#if NCNN_CPU_X86
+static void x86_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+#ifdef _MSC_VER
+    __cpuidex((int*)regs, leaf, subleaf);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// walk the deterministic cache parameters, leaf 4 on intel and 0x8000001d on amd
+static int get_x86_cache_sizes(int cache_size[3])
+{
+    unsigned int regs[4];
+    x86_cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+    x86_cpuid(0x80000000, 0, regs);
+    const unsigned int max_ext_leaf = regs[0];
+
+    const unsigned int leafs[2] = { 4, 0x8000001d };
+    const bool supported[2] = { max_leaf >= 4, max_ext_leaf >= 0x8000001d };
+
+    for (int l=0; l<2; l++)
+    {
+        if (!supported[l])
+            continue;
+
+        for (unsigned int i=0; i<16; i++)
+        {
+            x86_cpuid(leafs[l], i, regs);
+
+            // 0 = no more caches, 2 = instruction cache
+            const int type = regs[0] & 0x1f;
+            if (type == 0)
+                break;
+            if (type == 2)
+                continue;
+
+            const int level = (regs[0] >> 5) & 0x7;
+            if (level < 1 || level > 3 || cache_size[level - 1] != 0)
+                continue;
+
+            const int ways = ((regs[1] >> 22) & 0x3ff) + 1;
+            const int partitions = ((regs[1] >> 12) & 0x3ff) + 1;
+            const int line_size = (regs[1] & 0xfff) + 1;
+            const int sets = regs[2] + 1;
+            cache_size[level - 1] = ways * partitions * line_size * sets;
+        }
+
+        if (cache_size[0] != 0)
+            return 0;
+    }
+
+    return -1;
+}
+#endif // NCNN_CPU_X86
+
+#if defined __linux__
+// parse a sysfs cache size like "32K"
+static int read_sysfs_cache_size(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return 0;
+
+    int size = 0;
+    char unit = 0;
+    int nscan = fscanf(fp, "%d%c", &size, &unit);
+    fclose(fp);
+
+    if (nscan < 1)
+        return 0;
+
+    if (unit == 'K')
+        size *= 1024;
+    else if (unit == 'M')
+        size *= 1024 * 1024;
+
+    return size;
+}
+#endif // __linux__
+
+// physical cores, smt siblings and cache sizes
+// constructed on first use, as the default option queries it during static initialization
+struct CpuTopology
+{
+    CpuTopology();
+
+    std::vector<int> physical_cpuids;
+    std::vector< std::vector<int> > smt_siblings;
+    int cache_size[3];
+};
+
+CpuTopology::CpuTopology()
+{
+    cache_size[0] = 0;
+    cache_size[1] = 0;
+    cache_size[2] = 0;
+
+#if defined __linux__
+    std::vector<int> cpuids;
+    read_sysfs_list("/sys/devices/system/cpu/online", cpuids);
+
+    for (size_t i=0; i<cpuids.size(); i++)
+    {
+        const int cpuid = cpuids[i];
+
+        char path[256];
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpuid);
+
+        std::vector<int> siblings;
+        if (read_sysfs_list(path, siblings) != 0)
+            siblings = std::vector<int>(1, cpuid);
+
+        if ((int)smt_siblings.size() <= cpuid)
+            smt_siblings.resize(cpuid + 1);
+        smt_siblings[cpuid] = siblings;
+
+        // the first online sibling stands for the core
+        bool first = true;
+        for (size_t j=0; j<siblings.size() && siblings[j] < cpuid; j++)
+        {
+            if (std::find(cpuids.begin(), cpuids.end(), siblings[j]) != cpuids.end())
+                first = false;
+        }
+
+        if (first)
+            physical_cpuids.push_back(cpuid);
+    }
+
+    for (int i=0; i<16; i++)
+    {
+        char path[256];
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%d/level", i);
+
+        FILE* fp = fopen(path, "rb");
+        if (!fp)
+            break;
+
+        int level = 0;
+        fscanf(fp, "%d", &level);
+        fclose(fp);
+
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+        fp = fopen(path, "rb");
+        if (!fp)
+            continue;
+
+        char type[32] = { 0 };
+        fscanf(fp, "%31s", type);
+        fclose(fp);
+
+        if (level < 1 || level > 3 || strcmp(type, "Instruction") == 0 || cache_size[level - 1] != 0)
+            continue;
+
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+        cache_size[level - 1] = read_sysfs_cache_size(path);
+    }
+#endif // __linux__
+
+#if NCNN_CPU_X86
+    if (cache_size[0] == 0)
+    {
+        get_x86_cache_sizes(cache_size);
+    }
+#endif // NCNN_CPU_X86
+
+    if (physical_cpuids.empty())
+    {
+        // no smt information, every cpu is a core
+        const int cpucount = get_cpucount();
+
+        physical_cpuids.resize(cpucount);
+        smt_siblings.resize(cpucount);
+        for (int i=0; i<cpucount; i++)
+        {
+            physical_cpuids[i] = i;
+            smt_siblings[i] = std::vector<int>(1, i);
+        }
+    }
+}
+
+static const CpuTopology& get_cpu_topology()
+{
+    static CpuTopology topology;
+    return topology;
+}
+
+int get_physical_cpu_count()
+{
+    return get_cpu_topology().physical_cpuids.size();
+}
+
+int get_physical_cpuids(std::vector<int>& cpuids)
+{
+    cpuids = get_cpu_topology().physical_cpuids;
+
+    return 0;
+}
+
+int get_cpu_smt_siblings(int cpuid, std::vector<int>& cpuids)
+{
+    const CpuTopology& topology = get_cpu_topology();
+
+    if (cpuid < 0 || cpuid >= (int)topology.smt_siblings.size() || topology.smt_siblings[cpuid].empty())
+    {
+        fprintf(stderr, "invalid cpu %d\n", cpuid);
+        return -1;
+    }
+
+    cpuids = topology.smt_siblings[cpuid];
+
+    return 0;
+}
+
+int get_cpu_cache_size(int level)
+{
+    if (level < 1 || level > 3)
+        return 0;
+
+    return get_cpu_topology().cache_size[level - 1];
+}
+
 int get_omp_num_threads()
 {
 #ifdef _OPENMP
@@ -15,6 +15,8 @@
 #ifndef NCNN_CPU_H
 #define NCNN_CPU_H
 
+#include <vector>
+
 namespace ncnn {
 
 // test optional cpu features
@@ -39,6 +41,47 @@ int get_cpu_count();
 int get_cpu_powersave();
 int set_cpu_powersave(int powersave);
 
+// bind the calling thread to the given cpus
+// works with openmp threads and ThreadPool workers alike
+// not supported on ios
+// return 0 if success
+int set_cpu_thread_affinity(const std::vector<int>& cpuids);
+
+// numa topology detected from sysfs
+// nodes are numbered 0 ~ count-1, memory only nodes are skipped
+// a single node holding all cpus where numa is not available
+//
+// numa mode for multi-socket hosts:
+//   load one Net with use_numa_replication, weights are replicated on every node
+//   per node, bind a ThreadPool with set_affinity(cpuids of the node)
+//   extract with blob and workspace allocator = NumaAllocator(node)
+//   call set_numa_node_affinity(node) on the thread calling extract
+// or load one Net with NumaAllocator(-1) to interleave weights on all nodes
+int get_numa_node_count();
+// the system node id, as used by the kernel
+int get_numa_node_id(int node);
+// return 0 if success
+int get_numa_node_cpuids(int node, std::vector<int>& cpuids);
+// the node of the cpu, -1 if unknown
+int get_cpu_numa_node(int cpuid);
+// the cpu the calling thread is running on, -1 if unknown
+int get_current_cpu();
+// bind the calling thread to the cpus of the node
+// return 0 if success
+int set_numa_node_affinity(int node);
+
+// cpu topology detected from sysfs, cache sizes fall back to cpuid on x86
+// smt siblings share one physical core and its l1 and l2 cache
+int get_physical_cpu_count();
+// one cpu per physical core, bind threads to them for one thread per core
+// return 0 if success
+int get_physical_cpuids(std::vector<int>& cpuids);
+// the cpus sharing the core of cpuid, including itself
+// return 0 if success
+int get_cpu_smt_siblings(int cpuid, std::vector<int>& cpuids);
+// data or unified cache size in bytes of level 1 ~ 3, 0 if unknown
+int get_cpu_cache_size(int level);
+
 // misc function wrapper for openmp routines
 int get_omp_num_threads();
 void set_omp_num_threads(int num_threads);
@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include "cpu.h"
 
 namespace ncnn {
@@ -23,9 +24,11 @@ namespace ncnn {
 Option::Option()
 {
     lightmode = true;
-    num_threads = get_cpu_count();
+    num_threads = std::min(get_cpu_count(), get_physical_cpu_count());
     blob_allocator = 0;
     workspace_allocator = 0;
+    thread_pool = 0;
+    autotune_cache = 0;
 }
 
 static Option g_default_option;
@@ -48,10 +51,121 @@ int set_default_option(const Option& opt)
     return 0;
 }
 
+#ifndef _OPENMP
+// loops without opt.thread_pool share one pool when openmp is not compiled in
+// created on first use and kept for the lifetime of the process
+static Mutex g_default_thread_pool_lock;
+static ThreadPool* g_default_thread_pool = 0;
+
+static ThreadPool* get_default_thread_pool()
+{
+    g_default_thread_pool_lock.lock();
+
+    if (!g_default_thread_pool)
+        g_default_thread_pool = new ThreadPool(get_cpu_count());
+
+    g_default_thread_pool_lock.unlock();
+
+    return g_default_thread_pool;
+}
+#endif // _OPENMP
+
+void parallel_for(int count, parallel_for_func func, void* userdata, const Option& opt)
+{
+    if (opt.thread_pool)
+    {
+        opt.thread_pool->parallel_for(count, func, userdata, opt.num_threads);
+        return;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i=0; i<count; i++)
+    {
+        func(i, userdata);
+    }
+#else
+    if (opt.num_threads > 1 && count > 1)
+    {
+        get_default_thread_pool()->parallel_for(count, func, userdata, opt.num_threads);
+        return;
+    }
+
+    for (int i=0; i<count; i++)
+    {
+        func(i, userdata);
+    }
+#endif // _OPENMP
+}
+
+struct parallel_for_2d_args
+{
+    parallel_for_2d_func func;
+    void* userdata;
+    int rows;
+    int row_align;
+    int tiles;
+};
+
+static void parallel_for_2d_tile(int i, void* userdata)
+{
+    const parallel_for_2d_args* args = (const parallel_for_2d_args*)userdata;
+
+    const int q = i / args->tiles;
+    const int t = i % args->tiles;
+
+    // split in units of row_align rows
+    const int units = (args->rows + args->row_align - 1) / args->row_align;
+    const int y0 = std::min(units * t / args->tiles * args->row_align, args->rows);
+    const int y1 = std::min(units * (t + 1) / args->tiles * args->row_align, args->rows);
+
+    if (y0 < y1)
+        args->func(q, y0, y1, args->userdata);
+}
+
+void parallel_for_2d(int channels, int rows, parallel_for_2d_func func, void* userdata, const Option& opt, int row_align, size_t row_bytes)
+{
+    int num_threads = opt.num_threads;
+    if (opt.thread_pool && num_threads > opt.thread_pool->get_num_threads())
+        num_threads = opt.thread_pool->get_num_threads();
+
+    if (row_align < 1)
+        row_align = 1;
+
+    // aim at 4 tiles per thread for load balance, no split when channels are plenty
+    const int units = (rows + row_align - 1) / row_align;
+
+    int tiles = 1;
+    if (num_threads > 1 && channels < num_threads * 4)
+    {
+        tiles = std::min((num_threads * 4 + channels - 1) / channels, units);
+    }
+
+    // rows revisited for each input channel should stay in half of l2 cache
+    if (row_bytes > 0)
+    {
+        int l2_cache_size = get_cpu_cache_size(2);
+        if (l2_cache_size == 0)
+            l2_cache_size = 256 * 1024;
+
+        const size_t unit_bytes = row_bytes * row_align;
+        const int max_units = std::max((int)(l2_cache_size / 2 / unit_bytes), 1);
+        tiles = std::max(tiles, std::min((units + max_units - 1) / max_units, units));
+    }
+
+    if (tiles < 1)
+        tiles = 1;
+
+    parallel_for_2d_args args = { func, userdata, rows, row_align, tiles };
+    parallel_for(channels * tiles, parallel_for_2d_tile, &args, opt);
+}
+
 Layer::Layer()
 {
     one_blob_only = false;
     support_inplace = false;
+    shape_constant = false;
+    typeindex = -1;
 }
 
 Layer::~Layer()
@@ -68,6 +182,10 @@ int Layer::load_model(const ModelBin& /*mb*/)
     return 0;
 }
 
+void Layer::transformed_weights(std::vector<Mat*>& /*mats*/)
+{
+}
+
 int Layer::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     if (!support_inplace)
@@ -146,7 +264,9 @@ Layer* create_layer(int index)
     if (!layer_creator)
         return 0;
 
-    return layer_creator();
+    Layer* layer = layer_creator();
+    layer->typeindex = index;
+    return layer;
 }
 
 } // namespace ncnn
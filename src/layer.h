@@ -22,10 +22,12 @@
 #include "modelbin.h"
 #include "paramdict.h"
 #include "platform.h"
+#include "threadpool.h"
 
 namespace ncnn {
 
 class Allocator;
+class AutotuneCache;
 class Option
 {
 public:
@@ -39,7 +41,7 @@ public:
     bool lightmode;
 
     // thread count
-    // default value is the one returned by get_cpu_count()
+    // default value is one thread per physical core, at most get_cpu_count()
     int num_threads;
 
     // blob memory allocator
@@ -47,12 +49,34 @@ public:
 
     // workspace memory allocator
     Allocator* workspace_allocator;
+
+    // thread pool running the parallel loops
+    // null for openmp (default), or a shared pool when built without openmp
+    ThreadPool* thread_pool;
+
+    // kernel choices of autotuned layers
+    // null for the built-in heuristic (default)
+    AutotuneCache* autotune_cache;
 };
 
 // the global default option
 const Option& get_default_option();
 int set_default_option(const Option& opt);
 
+// run func(i, userdata) for i in [0, count) with opt.num_threads threads
+// on opt.thread_pool if set, otherwise with openmp or a shared pool without it
+void parallel_for(int count, parallel_for_func func, void* userdata, const Option& opt);
+
+// loop body of parallel_for_2d, called once for rows [y0, y1) of channel q
+typedef void (*parallel_for_2d_func)(int q, int y0, int y1, void* userdata);
+
+// run func over channels x rows with opt.num_threads threads
+// channels are split into row tiles when there are too few of them to keep all threads busy
+// tile boundaries fall on multiples of row_align, for kernels producing several rows at once
+// row_bytes is the size of one row the kernel revisits for each input channel,
+// tiles are then kept small enough to stay in l2 cache
+void parallel_for_2d(int channels, int rows, parallel_for_2d_func func, void* userdata, const Option& opt, int row_align = 1, size_t row_bytes = 0);
+
 class Layer
 {
 public:
@@ -69,6 +93,10 @@ public:
     // return 0 if success
     virtual int load_model(const ModelBin& mb);
 
+    // weight data transformed by load_model for the kernels of this build, in a fixed order
+    // a container stores them, load_model skips the transform of a mat given back non-empty
+    virtual void transformed_weights(std::vector<Mat*>& mats);
+
 public:
     // one input and one output blob
     bool one_blob_only;
@@ -76,6 +104,10 @@ public:
     // support inplace inference
     bool support_inplace;
 
+    // output depends on the shapes of bottom blobs only, not their values
+    // the net computes it once per input shape and shares it between extractors
+    bool shape_constant;
+
 public:
     // implement inference
     // return 0 if success
@@ -98,6 +130,10 @@ public:
     std::vector<int> bottoms;
     // blob index which this layer produces as output
     std::vector<int> tops;
+
+    // layer type index, LayerType::CustomBit set for custom layers
+    // -1 if not created by a layer factory
+    int typeindex;
 };
 
 // layer factory function
@@ -22,70 +22,83 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(AbsVal_arm)
 
-int AbsVal_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct absval_arm_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    Mat* bottom_top_blob;
+    int size;
+};
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
+static void absval_arm_channel(int q, void* userdata)
+{
+    const absval_arm_args* args = (const absval_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+
+    float* ptr = bottom_top_blob.channel(q);
 
 #if __ARM_NEON
-        int nn = size >> 2;
-        int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-        int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-        if (nn > 0)
-        {
-        asm volatile(
-            "0:                               \n"
-            "prfm       pldl1keep, [%1, #128] \n"
-            "ld1        {v0.4s}, [%1]         \n"
-            "fabs       v0.4s, v0.4s          \n"
-            "subs       %w0, %w0, #1          \n"
-            "st1        {v0.4s}, [%1], #16    \n"
-            "bne        0b                    \n"
-            : "=r"(nn),     // %0
-              "=r"(ptr)     // %1
-            : "0"(nn),
-              "1"(ptr)
-            : "cc", "memory", "v0"
-        );
-        }
+    if (nn > 0)
+    {
+    asm volatile(
+        "0:                               \n"
+        "prfm       pldl1keep, [%1, #128] \n"
+        "ld1        {v0.4s}, [%1]         \n"
+        "fabs       v0.4s, v0.4s          \n"
+        "subs       %w0, %w0, #1          \n"
+        "st1        {v0.4s}, [%1], #16    \n"
+        "bne        0b                    \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr)
+        : "cc", "memory", "v0"
+    );
+    }
 #else
-        if (nn > 0)
-        {
-        asm volatile(
-            "0:                             \n"
-            "vld1.f32   {d0-d1}, [%1]       \n"
-            "vabs.f32   q0, q0              \n"
-            "subs       %0, #1              \n"
-            "vst1.f32   {d0-d1}, [%1]!      \n"
-            "bne        0b                  \n"
-            : "=r"(nn),     // %0
-              "=r"(ptr)     // %1
-            : "0"(nn),
-              "1"(ptr)
-            : "cc", "memory", "q0"
-        );
-        }
+    if (nn > 0)
+    {
+    asm volatile(
+        "0:                             \n"
+        "vld1.f32   {d0-d1}, [%1]       \n"
+        "vabs.f32   q0, q0              \n"
+        "subs       %0, #1              \n"
+        "vst1.f32   {d0-d1}, [%1]!      \n"
+        "bne        0b                  \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr)
+        : "cc", "memory", "q0"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-        for (; remain>0; remain--)
-        {
-            *ptr = *ptr > 0 ? *ptr : -*ptr;
+    for (; remain>0; remain--)
+    {
+        *ptr = *ptr > 0 ? *ptr : -*ptr;
 
-            ptr++;
-        }
+        ptr++;
     }
+}
+
+int AbsVal_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    int size = w * h;
+
+    absval_arm_args args = { &bottom_top_blob, size };
+    parallel_for(channels, absval_arm_channel, &args, opt);
 
     return 0;
 }
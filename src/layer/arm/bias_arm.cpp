@@ -22,47 +22,62 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(Bias_arm)
 
-int Bias_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct bias_arm_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    Mat* bottom_top_blob;
+    int size;
+    const float* bias_ptr;
+};
 
-    const float* bias_ptr = bias_data;
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
+static void bias_arm_channel(int q, void* userdata)
+{
+    const bias_arm_args* args = (const bias_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    const float* bias_ptr = args->bias_ptr;
+
+    float* ptr = bottom_top_blob.channel(q);
 
-        float bias = bias_ptr[q];
+    float bias = bias_ptr[q];
 
 #if __ARM_NEON
-        int nn = size >> 2;
-        int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-        int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
-        float32x4_t _bias = vdupq_n_f32(bias);
-        for (; nn>0; nn--)
-        {
-            float32x4_t _p = vld1q_f32(ptr);
-            float32x4_t _outp = vaddq_f32(_p, _bias);
-            vst1q_f32(ptr, _outp);
-
-            ptr += 4;
-        }
+    float32x4_t _bias = vdupq_n_f32(bias);
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        float32x4_t _outp = vaddq_f32(_p, _bias);
+        vst1q_f32(ptr, _outp);
+
+        ptr += 4;
+    }
 #endif // __ARM_NEON
 
-        for (; remain>0; remain--)
-        {
-            *ptr = *ptr + bias;
+    for (; remain>0; remain--)
+    {
+        *ptr = *ptr + bias;
 
-            ptr++;
-        }
+        ptr++;
     }
+}
+
+int Bias_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    int size = w * h;
+
+    const float* bias_ptr = bias_data;
+    bias_arm_args args = { &bottom_top_blob, size, bias_ptr };
+    parallel_for(channels, bias_arm_channel, &args, opt);
 
     return 0;
 }
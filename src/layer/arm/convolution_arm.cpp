@@ -14,6 +14,9 @@
 
 #include "convolution_arm.h"
 
+#include <stdio.h>
+#include "autotune.h"
+
 namespace ncnn {
 
 #include "convolution_1x1.h"
@@ -38,9 +41,13 @@ int Convolution_arm::load_param(const ParamDict& pd)
 
     use_winograd3x3 = false;
     use_sgemm1x1 = false;
+    support_winograd3x3 = false;
+    support_sgemm1x1 = false;
 
     if (pd.use_winograd_convolution && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
+        support_winograd3x3 = true;
+
         int num_input = weight_data_size / 9 / num_output;
         // winograd is slow on small channel count
         if (num_input >= 16 && num_output >= 16)
@@ -50,6 +57,8 @@ int Convolution_arm::load_param(const ParamDict& pd)
     // TODO assume more proper condition
     if (pd.use_sgemm_convolution && kernel_w == 1 && kernel_h == 1 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
+        support_sgemm1x1 = true;
+
         int num_input = weight_data_size / num_output;
         if (num_input >= 64 && num_output >= 64)
             use_sgemm1x1 = true;
@@ -68,38 +77,104 @@ int Convolution_arm::load_model(const ModelBin& mb)
     {
 #if __ARM_NEON
 #if !__aarch64__
-        if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+        if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1 && weight_3x3s1_int8_data.empty())
         {
             int num_input = weight_data_size / 9 / num_output;
-            conv3x3s1_transform_kernel_int8_neon(weight_data, weight_3x3s1_int8_data, num_input, num_output);
+            conv3x3s1_transform_kernel_int8_neon(weight_data, weight_3x3s1_int8_data, num_input, num_output, mb.weight_allocator());
         }
 #endif // !__aarch64__
 #endif // __ARM_NEON
         return 0;
     }
 
-    if (use_winograd3x3)
+    // a container may have given back the transformed kernels already
+    if (support_winograd3x3 && weight_3x3_winograd64_data.empty())
     {
         int num_input = weight_data_size / 9 / num_output;
-//         conv3x3s1_winograd64_transform_kernel_neon(weight_data, weight_3x3_winograd64_data, num_input, num_output);
-        conv3x3s1_winograd64_transform_kernel_neon5(weight_data, weight_3x3_winograd64_data, num_input, num_output);
+//         conv3x3s1_winograd64_transform_kernel_neon(weight_data, weight_3x3_winograd64_data, num_input, num_output, mb.weight_allocator());
+        conv3x3s1_winograd64_transform_kernel_neon5(weight_data, weight_3x3_winograd64_data, num_input, num_output, mb.weight_allocator());
     }
 
-    if (use_sgemm1x1)
+    if (support_sgemm1x1 && weight_1x1_sgemm_data.empty())
     {
         int num_input = weight_data_size / num_output;
-        conv1x1s1_sgemm_transform_kernel_neon(weight_data, weight_1x1_sgemm_data, num_input, num_output);
+        conv1x1s1_sgemm_transform_kernel_neon(weight_data, weight_1x1_sgemm_data, num_input, num_output, mb.weight_allocator());
     }
 
-    if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
+    if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2 && weight_3x3s2_data.empty())
     {
         int num_input = weight_data_size / 9 / num_output;
-        conv3x3s2_transform_kernel_neon(weight_data, weight_3x3s2_data, num_input, num_output);
+        conv3x3s2_transform_kernel_neon(weight_data, weight_3x3s2_data, num_input, num_output, mb.weight_allocator());
     }
 
     return 0;
 }
 
+void Convolution_arm::transformed_weights(std::vector<Mat*>& mats)
+{
+    mats.push_back(&weight_3x3_winograd64_data);
+    mats.push_back(&weight_1x1_sgemm_data);
+    mats.push_back(&weight_3x3s2_data);
+    mats.push_back(&weight_3x3s1_int8_data);
+}
+
+// arguments of the loop bodies run by parallel_for
+struct convolution_arm_dilation_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    int dilation;
+    int x;
+    int y;
+};
+
+// gather the dense sub-image at offset (x, y) of channel c
+static void convolution_arm_dilation_gather(int c, void* userdata)
+{
+    const convolution_arm_dilation_args* args = (const convolution_arm_dilation_args*)userdata;
+    const Mat& bottom_blob_bordered = *args->bottom_blob;
+    Mat& inner_bottom_blob = *args->top_blob;
+    const int dilation = args->dilation;
+    const int w = bottom_blob_bordered.w;
+    const int inner_w = inner_bottom_blob.w;
+    const int inner_h = inner_bottom_blob.h;
+
+    float *outptr = inner_bottom_blob.channel(c);
+
+    for (int i = 0; i < inner_h; i ++)
+    {
+        const float *ptr = (const float *) bottom_blob_bordered.channel(c) + dilation * i * w + args->x * w + args->y;
+        for (int j = 0; j < inner_w; j ++)
+        {
+            outptr[j] = ptr[j*dilation];
+        }
+        outptr += inner_w;
+    }
+}
+
+// scatter the sub-image output of channel c back to offset (x, y)
+static void convolution_arm_dilation_scatter(int c, void* userdata)
+{
+    const convolution_arm_dilation_args* args = (const convolution_arm_dilation_args*)userdata;
+    const Mat& inner_top_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const int dilation = args->dilation;
+    const int outw = top_blob.w;
+    const int inner_outw = inner_top_blob.w;
+    const int inner_outh = inner_top_blob.h;
+
+    float *outptr = (float *) top_blob.channel(c) + args->x * outw + args->y;
+    for (int i = 0; i < inner_outh; i ++)
+    {
+        const float *ptr = (const float *) inner_top_blob.channel(c) + i * inner_outw;
+        for (int j = 0; j < inner_outw; j ++)
+        {
+            outptr[j*dilation] = ptr[j];
+        }
+        outptr += dilation * outw;
+    }
+}
+
 int Convolution_arm::forwardDilation(const Mat& bottom_blob, Mat& top_blob, conv_func conv, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -164,69 +239,88 @@ int Convolution_arm::forwardDilation(const Mat& bottom_blob, Mat& top_blob, conv
             if (inner_top_blob.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int c = 0; c < bottom_blob.c; c ++)
-            {
-                float *outptr = inner_bottom_blob.channel(c);
-
-                for (int i = 0; i < inner_h; i ++)
-                {
-                    const float *ptr = (const float *) bottom_blob_bordered.channel(c) + dilation * i * w + x * w + y;
-                    for (int j = 0; j < inner_w; j ++)
-                    {
-                        outptr[j] = ptr[j*dilation];
-                    }
-                    outptr += inner_w;
-                }
-            }
+            convolution_arm_dilation_args gather_args = { &bottom_blob_bordered, &inner_bottom_blob, dilation, x, y };
+            parallel_for(bottom_blob.c, convolution_arm_dilation_gather, &gather_args, opt);
 
             ncnn::Option opt_g = opt;
             opt_g.blob_allocator = inner_top_blob.allocator;
             conv(inner_bottom_blob, inner_top_blob, weight_data, bias_data, opt_g);
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int c = 0; c < num_output; c ++)
-            {
-                float *outptr = (float *) top_blob.channel(c) + x * outw + y;
-                for (int i = 0; i < inner_outh; i ++)
-                {
-                    const float *ptr = (const float *) inner_top_blob.channel(c) + i * inner_outw;
-                    for (int j = 0; j < inner_outw; j ++)
-                    {
-                        outptr[j*dilation] = ptr[j];
-                    }
-                    outptr += dilation * outw;
-                }
-            }
+            convolution_arm_dilation_args scatter_args = { &inner_top_blob, &top_blob, dilation, x, y };
+            parallel_for(num_output, convolution_arm_dilation_scatter, &scatter_args, opt);
         }
     }
 
     return 0;
 }
 
+// arguments of the algorithm runs timed by autotune
+struct convolution_autotune_args
+{
+    const Convolution_arm* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+static int convolution_arm_run(int algo, const Option& opt, void* userdata)
+{
+    const convolution_autotune_args* args = (const convolution_autotune_args*)userdata;
+
+    return args->layer->forward_algo(*args->bottom_blob, *args->top_blob, algo, opt);
+}
+
 int Convolution_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (opt.autotune_cache && !use_int8_inference && bottom_blob.dims == 3)
+    {
+        char signature[256];
+        sprintf(signature, "Convolution %d %dx%d %dx%d %dx%d %dx%d %dx%dx%d t%d",
+                num_output, kernel_w, kernel_h, stride_w, stride_h, dilation_w, dilation_h, pad_w, pad_h,
+                bottom_blob.w, bottom_blob.h, bottom_blob.c, opt.num_threads);
+
+        convolution_autotune_args args = { this, &bottom_blob, &top_blob };
+
+        Option opt_tuned;
+        int algo = autotune(signature, 4, convolution_arm_run, &args, opt, opt_tuned);
+        if (algo != -1)
+            return forward_algo(bottom_blob, top_blob, algo, opt_tuned);
+    }
+
+    return forward_algo(bottom_blob, top_blob, -1, opt);
+}
+
+int Convolution_arm::forward_algo(const Mat& bottom_blob, Mat& top_blob, int algo, const Option& opt) const
 {
     // convolv with NxN kernel
     // value = value + bias
 
-    if (bottom_blob.dims != 3)
+    if (algo == 3)
     {
         return Convolution::forward(bottom_blob, top_blob, opt);
     }
 
-    if (kernel_w != kernel_h || stride_w != stride_h)
+    if (algo == 1 && !support_winograd3x3)
+        return -1;
+
+    if (algo == 2 && !support_sgemm1x1)
+        return -1;
+
+    // the neon kernels below need square kernel, stride and dilation
+    if (bottom_blob.dims != 3 || kernel_w != kernel_h || stride_w != stride_h || kernel_w > 7 || stride_w > 4 || dilation_w != dilation_h)
     {
-        return Convolution::forward(bottom_blob, top_blob, opt);
+        return algo == -1 ? Convolution::forward(bottom_blob, top_blob, opt) : -1;
     }
 
-    const int kernel_size = kernel_w;
-    const int stride = stride_w;
-
-    if (kernel_size > 7 || stride > 4 || dilation_w != dilation_h)
+    // the dense sub-images of stride 1 float dilation run on the neon kernels
+    // the generic im2col handles int8 and strided dilation natively
+    if (dilation_w != 1 && (use_int8_inference || stride_w != 1 || algo > 0))
     {
-        return Convolution::forward(bottom_blob, top_blob, opt);
+        return algo == -1 ? Convolution::forward(bottom_blob, top_blob, opt) : -1;
     }
 
+    const int kernel_size = kernel_w;
+    const int stride = stride_w;
+
     typedef void (*conv_func)(const Mat&, Mat&, const Mat&, const Mat&, const Option&);
 
     // kernel_size x stride
@@ -340,16 +434,13 @@ int Convolution_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         conv = conv_func_table[kernel_size-1][stride-1];
         if (!conv)
         {
-            return Convolution::forward(bottom_blob, top_blob, opt);
+            return algo == -1 ? Convolution::forward(bottom_blob, top_blob, opt) : -1;
         }
+    }
 
-        if (dilation_w != 1)
-        {
-            if (stride != 1)
-                return Convolution::forward(bottom_blob, top_blob, opt);
-
-            return forwardDilation(bottom_blob, top_blob, conv, opt);
-        }
+    if (dilation_w != 1)
+    {
+        return forwardDilation(bottom_blob, top_blob, conv, opt);
     }
 
     int w = bottom_blob.w;
@@ -434,12 +525,22 @@ int Convolution_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         return 0;
     }
 
-    if (use_winograd3x3 && w <= 120 && h <= 120)
+    if (algo == -1)
+    {
+        if (use_winograd3x3 && w <= 120 && h <= 120)
+            algo = 1;
+        else if (use_sgemm1x1)
+            algo = 2;
+        else
+            algo = 0;
+    }
+
+    if (algo == 1)
     {
 //         conv3x3s1_winograd64_neon4(bottom_blob_bordered, top_blob, weight_3x3_winograd64_data, bias_data, opt);
         conv3x3s1_winograd64_neon5(bottom_blob_bordered, top_blob, weight_3x3_winograd64_data, bias_data, opt);
     }
-    else if (use_sgemm1x1)
+    else if (algo == 2)
     {
         conv1x1s1_sgemm_neon(bottom_blob_bordered, top_blob, weight_1x1_sgemm_data, bias_data, opt);
     }
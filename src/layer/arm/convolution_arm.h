@@ -28,12 +28,28 @@ public:
 
     virtual int load_model(const ModelBin& mb);
 
+    virtual void transformed_weights(std::vector<Mat*>& mats);
+
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
-    virtual int forwardDilation(const Mat& bottom_blob, Mat& top_blob, conv_func conv, const Option& opt) const;
+
+    // forward with algorithm algo, -1 for the built-in heuristic
+    // 0 = neon kernel chosen by kernel size and stride
+    // 1 = winograd64, 3x3 stride 1 only
+    // 2 = sgemm, 1x1 stride 1 only
+    // 3 = generic convolution
+    // return -1 if the algorithm does not apply
+    int forward_algo(const Mat& bottom_blob, Mat& top_blob, int algo, const Option& opt) const;
+
+    // run the dense sub-images of a stride 1 dilated convolution on conv
+    int forwardDilation(const Mat& bottom_blob, Mat& top_blob, conv_func conv, const Option& opt) const;
 
 public:
+    // heuristic choice
     bool use_winograd3x3;
     bool use_sgemm1x1;
+    // kernel transformed, so autotune may pick the path for any channel count
+    bool support_winograd3x3;
+    bool support_sgemm1x1;
     Mat weight_3x3_winograd64_data;
     Mat weight_1x1_sgemm_data;
     Mat weight_3x3s2_data;
@@ -19,6 +19,7 @@
 #endif
 
 #include "layer_type.h"
+#include "fused_activation.h"
 
 namespace ncnn {
 
@@ -117,6 +118,75 @@ int ConvolutionDepthWise_arm::load_model(const ModelBin& mb)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct convolutiondepthwise_arm_args
+{
+    const ConvolutionDepthWise_arm* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    const Option* opt;
+};
+
+// quantize the channels of group g
+static void convolutiondepthwise_arm_quantize_group(int g, void* userdata)
+{
+    const convolutiondepthwise_arm_args* args = (const convolutiondepthwise_arm_args*)userdata;
+    const ConvolutionDepthWise_arm* layer = args->layer;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& bottom_blob_int8 = *args->top_blob;
+    const Option& opt = *args->opt;
+    const int channels_g = bottom_blob_int8.c / layer->group;
+    const int shuffle_group = layer->shuffle_group;
+
+    ncnn::Option opt_g = opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = bottom_blob_int8.allocator;
+
+    const Mat bottom_blob_g = shuffle_group ? bottom_blob.channel_range(layer->bottom_channel(g), 1) : bottom_blob.channel_range(channels_g * g, channels_g);
+    Mat bottom_blob_int8_g = bottom_blob_int8.channel_range(channels_g * g, channels_g);
+    layer->quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
+}
+
+// dequantize channel g inplace
+static void convolutiondepthwise_arm_dequantize_group(int g, void* userdata)
+{
+    const convolutiondepthwise_arm_args* args = (const convolutiondepthwise_arm_args*)userdata;
+    const ConvolutionDepthWise_arm* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+    const Option& opt = *args->opt;
+
+    ncnn::Option opt_g = opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = top_blob.allocator;
+
+    Mat top_blob_g = top_blob.channel_range(g, 1);
+    layer->dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
+}
+
+// forward group g through its own convolution on one thread
+static void convolutiondepthwise_arm_group(int g, void* userdata)
+{
+    const convolutiondepthwise_arm_args* args = (const convolutiondepthwise_arm_args*)userdata;
+    const ConvolutionDepthWise_arm* layer = args->layer;
+    const Mat& bottom_blob_bordered = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Option& opt = *args->opt;
+    const int channels_g = bottom_blob_bordered.c / layer->group;
+    const int num_output_g = top_blob.c / layer->group;
+
+    Mat bottom_blob_bordered_g = bottom_blob_bordered.channel_range(channels_g * g, channels_g);
+    Mat top_blob_g = top_blob.channel_range(num_output_g * g, num_output_g);
+
+    const ncnn::Layer* op = layer->group_ops[g];
+
+    ncnn::Option opt_g = opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = top_blob.allocator;
+
+    // forward
+    op->forward(bottom_blob_bordered_g, top_blob_g, opt_g);
+}
+
 int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // convolv with NxN kernel
@@ -133,9 +203,18 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
         return -100;
     }
 
+    if (shuffle_group && (channels != group || channels % shuffle_group != 0))
+    {
+        // the fused shuffle is only gathered for depth-wise input
+        return -100;
+    }
+
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
+    // channels of the fused shuffle are gathered once, by the quantize or padding copy
+    bool gather = shuffle_group != 0;
+
     Mat bottom_blob_unbordered = bottom_blob;
     if (use_int8_inference && elemsize != 1)
     {
@@ -144,48 +223,21 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
         if (bottom_blob_int8.empty())
             return -100;
 
-        const int channels_g = channels / group;
-
         // quantize, scale and round to nearest
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = bottom_blob_int8.allocator;
-
-            const Mat bottom_blob_g = bottom_blob.channel_range(channels_g * g, channels_g);
-            Mat bottom_blob_int8_g = bottom_blob_int8.channel_range(channels_g * g, channels_g);
-            quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
-        }
+        convolutiondepthwise_arm_args args = { this, &bottom_blob, &bottom_blob_int8, &opt };
+        parallel_for(group, convolutiondepthwise_arm_quantize_group, &args, opt);
 
         bottom_blob_unbordered = bottom_blob_int8;
+        gather = false;
     }
 
-    Mat bottom_blob_bordered = bottom_blob_unbordered;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, pad_h, pad_h, pad_w, pad_w, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-        if (bottom_blob_bordered.empty())
-            return -100;
-
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
-    else if (pad_w == -233 && pad_h == -233)
-    {
-        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
-        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
-        if (wpad > 0 || hpad > 0)
-        {
-            copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, hpad / 2, hpad - hpad / 2, wpad / 2, wpad - wpad / 2, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-            if (bottom_blob_bordered.empty())
-                return -100;
-        }
+    Mat bottom_blob_bordered;
+    int ret = make_padding(bottom_blob_unbordered, bottom_blob_bordered, gather, opt);
+    if (ret != 0)
+        return ret;
 
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
 
     int outw = (w - kernel_extent_w) / stride_w + 1;
     int outh = (h - kernel_extent_h) / stride_h + 1;
@@ -213,16 +265,10 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
                     }
 
                     // dequantize, reverse scale inplace
-                    #pragma omp parallel for num_threads(opt.num_threads)
-                    for (int g=0; g<group; g++)
-                    {
-                        ncnn::Option opt_g = opt;
-                        opt_g.num_threads = 1;
-                        opt_g.blob_allocator = top_blob.allocator;
+                    convolutiondepthwise_arm_args args = { this, 0, &top_blob, &opt };
+                    parallel_for(group, convolutiondepthwise_arm_dequantize_group, &args, opt);
 
-                        Mat top_blob_g = top_blob.channel_range(g, 1);
-                        dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
-                    }
+                    fused_activation_inplace(top_blob, activation_type, activation_params, opt);
 
                     return 0;
                 }
@@ -235,31 +281,33 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
                 if (stride_w == 1 && stride_h == 1)
                 {
                     convdw3x3s1_neon(bottom_blob_bordered, top_blob, weight_data, bias_data, opt);
+                    fused_activation_inplace(top_blob, activation_type, activation_params, opt);
                     return 0;
                 }
                 else if (stride_w == 2 && stride_h == 2)
                 {
                     convdw3x3s2_neon(bottom_blob_bordered, top_blob, weight_data, bias_data, opt);
+                    fused_activation_inplace(top_blob, activation_type, activation_params, opt);
                     return 0;
                 }
             }
         }
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            Mat bottom_blob_bordered_g = bottom_blob_bordered.channel_range(g, 1);
-            Mat top_blob_g = top_blob.channel_range(g, 1);
+        convolutiondepthwise_arm_args args = { this, &bottom_blob_bordered, &top_blob, &opt };
+        parallel_for(group, convolutiondepthwise_arm_group, &args, opt);
 
-            const ncnn::Layer* op = group_ops[g];
+        fused_activation_inplace(top_blob, activation_type, activation_params, opt);
 
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = top_blob.allocator;
+        return 0;
+    }
 
-            // forward
-            op->forward(bottom_blob_bordered_g, top_blob_g, opt_g);
-        }
+    // enough groups to keep all threads busy, one thread per group
+    if (group >= opt.num_threads)
+    {
+        convolutiondepthwise_arm_args args = { this, &bottom_blob_bordered, &top_blob, &opt };
+        parallel_for(group, convolutiondepthwise_arm_group, &args, opt);
+
+        fused_activation_inplace(top_blob, activation_type, activation_params, opt);
 
         return 0;
     }
@@ -267,6 +315,7 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
     const int channels_g = channels / group;
     const int num_output_g = num_output / group;
 
+    // few groups, each running on all threads
     for (int g=0; g<group; g++)
     {
         Mat bottom_blob_bordered_g = bottom_blob_bordered.channel_range(channels_g * g, channels_g);
@@ -281,6 +330,8 @@ int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, con
         op->forward(bottom_blob_bordered_g, top_blob_g, opt_g);
     }
 
+    fused_activation_inplace(top_blob, activation_type, activation_params, opt);
+
     return 0;
 }
 
@@ -20,6 +20,79 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(DeconvolutionDepthWise_arm)
 
+// arguments of the loop body run by parallel_for
+struct deconvolutiondepthwise_arm_args
+{
+    const DeconvolutionDepthWise_arm* layer;
+    const Mat* bottom_blob;
+    const Mat* top_blob_bordered;
+    const Option* opt;
+};
+
+// deconvolve channel g with a single output deconvolution
+static void deconvolutiondepthwise_arm_channel(int g, void* userdata)
+{
+    const deconvolutiondepthwise_arm_args* args = (const deconvolutiondepthwise_arm_args*)userdata;
+    const DeconvolutionDepthWise_arm* layer = args->layer;
+    const Mat& bottom_blob = *args->bottom_blob;
+    const Mat& top_blob_bordered = *args->top_blob_bordered;
+    const Option& opt = *args->opt;
+
+    const int kernel_w = layer->kernel_w;
+    const int kernel_h = layer->kernel_h;
+    const int dilation_w = layer->dilation_w;
+    const int dilation_h = layer->dilation_h;
+    const int stride_w = layer->stride_w;
+    const int stride_h = layer->stride_h;
+    const int bias_term = layer->bias_term;
+    const Mat& weight_data = layer->weight_data;
+    const Mat& bias_data = layer->bias_data;
+    const int maxk = kernel_w * kernel_h;
+
+    Mat bottom_blob_g = bottom_blob.channel_range(g, 1);
+    Mat top_blob_bordered_g = top_blob_bordered.channel_range(g, 1);
+    Mat weight_data_g = weight_data.range(maxk * g, maxk);
+
+    Mat bias_data_g;
+    if (bias_term)
+        bias_data_g = bias_data.range(g, 1);
+
+    // call Deconvolution
+    ncnn::Layer* op = ncnn::create_layer(ncnn::LayerType::Deconvolution);
+
+    // set param
+    ncnn::ParamDict pd;
+    pd.set(0, 1);// num_output
+    pd.set(1, kernel_w);
+    pd.set(11, kernel_h);
+    pd.set(2, dilation_w);
+    pd.set(12, dilation_h);
+    pd.set(3, stride_w);
+    pd.set(13, stride_h);
+    pd.set(4, 0);// pad_w
+    pd.set(14, 0);// pad_h
+    pd.set(5, bias_term);
+    pd.set(6, maxk);// weight_data_size
+
+    op->load_param(pd);
+
+    // set weights
+    ncnn::Mat weights[2];
+    weights[0] = weight_data_g;
+    weights[1] = bias_data_g;
+
+    op->load_model(ModelBinFromMatArray(weights));
+
+    ncnn::Option opt_g = opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = top_blob_bordered.allocator;
+
+    // forward
+    op->forward(bottom_blob_g, top_blob_bordered_g, opt_g);
+
+    delete op;
+}
+
 int DeconvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // convolv with NxN kernel
@@ -62,52 +135,8 @@ int DeconvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, c
     // depth-wise
     if (channels == group && group == num_output)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            Mat bottom_blob_g = bottom_blob.channel_range(g, 1);
-            Mat top_blob_bordered_g = top_blob_bordered.channel_range(g, 1);
-            Mat weight_data_g = weight_data.range(maxk * g, maxk);
-
-            Mat bias_data_g;
-            if (bias_term)
-                bias_data_g = bias_data.range(g, 1);
-
-            // call Deconvolution
-            ncnn::Layer* op = ncnn::create_layer(ncnn::LayerType::Deconvolution);
-
-            // set param
-            ncnn::ParamDict pd;
-            pd.set(0, 1);// num_output
-            pd.set(1, kernel_w);
-            pd.set(11, kernel_h);
-            pd.set(2, dilation_w);
-            pd.set(12, dilation_h);
-            pd.set(3, stride_w);
-            pd.set(13, stride_h);
-            pd.set(4, 0);// pad_w
-            pd.set(14, 0);// pad_h
-            pd.set(5, bias_term);
-            pd.set(6, maxk);// weight_data_size
-
-            op->load_param(pd);
-
-            // set weights
-            ncnn::Mat weights[2];
-            weights[0] = weight_data_g;
-            weights[1] = bias_data_g;
-
-            op->load_model(ModelBinFromMatArray(weights));
-
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = top_blob_bordered.allocator;
-
-            // forward
-            op->forward(bottom_blob_g, top_blob_bordered_g, opt_g);
-
-            delete op;
-        }
+        deconvolutiondepthwise_arm_args args = { this, &bottom_blob, &top_blob_bordered, &opt };
+        parallel_for(group, deconvolutiondepthwise_arm_channel, &args, opt);
     }
     else
     {
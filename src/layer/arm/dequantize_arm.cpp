@@ -19,215 +19,176 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(Dequantize_arm)
 
-int Dequantize_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct dequantize_arm_args
 {
-#if __aarch64__
-    // TODO port to aarch64
-    return Dequantize::forward_inplace(bottom_top_blob, opt);
-#endif // __aarch64__
-
-    int dims = bottom_top_blob.dims;
-
-    if (dims == 1)
-    {
-        int w = bottom_top_blob.w;
-
-        int* intptr = bottom_top_blob;
-        float* ptr = bottom_top_blob;
-
-        if (bias_term)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
-            {
-                ptr[i] = intptr[i] * scale + bias_data[i];
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
-            {
-                ptr[i] = intptr[i] * scale;
-            }
-        }
-    }
+    Mat* bottom_top_blob;
+    int size;
+    float scale;
+    const float* bias_data_ptr;
+};
 
-    if (dims == 2)
-    {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-
-        if (bias_term)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
-            {
-                const int* intptr = bottom_top_blob.row<const int>(i);
-                float* ptr = bottom_top_blob.row(i);
-
-                float bias = bias_data_size > 1 ? bias_data[i] : bias_data[0];
-
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = intptr[j] * scale + bias;
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
-            {
-                const int* intptr = bottom_top_blob.row<const int>(i);
-                float* ptr = bottom_top_blob.row(i);
-
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = intptr[j] * scale;
-                }
-            }
-        }
-    }
-
-    if (dims == 3)
-    {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-        int channels = bottom_top_blob.c;
-        int size = w * h;
+static void dequantize_arm_bias_channel(int q, void* userdata)
+{
+    const dequantize_arm_args* args = (const dequantize_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    float scale = args->scale;
+    const float* bias_data_ptr = args->bias_data_ptr;
 
-        if (bias_term)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                int* intptr = bottom_top_blob.channel(q);
-                float* ptr = bottom_top_blob.channel(q);
+    int* intptr = bottom_top_blob.channel(q);
+    float* ptr = bottom_top_blob.channel(q);
 
-                float bias = bias_data[q];
+    float bias = bias_data_ptr[q];
 
 #if __ARM_NEON
-                int nn = size >> 3;
-                int remain = size & 7;
+    int nn = size >> 3;
+    int remain = size & 7;
 #else
-                int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-                // TODO
+    // TODO
 #else
-                if (nn > 0)
-                {
-                asm volatile(
-                    "pld        [%1, #256]          \n"
-                    "vld1.s32   {d0-d3}, [%1]!      \n" //q0-q1 data
-                    "vdup.f32   q10, %6             \n" //q10 scale
-                    "vdup.f32   q12, %7             \n" //q12 bias
-
-                    "0:                             \n"
-                    "vcvt.f32.s32 q0, q0           \n"
-                    "vcvt.f32.s32 q1, q1           \n"
-
-                    "vmul.f32   q0,q0,q10           \n"
-                    "vmul.f32   q1,q1,q10           \n"
-
-                    "vadd.f32   q2,q0,q12           \n"
-                    "vadd.f32   q3,q1,q12           \n"
-
-                    "pld        [%1, #256]          \n"
-                    "vld1.s32   {d0-d3}, [%1]!      \n"
-                    "vst1.f32   {d4-d7}, [%2]!      \n"
-
-                    "subs       %0, #1              \n"
-                    "bne        0b                  \n"
-
-                    "sub        %1, #32             \n"
-                    : "=r"(nn),         // %0
-                      "=r"(intptr),     // %1
-                      "=r"(ptr)         // %2
-                    : "0"(nn),
-                      "1"(intptr),
-                      "2"(ptr),
-                      "r"(scale),       // %6
-                      "r"(bias)         // %7
-                    : "cc", "memory", "q0", "q1", "q2", "q4", "q10", "q12"
-                );
-                }
+    if (nn > 0)
+    {
+    asm volatile(
+        "pld        [%1, #256]          \n"
+        "vld1.s32   {d0-d3}, [%1]!      \n" //q0-q1 data
+        "vdup.f32   q10, %6             \n" //q10 scale
+        "vdup.f32   q12, %7             \n" //q12 bias
+
+        "0:                             \n"
+        "vcvt.f32.s32 q0, q0           \n"
+        "vcvt.f32.s32 q1, q1           \n"
+
+        "vmul.f32   q0,q0,q10           \n"
+        "vmul.f32   q1,q1,q10           \n"
+
+        "vadd.f32   q2,q0,q12           \n"
+        "vadd.f32   q3,q1,q12           \n"
+
+        "pld        [%1, #256]          \n"
+        "vld1.s32   {d0-d3}, [%1]!      \n"
+        "vst1.f32   {d4-d7}, [%2]!      \n"
+
+        "subs       %0, #1              \n"
+        "bne        0b                  \n"
+
+        "sub        %1, #32             \n"
+        : "=r"(nn),         // %0
+          "=r"(intptr),     // %1
+          "=r"(ptr)         // %2
+        : "0"(nn),
+          "1"(intptr),
+          "2"(ptr),
+          "r"(scale),       // %6
+          "r"(bias)         // %7
+        : "cc", "memory", "q0", "q1", "q2", "q4", "q10", "q12"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-                for (; remain>0; remain--)
-                {
-                    *ptr = *intptr * scale + bias;
-
-                    intptr++;
-                    ptr++;
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                int* intptr = bottom_top_blob.channel(q);
-                float* ptr = bottom_top_blob.channel(q);
+    for (; remain>0; remain--)
+    {
+        *ptr = *intptr * scale + bias;
+
+        intptr++;
+        ptr++;
+    }
+}
+
+static void dequantize_arm_channel(int q, void* userdata)
+{
+    const dequantize_arm_args* args = (const dequantize_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    float scale = args->scale;
+
+    int* intptr = bottom_top_blob.channel(q);
+    float* ptr = bottom_top_blob.channel(q);
 
 #if __ARM_NEON
-                int nn = size >> 3;
-                int remain = size & 7;
+    int nn = size >> 3;
+    int remain = size & 7;
 #else
-                int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-                // TODO
+    // TODO
 #else
-                if (nn > 0)
-                {
-                asm volatile(
-                    "pld        [%1, #256]          \n"
-                    "vld1.s32   {d0-d3}, [%1]!      \n" //q0-q1 data
-                    "vdup.f32   q10, %6             \n" //q10 scale
-
-                    "0:                             \n"
-                    "vcvt.f32.s32 q0, q0           \n"
-                    "vcvt.f32.s32 q1, q1           \n"
-
-                    "vmul.f32   q2,q0,q10           \n"
-                    "vmul.f32   q3,q1,q10           \n"
-
-                    "pld        [%1, #256]          \n"
-                    "vld1.s32   {d0-d3}, [%1]!      \n"
-                    "vst1.f32   {d4-d7}, [%2]!      \n"
-
-                    "subs       %0, #1              \n"
-                    "bne        0b                  \n"
-
-                    "sub        %1, #32             \n"
-                    : "=r"(nn),         // %0
-                      "=r"(intptr),     // %1
-                      "=r"(ptr)         // %2
-                    : "0"(nn),
-                      "1"(intptr),
-                      "2"(ptr),
-                      "r"(scale)        // %6
-                    : "cc", "memory", "q0", "q1", "q2", "q4", "q10", "q12"
-                );              
-                }
+    if (nn > 0)
+    {
+    asm volatile(
+        "pld        [%1, #256]          \n"
+        "vld1.s32   {d0-d3}, [%1]!      \n" //q0-q1 data
+        "vdup.f32   q10, %6             \n" //q10 scale
+
+        "0:                             \n"
+        "vcvt.f32.s32 q0, q0           \n"
+        "vcvt.f32.s32 q1, q1           \n"
+
+        "vmul.f32   q2,q0,q10           \n"
+        "vmul.f32   q3,q1,q10           \n"
+
+        "pld        [%1, #256]          \n"
+        "vld1.s32   {d0-d3}, [%1]!      \n"
+        "vst1.f32   {d4-d7}, [%2]!      \n"
+
+        "subs       %0, #1              \n"
+        "bne        0b                  \n"
+
+        "sub        %1, #32             \n"
+        : "=r"(nn),         // %0
+          "=r"(intptr),     // %1
+          "=r"(ptr)         // %2
+        : "0"(nn),
+          "1"(intptr),
+          "2"(ptr),
+          "r"(scale)        // %6
+        : "cc", "memory", "q0", "q1", "q2", "q4", "q10", "q12"
+    );              
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-                for (; remain>0; remain--)
-                {
-                    *ptr = *intptr * scale;
-
-                    intptr++;
-                    ptr++;
-                }
-            }
-        }   
+    for (; remain>0; remain--)
+    {
+        *ptr = *intptr * scale;
+
+        intptr++;
+        ptr++;
+    }
+}
+
+int Dequantize_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if __aarch64__
+    // TODO port to aarch64
+    return Dequantize::forward_inplace(bottom_top_blob, opt);
+#endif // __aarch64__
+
+    int dims = bottom_top_blob.dims;
+    if (dims != 3)
+        return Dequantize::forward_inplace(bottom_top_blob, opt);
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    int size = w * h;
+
+    dequantize_arm_args args = { &bottom_top_blob, size, scale, bias_data };
+
+    if (bias_term)
+    {
+        parallel_for(channels, dequantize_arm_bias_channel, &args, opt);
+    }
+    else
+    {
+        parallel_for(channels, dequantize_arm_channel, &args, opt);
     }
 
     return 0;
@@ -24,25 +24,86 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(LRN_arm)
 
-int LRN_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct lrn_arm_square_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    size_t elemsize = bottom_top_blob.elemsize;
-    int size = w * h;
+    Mat* bottom_top_blob;
+    int size;
+    Mat* square_blob;
+};
 
-    // squared values with local_size padding
-    Mat square_blob;
-    square_blob.create(w, h, channels, elemsize, opt.workspace_allocator);
-    if (square_blob.empty())
-        return -100;
+static void lrn_arm_square_channel(int q, void* userdata)
+{
+    const lrn_arm_square_args* args = (const lrn_arm_square_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    Mat& square_blob = *args->square_blob;
+
+    const float* ptr = bottom_top_blob.channel(q);
+    float* outptr = square_blob.channel(q);
+
+#if __ARM_NEON
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
+#else
+    int remain = size;
+#endif // __ARM_NEON
+
+#if __ARM_NEON
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        float32x4_t _outp = vmulq_f32(_p, _p);
+        vst1q_f32(outptr, _outp);
+
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __ARM_NEON
+    for (; remain>0; remain--)
+    {
+        *outptr = *ptr * *ptr;
+
+        ptr++;
+        outptr++;
+    }
+}
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
+// arguments of the loop body run by parallel_for
+struct lrn_arm_across_args
+{
+    Mat* bottom_top_blob;
+    int channels;
+    int size;
+    Mat* square_blob;
+    Mat* square_sum;
+    float alpha_div_size;
+    int local_size;
+    float bias;
+    float beta;
+};
+
+static void lrn_arm_across_channel(int q, void* userdata)
+{
+    const lrn_arm_across_args* args = (const lrn_arm_across_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int channels = args->channels;
+    int size = args->size;
+    Mat& square_blob = *args->square_blob;
+    Mat& square_sum = *args->square_sum;
+    const float alpha_div_size = args->alpha_div_size;
+    int local_size = args->local_size;
+    float bias = args->bias;
+    float beta = args->beta;
+
+    // square sum
+    for (int p=q - local_size / 2; p<=q + local_size / 2; p++)
     {
-        const float* ptr = bottom_top_blob.channel(q);
-        float* outptr = square_blob.channel(q);
+        if (p < 0 || p >= channels)
+            continue;
+
+        const float* sptr = square_blob.channel(p);
+        float* ssptr = square_sum.channel(q);
 
 #if __ARM_NEON
         int nn = size >> 2;
@@ -54,108 +115,140 @@ int LRN_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 #if __ARM_NEON
         for (; nn>0; nn--)
         {
-            float32x4_t _p = vld1q_f32(ptr);
-            float32x4_t _outp = vmulq_f32(_p, _p);
-            vst1q_f32(outptr, _outp);
+            float32x4_t _sp = vld1q_f32(sptr);
+            float32x4_t _ssp = vld1q_f32(ssptr);
+            _ssp = vaddq_f32(_ssp, _sp);
+            vst1q_f32(ssptr, _ssp);
 
-            ptr += 4;
-            outptr += 4;
+            sptr += 4;
+            ssptr += 4;
         }
 #endif // __ARM_NEON
         for (; remain>0; remain--)
         {
-            *outptr = *ptr * *ptr;
-
-            ptr++;
-            outptr++;
+            *ssptr += *sptr;
+            sptr++;
+            ssptr++;
         }
     }
 
-    if (region_type == NormRegion_ACROSS_CHANNELS)
-    {
-        Mat square_sum;
-        square_sum.create(w, h, channels, elemsize, opt.workspace_allocator);
-        if (square_sum.empty())
-            return -100;
-        square_sum.fill(0.f);
-
-        const float alpha_div_size = alpha / local_size;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            // square sum
-            for (int p=q - local_size / 2; p<=q + local_size / 2; p++)
-            {
-                if (p < 0 || p >= channels)
-                    continue;
-
-                const float* sptr = square_blob.channel(p);
-                float* ssptr = square_sum.channel(q);
+    float* ptr = bottom_top_blob.channel(q);
+    float* ssptr = square_sum.channel(q);
 
 #if __ARM_NEON
-                int nn = size >> 2;
-                int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-                int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
-                for (; nn>0; nn--)
-                {
-                    float32x4_t _sp = vld1q_f32(sptr);
-                    float32x4_t _ssp = vld1q_f32(ssptr);
-                    _ssp = vaddq_f32(_ssp, _sp);
-                    vst1q_f32(ssptr, _ssp);
-
-                    sptr += 4;
-                    ssptr += 4;
-                }
+    float32x4_t _bias = vdupq_n_f32(bias);
+    float32x4_t _ads = vdupq_n_f32(alpha_div_size);
+    float32x4_t _mb = vdupq_n_f32(-beta);
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        float32x4_t _ssp = vld1q_f32(ssptr);
+        _ssp = vmulq_f32(_ssp, _ads);
+        _ssp = vaddq_f32(_ssp, _bias);
+        _ssp = pow_ps(_ssp, _mb);
+        _p = vmulq_f32(_p, _ssp);
+        vst1q_f32(ptr, _p);
+
+        ssptr += 4;
+        ptr += 4;
+    }
 #endif // __ARM_NEON
-                for (; remain>0; remain--)
-                {
-                    *ssptr += *sptr;
-                    sptr++;
-                    ssptr++;
-                }
-            }
+    for (; remain>0; remain--)
+    {
+        *ptr = *ptr * pow(bias + alpha_div_size * *ssptr, -beta);
 
-            float* ptr = bottom_top_blob.channel(q);
-            float* ssptr = square_sum.channel(q);
+        ssptr++;
+        ptr++;
+    }
+}
 
-#if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
-#else
-            int remain = size;
-#endif // __ARM_NEON
+// arguments of the loop body run by parallel_for
+struct lrn_arm_within_args
+{
+    Mat* bottom_top_blob;
+    float alpha_div_size;
+    int outw;
+    int outh;
+    Mat* square_blob_bordered;
+    int maxk;
+    int* space_ofs;
+    float bias;
+    float beta;
+};
+
+static void lrn_arm_within_channel(int q, void* userdata)
+{
+    const lrn_arm_within_args* args = (const lrn_arm_within_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float alpha_div_size = args->alpha_div_size;
+    int outw = args->outw;
+    int outh = args->outh;
+    Mat& square_blob_bordered = *args->square_blob_bordered;
+    const int maxk = args->maxk;
+    int* space_ofs = args->space_ofs;
+    float bias = args->bias;
+    float beta = args->beta;
+
+    float* ptr = bottom_top_blob.channel(q);
+    const Mat m = square_blob_bordered.channel(q);
+
+    for (int i = 0; i < outh; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            const float* sptr = m.row(i) + j;
 
-#if __ARM_NEON
-            float32x4_t _bias = vdupq_n_f32(bias);
-            float32x4_t _ads = vdupq_n_f32(alpha_div_size);
-            float32x4_t _mb = vdupq_n_f32(-beta);
-            for (; nn>0; nn--)
+            float ss = 0.f;
+
+            for (int k = 0; k < maxk; k++)
             {
-                float32x4_t _p = vld1q_f32(ptr);
-                float32x4_t _ssp = vld1q_f32(ssptr);
-                _ssp = vmulq_f32(_ssp, _ads);
-                _ssp = vaddq_f32(_ssp, _bias);
-                _ssp = pow_ps(_ssp, _mb);
-                _p = vmulq_f32(_p, _ssp);
-                vst1q_f32(ptr, _p);
-
-                ssptr += 4;
-                ptr += 4;
+                float val = sptr[ space_ofs[k] ];
+                ss += val;
             }
-#endif // __ARM_NEON
-            for (; remain>0; remain--)
-            {
-                *ptr = *ptr * pow(bias + alpha_div_size * *ssptr, -beta);
 
-                ssptr++;
-                ptr++;
-            }
+            ptr[j] = ptr[j] * pow(bias + alpha_div_size * ss, -beta);
         }
+
+        ptr += outw;
+    }
+}
+
+int LRN_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    size_t elemsize = bottom_top_blob.elemsize;
+    int size = w * h;
+
+    // squared values with local_size padding
+    Mat square_blob;
+    square_blob.create(w, h, channels, elemsize, opt.workspace_allocator);
+    if (square_blob.empty())
+        return -100;
+
+    lrn_arm_square_args square_args = { &bottom_top_blob, size, &square_blob };
+    parallel_for(channels, lrn_arm_square_channel, &square_args, opt);
+
+    if (region_type == NormRegion_ACROSS_CHANNELS)
+    {
+        Mat square_sum;
+        square_sum.create(w, h, channels, elemsize, opt.workspace_allocator);
+        if (square_sum.empty())
+            return -100;
+        square_sum.fill(0.f);
+
+        const float alpha_div_size = alpha / local_size;
+
+        lrn_arm_across_args args = { &bottom_top_blob, channels, size, &square_blob, &square_sum, alpha_div_size, local_size, bias, beta };
+        parallel_for(channels, lrn_arm_across_channel, &args, opt);
     }
     else if (region_type == NormRegion_WITHIN_CHANNEL)
     {
@@ -197,32 +290,8 @@ int LRN_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
             }
         }
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            const Mat m = square_blob_bordered.channel(q);
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    const float* sptr = m.row(i) + j;
-
-                    float ss = 0.f;
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = sptr[ space_ofs[k] ];
-                        ss += val;
-                    }
-
-                    ptr[j] = ptr[j] * pow(bias + alpha_div_size * ss, -beta);
-                }
-
-                ptr += outw;
-            }
-        }
+        lrn_arm_within_args args = { &bottom_top_blob, alpha_div_size, outw, outh, &square_blob_bordered, maxk, space_ofs, bias, beta };
+        parallel_for(channels, lrn_arm_within_channel, &args, opt);
     }
 
     return 0;
@@ -29,14 +29,25 @@ static inline signed char float2int8(float v)
     return (signed char)int32;
 }
 
-int Quantize_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct quantize_arm_args
 {
-#if __aarch64__
-    // TODO port to aarch64 fcvtas
-    return Quantize::forward(bottom_blob, top_blob, opt);
-#endif // __aarch64__
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    int size;
+    float scale;
+};
+
+static void quantize_arm_channel(int q, void* userdata)
+{
+    const quantize_arm_args* args = (const quantize_arm_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    int size = args->size;
+    float scale = args->scale;
 
 #if !__aarch64__
+    // round to nearest for vcvtr, the mode is per thread
     int FPSCR_value = 0;
 
     asm volatile(
@@ -49,127 +60,71 @@ int Quantize_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     );
 #endif
 
-    int dims = bottom_blob.dims;
-
-    if (dims == 1)
-    {
-        int w = bottom_blob.w;
-
-        top_blob.create(w, (size_t)1u, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        const float* ptr = bottom_blob;
-        signed char* outptr = top_blob;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<w; i++)
-        {
-            outptr[i] = float2int8(ptr[i] * scale);
-        }
-    }
-
-    if (dims == 2)
-    {
-        int w = bottom_blob.w;
-        int h = bottom_blob.h;
-        int size = w * h;
-
-        top_blob.create(w, h, (size_t)1u, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        const float* ptr = bottom_blob;
-        signed char* outptr = top_blob;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<size; i++)
-        {
-            outptr[i] = float2int8(ptr[i] * scale);
-        }
-    }
-
-    if (dims == 3)
-    {
-        int w = bottom_blob.w;
-        int h = bottom_blob.h;
-        int channels = bottom_blob.c;
-        int size = w * h;
-
-        top_blob.create(w, h, channels, (size_t)1u, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            signed char* outptr = top_blob.channel(q);
+    const float* ptr = bottom_blob.channel(q);
+    signed char* outptr = top_blob.channel(q);
 
 #if __ARM_NEON
-            int nn = size >> 3;
-            int remain = size & 7;
+    int nn = size >> 3;
+    int remain = size & 7;
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-            // TODO
+    // TODO
 #else
-            if (nn > 0)
-            {
-            asm volatile(
-                "pld        [%1, #256]          \n"
-                "vld1.f32   {d0-d3}, [%1]!      \n"
-                "vdup.32    q10, %6             \n"
-
-                "0:                             \n"
-                "vmul.f32   q0,q0,q10           \n"
-                "vmul.f32   q1,q1,q10           \n"
-
-                "vcvtr.s32.f32 s0,s0            \n"
-                "vcvtr.s32.f32 s1,s1            \n"
-                "vcvtr.s32.f32 s2,s2            \n"
-                "vcvtr.s32.f32 s3,s3            \n"
-                "vcvtr.s32.f32 s4,s4            \n"
-                "vcvtr.s32.f32 s5,s5            \n"
-                "vcvtr.s32.f32 s6,s6            \n"
-                "vcvtr.s32.f32 s7,s7            \n"
-
-                "vqmovn.s32 d4,q0               \n"
-                "vqmovn.s32 d5,q1               \n"
-
-                "pld        [%1, #256]          \n"
-                "vld1.f32   {d0-d3}, [%1]!      \n"
-
-                "vqmovn.s16 d4, q2              \n"
-                "vst1.8     {d4}, [%2]!         \n"
-
-                "subs       %0, #1              \n"
-                "bne        0b                  \n"
-
-                "sub        %1, #32             \n"
-                : "=r"(nn),         // %0
-                  "=r"(ptr),        // %1
-                  "=r"(outptr)      // %2
-                : "0"(nn),
-                  "1"(ptr),
-                  "2"(outptr),
-                  "r"(scale)        // %6
-                : "cc", "memory", "q0", "q1", "q2", "q3", "q4", "q10", "q11"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "pld        [%1, #256]          \n"
+        "vld1.f32   {d0-d3}, [%1]!      \n"
+        "vdup.32    q10, %6             \n"
+
+        "0:                             \n"
+        "vmul.f32   q0,q0,q10           \n"
+        "vmul.f32   q1,q1,q10           \n"
+
+        "vcvtr.s32.f32 s0,s0            \n"
+        "vcvtr.s32.f32 s1,s1            \n"
+        "vcvtr.s32.f32 s2,s2            \n"
+        "vcvtr.s32.f32 s3,s3            \n"
+        "vcvtr.s32.f32 s4,s4            \n"
+        "vcvtr.s32.f32 s5,s5            \n"
+        "vcvtr.s32.f32 s6,s6            \n"
+        "vcvtr.s32.f32 s7,s7            \n"
+
+        "vqmovn.s32 d4,q0               \n"
+        "vqmovn.s32 d5,q1               \n"
+
+        "pld        [%1, #256]          \n"
+        "vld1.f32   {d0-d3}, [%1]!      \n"
+
+        "vqmovn.s16 d4, q2              \n"
+        "vst1.8     {d4}, [%2]!         \n"
+
+        "subs       %0, #1              \n"
+        "bne        0b                  \n"
+
+        "sub        %1, #32             \n"
+        : "=r"(nn),         // %0
+          "=r"(ptr),        // %1
+          "=r"(outptr)      // %2
+        : "0"(nn),
+          "1"(ptr),
+          "2"(outptr),
+          "r"(scale)        // %6
+        : "cc", "memory", "q0", "q1", "q2", "q3", "q4", "q10", "q11"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-            for (; remain>0; remain--)
-            {
-                *outptr = float2int8(*ptr * scale);
-
-                ptr++;
-                outptr++;
-            }
-        }
+    for (; remain>0; remain--)
+    {
+        *outptr = float2int8(*ptr * scale);
+
+        ptr++;
+        outptr++;
     }
 
 #if !__aarch64__
@@ -180,6 +135,33 @@ int Quantize_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
         : "memory"
     );
 #endif
+}
+
+int Quantize_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __aarch64__
+    // TODO port to aarch64 fcvtas
+    return Quantize::forward(bottom_blob, top_blob, opt);
+#endif // __aarch64__
+
+    int dims = bottom_blob.dims;
+    if (dims != 3)
+        return Quantize::forward(bottom_blob, top_blob, opt);
+
+    if (dims == 3)
+    {
+        int w = bottom_blob.w;
+        int h = bottom_blob.h;
+        int channels = bottom_blob.c;
+        int size = w * h;
+
+        top_blob.create(w, h, channels, (size_t)1u, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        quantize_arm_args args = { &bottom_blob, &top_blob, size, scale };
+        parallel_for(channels, quantize_arm_channel, &args, opt);
+    }
 
     return 0;
 }
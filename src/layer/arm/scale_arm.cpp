@@ -22,93 +22,125 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(Scale_arm)
 
-int Scale_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct scale_bias_arm_args
 {
-    int dims = bottom_top_blob.dims;
-    if (dims != 3)
-        return Scale::forward_inplace(bottom_top_blob, opt);
+    Mat* bottom_top_blob;
+    int size;
+    const float* scale_ptr;
+    const float* bias_ptr;
+};
 
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+static void scale_bias_arm_channel(int q, void* userdata)
+{
+    const scale_bias_arm_args* args = (const scale_bias_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    const float* scale_ptr = args->scale_ptr;
+    const float* bias_ptr = args->bias_ptr;
 
-    if (bias_term)
-    {
-        const float* scale_ptr = scale_data;
-        const float* bias_ptr = bias_data;
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
+    float* ptr = bottom_top_blob.channel(q);
 
-            float s = scale_ptr[q];
-            float bias = bias_ptr[q];
+    float s = scale_ptr[q];
+    float bias = bias_ptr[q];
 
 #if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
-            float32x4_t _s = vdupq_n_f32(s);
-            float32x4_t _bias = vdupq_n_f32(bias);
-            for (; nn>0; nn--)
-            {
-                float32x4_t _p = vld1q_f32(ptr);
-                _p = vmlaq_f32(_bias, _p, _s);
-                vst1q_f32(ptr, _p);
-
-                ptr += 4;
-            }
+    float32x4_t _s = vdupq_n_f32(s);
+    float32x4_t _bias = vdupq_n_f32(bias);
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        _p = vmlaq_f32(_bias, _p, _s);
+        vst1q_f32(ptr, _p);
+
+        ptr += 4;
+    }
 #endif // __ARM_NEON
 
-            for (; remain>0; remain--)
-            {
-                *ptr = *ptr * s + bias;
+    for (; remain>0; remain--)
+    {
+        *ptr = *ptr * s + bias;
 
-                ptr++;
-            }
-        }
+        ptr++;
     }
-    else
-    {
-        const float* scale_ptr = scale_data;
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
+}
+
+// arguments of the loop body run by parallel_for
+struct scale_arm_args
+{
+    Mat* bottom_top_blob;
+    int size;
+    const float* scale_ptr;
+};
+
+static void scale_arm_channel(int q, void* userdata)
+{
+    const scale_arm_args* args = (const scale_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    const float* scale_ptr = args->scale_ptr;
+
+    float* ptr = bottom_top_blob.channel(q);
 
-            float s = scale_ptr[q];
+    float s = scale_ptr[q];
 
 #if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
-            float32x4_t _s = vdupq_n_f32(s);
-            for (; nn>0; nn--)
-            {
-                float32x4_t _p = vld1q_f32(ptr);
-                _p = vmulq_f32(_p, _s);
-                vst1q_f32(ptr, _p);
-
-                ptr += 4;
-            }
+    float32x4_t _s = vdupq_n_f32(s);
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        _p = vmulq_f32(_p, _s);
+        vst1q_f32(ptr, _p);
+
+        ptr += 4;
+    }
 #endif // __ARM_NEON
 
-            for (; remain>0; remain--)
-            {
-                *ptr *= s;
+    for (; remain>0; remain--)
+    {
+        *ptr *= s;
+
+        ptr++;
+    }
+}
+
+int Scale_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int dims = bottom_top_blob.dims;
+    if (dims != 3)
+        return Scale::forward_inplace(bottom_top_blob, opt);
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    int size = w * h;
 
-                ptr++;
-            }
-        }
+    if (bias_term)
+    {
+        const float* scale_ptr = scale_data;
+        const float* bias_ptr = bias_data;
+        scale_bias_arm_args args = { &bottom_top_blob, size, scale_ptr, bias_ptr };
+        parallel_for(channels, scale_bias_arm_channel, &args, opt);
+    }
+    else
+    {
+        const float* scale_ptr = scale_data;
+        scale_arm_args args = { &bottom_top_blob, size, scale_ptr };
+        parallel_for(channels, scale_arm_channel, &args, opt);
     }
 
     return 0;
@@ -25,48 +25,61 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(Sigmoid_arm)
 
-int Sigmoid_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct sigmoid_arm_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    Mat* bottom_top_blob;
+    int size;
+};
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
+static void sigmoid_arm_channel(int q, void* userdata)
+{
+    const sigmoid_arm_args* args = (const sigmoid_arm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+
+    float* ptr = bottom_top_blob.channel(q);
 
 #if __ARM_NEON
-        int nn = size >> 2;
-        int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-        int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
-        float32x4_t _one = vdupq_n_f32(1.f);
-        for (; nn>0; nn--)
-        {
-            float32x4_t _p = vld1q_f32(ptr);
-            _p = vnegq_f32(_p);
-            _p = exp_ps(_p);
-            _p = vaddq_f32(_p, _one);
-            float32x4_t _outp = vrecpeq_f32(_p);
-            _outp = vmulq_f32(vrecpsq_f32(_p, _outp), _outp);
+    float32x4_t _one = vdupq_n_f32(1.f);
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        _p = vnegq_f32(_p);
+        _p = exp_ps(_p);
+        _p = vaddq_f32(_p, _one);
+        float32x4_t _outp = vrecpeq_f32(_p);
+        _outp = vmulq_f32(vrecpsq_f32(_p, _outp), _outp);
 //             _outp = vmulq_f32(vrecpsq_f32(_p, _outp), _outp);
-            vst1q_f32(ptr, _outp);
+        vst1q_f32(ptr, _outp);
 
-            ptr += 4;
-        }
+        ptr += 4;
+    }
 #endif // __ARM_NEON
-        for (; remain>0; remain--)
-        {
-            *ptr = 1.f / (1.f + exp(-*ptr));
+    for (; remain>0; remain--)
+    {
+        *ptr = 1.f / (1.f + exp(-*ptr));
 
-            ptr++;
-        }
+        ptr++;
     }
+}
+
+int Sigmoid_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+    int size = w * h;
+
+    sigmoid_arm_args args = { &bottom_top_blob, size };
+    parallel_for(channels, sigmoid_arm_channel, &args, opt);
 
     return 0;
 }
@@ -25,6 +25,106 @@ namespace ncnn {
 
 DEFINE_LAYER_CREATOR(Softmax_arm)
 
+// arguments of the loop body run by parallel_for
+struct softmax_arm_exp_args
+{
+    Mat* bottom_top_blob;
+    int size;
+    Mat* max;
+};
+
+static void softmax_arm_exp_channel(int q, void* userdata)
+{
+    const softmax_arm_exp_args* args = (const softmax_arm_exp_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    Mat& max = *args->max;
+
+    float* ptr = bottom_top_blob.channel(q);
+    float* maxptr = max;
+
+#if __ARM_NEON
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
+#else
+    int remain = size;
+#endif // __ARM_NEON
+
+#if __ARM_NEON
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        float32x4_t _max = vld1q_f32(maxptr);
+
+        _p = exp_ps(vsubq_f32(_p, _max));
+
+        vst1q_f32(ptr, _p);
+
+        ptr += 4;
+        maxptr += 4;
+    }
+#endif // __ARM_NEON
+
+    for (; remain>0; remain--)
+    {
+        *ptr = exp(*ptr - *maxptr);
+
+        ptr++;
+        maxptr++;
+    }
+}
+
+// arguments of the loop body run by parallel_for
+struct softmax_arm_div_args
+{
+    Mat* bottom_top_blob;
+    int size;
+    Mat* sum;
+};
+
+static void softmax_arm_div_channel(int q, void* userdata)
+{
+    const softmax_arm_div_args* args = (const softmax_arm_div_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    int size = args->size;
+    Mat& sum = *args->sum;
+
+    float* ptr = bottom_top_blob.channel(q);
+    float* sumptr = sum;
+
+#if __ARM_NEON
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
+#else
+    int remain = size;
+#endif // __ARM_NEON
+
+#if __ARM_NEON
+    for (; nn>0; nn--)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        float32x4_t _sum = vld1q_f32(sumptr);
+#if __aarch64__
+        _p = vdivq_f32(_p, _sum);
+#else
+        _p = div_ps(_p, _sum);
+#endif // __aarch64__
+        vst1q_f32(ptr, _p);
+
+        ptr += 4;
+        sumptr += 4;
+    }
+#endif // __ARM_NEON
+
+    for (; remain>0; remain--)
+    {
+        *ptr /= *sumptr;
+
+        ptr++;
+        sumptr++;
+    }
+}
+
 int Softmax_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
     int dims = bottom_top_blob.dims;
@@ -58,42 +158,8 @@ int Softmax_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
         }
     }
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-        float* maxptr = max;
-
-#if __ARM_NEON
-        int nn = size >> 2;
-        int remain = size - (nn << 2);
-#else
-        int remain = size;
-#endif // __ARM_NEON
-
-#if __ARM_NEON
-        for (; nn>0; nn--)
-        {
-            float32x4_t _p = vld1q_f32(ptr);
-            float32x4_t _max = vld1q_f32(maxptr);
-
-            _p = exp_ps(vsubq_f32(_p, _max));
-
-            vst1q_f32(ptr, _p);
-
-            ptr += 4;
-            maxptr += 4;
-        }
-#endif // __ARM_NEON
-
-        for (; remain>0; remain--)
-        {
-            *ptr = exp(*ptr - *maxptr);
-
-            ptr++;
-            maxptr++;
-        }
-    }
+    softmax_arm_exp_args exp_args = { &bottom_top_blob, size, &max };
+    parallel_for(channels, softmax_arm_exp_channel, &exp_args, opt);
 
     Mat sum;
     sum.create(w, h, elemsize, opt.workspace_allocator);
@@ -134,44 +200,8 @@ int Softmax_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
         }
     }
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-        float* sumptr = sum;
-
-#if __ARM_NEON
-        int nn = size >> 2;
-        int remain = size - (nn << 2);
-#else
-        int remain = size;
-#endif // __ARM_NEON
-
-#if __ARM_NEON
-        for (; nn>0; nn--)
-        {
-            float32x4_t _p = vld1q_f32(ptr);
-            float32x4_t _sum = vld1q_f32(sumptr);
-#if __aarch64__
-            _p = vdivq_f32(_p, _sum);
-#else
-            _p = div_ps(_p, _sum);
-#endif // __aarch64__
-            vst1q_f32(ptr, _p);
-
-            ptr += 4;
-            sumptr += 4;
-        }
-#endif // __ARM_NEON
-
-        for (; remain>0; remain--)
-        {
-            *ptr /= *sumptr;
-
-            ptr++;
-            sumptr++;
-        }
-    }
+    softmax_arm_div_args div_args = { &bottom_top_blob, size, &sum };
+    parallel_for(channels, softmax_arm_div_channel, &div_args, opt);
 
     return 0;
 }
@@ -51,10 +51,10 @@ int BatchNorm::load_model(const ModelBin& mb)
     if (bias_data.empty())
         return -100;
 
-    a_data.create(channels);
+    a_data.create(channels, 4u, mb.weight_allocator());
     if (a_data.empty())
         return -100;
-    b_data.create(channels);
+    b_data.create(channels, 4u, mb.weight_allocator());
     if (b_data.empty())
         return -100;
 
@@ -68,22 +68,28 @@ int BatchNorm::load_model(const ModelBin& mb)
     return 0;
 }
 
-int BatchNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct batchnorm_args
 {
-    // a = bias - slope * mean / sqrt(var)
-    // b = slope / sqrt(var)
-    // value = b * value + a
+    const BatchNorm* layer;
+    Mat* bottom_top_blob;
+};
+
+// a vec is split into single element rows, each with its own a and b
+static void batchnorm_rows(int q, int y0, int y1, void* userdata)
+{
+    const batchnorm_args* args = (const batchnorm_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float* a_data = args->layer->a_data;
+    const float* b_data = args->layer->b_data;
 
     int dims = bottom_top_blob.dims;
 
     if (dims == 1)
     {
-        int w = bottom_top_blob.w;
-
         float* ptr = bottom_top_blob;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<w; i++)
+        for (int i=y0; i<y1; i++)
         {
             ptr[i] = b_data[i] * ptr[i] + a_data[i];
         }
@@ -92,10 +98,8 @@ int BatchNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     if (dims == 2)
     {
         int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<h; i++)
+        for (int i=y0; i<y1; i++)
         {
             float* ptr = bottom_top_blob.row(i);
             float a = a_data[i];
@@ -110,23 +114,43 @@ int BatchNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 
     if (dims == 3)
     {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-        int size = w * h;
+        const int size = bottom_top_blob.w * (y1 - y0);
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float a = a_data[q];
-            float b = b_data[q];
+        float* ptr = bottom_top_blob.channel(q).row(y0);
+        float a = a_data[q];
+        float b = b_data[q];
 
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] = b * ptr[i] + a;
-            }
+        for (int i=0; i<size; i++)
+        {
+            ptr[i] = b * ptr[i] + a;
         }
     }
+}
+
+int BatchNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    // a = bias - slope * mean / sqrt(var)
+    // b = slope / sqrt(var)
+    // value = b * value + a
+
+    int dims = bottom_top_blob.dims;
+
+    batchnorm_args args = { this, &bottom_top_blob };
+
+    if (dims == 1)
+    {
+        parallel_for_2d(1, bottom_top_blob.w, batchnorm_rows, &args, opt);
+    }
+
+    if (dims == 2)
+    {
+        parallel_for_2d(1, bottom_top_blob.h, batchnorm_rows, &args, opt);
+    }
+
+    if (dims == 3)
+    {
+        parallel_for_2d(channels, bottom_top_blob.h, batchnorm_rows, &args, opt);
+    }
 
     return 0;
 }
@@ -40,25 +40,37 @@ int Bias::load_model(const ModelBin& mb)
     return 0;
 }
 
-int Bias::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct bias_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    const Bias* layer;
+    Mat* bottom_top_blob;
+};
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
+static void bias_rows(int q, int y0, int y1, void* userdata)
+{
+    const bias_args* args = (const bias_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
 
-        float bias = bias_data[q];
+    float* ptr = bottom_top_blob.channel(q).row(y0);
 
-        for (int i=0; i<size; i++)
-        {
-            ptr[i] += bias;
-        }
+    float bias = args->layer->bias_data[q];
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] += bias;
     }
+}
+
+int Bias::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+
+    bias_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, bias_rows, &args, opt);
 
     return 0;
 }
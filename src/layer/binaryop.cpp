@@ -42,106 +42,125 @@ int BinaryOp::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct binary_op_args
+{
+    const Mat* a;
+    const Mat* b;
+    Mat* c;
+};
+
+// rows of a 3d output, the other operand is broadcast over rows or channels
 template<typename Op>
-static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
+static void binary_op_rows(int q, int y0, int y1, void* userdata)
 {
+    const binary_op_args* args = (const binary_op_args*)userdata;
+    const Mat& a = *args->a;
+    const Mat& b = *args->b;
+    Mat& c = *args->c;
+
     Op op;
 
-    int w = a.w;
-    int h = a.h;
-    int channels = a.c;
-    int size = w * h;
-    size_t elemsize = a.elemsize;
+    const int w = c.w;
+    const int h = c.h;
+    const int size = w * (y1 - y0);
 
-    int w1 = b.w;
-    int h1 = b.h;
-    int channels1 = b.c;
-    int size1 = w1 * h1;
+    float* outptr = c.channel(q).row(y0);
 
     if (a.dims == 3)
     {
-        c.create(w, h, channels, elemsize, opt.blob_allocator);
-        if (c.empty())
-            return -100;
+        const float* ptr = a.channel(q).row(y0);
 
         if (b.dims == 3)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
+            const float* ptr1 = b.channel(q).row(y0);
+
+            for (int i=0; i<size; i++)
             {
-                const float* ptr = a.channel(q);
-                const float* ptr1 = b.channel(q);
-                float* outptr = c.channel(q);
+                outptr[i] = op(ptr[i], ptr1[i]);
+            }
+        }
+        else if (b.dims == 2)
+        {
+            const float* ptr1 = (const float*)b + h * q;
 
-                for (int i=0; i<size; i++)
+            for (int y=y0; y<y1; y++)
+            {
+                const float b0 = ptr1[y];
+                for (int x=0; x<w; x++)
                 {
-                    outptr[i] = op(ptr[i], ptr1[i]);
+                    outptr[x] = op(ptr[x], b0);
                 }
+
+                ptr += w;
+                outptr += w;
             }
+        }
+        else
+        {
+            const float b0 = b.w == 1 ? b[0] : b[q];
 
-            return 0;
+            for (int i=0; i<size; i++)
+            {
+                outptr[i] = op(ptr[i], b0);
+            }
         }
+    }
+    else if (a.dims == 2)
+    {
+        const float* ptr = (const float*)a + h * q;
+        const float* ptr1 = b.channel(q).row(y0);
 
-        if (b.dims == 2)
+        for (int y=y0; y<y1; y++)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
+            const float a0 = ptr[y];
+            for (int x=0; x<w; x++)
             {
-                const float* ptr = a.channel(q);
-                const float* ptr1 = (const float*)b + h * q;
-                float* outptr = c.channel(q);
-
-                for (int y=0; y<h; y++)
-                {
-                    const float b0 = ptr1[y];
-                    for (int x=0; x<w; x++)
-                    {
-                        outptr[x] = op(ptr[x], b0);
-                    }
-
-                    ptr += w;
-                    outptr += w;
-                }
+                outptr[x] = op(a0, ptr1[x]);
             }
 
-            return 0;
+            ptr1 += w;
+            outptr += w;
         }
+    }
+    else
+    {
+        const float a0 = a.w == 1 ? a[0] : a[q];
+        const float* ptr1 = b.channel(q).row(y0);
 
-        if (b.dims == 1)
+        for (int i=0; i<size; i++)
         {
-            if (b.w == 1)
-            {
-                const float b0 = b[0];
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int q=0; q<channels; q++)
-                {
-                    const float* ptr = a.channel(q);
-                    float* outptr = c.channel(q);
+            outptr[i] = op(a0, ptr1[i]);
+        }
+    }
+}
 
-                    for (int i=0; i<size; i++)
-                    {
-                        outptr[i] = op(ptr[i], b0);
-                    }
-                }
+template<typename Op>
+static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
+{
+    Op op;
 
-                return 0;
-            }
+    int w = a.w;
+    int h = a.h;
+    int channels = a.c;
+    int size = w * h;
+    size_t elemsize = a.elemsize;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = a.channel(q);
-                const float b0 = b[q];
-                float* outptr = c.channel(q);
+    int w1 = b.w;
+    int h1 = b.h;
+    int channels1 = b.c;
+    int size1 = w1 * h1;
 
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = op(ptr[i], b0);
-                }
-            }
+    if (a.dims == 3)
+    {
+        c.create(w, h, channels, elemsize, opt.blob_allocator);
+        if (c.empty())
+            return -100;
 
-            return 0;
-        }
+        binary_op_args args = { &a, &b, &c };
+        parallel_for_2d(channels, h, binary_op_rows<Op>, &args, opt);
+
+        return 0;
     }
     else if (a.dims == 2)
     {
@@ -151,25 +170,8 @@ static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
             if (c.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels1; q++)
-            {
-                const float* ptr = (const float*)a + h1 * q;
-                const float* ptr1 = b.channel(q);
-                float* outptr = c.channel(q);
-
-                for (int y=0; y<h1; y++)
-                {
-                    const float a0 = ptr[y];
-                    for (int x=0; x<w1; x++)
-                    {
-                        outptr[x] = op(a0, ptr1[x]);
-                    }
-
-                    ptr1 += w1;
-                    outptr += w1;
-                }
-            }
+            binary_op_args args = { &a, &b, &c };
+            parallel_for_2d(channels1, h1, binary_op_rows<Op>, &args, opt);
 
             return 0;
         }
@@ -233,18 +235,8 @@ static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
                 if (c.empty())
                     return -100;
 
-                const float a0 = a[0];
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int q=0; q<channels1; q++)
-                {
-                    const float* ptr1 = b.channel(q);
-                    float* outptr = c.channel(q);
-
-                    for (int i=0; i<size1; i++)
-                    {
-                        outptr[i] = op(a0, ptr1[i]);
-                    }
-                }
+                binary_op_args args = { &a, &b, &c };
+                parallel_for_2d(channels1, h1, binary_op_rows<Op>, &args, opt);
 
                 return 0;
             }
@@ -286,18 +278,8 @@ static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
             if (c.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels1; q++)
-            {
-                const float a0 = a[q];
-                const float* ptr1 = b.channel(q);
-                float* outptr = c.channel(q);
-
-                for (int i=0; i<size1; i++)
-                {
-                    outptr[i] = op(a0, ptr1[i]);
-                }
-            }
+            binary_op_args args = { &a, &b, &c };
+            parallel_for_2d(channels1, h1, binary_op_rows<Op>, &args, opt);
 
             return 0;
         }
@@ -353,26 +335,40 @@ static int binary_op(const Mat& a, const Mat& b, Mat& c, const Option& opt)
     return 0;
 }
 
+// arguments of the scalar loop body run by parallel_for_2d
+struct binary_op_scalar_args
+{
+    Mat* a;
+    float b;
+};
+
 template<typename Op>
-static int binary_op_scalar_inplace(Mat& a, float b, const Option& opt)
+static void binary_op_scalar_rows(int q, int y0, int y1, void* userdata)
 {
+    const binary_op_scalar_args* args = (const binary_op_scalar_args*)userdata;
+    Mat& a = *args->a;
+    const float b = args->b;
+
     Op op;
 
-    int w = a.w;
-    int h = a.h;
-    int channels = a.c;
-    int size = w * h;
+    const int size = a.w * (y1 - y0);
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = a.channel(q);
+    float* ptr = a.channel(q).row(y0);
 
-        for (int i=0; i<size; i++)
-        {
-            ptr[i] = op(ptr[i], b);
-        }
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = op(ptr[i], b);
     }
+}
+
+template<typename Op>
+static int binary_op_scalar_inplace(Mat& a, float b, const Option& opt)
+{
+    int h = a.h;
+    int channels = a.c;
+
+    binary_op_scalar_args args = { &a, b };
+    parallel_for_2d(channels, h, binary_op_scalar_rows<Op>, &args, opt);
 
     return 0;
 }
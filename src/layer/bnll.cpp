@@ -25,26 +25,37 @@ BNLL::BNLL()
     support_inplace = true;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct bnll_args
+{
+    Mat* bottom_top_blob;
+};
+
+static void bnll_rows(int q, int y0, int y1, void* userdata)
+{
+    const bnll_args* args = (const bnll_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
+
+    for (int i=0; i<size; i++)
+    {
+        if (ptr[i] > 0)
+            ptr[i] = ptr[i] + log(1.f + exp(-ptr[i]));
+        else
+            ptr[i] = log(1.f + exp(ptr[i]));
+    }
+}
+
 int BNLL::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
-    int size = w * h;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            if (ptr[i] > 0)
-                ptr[i] = ptr[i] + log(1.f + exp(-ptr[i]));
-            else
-                ptr[i] = log(1.f + exp(ptr[i]));
-        }
-    }
+    bnll_args args = { &bottom_top_blob };
+    parallel_for_2d(channels, h, bnll_rows, &args, opt);
 
     return 0;
 }
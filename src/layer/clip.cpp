@@ -34,26 +34,40 @@ int Clip::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct clip_args
+{
+    const Clip* layer;
+    Mat* bottom_top_blob;
+};
+
+static void clip_rows(int q, int y0, int y1, void* userdata)
+{
+    const clip_args* args = (const clip_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float min = args->layer->min;
+    const float max = args->layer->max;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
+
+    for (int i=0; i<size; i++)
+    {
+        if (ptr[i] < min)
+            ptr[i] = min;
+        if (ptr[i] > max)
+            ptr[i] = max;
+    }
+}
+
 int Clip::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
-    int size = w * h;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            if (ptr[i] < min)
-                ptr[i] = min;
-            if (ptr[i] > max)
-                ptr[i] = max;
-        }
-    }
+    clip_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, clip_rows, &args, opt);
 
     return 0;
 }
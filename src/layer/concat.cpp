@@ -31,6 +31,80 @@ int Concat::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct concat_args
+{
+    const std::vector<Mat>* bottom_blobs;
+    Mat* top_blob;
+    int axis;
+};
+
+// interleave rows of 2d blobs, one output row each
+static void concat_rows(int /*q*/, int y0, int y1, void* userdata)
+{
+    const concat_args* args = (const concat_args*)userdata;
+    const std::vector<Mat>& bottom_blobs = *args->bottom_blobs;
+    Mat& top_blob = *args->top_blob;
+
+    const size_t elemsize = top_blob.elemsize;
+
+    for (int i=y0; i<y1; i++)
+    {
+        float* outptr = top_blob.row(i);
+        for (size_t b=0; b<bottom_blobs.size(); b++)
+        {
+            const Mat& bottom_blob = bottom_blobs[b];
+
+            const float* ptr = bottom_blob.row(i);
+            memcpy(outptr, ptr, bottom_blob.w * elemsize);
+
+            outptr += bottom_blob.w;
+        }
+    }
+}
+
+// concat rows or interleave columns of 3d blobs, one output channel each
+static void concat_channel(int q, void* userdata)
+{
+    const concat_args* args = (const concat_args*)userdata;
+    const std::vector<Mat>& bottom_blobs = *args->bottom_blobs;
+    Mat& top_blob = *args->top_blob;
+
+    const size_t elemsize = top_blob.elemsize;
+
+    float* outptr = top_blob.channel(q);
+
+    if (args->axis == 1)
+    {
+        for (size_t b=0; b<bottom_blobs.size(); b++)
+        {
+            const Mat& bottom_blob = bottom_blobs[b];
+
+            int size = bottom_blob.w * bottom_blob.h;
+
+            const float* ptr = bottom_blob.channel(q);
+            memcpy(outptr, ptr, size * elemsize);
+
+            outptr += size;
+        }
+    }
+    else
+    {
+        for (int i=0; i<top_blob.h; i++)
+        {
+            for (size_t b=0; b<bottom_blobs.size(); b++)
+            {
+                const Mat& bottom_blob = bottom_blobs[b];
+
+                const float* ptr = bottom_blob.channel(q).row(i);
+                memcpy(outptr, ptr, bottom_blob.w * elemsize);
+
+                outptr += bottom_blob.w;
+            }
+        }
+    }
+}
+
 int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     int dims = bottom_blobs[0].dims;
@@ -120,20 +194,8 @@ int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
         if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<h; i++)
-        {
-            float* outptr = top_blob.row(i);
-            for (size_t b=0; b<bottom_blobs.size(); b++)
-            {
-                const Mat& bottom_blob = bottom_blobs[b];
-
-                const float* ptr = bottom_blob.row(i);
-                memcpy(outptr, ptr, bottom_blob.w * elemsize);
-
-                outptr += bottom_blob.w;
-            }
-        }
+        concat_args args = { &bottom_blobs, &top_blob, axis };
+        parallel_for_2d(1, h, concat_rows, &args, opt);
 
         return 0;
     }
@@ -167,7 +229,10 @@ int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
 
             const float* ptr = bottom_blob;
             float* outptr = top_blob.channel(q);
-            memcpy(outptr, ptr, size * elemsize);
+
+            // the producer may have written into the output already, see Net::forward_layer
+            if (ptr != outptr)
+                memcpy(outptr, ptr, size * elemsize);
 
             q += channels;
         }
@@ -194,23 +259,8 @@ int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
         if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* outptr = top_blob.channel(q);
-
-            for (size_t b=0; b<bottom_blobs.size(); b++)
-            {
-                const Mat& bottom_blob = bottom_blobs[b];
-
-                int size = bottom_blob.w * bottom_blob.h;
-
-                const float* ptr = bottom_blob.channel(q);
-                memcpy(outptr, ptr, size * elemsize);
-
-                outptr += size;
-            }
-        }
+        concat_args args = { &bottom_blobs, &top_blob, axis };
+        parallel_for(channels, concat_channel, &args, opt);
 
         return 0;
     }
@@ -234,24 +284,8 @@ int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
         if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* outptr = top_blob.channel(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (size_t b=0; b<bottom_blobs.size(); b++)
-                {
-                    const Mat& bottom_blob = bottom_blobs[b];
-
-                    const float* ptr = bottom_blob.channel(q).row(i);
-                    memcpy(outptr, ptr, bottom_blob.w * elemsize);
-
-                    outptr += bottom_blob.w;
-                }
-            }
-        }
+        concat_args args = { &bottom_blobs, &top_blob, axis };
+        parallel_for(channels, concat_channel, &args, opt);
 
         return 0;
     }
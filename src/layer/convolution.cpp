@@ -14,6 +14,9 @@
 
 #include "convolution.h"
 
+#include <string.h>
+#include <algorithm>
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
@@ -50,6 +53,8 @@ int Convolution::load_param(const ParamDict& pd)
     weight_data_size = pd.get(6, 0);
     int8_scale_term = pd.get(8, 0);
 
+    shuffle_group = 0;
+
     use_int8_inference = pd.use_int8_inference;
 
     if (int8_scale_term == 0)
@@ -77,6 +82,41 @@ int Convolution::load_model(const ModelBin& mb)
         bottom_blob_int8_scale = mb.load(1, 1)[0];
     }
 
+    if (shuffle_group)
+    {
+        const int maxk = kernel_w * kernel_h;
+        const int channels = weight_data_size / maxk / num_output;
+        const int chs_per_group = channels / shuffle_group;
+
+        if (channels != chs_per_group * shuffle_group)
+        {
+            fprintf(stderr, "fused shuffle group %d does not divide %d input channels\n", shuffle_group, channels);
+            return -1;
+        }
+
+        // input channel q of the shuffled blob is channel (q % group) * chs_per_group + q / group before it
+        // copied, the weight data may reference external memory
+        const size_t kernel_size = maxk * weight_data.elemsize;
+
+        Mat weight_data_unshuffled(weight_data_size, weight_data.elemsize, mb.weight_allocator());
+        if (weight_data_unshuffled.empty())
+            return -100;
+
+        for (int p=0; p<num_output; p++)
+        {
+            const unsigned char* kptr = (const unsigned char*)weight_data.data + p * channels * kernel_size;
+            unsigned char* outptr = (unsigned char*)weight_data_unshuffled.data + p * channels * kernel_size;
+
+            for (int q=0; q<channels; q++)
+            {
+                int src_q = (q % shuffle_group) * chs_per_group + q / shuffle_group;
+                memcpy(outptr + src_q * kernel_size, kptr + q * kernel_size, kernel_size);
+            }
+        }
+
+        weight_data = weight_data_unshuffled;
+    }
+
     bool weight_data_is_int8 = (weight_data.elemsize == (size_t)1u);
     bool weight_data_is_float32 = (weight_data.elemsize == (size_t)4u);
 
@@ -138,6 +178,232 @@ int Convolution::load_model(const ModelBin& mb)
     return 0;
 }
 
+// arguments of the im2col and gemm loop bodies
+// the im2col matrix holds the columns [col_offset, col_offset + col_count) of the output,
+// in panels of 8 columns, each panel stores K rows of 8 values with K = channels * maxk
+struct convolution_sgemm_args
+{
+    const Convolution* layer;
+    const Mat* bottom_blob_bordered;
+    Mat* top_blob;
+    float* col;
+    int col_offset;
+    int col_count;
+};
+
+static void convolution_im2col_channel(int q, void* userdata)
+{
+    const convolution_sgemm_args* args = (const convolution_sgemm_args*)userdata;
+    const Convolution* layer = args->layer;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+
+    const int outw = args->top_blob->w;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+    const int K = bottom_blob_bordered.c * maxk;
+    const int col_count = args->col_count;
+    const int col_count_padded = (col_count + 7) / 8 * 8;
+
+    const Mat m = bottom_blob_bordered.channel(q);
+
+    for (int u = 0; u < layer->kernel_h; u++)
+    {
+        for (int v = 0; v < layer->kernel_w; v++)
+        {
+            const int k = q * maxk + u * layer->kernel_w + v;
+            float* colptr = args->col + k * 8;
+
+            int i = args->col_offset / outw;
+            int j = args->col_offset % outw;
+
+            int n = 0;
+            for (; n < col_count; n++)
+            {
+                const float* sptr = m.row(i * layer->stride_h + u * layer->dilation_h);
+                colptr[(n / 8) * K * 8 + n % 8] = sptr[j * layer->stride_w + v * layer->dilation_w];
+
+                j++;
+                if (j == outw)
+                {
+                    j = 0;
+                    i++;
+                }
+            }
+
+            // zero the tail of the last panel
+            for (; n < col_count_padded; n++)
+            {
+                colptr[(n / 8) * K * 8 + n % 8] = 0.f;
+            }
+        }
+    }
+}
+
+// output channels in blocks of 4, the remaining ones in blocks of 1
+// panels [y0, y1) of the im2col matrix
+static void convolution_sgemm_block(int b, int y0, int y1, void* userdata)
+{
+    const convolution_sgemm_args* args = (const convolution_sgemm_args*)userdata;
+    const Convolution* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+
+    const int maxk = layer->kernel_w * layer->kernel_h;
+    const int K = args->bottom_blob_bordered->c * maxk;
+    const int nn_outch = layer->num_output / 4;
+
+    const int p = b < nn_outch ? b * 4 : nn_outch * 4 + (b - nn_outch);
+    const float* bias = layer->bias_term ? (const float*)layer->bias_data : 0;
+
+    if (b < nn_outch)
+    {
+        const float* kptr0 = (const float*)layer->weight_data + K * p;
+        const float* kptr1 = kptr0 + K;
+        const float* kptr2 = kptr1 + K;
+        const float* kptr3 = kptr2 + K;
+
+        for (int y = y0; y < y1; y++)
+        {
+            const float* colptr = args->col + y * K * 8;
+
+            float sum0[8];
+            float sum1[8];
+            float sum2[8];
+            float sum3[8];
+            for (int c = 0; c < 8; c++)
+            {
+                sum0[c] = bias ? bias[p] : 0.f;
+                sum1[c] = bias ? bias[p + 1] : 0.f;
+                sum2[c] = bias ? bias[p + 2] : 0.f;
+                sum3[c] = bias ? bias[p + 3] : 0.f;
+            }
+
+            for (int k = 0; k < K; k++)
+            {
+                const float w0 = kptr0[k];
+                const float w1 = kptr1[k];
+                const float w2 = kptr2[k];
+                const float w3 = kptr3[k];
+
+                for (int c = 0; c < 8; c++)
+                {
+                    sum0[c] += w0 * colptr[c];
+                    sum1[c] += w1 * colptr[c];
+                    sum2[c] += w2 * colptr[c];
+                    sum3[c] += w3 * colptr[c];
+                }
+
+                colptr += 8;
+            }
+
+            const int n0 = args->col_offset + y * 8;
+            const int count = std::min(8, args->col_count - y * 8);
+
+            float* outptr0 = (float*)top_blob.channel(p) + n0;
+            float* outptr1 = (float*)top_blob.channel(p + 1) + n0;
+            float* outptr2 = (float*)top_blob.channel(p + 2) + n0;
+            float* outptr3 = (float*)top_blob.channel(p + 3) + n0;
+            for (int c = 0; c < count; c++)
+            {
+                outptr0[c] = sum0[c];
+                outptr1[c] = sum1[c];
+                outptr2[c] = sum2[c];
+                outptr3[c] = sum3[c];
+            }
+        }
+    }
+    else
+    {
+        const float* kptr = (const float*)layer->weight_data + K * p;
+
+        for (int y = y0; y < y1; y++)
+        {
+            const float* colptr = args->col + y * K * 8;
+
+            float sum[8];
+            for (int c = 0; c < 8; c++)
+            {
+                sum[c] = bias ? bias[p] : 0.f;
+            }
+
+            for (int k = 0; k < K; k++)
+            {
+                const float w = kptr[k];
+
+                for (int c = 0; c < 8; c++)
+                {
+                    sum[c] += w * colptr[c];
+                }
+
+                colptr += 8;
+            }
+
+            const int n0 = args->col_offset + y * 8;
+            const int count = std::min(8, args->col_count - y * 8);
+
+            float* outptr = (float*)top_blob.channel(p) + n0;
+            for (int c = 0; c < count; c++)
+            {
+                outptr[c] = sum[c];
+            }
+        }
+    }
+}
+
+// arguments of the int8 loop body run by parallel_for
+struct convolution_int8_args
+{
+    const Convolution* layer;
+    const Mat* bottom_blob_bordered;
+    Mat* top_blob;
+    const int* space_ofs;
+};
+
+static void convolution_int8_output(int p, void* userdata)
+{
+    const convolution_int8_args* args = (const convolution_int8_args*)userdata;
+    const Convolution* layer = args->layer;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    const int* space_ofs = args->space_ofs;
+
+    const int channels = bottom_blob_bordered.c;
+    const int outw = args->top_blob->w;
+    const int outh = args->top_blob->h;
+    const int stride_w = layer->stride_w;
+    const int stride_h = layer->stride_h;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+
+    int* outptr = args->top_blob->channel(p);
+
+    for (int i = 0; i < outh; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            int sum = 0;
+
+            const signed char* kptr = (const signed char*)layer->weight_data + maxk * channels * p;
+
+            // channels
+            for (int q=0; q<channels; q++)
+            {
+                const Mat m = bottom_blob_bordered.channel(q);
+                const signed char* sptr = m.row<signed char>(i*stride_h) + j*stride_w;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    int val = sptr[ space_ofs[k] ];
+                    int w = kptr[k];
+                    sum += val * w;
+                }
+
+                kptr += maxk;
+            }
+
+            outptr[j] = sum;
+        }
+
+        outptr += outw;
+    }
+}
+
 int Convolution::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // convolv with NxN kernel
@@ -248,64 +514,31 @@ int Convolution::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
 
     const int maxk = kernel_w * kernel_h;
 
-    // kernel offsets
-    std::vector<int> _space_ofs(maxk);
-    int* space_ofs = &_space_ofs[0];
-    {
-        int p1 = 0;
-        int p2 = 0;
-        int gap = w * dilation_h - kernel_w * dilation_w;
-        for (int i = 0; i < kernel_h; i++)
-        {
-            for (int j = 0; j < kernel_w; j++)
-            {
-                space_ofs[p1] = p2;
-                p1++;
-                p2 += dilation_w;
-            }
-            p2 += gap;
-        }
-    }
-
     if (use_int8_inference)
     {
-        // num_output
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int p=0; p<num_output; p++)
+        // kernel offsets
+        std::vector<int> _space_ofs(maxk);
+        int* space_ofs = &_space_ofs[0];
         {
-            int* outptr = top_blob.channel(p);
-
-            for (int i = 0; i < outh; i++)
+            int p1 = 0;
+            int p2 = 0;
+            int gap = w * dilation_h - kernel_w * dilation_w;
+            for (int i = 0; i < kernel_h; i++)
             {
-                for (int j = 0; j < outw; j++)
+                for (int j = 0; j < kernel_w; j++)
                 {
-                    int sum = 0;
-
-                    const signed char* kptr = (const signed char*)weight_data + maxk * channels * p;
-
-                    // channels
-                    for (int q=0; q<channels; q++)
-                    {
-                        const Mat m = bottom_blob_bordered.channel(q);
-                        const signed char* sptr = m.row<signed char>(i*stride_h) + j*stride_w;
-
-                        for (int k = 0; k < maxk; k++)
-                        {
-                            int val = sptr[ space_ofs[k] ];
-                            int w = kptr[k];
-                            sum += val * w;
-                        }
-
-                        kptr += maxk;
-                    }
-
-                    outptr[j] = sum;
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
                 }
-
-                outptr += outw;
+                p2 += gap;
             }
         }
 
+        // num_output
+        convolution_int8_args args = { this, &bottom_blob_bordered, &top_blob, space_ofs };
+        parallel_for(num_output, convolution_int8_output, &args, opt);
+
         // dequantize, reverse scale inplace
         {
             ncnn::Option opt_g = opt;
@@ -317,44 +550,32 @@ int Convolution::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
         return 0;
     }
 
-    // num_output
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<num_output; p++)
-    {
-        float* outptr = top_blob.channel(p);
-
-        for (int i = 0; i < outh; i++)
-        {
-            for (int j = 0; j < outw; j++)
-            {
-                float sum = 0.f;
+    // im2col + sgemm, in column chunks whose im2col matrix fits in half of l2 cache
+    const int K = channels * maxk;
+    const int size = outw * outh;
 
-                if (bias_term)
-                    sum = bias_data[p];
+    int l2_cache_size = get_cpu_cache_size(2);
+    if (l2_cache_size == 0)
+        l2_cache_size = 256 * 1024;
 
-                const float* kptr = (const float*)weight_data + maxk * channels * p;
+    int chunk = l2_cache_size / 2 / (K * sizeof(float)) / 8 * 8;
+    chunk = std::min(std::max(chunk, 64), (size + 7) / 8 * 8);
 
-                // channels
-                for (int q=0; q<channels; q++)
-                {
-                    const Mat m = bottom_blob_bordered.channel(q);
-                    const float* sptr = m.row(i*stride_h) + j*stride_w;
+    Mat col(K * 8, chunk / 8, (size_t)4u, opt.workspace_allocator);
+    if (col.empty())
+        return -100;
 
-                    for (int k = 0; k < maxk; k++) // 29.23
-                    {
-                        float val = sptr[ space_ofs[k] ]; // 20.72
-                        float w = kptr[k];
-                        sum += val * w; // 41.45
-                    }
+    const int nn_outch = num_output / 4 + num_output % 4;
 
-                    kptr += maxk;
-                }
+    convolution_sgemm_args args = { this, &bottom_blob_bordered, &top_blob, col, 0, 0 };
+    for (int n = 0; n < size; n += chunk)
+    {
+        args.col_offset = n;
+        args.col_count = std::min(chunk, size - n);
 
-                outptr[j] = sum;
-            }
+        parallel_for(channels, convolution_im2col_channel, &args, opt);
 
-            outptr += outw;
-        }
+        parallel_for_2d(nn_outch, (args.col_count + 7) / 8, convolution_sgemm_block, &args, opt);
     }
 
     return 0;
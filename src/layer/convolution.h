@@ -48,6 +48,10 @@ public:
 
     int int8_scale_term;
 
+    // group of a ShuffleChannel fused in front of this layer by Net
+    // the weights of each input channel are moved to the unshuffled channel, 0 = none
+    int shuffle_group;
+
     // model
     Mat weight_data;
     Mat bias_data;
@@ -14,7 +14,11 @@
 
 #include "convolutiondepthwise.h"
 
+#include <string.h>
+#include <algorithm>
+
 #include "layer_type.h"
+#include "fused_activation.h"
 
 namespace ncnn {
 
@@ -54,6 +58,10 @@ int ConvolutionDepthWise::load_param(const ParamDict& pd)
     weight_data_size = pd.get(6, 0);
     group = pd.get(7, 1);
     int8_scale_term = pd.get(8, 0);
+    activation_type = pd.get(9, 0);
+    activation_params = pd.get(10, Mat());
+
+    shuffle_group = 0;
 
     use_int8_inference = pd.use_int8_inference;
 
@@ -63,6 +71,12 @@ int ConvolutionDepthWise::load_param(const ParamDict& pd)
         return -100;
     }
 
+    if (activation_params.w < activation_param_count(activation_type))
+    {
+        fprintf(stderr, "activation type %d needs %d params\n", activation_type, activation_param_count(activation_type));
+        return -1;
+    }
+
     if (int8_scale_term == 0)
         use_int8_inference = false;
 
@@ -190,6 +204,381 @@ int ConvolutionDepthWise::load_model(const ModelBin& mb)
     return 0;
 }
 
+int ConvolutionDepthWise::bottom_channel(int q) const
+{
+    if (shuffle_group == 0)
+        return q;
+
+    // inverse of ShuffleChannel, which moves channel chs_per_group * i + j to group * j + i
+    const int chs_per_group = group / shuffle_group;
+    return (q % shuffle_group) * chs_per_group + q / shuffle_group;
+}
+
+// arguments of the padding loop body run by parallel_for
+struct convolutiondepthwise_padding_args
+{
+    const ConvolutionDepthWise* layer;
+    const Mat* bottom_blob;
+    Mat* bottom_blob_bordered;
+    int top;
+    int left;
+};
+
+static void convolutiondepthwise_padding_channel(int q, void* userdata)
+{
+    const convolutiondepthwise_padding_args* args = (const convolutiondepthwise_padding_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int outw = bottom_blob_bordered.w;
+    const int outh = bottom_blob_bordered.h;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int top = args->top;
+    const int left = args->left;
+    const int right = outw - w - left;
+
+    const unsigned char* ptr = bottom_blob.channel(args->layer->bottom_channel(q));
+    unsigned char* outptr = bottom_blob_bordered.channel(q);
+
+    memset(outptr, 0, outw * top * elemsize);
+    outptr += outw * top * elemsize;
+
+    for (int i = 0; i < h; i++)
+    {
+        memset(outptr, 0, left * elemsize);
+        memcpy(outptr + left * elemsize, ptr, w * elemsize);
+        memset(outptr + (left + w) * elemsize, 0, right * elemsize);
+
+        ptr += w * elemsize;
+        outptr += outw * elemsize;
+    }
+
+    memset(outptr, 0, outw * (outh - top - h) * elemsize);
+}
+
+int ConvolutionDepthWise::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, bool gather, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+
+    int top = 0;
+    int bottom = 0;
+    int left = 0;
+    int right = 0;
+
+    if (pad_w > 0 || pad_h > 0)
+    {
+        top = pad_h;
+        bottom = pad_h;
+        left = pad_w;
+        right = pad_w;
+    }
+    else if (pad_w == -233 && pad_h == -233)
+    {
+        const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+        const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            top = hpad / 2;
+            bottom = hpad - hpad / 2;
+            left = wpad / 2;
+            right = wpad - wpad / 2;
+        }
+    }
+
+    if (!gather)
+    {
+        if (top == 0 && bottom == 0 && left == 0 && right == 0)
+        {
+            bottom_blob_bordered = bottom_blob;
+            return 0;
+        }
+
+        copy_make_border(bottom_blob, bottom_blob_bordered, top, bottom, left, right, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
+        if (bottom_blob_bordered.empty())
+            return -100;
+
+        return 0;
+    }
+
+    // the shuffle is done by the copy made for the padding, padding never crops here
+    top = std::max(top, 0);
+    bottom = std::max(bottom, 0);
+    left = std::max(left, 0);
+    right = std::max(right, 0);
+
+    bottom_blob_bordered.create(w + left + right, h + top + bottom, bottom_blob.c, bottom_blob.elemsize, opt.workspace_allocator);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    convolutiondepthwise_padding_args args = { this, &bottom_blob, &bottom_blob_bordered, top, left };
+    parallel_for(bottom_blob.c, convolutiondepthwise_padding_channel, &args, opt);
+
+    return 0;
+}
+
+// arguments of the depth-wise loop body run by parallel_for_2d
+struct convolutiondepthwise_args
+{
+    const ConvolutionDepthWise* layer;
+    const Mat* bottom_blob_bordered;
+    Mat* top_blob;
+    const int* space_ofs;
+};
+
+// kernel offsets in space_ofs carry the dilation
+static void convolutiondepthwise_output(int g, int y0, int y1, void* userdata)
+{
+    const convolutiondepthwise_args* args = (const convolutiondepthwise_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = top_blob.w;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+
+    float* outptr = top_blob.channel(g).row(y0);
+    const float* kptr = (const float*)layer->weight_data + maxk * g;
+    const Mat m = args->bottom_blob_bordered->channel(g);
+
+    const float bias0 = layer->bias_term ? layer->bias_data[g] : 0.f;
+
+    for (int i = y0; i < y1; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            float sum = bias0;
+
+            const float* sptr = m.row(i*layer->stride_h) + j*layer->stride_w;
+
+            for (int k = 0; k < maxk; k++)
+            {
+                float val = sptr[ space_ofs[k] ];
+                float w = kptr[k];
+                sum += val * w;
+            }
+
+            outptr[j] = activation_ss(sum, layer->activation_type, layer->activation_params);
+        }
+
+        outptr += outw;
+    }
+}
+
+// output channel gp of a grouped convolution, group g = gp / num_output_g
+static void convolutiondepthwise_group_output(int gp, void* userdata)
+{
+    const convolutiondepthwise_args* args = (const convolutiondepthwise_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+    const int channels_g = bottom_blob_bordered.c / layer->group;
+    const int num_output_g = layer->num_output / layer->group;
+
+    const int g = gp / num_output_g;
+    const int p = gp % num_output_g;
+
+    float* outptr = top_blob.channel(gp);
+    const float* weight_data_ptr = (const float*)layer->weight_data + maxk * channels_g * num_output_g * g;
+
+    for (int i = 0; i < outh; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            float sum = 0.f;
+
+            if (layer->bias_term)
+                sum = layer->bias_data[gp];
+
+            const float* kptr = weight_data_ptr + maxk * channels_g * p;
+
+            // channels_g
+            for (int q=0; q<channels_g; q++)
+            {
+                const Mat m = bottom_blob_bordered.channel(channels_g * g + q);
+                const float* sptr = m.row(i*layer->stride_h) + j*layer->stride_w;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    float val = sptr[ space_ofs[k] ];
+                    float w = kptr[k];
+                    sum += val * w;
+                }
+
+                kptr += maxk;
+            }
+
+            outptr[j] = activation_ss(sum, layer->activation_type, layer->activation_params);
+        }
+
+        outptr += outw;
+    }
+}
+
+// arguments of the int8 loop bodies run by parallel_for
+struct convolutiondepthwise_quantize_args
+{
+    const ConvolutionDepthWise* layer;
+    const Mat* bottom_blob;
+    Mat* bottom_blob_int8;
+    const Option* opt;
+};
+
+struct convolutiondepthwise_int8_args
+{
+    const ConvolutionDepthWise* layer;
+    const Mat* bottom_blob_bordered;
+    Mat* top_blob;
+    const int* space_ofs;
+    const Option* opt;
+};
+
+// each group has its own quantize scale
+static void convolutiondepthwise_quantize_group(int g, void* userdata)
+{
+    const convolutiondepthwise_quantize_args* args = (const convolutiondepthwise_quantize_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& bottom_blob_int8 = *args->bottom_blob_int8;
+
+    const int channels_g = bottom_blob.c / layer->group;
+
+    ncnn::Option opt_g = *args->opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = bottom_blob_int8.allocator;
+
+    const Mat bottom_blob_g = layer->shuffle_group ? bottom_blob.channel_range(layer->bottom_channel(g), 1) : bottom_blob.channel_range(channels_g * g, channels_g);
+    Mat bottom_blob_int8_g = bottom_blob_int8.channel_range(channels_g * g, channels_g);
+    layer->quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
+}
+
+// depth-wise channel g, dequantized right away while it is hot
+static void convolutiondepthwise_int8_dw_output(int g, void* userdata)
+{
+    const convolutiondepthwise_int8_args* args = (const convolutiondepthwise_int8_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+
+    int* outptr = top_blob.channel(g);
+    const signed char* kptr = (const signed char*)layer->weight_data + maxk * g;
+    const Mat m = args->bottom_blob_bordered->channel(g);
+
+    for (int i = 0; i < outh; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            int sum = 0;
+
+            const signed char* sptr = m.row<signed char>(i*layer->stride_h) + j*layer->stride_w;
+
+            for (int k = 0; k < maxk; k++)
+            {
+                signed char val = sptr[ space_ofs[k] ];
+                signed char w = kptr[k];
+                sum += val * w;
+            }
+
+            outptr[j] = sum;
+        }
+
+        outptr += outw;
+    }
+
+    // dequantize, reverse scale inplace
+    {
+        ncnn::Option opt_g = *args->opt;
+        opt_g.num_threads = 1;
+        opt_g.blob_allocator = top_blob.allocator;
+
+        Mat top_blob_g = top_blob.channel_range(g, 1);
+        layer->dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
+    }
+}
+
+// output channel gp of a grouped int8 convolution, group g = gp / num_output_g
+static void convolutiondepthwise_int8_output(int gp, void* userdata)
+{
+    const convolutiondepthwise_int8_args* args = (const convolutiondepthwise_int8_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int maxk = layer->kernel_w * layer->kernel_h;
+    const int channels_g = bottom_blob_bordered.c / layer->group;
+    const int num_output_g = layer->num_output / layer->group;
+
+    const int g = gp / num_output_g;
+    const int p = gp % num_output_g;
+
+    int* outptr = top_blob.channel(gp);
+    const signed char* weight_data_ptr = (const signed char*)layer->weight_data + maxk * channels_g * num_output_g * g;
+
+    for (int i = 0; i < outh; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            int sum = 0;
+
+            const signed char* kptr = weight_data_ptr + maxk * channels_g * p;
+
+            // channels_g
+            for (int q=0; q<channels_g; q++)
+            {
+                const Mat m = bottom_blob_bordered.channel(channels_g * g + q);
+                const signed char* sptr = m.row<signed char>(i*layer->stride_h) + j*layer->stride_w;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    signed char val = sptr[ space_ofs[k] ];
+                    signed char w = kptr[k];
+                    sum += val * w;
+                }
+
+                kptr += maxk;
+            }
+
+            outptr[j] = sum;
+        }
+
+        outptr += outw;
+    }
+}
+
+static void convolutiondepthwise_dequantize_group(int g, void* userdata)
+{
+    const convolutiondepthwise_int8_args* args = (const convolutiondepthwise_int8_args*)userdata;
+    const ConvolutionDepthWise* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+
+    const int num_output_g = layer->num_output / layer->group;
+
+    ncnn::Option opt_g = *args->opt;
+    opt_g.num_threads = 1;
+    opt_g.blob_allocator = top_blob.allocator;
+
+    Mat top_blob_g = top_blob.channel_range(num_output_g * g, num_output_g);
+    layer->dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
+}
+
 int ConvolutionDepthWise::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // convolv with NxN kernel
@@ -206,11 +595,20 @@ int ConvolutionDepthWise::forward(const Mat& bottom_blob, Mat& top_blob, const O
         return -100;
     }
 
+    if (shuffle_group && (channels != group || channels % shuffle_group != 0))
+    {
+        // the fused shuffle is only gathered for depth-wise input
+        return -100;
+    }
+
 //     fprintf(stderr, "ConvolutionDepthWise input %d x %d  pad = %d %d  ksize=%d %d  stride=%d %d\n", w, h, pad_w, pad_h, kernel_w, kernel_h, stride_w, stride_h);
 
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
+    // channels of the fused shuffle are gathered once, by the quantize or padding copy
+    bool gather = shuffle_group != 0;
+
     Mat bottom_blob_unbordered = bottom_blob;
     if (use_int8_inference && elemsize != 1)
     {
@@ -219,48 +617,21 @@ int ConvolutionDepthWise::forward(const Mat& bottom_blob, Mat& top_blob, const O
         if (bottom_blob_int8.empty())
             return -100;
 
-        const int channels_g = channels / group;
-
         // quantize, scale and round to nearest
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = bottom_blob_int8.allocator;
-
-            const Mat bottom_blob_g = bottom_blob.channel_range(channels_g * g, channels_g);
-            Mat bottom_blob_int8_g = bottom_blob_int8.channel_range(channels_g * g, channels_g);
-            quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
-        }
+        convolutiondepthwise_quantize_args qargs = { this, &bottom_blob, &bottom_blob_int8, &opt };
+        parallel_for(group, convolutiondepthwise_quantize_group, &qargs, opt);
 
         bottom_blob_unbordered = bottom_blob_int8;
+        gather = false;
     }
 
-    Mat bottom_blob_bordered = bottom_blob_unbordered;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, pad_h, pad_h, pad_w, pad_w, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-        if (bottom_blob_bordered.empty())
-            return -100;
+    Mat bottom_blob_bordered;
+    int ret = make_padding(bottom_blob_unbordered, bottom_blob_bordered, gather, opt);
+    if (ret != 0)
+        return ret;
 
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
-    else if (pad_w == -233 && pad_h == -233)
-    {
-        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
-        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
-        if (wpad > 0 || hpad > 0)
-        {
-            copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, hpad / 2, hpad - hpad / 2, wpad / 2, wpad - wpad / 2, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-            if (bottom_blob_bordered.empty())
-                return -100;
-        }
-
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
 
     int outw = (w - kernel_extent_w) / stride_w + 1;
     int outh = (h - kernel_extent_h) / stride_h + 1;
@@ -292,200 +663,38 @@ int ConvolutionDepthWise::forward(const Mat& bottom_blob, Mat& top_blob, const O
 
     if (use_int8_inference)
     {
+        convolutiondepthwise_int8_args args = { this, &bottom_blob_bordered, &top_blob, space_ofs, &opt };
+
         // depth-wise
         if (channels == group && group == num_output)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int g=0; g<group; g++)
-            {
-                int* outptr = top_blob.channel(g);
-                const signed char* kptr = (const signed char*)weight_data + maxk * g;
-                const Mat m = bottom_blob_bordered.channel(g);
-
-                for (int i = 0; i < outh; i++)
-                {
-                    for (int j = 0; j < outw; j++)
-                    {
-                        int sum = 0;
-
-                        const signed char* sptr = m.row<signed char>(i*stride_h) + j*stride_w;
-
-                        for (int k = 0; k < maxk; k++)
-                        {
-                            signed char val = sptr[ space_ofs[k] ];
-                            signed char w = kptr[k];
-                            sum += val * w;
-                        }
-
-                        outptr[j] = sum;
-                    }
-
-                    outptr += outw;
-                }
-
-                // dequantize, reverse scale inplace
-                {
-                    ncnn::Option opt_g = opt;
-                    opt_g.num_threads = 1;
-                    opt_g.blob_allocator = top_blob.allocator;
-
-                    Mat top_blob_g = top_blob.channel_range(g, 1);
-                    dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
-                }
-            }
+            parallel_for(group, convolutiondepthwise_int8_dw_output, &args, opt);
         }
         else
         {
-            const int channels_g = channels / group;
-            const int num_output_g = num_output / group;
-
-#ifdef _WIN32
-            #pragma omp parallel for num_threads(opt.num_threads)
-#else // _WIN32
-            #pragma omp parallel for collapse(2) num_threads(opt.num_threads)
-#endif // _WIN32
-            for (int g=0; g<group; g++)
-            {
-                for (int p=0; p<num_output_g; p++)
-                {
-                    int* outptr = top_blob.channel(g * num_output_g + p);
-                    const signed char* weight_data_ptr = (const signed char*)weight_data + maxk * channels_g * num_output_g * g;
-
-                    for (int i = 0; i < outh; i++)
-                    {
-                        for (int j = 0; j < outw; j++)
-                        {
-                            int sum = 0;
-
-                            const signed char* kptr = weight_data_ptr + maxk * channels_g * p;
-
-                            // channels_g
-                            for (int q=0; q<channels_g; q++)
-                            {
-                                const Mat m = bottom_blob_bordered.channel(channels_g * g + q);
-                                const signed char* sptr = m.row<signed char>(i*stride_h) + j*stride_w;
-
-                                for (int k = 0; k < maxk; k++)
-                                {
-                                    signed char val = sptr[ space_ofs[k] ];
-                                    signed char w = kptr[k];
-                                    sum += val * w;
-                                }
-
-                                kptr += maxk;
-                            }
-
-                            outptr[j] = sum;
-                        }
-
-                        outptr += outw;
-                    }
-                }
-            }
+            parallel_for(num_output, convolutiondepthwise_int8_output, &args, opt);
 
             // dequantize, reverse scale inplace
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int g=0; g<group; g++)
-            {
-                ncnn::Option opt_g = opt;
-                opt_g.num_threads = 1;
-                opt_g.blob_allocator = top_blob.allocator;
-
-                Mat top_blob_g = top_blob.channel_range(num_output_g * g, num_output_g);
-                dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
-            }
+            parallel_for(group, convolutiondepthwise_dequantize_group, &args, opt);
         }
 
+        fused_activation_inplace(top_blob, activation_type, activation_params, opt);
+
         return 0;
     }
 
     // depth-wise
     if (channels == group && group == num_output)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            float* outptr = top_blob.channel(g);
-            const float* kptr = (const float*)weight_data + maxk * g;
-            const Mat m = bottom_blob_bordered.channel(g);
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    float sum = 0.f;
-
-                    if (bias_term)
-                        sum = bias_data[g];
-
-                    const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = sptr[ space_ofs[k] ];
-                        float w = kptr[k];
-                        sum += val * w;
-                    }
-
-                    outptr[j] = sum;
-                }
-
-                outptr += outw;
-            }
-        }
+        convolutiondepthwise_args args = { this, &bottom_blob_bordered, &top_blob, space_ofs };
+        parallel_for_2d(group, outh, convolutiondepthwise_output, &args, opt);
 
         return 0;
     }
 
-    const int channels_g = channels / group;
-    const int num_output_g = num_output / group;
-
-#ifdef _WIN32
-    #pragma omp parallel for num_threads(opt.num_threads)
-#else // _WIN32
-    #pragma omp parallel for collapse(2) num_threads(opt.num_threads)
-#endif // _WIN32
-    for (int g=0; g<group; g++)
-    {
-        for (int p=0; p<num_output_g; p++)
-        {
-            float* outptr = top_blob.channel(g * num_output_g + p);
-            const float* weight_data_ptr = (const float*)weight_data + maxk * channels_g * num_output_g * g;
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    float sum = 0.f;
-
-                    if (bias_term)
-                        sum = bias_data[num_output_g * g + p];
-
-                    const float* kptr = weight_data_ptr + maxk * channels_g * p;
-
-                    // channels_g
-                    for (int q=0; q<channels_g; q++)
-                    {
-                        const Mat m = bottom_blob_bordered.channel(channels_g * g + q);
-                        const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                        for (int k = 0; k < maxk; k++)
-                        {
-                            float val = sptr[ space_ofs[k] ];
-                            float w = kptr[k];
-                            sum += val * w;
-                        }
-
-                        kptr += maxk;
-                    }
-
-                    outptr[j] = sum;
-                }
-
-                outptr += outw;
-            }
-        }
-    }
+    // every output channel of every group
+    convolutiondepthwise_args args = { this, &bottom_blob_bordered, &top_blob, space_ofs };
+    parallel_for(num_output, convolutiondepthwise_group_output, &args, opt);
 
     return 0;
 }
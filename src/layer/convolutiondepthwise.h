@@ -31,6 +31,12 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+    // bottom blob channel read as input channel q, see shuffle_group
+    int bottom_channel(int q) const;
+
+    // pad the input for the kernel, gathering the channels of the fused shuffle if gather is set
+    int make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, bool gather, const Option& opt) const;
+
 public:
     // param
     int num_output;
@@ -49,6 +55,14 @@ public:
 
     int int8_scale_term;
 
+    // fused activation, see fused_activation.h
+    int activation_type;
+    Mat activation_params;
+
+    // group of a ShuffleChannel fused in front of this depth-wise layer by Net
+    // the input is read through the shuffle instead of after it, 0 = none
+    int shuffle_group;
+
     // model
     Mat weight_data;
     Mat bias_data;
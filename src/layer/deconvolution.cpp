@@ -14,8 +14,22 @@
 
 #include "deconvolution.h"
 
+#include <algorithm>
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#if __AVX2__
+#include <immintrin.h>
+#endif // __AVX2__
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
 namespace ncnn {
 
+#include "deconvolution_sgemm.h"
+
 DEFINE_LAYER_CREATOR(Deconvolution)
 
 Deconvolution::Deconvolution()
@@ -72,96 +86,18 @@ int Deconvolution::forward(const Mat& bottom_blob, Mat& top_blob, const Option&
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
-    int outw = (w - 1) * stride_w + kernel_extent_w;
-    int outh = (h - 1) * stride_h + kernel_extent_h;
-
-    Mat top_blob_bordered;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        top_blob_bordered.create(outw, outh, num_output, elemsize, opt.workspace_allocator);
-        if (top_blob_bordered.empty())
-            return -100;
-    }
-    else
-    {
-        top_blob_bordered = top_blob;
-        top_blob_bordered.create(outw, outh, num_output, elemsize, opt.blob_allocator);
-        if (top_blob_bordered.empty())
-            return -100;
-    }
-
-    const int maxk = kernel_w * kernel_h;
+    // the pad border is cut while scattering
+    int outw = (w - 1) * stride_w + kernel_extent_w - pad_w * 2;
+    int outh = (h - 1) * stride_h + kernel_extent_h - pad_h * 2;
 
-    // kernel offsets
-    std::vector<int> _space_ofs(maxk);
-    int* space_ofs = &_space_ofs[0];
-    {
-        int p1 = 0;
-        int p2 = 0;
-        int gap = outw * dilation_h - kernel_w * dilation_w;
-        for (int i = 0; i < kernel_h; i++)
-        {
-            for (int j = 0; j < kernel_w; j++)
-            {
-                space_ofs[p1] = p2;
-                p1++;
-                p2 += dilation_w;
-            }
-            p2 += gap;
-        }
-    }
+    top_blob.create(outw, outh, num_output, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
 
     // num_output
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<num_output; p++)
-    {
-        Mat out = top_blob_bordered.channel(p);
-
-        const float bias = bias_term ? bias_data[p] : 0.f;
-
-        out.fill(bias);
-
-        for (int i = 0; i < h; i++)
-        {
-            for (int j = 0; j < w; j++)
-            {
-                float* outptr = out.row(i*stride_h) + j*stride_w;
-
-                const float* kptr = (const float*)weight_data + maxk * channels * p;
-
-                // channels
-                for (int q=0; q<channels; q++)
-                {
-                    const Mat m = bottom_blob.channel(q);
-                    float val = *(m.row(i) + j);
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float w = kptr[k];
-                        outptr[ space_ofs[k] ] += val * w;
-                    }
-
-                    kptr += maxk;
-                }
-            }
-        }
-    }
-
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_cut_border(top_blob_bordered, top_blob, pad_h, pad_h, pad_w, pad_w, opt.blob_allocator, opt.num_threads);
-        if (top_blob.empty())
-            return -100;
-
-        outw = top_blob.w;
-        outh = top_blob.h;
-    }
-    else
-    {
-        top_blob = top_blob_bordered;
-    }
-
-    return 0;
+    deconvolution_sgemm_args args = { &bottom_blob, 0, &top_blob, weight_data, bias_term ? (const float*)bias_data : 0, channels, num_output,
+                                      kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, pad_w, pad_h };
+    return deconvolution_sgemm(args, opt);
 }
 
 } // namespace ncnn
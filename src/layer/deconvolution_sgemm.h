@@ -0,0 +1,396 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// deconvolution as sgemm + col2im, shared by Deconvolution and DeconvolutionDepthWise
+//
+// for output channel p, the kernel taps k and input pixels n form the matrix
+//   col[k][n] = sum_q weight[p][q][k] * bottom[q][n]
+// which is computed 4 taps x 8 pixels at a time and scattered into the output right away,
+// taps landing in the pad border are dropped, so the output comes out cropped
+// the input is packed into 8 pixel panels once and shared by all output channels
+
+// arguments of the loop bodies run by parallel_for
+struct deconvolution_sgemm_args
+{
+    const Mat* bottom_blob;
+    // tile t of 8 input pixels at row t, [channel][8], zero padded, see deconvolution_sgemm_pack
+    const Mat* bottom_tm;
+    Mat* top_blob;
+    const float* weight;
+    const float* bias;
+    int channels_g;
+    int num_output_g;
+    int kernel_w;
+    int kernel_h;
+    int dilation_w;
+    int dilation_h;
+    int stride_w;
+    int stride_h;
+    int pad_w;
+    int pad_h;
+};
+
+#if __AVX2__
+// a * b + c, fused only when the target has fma
+static inline __m256 deconvolution_sgemm_fmadd_avx(__m256 _a, __m256 _b, __m256 _c)
+{
+#if __FMA__
+    return _mm256_fmadd_ps(_a, _b, _c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(_a, _b), _c);
+#endif // __FMA__
+}
+#endif // __AVX2__
+
+static void deconvolution_sgemm_pack(int t, void* userdata)
+{
+    const deconvolution_sgemm_args* args = (const deconvolution_sgemm_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int n0 = t * 8;
+    const int count = std::min(8, size - n0);
+
+    float* pp = (float*)args->bottom_tm->row(t);
+
+    for (int q = 0; q < bottom_blob.c; q++)
+    {
+        const float* ptr = (const float*)bottom_blob.channel(q) + n0;
+
+        int c = 0;
+        for (; c < count; c++)
+            pp[c] = ptr[c];
+        for (; c < 8; c++)
+            pp[c] = 0.f;
+
+        pp += 8;
+    }
+}
+
+// add the 8 pixel sums of tap k into the output
+// one_row tells the 8 pixels are of one input row, unchecked when they all land inside the output
+static inline void deconvolution_col2im(const deconvolution_sgemm_args* args, float* outptr, int outw, int outh, const int* base_x, const int* base_y, int count, bool one_row, int k, const float* sum)
+{
+    const int y = k / args->kernel_w * args->dilation_h;
+    const int x = k % args->kernel_w * args->dilation_w;
+
+    const int oy0 = base_y[0] + y;
+    const int ox0 = base_x[0] + x;
+
+    if (one_row && oy0 >= 0 && oy0 < outh && ox0 >= 0 && ox0 + 7 * args->stride_w < outw)
+    {
+        float* o = outptr + oy0 * outw + ox0;
+
+        if (args->stride_w == 1)
+        {
+#if __AVX2__
+            _mm256_storeu_ps(o, _mm256_add_ps(_mm256_loadu_ps(o), _mm256_loadu_ps(sum)));
+#elif __SSE2__
+            _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_loadu_ps(sum)));
+            _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_loadu_ps(sum + 4)));
+#elif __ARM_NEON
+            vst1q_f32(o, vaddq_f32(vld1q_f32(o), vld1q_f32(sum)));
+            vst1q_f32(o + 4, vaddq_f32(vld1q_f32(o + 4), vld1q_f32(sum + 4)));
+#else
+            for (int c = 0; c < 8; c++)
+                o[c] += sum[c];
+#endif // __AVX2__
+        }
+        else
+        {
+            for (int c = 0; c < 8; c++)
+                o[c * args->stride_w] += sum[c];
+        }
+
+        return;
+    }
+
+    // border
+    for (int c = 0; c < count; c++)
+    {
+        const int oy = base_y[c] + y;
+        const int ox = base_x[c] + x;
+        if (oy < 0 || oy >= outh || ox < 0 || ox >= outw)
+            continue;
+
+        outptr[oy * outw + ox] += sum[c];
+    }
+}
+
+static void deconvolution_sgemm_output(int p, void* userdata)
+{
+    const deconvolution_sgemm_args* args = (const deconvolution_sgemm_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int w = bottom_blob.w;
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int channels_g = args->channels_g;
+    const int maxk = args->kernel_w * args->kernel_h;
+
+    const int q0 = p / args->num_output_g * channels_g;
+    const float* kptr = args->weight + p * channels_g * maxk;
+
+    Mat out = top_blob.channel(p);
+    out.fill(args->bias ? args->bias[p] : 0.f);
+
+    float* outptr = out;
+
+    if (channels_g == 1)
+    {
+        // depthwise, no reduction to share between taps, scatter each input row per tap
+        const int h = bottom_blob.h;
+        const float* ptr = bottom_blob.channel(q0);
+
+        for (int ky = 0; ky < args->kernel_h; ky++)
+        {
+            for (int kx = 0; kx < args->kernel_w; kx++)
+            {
+                const float w0 = kptr[ky * args->kernel_w + kx];
+                const int x = kx * args->dilation_w - args->pad_w;
+
+                // input columns whose tap lands inside the output
+                int j0 = 0;
+                while (j0 < w && j0 * args->stride_w + x < 0)
+                    j0++;
+                int j1 = w;
+                while (j1 > j0 && (j1 - 1) * args->stride_w + x >= outw)
+                    j1--;
+
+                for (int i = 0; i < h; i++)
+                {
+                    const int oy = i * args->stride_h + ky * args->dilation_h - args->pad_h;
+                    if (oy < 0 || oy >= outh)
+                        continue;
+
+                    const float* r = ptr + i * w;
+                    float* o = outptr + oy * outw;
+                    for (int j = j0; j < j1; j++)
+                    {
+                        o[j * args->stride_w + x] += w0 * r[j];
+                    }
+                }
+            }
+        }
+
+        return;
+    }
+
+    for (int n0 = 0; n0 < size; n0 += 8)
+    {
+        const int count = std::min(8, size - n0);
+        const bool one_row = count == 8 && n0 % w + 8 <= w;
+
+        int base_x[8];
+        int base_y[8];
+        for (int c = 0; c < count; c++)
+        {
+            base_x[c] = (n0 + c) % w * args->stride_w - args->pad_w;
+            base_y[c] = (n0 + c) / w * args->stride_h - args->pad_h;
+        }
+
+        // the channels of this group in the packed tile
+        const float* panel = (const float*)args->bottom_tm->row(n0 / 8) + q0 * 8;
+
+        int k = 0;
+        for (; k + 3 < maxk; k += 4)
+        {
+            float sum[4][8];
+
+            const float* kp = kptr + k;
+            const float* pp = panel;
+#if __AVX2__
+            __m256 _sum0 = _mm256_setzero_ps();
+            __m256 _sum1 = _mm256_setzero_ps();
+            __m256 _sum2 = _mm256_setzero_ps();
+            __m256 _sum3 = _mm256_setzero_ps();
+
+            for (int q = 0; q < channels_g; q++)
+            {
+                __m256 _p = _mm256_loadu_ps(pp);
+
+                _sum0 = deconvolution_sgemm_fmadd_avx(_mm256_set1_ps(kp[0]), _p, _sum0);
+                _sum1 = deconvolution_sgemm_fmadd_avx(_mm256_set1_ps(kp[1]), _p, _sum1);
+                _sum2 = deconvolution_sgemm_fmadd_avx(_mm256_set1_ps(kp[2]), _p, _sum2);
+                _sum3 = deconvolution_sgemm_fmadd_avx(_mm256_set1_ps(kp[3]), _p, _sum3);
+
+                kp += maxk;
+                pp += 8;
+            }
+
+            _mm256_storeu_ps(sum[0], _sum0);
+            _mm256_storeu_ps(sum[1], _sum1);
+            _mm256_storeu_ps(sum[2], _sum2);
+            _mm256_storeu_ps(sum[3], _sum3);
+#elif __SSE2__
+            __m128 _sum00 = _mm_setzero_ps();
+            __m128 _sum01 = _mm_setzero_ps();
+            __m128 _sum10 = _mm_setzero_ps();
+            __m128 _sum11 = _mm_setzero_ps();
+            __m128 _sum20 = _mm_setzero_ps();
+            __m128 _sum21 = _mm_setzero_ps();
+            __m128 _sum30 = _mm_setzero_ps();
+            __m128 _sum31 = _mm_setzero_ps();
+
+            for (int q = 0; q < channels_g; q++)
+            {
+                __m128 _p0 = _mm_loadu_ps(pp);
+                __m128 _p1 = _mm_loadu_ps(pp + 4);
+
+                __m128 _w0 = _mm_set1_ps(kp[0]);
+                __m128 _w1 = _mm_set1_ps(kp[1]);
+                __m128 _w2 = _mm_set1_ps(kp[2]);
+                __m128 _w3 = _mm_set1_ps(kp[3]);
+
+                _sum00 = _mm_add_ps(_sum00, _mm_mul_ps(_w0, _p0));
+                _sum01 = _mm_add_ps(_sum01, _mm_mul_ps(_w0, _p1));
+                _sum10 = _mm_add_ps(_sum10, _mm_mul_ps(_w1, _p0));
+                _sum11 = _mm_add_ps(_sum11, _mm_mul_ps(_w1, _p1));
+                _sum20 = _mm_add_ps(_sum20, _mm_mul_ps(_w2, _p0));
+                _sum21 = _mm_add_ps(_sum21, _mm_mul_ps(_w2, _p1));
+                _sum30 = _mm_add_ps(_sum30, _mm_mul_ps(_w3, _p0));
+                _sum31 = _mm_add_ps(_sum31, _mm_mul_ps(_w3, _p1));
+
+                kp += maxk;
+                pp += 8;
+            }
+
+            _mm_storeu_ps(sum[0], _sum00);
+            _mm_storeu_ps(sum[0] + 4, _sum01);
+            _mm_storeu_ps(sum[1], _sum10);
+            _mm_storeu_ps(sum[1] + 4, _sum11);
+            _mm_storeu_ps(sum[2], _sum20);
+            _mm_storeu_ps(sum[2] + 4, _sum21);
+            _mm_storeu_ps(sum[3], _sum30);
+            _mm_storeu_ps(sum[3] + 4, _sum31);
+#elif __ARM_NEON
+            float32x4_t _sum00 = vdupq_n_f32(0.f);
+            float32x4_t _sum01 = vdupq_n_f32(0.f);
+            float32x4_t _sum10 = vdupq_n_f32(0.f);
+            float32x4_t _sum11 = vdupq_n_f32(0.f);
+            float32x4_t _sum20 = vdupq_n_f32(0.f);
+            float32x4_t _sum21 = vdupq_n_f32(0.f);
+            float32x4_t _sum30 = vdupq_n_f32(0.f);
+            float32x4_t _sum31 = vdupq_n_f32(0.f);
+
+            for (int q = 0; q < channels_g; q++)
+            {
+                float32x4_t _p0 = vld1q_f32(pp);
+                float32x4_t _p1 = vld1q_f32(pp + 4);
+
+                _sum00 = vmlaq_n_f32(_sum00, _p0, kp[0]);
+                _sum01 = vmlaq_n_f32(_sum01, _p1, kp[0]);
+                _sum10 = vmlaq_n_f32(_sum10, _p0, kp[1]);
+                _sum11 = vmlaq_n_f32(_sum11, _p1, kp[1]);
+                _sum20 = vmlaq_n_f32(_sum20, _p0, kp[2]);
+                _sum21 = vmlaq_n_f32(_sum21, _p1, kp[2]);
+                _sum30 = vmlaq_n_f32(_sum30, _p0, kp[3]);
+                _sum31 = vmlaq_n_f32(_sum31, _p1, kp[3]);
+
+                kp += maxk;
+                pp += 8;
+            }
+
+            vst1q_f32(sum[0], _sum00);
+            vst1q_f32(sum[0] + 4, _sum01);
+            vst1q_f32(sum[1], _sum10);
+            vst1q_f32(sum[1] + 4, _sum11);
+            vst1q_f32(sum[2], _sum20);
+            vst1q_f32(sum[2] + 4, _sum21);
+            vst1q_f32(sum[3], _sum30);
+            vst1q_f32(sum[3] + 4, _sum31);
+#else
+            for (int c = 0; c < 8; c++)
+            {
+                sum[0][c] = 0.f;
+                sum[1][c] = 0.f;
+                sum[2][c] = 0.f;
+                sum[3][c] = 0.f;
+            }
+
+            for (int q = 0; q < channels_g; q++)
+            {
+                const float w0 = kp[0];
+                const float w1 = kp[1];
+                const float w2 = kp[2];
+                const float w3 = kp[3];
+
+                for (int c = 0; c < 8; c++)
+                {
+                    sum[0][c] += w0 * pp[c];
+                    sum[1][c] += w1 * pp[c];
+                    sum[2][c] += w2 * pp[c];
+                    sum[3][c] += w3 * pp[c];
+                }
+
+                kp += maxk;
+                pp += 8;
+            }
+#endif // __AVX2__
+
+            deconvolution_col2im(args, outptr, outw, outh, base_x, base_y, count, one_row, k, sum[0]);
+            deconvolution_col2im(args, outptr, outw, outh, base_x, base_y, count, one_row, k + 1, sum[1]);
+            deconvolution_col2im(args, outptr, outw, outh, base_x, base_y, count, one_row, k + 2, sum[2]);
+            deconvolution_col2im(args, outptr, outw, outh, base_x, base_y, count, one_row, k + 3, sum[3]);
+        }
+        for (; k < maxk; k++)
+        {
+            float sum[8] = { 0.f };
+
+            const float* kp = kptr + k;
+            const float* pp = panel;
+            for (int q = 0; q < channels_g; q++)
+            {
+                const float w0 = kp[0];
+
+                for (int c = 0; c < 8; c++)
+                {
+                    sum[c] += w0 * pp[c];
+                }
+
+                kp += maxk;
+                pp += 8;
+            }
+
+            deconvolution_col2im(args, outptr, outw, outh, base_x, base_y, count, one_row, k, sum);
+        }
+    }
+}
+
+// pack the input once, then run the output channels
+// return -100 if the packed input can not be allocated
+static int deconvolution_sgemm(deconvolution_sgemm_args& args, const Option& opt)
+{
+    const Mat& bottom_blob = *args.bottom_blob;
+
+    // the depthwise path reads the input rows directly
+    Mat bottom_tm;
+    if (args.channels_g > 1)
+    {
+        const int tiles = (bottom_blob.w * bottom_blob.h + 7) / 8;
+
+        bottom_tm.create(8 * bottom_blob.c, tiles, (size_t)4u, opt.workspace_allocator);
+        if (bottom_tm.empty())
+            return -100;
+
+        args.bottom_tm = &bottom_tm;
+        parallel_for(tiles, deconvolution_sgemm_pack, &args, opt);
+    }
+
+    parallel_for(args.top_blob->c, deconvolution_sgemm_output, &args, opt);
+
+    return 0;
+}
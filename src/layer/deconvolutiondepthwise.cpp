@@ -14,8 +14,22 @@
 
 #include "deconvolutiondepthwise.h"
 
+#include <algorithm>
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#if __AVX2__
+#include <immintrin.h>
+#endif // __AVX2__
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
 namespace ncnn {
 
+#include "deconvolution_sgemm.h"
+
 DEFINE_LAYER_CREATOR(DeconvolutionDepthWise)
 
 DeconvolutionDepthWise::DeconvolutionDepthWise()
@@ -77,135 +91,21 @@ int DeconvolutionDepthWise::forward(const Mat& bottom_blob, Mat& top_blob, const
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
-    int outw = (w - 1) * stride_w + kernel_extent_w;
-    int outh = (h - 1) * stride_h + kernel_extent_h;
-
-    Mat top_blob_bordered;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        top_blob_bordered.create(outw, outh, num_output, elemsize, opt.workspace_allocator);
-        if (top_blob_bordered.empty())
-            return -100;
-    }
-    else
-    {
-        top_blob_bordered = top_blob;
-        top_blob_bordered.create(outw, outh, num_output, elemsize, opt.blob_allocator);
-        if (top_blob_bordered.empty())
-            return -100;
-    }
-
-    const int maxk = kernel_w * kernel_h;
-
-    // kernel offsets
-    std::vector<int> _space_ofs(maxk);
-    int* space_ofs = &_space_ofs[0];
-    {
-        int p1 = 0;
-        int p2 = 0;
-        int gap = outw * dilation_h - kernel_w * dilation_w;
-        for (int i = 0; i < kernel_h; i++)
-        {
-            for (int j = 0; j < kernel_w; j++)
-            {
-                space_ofs[p1] = p2;
-                p1++;
-                p2 += dilation_w;
-            }
-            p2 += gap;
-        }
-    }
+    // the pad border is cut while scattering
+    int outw = (w - 1) * stride_w + kernel_extent_w - pad_w * 2;
+    int outh = (h - 1) * stride_h + kernel_extent_h - pad_h * 2;
 
-    // depth-wise
-    if (channels == group && group == num_output)
-    {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            const float* inptr = bottom_blob.channel(g);
-            const float* kptr = (const float*)weight_data + maxk * g;
-            Mat m = top_blob_bordered.channel(g);
-
-            const float bias = bias_term ? bias_data[g] : 0.f;
-
-            m.fill(bias);
-
-            for (int i = 0; i < h; i++)
-            {
-                for (int j = 0; j < w; j++)
-                {
-                    float* outptr = m.row(i*stride_h) + j*stride_w;
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = inptr[i*w + j];
-                        float w = kptr[k];
-                        outptr[ space_ofs[k] ] += val * w;
-                    }
-                }
-            }
-        }
-    }
-    else
-    {
-        // num_output
-        const int channels_g = channels / group;
-        const int num_output_g = num_output / group;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g = 0; g < group; g++)
-        {
-            const float* weight_data_ptr = (const float*)weight_data + maxk * channels_g * num_output_g * g;
-            for (int p = 0; p < num_output_g; p++)
-            {
-                Mat out = top_blob_bordered.channel(g * num_output_g + p);
-
-                const float bias = bias_term ? bias_data[g * num_output_g + p] : 0.f;
-
-                out.fill(bias);
-
-                for (int i = 0; i < h; i++)
-                {
-                    for (int j = 0; j < w; j++)
-                    {
-                        float* outptr = out.row(i*stride_h) + j*stride_w;
-
-                        const float* kptr = weight_data_ptr + maxk * channels_g * p;
-
-                        // channels_g
-                        for (int q = 0; q < channels_g; q++)
-                        {
-                            const Mat m = bottom_blob.channel(channels_g * g + q);
-                            float val = *(m.row(i) + j);
-
-                            for (int k = 0; k < maxk; k++)
-                            {
-                                outptr[ space_ofs[k] ] += val * kptr[k];
-                            }
-
-                            kptr += maxk;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_cut_border(top_blob_bordered, top_blob, pad_h, pad_h, pad_w, pad_w, opt.blob_allocator, opt.num_threads);
-        if (top_blob.empty())
-            return -100;
+    top_blob.create(outw, outh, num_output, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
 
-        outw = top_blob.w;
-        outh = top_blob.h;
-    }
-    else
-    {
-        top_blob = top_blob_bordered;
-    }
+    // num_output, each reads the channels of its group
+    const int channels_g = channels / group;
+    const int num_output_g = num_output / group;
 
-    return 0;
+    deconvolution_sgemm_args args = { &bottom_blob, 0, &top_blob, weight_data, bias_term ? (const float*)bias_data : 0, channels_g, num_output_g,
+                                      kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, pad_w, pad_h };
+    return deconvolution_sgemm(args, opt);
 }
 
 } // namespace ncnn
@@ -45,123 +45,68 @@ int Dequantize::load_model(const ModelBin& mb)
     return 0;
 }
 
-int Dequantize::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct dequantize_args
 {
-    int dims = bottom_top_blob.dims;
+    const Dequantize* layer;
+    Mat* blob;
+};
 
-    if (dims == 1)
-    {
-        int w = bottom_top_blob.w;
-
-        const int* intptr = bottom_top_blob;
-        float* ptr = bottom_top_blob;
+// a vec is split into single element rows, each with its own bias
+static void dequantize_rows(int q, int y0, int y1, void* userdata)
+{
+    const dequantize_args* args = (const dequantize_args*)userdata;
+    const Dequantize* layer = args->layer;
+    Mat& m = *args->blob;
 
-        if (bias_term)
-        {
-            if (bias_data_size > 1)
-            {
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int i=0; i<w; i++)
-                {
-                    ptr[i] = intptr[i] * scale + bias_data[i];
-                }
-            }
-            else
-            {
-                float bias = bias_data[0];
-
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int i=0; i<w; i++)
-                {
-                    ptr[i] = intptr[i] * scale + bias;
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
-            {
-                ptr[i] = intptr[i] * scale;
-            }
-        }
-    }
+    const float scale = layer->scale;
 
-    if (dims == 2)
+    if (m.dims == 1)
     {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
+        const int* intptr = m;
+        float* ptr = m;
 
-        if (bias_term)
+        for (int i=y0; i<y1; i++)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
-            {
-                const int* intptr = bottom_top_blob.row<const int>(i);
-                float* ptr = bottom_top_blob.row(i);
-
-                float bias = bias_data_size > 1 ? bias_data[i] : bias_data[0];
-
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = intptr[j] * scale + bias;
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
-            {
-                const int* intptr = bottom_top_blob.row<const int>(i);
-                float* ptr = bottom_top_blob.row(i);
-
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = intptr[j] * scale;
-                }
-            }
+            float bias = layer->bias_term ? layer->bias_data[layer->bias_data_size > 1 ? i : 0] : 0.f;
+
+            ptr[i] = intptr[i] * scale + bias;
         }
+
+        return;
     }
 
-    if (dims == 3)
+    const int w = m.w;
+    Mat mq = m.channel(q);
+
+    for (int i=y0; i<y1; i++)
     {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-        int channels = bottom_top_blob.c;
-        int size = w * h;
+        const int* intptr = mq.row<const int>(i);
+        float* ptr = mq.row(i);
 
-        if (bias_term)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const int* intptr = bottom_top_blob.channel(q);
-                float* ptr = bottom_top_blob.channel(q);
-
-                float bias = bias_data_size > 1 ? bias_data[q] : bias_data[0];
-
-                for (int i=0; i<size; i++)
-                {
-                    ptr[i] = intptr[i] * scale + bias;
-                }
-            }
-        }
-        else
+        // per row for 2d, per channel for 3d
+        int bias_index = m.dims == 2 ? i : q;
+        float bias = layer->bias_term ? layer->bias_data[layer->bias_data_size > 1 ? bias_index : 0] : 0.f;
+
+        for (int j=0; j<w; j++)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const int* intptr = bottom_top_blob.channel(q);
-                float* ptr = bottom_top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    ptr[i] = intptr[i] * scale;
-                }
-            }
+            ptr[j] = intptr[j] * scale + bias;
         }
     }
+}
+
+int Dequantize::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int dims = bottom_top_blob.dims;
+
+    dequantize_args args = { this, &bottom_top_blob };
+
+    if (dims == 1)
+        parallel_for_2d(1, bottom_top_blob.w, dequantize_rows, &args, opt);
+    else if (dims == 2)
+        parallel_for_2d(1, bottom_top_blob.h, dequantize_rows, &args, opt);
+    else if (dims == 3)
+        parallel_for_2d(bottom_top_blob.c, bottom_top_blob.h, dequantize_rows, &args, opt);
 
     return 0;
 }
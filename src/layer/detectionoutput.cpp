@@ -15,6 +15,7 @@
 #include "detectionoutput.h"
 #include <algorithm>
 #include <math.h>
+#include "nms.h"
 
 namespace ncnn {
 
@@ -37,136 +38,33 @@ int DetectionOutput::load_param(const ParamDict& pd)
     return 0;
 }
 
-struct BBoxRect
+// arguments of the loop body run by parallel_for_2d
+struct detectionoutput_args
 {
-    float xmin;
-    float ymin;
-    float xmax;
-    float ymax;
-    int label;
+    const Mat* location;
+    const Mat* priorbox;
+    const std::vector<int>* candidates;
+    Mat* bboxes;
 };
 
-static inline float intersection_area(const BBoxRect& a, const BBoxRect& b)
+// decode the candidates [y0, y1) against their prior boxes
+static void detectionoutput_decode_rows(int /*q*/, int y0, int y1, void* userdata)
 {
-    if (a.xmin > b.xmax || a.xmax < b.xmin || a.ymin > b.ymax || a.ymax < b.ymin)
-    {
-        // no intersection
-        return 0.f;
-    }
-
-    float inter_width = std::min(a.xmax, b.xmax) - std::max(a.xmin, b.xmin);
-    float inter_height = std::min(a.ymax, b.ymax) - std::max(a.ymin, b.ymin);
-
-    return inter_width * inter_height;
-}
+    const detectionoutput_args* args = (const detectionoutput_args*)userdata;
 
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right)
-{
-    int i = left;
-    int j = right;
-    float p = scores[(left + right) / 2];
+    const float* location_ptr = *args->location;
+    const float* priorbox_ptr = args->priorbox->row(0);
+    const float* variance_ptr = args->priorbox->row(1);
 
-    while (i <= j)
+    for (int k = y0; k < y1; k++)
     {
-        while (scores[i] > p)
-            i++;
-
-        while (scores[j] < p)
-            j--;
-
-        if (i <= j)
-        {
-            // swap
-            std::swap(datas[i], datas[j]);
-            std::swap(scores[i], scores[j]);
-
-            i++;
-            j--;
-        }
-    }
-
-    if (left < j)
-        qsort_descent_inplace(datas, scores, left, j);
-
-    if (i < right)
-        qsort_descent_inplace(datas, scores, i, right);
-}
-
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores)
-{
-    if (datas.empty() || scores.empty())
-        return;
-
-    qsort_descent_inplace(datas, scores, 0, scores.size() - 1);
-}
-
-static void nms_sorted_bboxes(const std::vector<BBoxRect>& bboxes, std::vector<int>& picked, float nms_threshold)
-{
-    picked.clear();
-
-    const int n = bboxes.size();
-
-    std::vector<float> areas(n);
-    for (int i = 0; i < n; i++)
-    {
-        const BBoxRect& r = bboxes[i];
-
-        float width = r.xmax - r.xmin;
-        float height = r.ymax - r.ymin;
-
-        areas[i] = width * height;
-    }
-
-    for (int i = 0; i < n; i++)
-    {
-        const BBoxRect& a = bboxes[i];
-
-        int keep = 1;
-        for (int j = 0; j < (int)picked.size(); j++)
-        {
-            const BBoxRect& b = bboxes[picked[j]];
-
-            // intersection over union
-            float inter_area = intersection_area(a, b);
-            float union_area = areas[i] + areas[picked[j]] - inter_area;
-//             float IoU = inter_area / union_area
-            if (inter_area / union_area > nms_threshold)
-                keep = 0;
-        }
-
-        if (keep)
-            picked.push_back(i);
-    }
-}
-
-int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
-{
-    const Mat& location = bottom_blobs[0];
-    const Mat& confidence = bottom_blobs[1];
-    const Mat& priorbox = bottom_blobs[2];
-
-    const int num_prior = priorbox.w / 4;
-
-    // apply location with priorbox
-    Mat bboxes;
-    bboxes.create(4, num_prior, 4u, opt.workspace_allocator);
-    if (bboxes.empty())
-        return -100;
+        const int i = (*args->candidates)[k];
 
-    const float* location_ptr = location;
-    const float* priorbox_ptr = priorbox.row(0);
-    const float* variance_ptr = priorbox.row(1);
-
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int i = 0; i < num_prior; i++)
-    {
         const float* loc = location_ptr + i * 4;
         const float* pb = priorbox_ptr + i * 4;
         const float* var = variance_ptr + i * 4;
 
-        float* bbox = bboxes.row(i);
+        float* bbox = args->bboxes->row(k);
 
         // CENTER_SIZE
         float pb_w = pb[2] - pb[0];
@@ -184,79 +82,77 @@ int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
         bbox[2] = bbox_cx + bbox_w * 0.5f;
         bbox[3] = bbox_cy + bbox_h * 0.5f;
     }
+}
+
+int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& location = bottom_blobs[0];
+    const Mat& confidence = bottom_blobs[1];
+    const Mat& priorbox = bottom_blobs[2];
 
-    // sort and nms for each class
-    std::vector< std::vector<BBoxRect> > all_class_bbox_rects;
-    std::vector< std::vector<float> > all_class_bbox_scores;
-    all_class_bbox_rects.resize(num_class);
-    all_class_bbox_scores.resize(num_class);
+    const int num_prior = priorbox.w / 4;
 
-    // start from 1 to ignore background class
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int i = 1; i < num_class; i++)
+    // only priors scoring above confidence_threshold in some class are decoded
+    std::vector<int> candidates;
+    for (int j = 0; j < num_prior; j++)
     {
-        // filter by confidence_threshold
-        std::vector<BBoxRect> class_bbox_rects;
-        std::vector<float> class_bbox_scores;
+        const float* conf = (const float*)confidence + j * num_class;
 
-        for (int j = 0; j < num_prior; j++)
+        // start from 1 to ignore background class
+        for (int i = 1; i < num_class; i++)
         {
-            float score = confidence[j * num_class + i];
-
-            if (score > confidence_threshold)
+            if (conf[i] > confidence_threshold)
             {
-                const float* bbox = bboxes.row(j);
-                BBoxRect c = { bbox[0], bbox[1], bbox[2], bbox[3], i };
-                class_bbox_rects.push_back(c);
-                class_bbox_scores.push_back(score);
+                candidates.push_back(j);
+                break;
             }
         }
+    }
 
-        // sort inplace
-        qsort_descent_inplace(class_bbox_rects, class_bbox_scores);
+    const int num_candidate = candidates.size();
 
-        // keep nms_top_k
-        if (nms_top_k < (int)class_bbox_rects.size())
-        {
-            class_bbox_rects.resize(nms_top_k);
-            class_bbox_scores.resize(nms_top_k);
-        }
+    // apply location with priorbox
+    Mat bboxes;
+    bboxes.create(4, num_candidate, 4u, opt.workspace_allocator);
+    if (num_candidate && bboxes.empty())
+        return -100;
+
+    detectionoutput_args args = { &location, &priorbox, &candidates, &bboxes };
+    parallel_for_2d(1, num_candidate, detectionoutput_decode_rows, &args, opt);
 
-        // apply nms
-        std::vector<int> picked;
-        nms_sorted_bboxes(class_bbox_rects, picked, nms_threshold);
+    // filter by confidence_threshold for each class
+    std::vector< std::vector<DetectionBox> > all_class_bboxes(num_class);
+
+    for (int k = 0; k < num_candidate; k++)
+    {
+        const float* conf = (const float*)confidence + candidates[k] * num_class;
+        const float* bbox = bboxes.row(k);
 
-        // select
-        for (int j = 0; j < (int)picked.size(); j++)
+        for (int i = 1; i < num_class; i++)
         {
-            int z = picked[j];
-            all_class_bbox_rects[i].push_back(class_bbox_rects[z]);
-            all_class_bbox_scores[i].push_back(class_bbox_scores[z]);
+            float score = conf[i];
+
+            if (score > confidence_threshold)
+            {
+                DetectionBox c = { bbox[0], bbox[1], bbox[2], bbox[3], score, i };
+                all_class_bboxes[i].push_back(c);
+            }
         }
     }
 
+    // sort, keep nms_top_k and nms for each class
+    nms_topk_per_class(all_class_bboxes, nms_threshold, nms_top_k, opt);
+
     // gather all class
-    std::vector<BBoxRect> bbox_rects;
-    std::vector<float> bbox_scores;
+    std::vector<DetectionBox> bbox_rects;
 
     for (int i = 1; i < num_class; i++)
     {
-        const std::vector<BBoxRect>& class_bbox_rects = all_class_bbox_rects[i];
-        const std::vector<float>& class_bbox_scores = all_class_bbox_scores[i];
-
-        bbox_rects.insert(bbox_rects.end(), class_bbox_rects.begin(), class_bbox_rects.end());
-        bbox_scores.insert(bbox_scores.end(), class_bbox_scores.begin(), class_bbox_scores.end());
+        bbox_rects.insert(bbox_rects.end(), all_class_bboxes[i].begin(), all_class_bboxes[i].end());
     }
 
-    // global sort inplace
-    qsort_descent_inplace(bbox_rects, bbox_scores);
-
-    // keep_top_k
-    if (keep_top_k < (int)bbox_rects.size())
-    {
-        bbox_rects.resize(keep_top_k);
-        bbox_scores.resize(keep_top_k);
-    }
+    // global sort and keep_top_k
+    sort_descent_topk(bbox_rects, keep_top_k);
 
     // fill result
     int num_detected = bbox_rects.size();
@@ -268,12 +164,11 @@ int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
 
     for (int i = 0; i < num_detected; i++)
     {
-        const BBoxRect& r = bbox_rects[i];
-        float score = bbox_scores[i];
+        const DetectionBox& r = bbox_rects[i];
         float* outptr = top_blob.row(i);
 
         outptr[0] = r.label;
-        outptr[1] = score;
+        outptr[1] = r.score;
         outptr[2] = r.xmin;
         outptr[3] = r.ymin;
         outptr[4] = r.xmax;
@@ -31,6 +31,29 @@ int Dropout::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct dropout_args
+{
+    const Dropout* layer;
+    Mat* bottom_top_blob;
+};
+
+static void dropout_rows(int q, int y0, int y1, void* userdata)
+{
+    const dropout_args* args = (const dropout_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float scale = args->layer->scale;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = ptr[i] * scale;
+    }
+}
+
 int Dropout::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
     if (scale == 1.f)
@@ -38,21 +61,11 @@ int Dropout::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
         return 0;
     }
 
-    int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
-    int size = w * h;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            ptr[i] = ptr[i] * scale;
-        }
-    }
+    dropout_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, dropout_rows, &args, opt);
 
     return 0;
 }
@@ -31,158 +31,123 @@ int Eltwise::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Eltwise::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct eltwise_args
 {
-    const Mat& bottom_blob = bottom_blobs[0];
-    int w = bottom_blob.w;
-    int h = bottom_blob.h;
-    int channels = bottom_blob.c;
-    size_t elemsize = bottom_blob.elemsize;
-    int size = w * h;
+    const Eltwise* layer;
+    const std::vector<Mat>* bottom_blobs;
+    Mat* top_blob;
+};
 
-    Mat& top_blob = top_blobs[0];
-    top_blob.create(w, h, channels, elemsize, opt.blob_allocator);
-    if (top_blob.empty())
-        return -100;
+static void eltwise_rows(int q, int y0, int y1, void* userdata)
+{
+    const eltwise_args* args = (const eltwise_args*)userdata;
+    const Eltwise* layer = args->layer;
+    const std::vector<Mat>& bottom_blobs = *args->bottom_blobs;
+    Mat& top_blob = *args->top_blob;
+
+    const int size = top_blob.w * (y1 - y0);
 
-    if (op_type == Operation_PROD)
+    // all inputs are applied to one row tile before moving on, keeping it in cache
+    const float* ptr = bottom_blobs[0].channel(q).row(y0);
+    const float* ptr1 = bottom_blobs[1].channel(q).row(y0);
+    float* outptr = top_blob.channel(q).row(y0);
+
+    if (layer->op_type == Eltwise::Operation_PROD)
     {
         // first blob
-        const Mat& bottom_blob1 = bottom_blobs[1];
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            const float* ptr = bottom_blob.channel(q);
-            const float* ptr1 = bottom_blob1.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = ptr[i] * ptr1[i];
-            }
+            outptr[i] = ptr[i] * ptr1[i];
         }
 
         for (size_t b=2; b<bottom_blobs.size(); b++)
         {
-            const Mat& bottom_blob1 = bottom_blobs[b];
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob1.channel(q);
-                float* outptr = top_blob.channel(q);
+            const float* ptr = bottom_blobs[b].channel(q).row(y0);
 
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] *= ptr[i];
-                }
+            for (int i=0; i<size; i++)
+            {
+                outptr[i] *= ptr[i];
             }
         }
     }
-    else if (op_type == Operation_SUM)
+    else if (layer->op_type == Eltwise::Operation_SUM)
     {
-        if (coeffs.w == 0)
+        if (layer->coeffs.w == 0)
         {
             // first blob
-            const Mat& bottom_blob1 = bottom_blobs[1];
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
+            for (int i=0; i<size; i++)
             {
-                const float* ptr = bottom_blob.channel(q);
-                const float* ptr1 = bottom_blob1.channel(q);
-                float* outptr = top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] + ptr1[i];
-                }
+                outptr[i] = ptr[i] + ptr1[i];
             }
 
             for (size_t b=2; b<bottom_blobs.size(); b++)
             {
-                const Mat& bottom_blob1 = bottom_blobs[b];
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int q=0; q<channels; q++)
-                {
-                    const float* ptr = bottom_blob1.channel(q);
-                    float* outptr = top_blob.channel(q);
+                const float* ptr = bottom_blobs[b].channel(q).row(y0);
 
-                    for (int i=0; i<size; i++)
-                    {
-                        outptr[i] += ptr[i];
-                    }
+                for (int i=0; i<size; i++)
+                {
+                    outptr[i] += ptr[i];
                 }
             }
         }
         else
         {
             // first blob
-            const Mat& bottom_blob1 = bottom_blobs[1];
-            float coeff0 = coeffs[0];
-            float coeff1 = coeffs[1];
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
+            float coeff0 = layer->coeffs[0];
+            float coeff1 = layer->coeffs[1];
+            for (int i=0; i<size; i++)
             {
-                const float* ptr = bottom_blob.channel(q);
-                const float* ptr1 = bottom_blob1.channel(q);
-                float* outptr = top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] * coeff0 + ptr1[i] * coeff1;
-                }
+                outptr[i] = ptr[i] * coeff0 + ptr1[i] * coeff1;
             }
 
             for (size_t b=2; b<bottom_blobs.size(); b++)
             {
-                const Mat& bottom_blob1 = bottom_blobs[b];
-                float coeff = coeffs[b];
-                #pragma omp parallel for num_threads(opt.num_threads)
-                for (int q=0; q<channels; q++)
-                {
-                    const float* ptr = bottom_blob1.channel(q);
-                    float* outptr = top_blob.channel(q);
+                const float* ptr = bottom_blobs[b].channel(q).row(y0);
+                float coeff = layer->coeffs[b];
 
-                    for (int i=0; i<size; i++)
-                    {
-                        outptr[i] += ptr[i] * coeff;
-                    }
+                for (int i=0; i<size; i++)
+                {
+                    outptr[i] += ptr[i] * coeff;
                 }
             }
         }
     }
-    else if (op_type == Operation_MAX)
+    else if (layer->op_type == Eltwise::Operation_MAX)
     {
         // first blob
-        const Mat& bottom_blob1 = bottom_blobs[1];
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            const float* ptr = bottom_blob.channel(q);
-            const float* ptr1 = bottom_blob1.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = std::max(ptr[i], ptr1[i]);
-            }
+            outptr[i] = std::max(ptr[i], ptr1[i]);
         }
 
         for (size_t b=2; b<bottom_blobs.size(); b++)
         {
-            const Mat& bottom_blob1 = bottom_blobs[b];
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob1.channel(q);
-                float* outptr = top_blob.channel(q);
+            const float* ptr = bottom_blobs[b].channel(q).row(y0);
 
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = std::max(outptr[i], ptr[i]);
-                }
+            for (int i=0; i<size; i++)
+            {
+                outptr[i] = std::max(outptr[i], ptr[i]);
             }
         }
     }
+}
+
+int Eltwise::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(w, h, channels, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    eltwise_args args = { this, &bottom_blobs, &top_blob };
+    parallel_for_2d(channels, h, eltwise_rows, &args, opt);
 
     return 0;
 }
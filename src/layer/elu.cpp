@@ -32,24 +32,37 @@ int ELU::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct elu_args
+{
+    const ELU* layer;
+    Mat* bottom_top_blob;
+};
+
+static void elu_rows(int q, int y0, int y1, void* userdata)
+{
+    const elu_args* args = (const elu_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float alpha = args->layer->alpha;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
+
+    for (int i=0; i<size; i++)
+    {
+        if (ptr[i] < 0.f)
+            ptr[i] = alpha * (exp(ptr[i]) - 1.f);
+    }
+}
+
 int ELU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
-    int size = w * h;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            if (ptr[i] < 0.f)
-                ptr[i] = alpha * (exp(ptr[i]) - 1.f);
-        }
-    }
+    elu_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, elu_rows, &args, opt);
 
     return 0;
 }
@@ -51,39 +51,59 @@ int Embed::load_model(const ModelBin& mb)
     return 0;
 }
 
-int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct embed_args
 {
-    int words = bottom_blob.total();
+    const Embed* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
 
-    top_blob.create(num_output, words, 4u, opt.blob_allocator);
-    if (top_blob.empty())
-        return -100;
+// one output row per word
+static void embed_rows(int /*q*/, int y0, int y1, void* userdata)
+{
+    const embed_args* args = (const embed_args*)userdata;
+    const Embed* layer = args->layer;
 
-    // num_output
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<words; q++)
+    const int num_output = layer->num_output;
+    const int input_dim = layer->input_dim;
+
+    for (int q=y0; q<y1; q++)
     {
-        float* outptr = top_blob.row(q);
+        float* outptr = args->top_blob->row(q);
 
-        int word_index = ((const int*)bottom_blob)[q];
+        int word_index = ((const int*)(*args->bottom_blob))[q];
 
         if (word_index < 0)
             word_index = 0;
         if (word_index >= input_dim)
             word_index = input_dim - 1;
 
-        const float* em = (const float*)weight_data + num_output * word_index;
+        const float* em = (const float*)layer->weight_data + num_output * word_index;
 
         memcpy(outptr, em, num_output * sizeof(float));
 
-        if (bias_term)
+        if (layer->bias_term)
         {
             for (int p=0; p<num_output; p++)
             {
-                outptr[p] += bias_data[p];
+                outptr[p] += layer->bias_data[p];
             }
         }
     }
+}
+
+int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int words = bottom_blob.total();
+
+    top_blob.create(num_output, words, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // num_output
+    embed_args args = { this, &bottom_blob, &top_blob };
+    parallel_for_2d(1, words, embed_rows, &args, opt);
 
     return 0;
 }
@@ -24,6 +24,30 @@ Flatten::Flatten()
     support_inplace = false;
 }
 
+// arguments of the loop body run by parallel_for
+struct flatten_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// copy channel q into its place in the flat blob
+static void flatten_channel(int q, void* userdata)
+{
+    const flatten_args* args = (const flatten_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+
+    int size = bottom_blob.w * bottom_blob.h;
+
+    const float* ptr = bottom_blob.channel(q);
+    float* outptr = (float*)(*args->top_blob) + size * q;
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = ptr[i];
+    }
+}
+
 int Flatten::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -36,17 +60,8 @@ int Flatten::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     if (top_blob.empty())
         return -100;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        const float* ptr = bottom_blob.channel(q);
-        float* outptr = (float*)top_blob + size * q;
-
-        for (int i=0; i<size; i++)
-        {
-            outptr[i] = ptr[i];
-        }
-    }
+    flatten_args args = { &bottom_blob, &top_blob };
+    parallel_for(channels, flatten_channel, &args, opt);
 
     return 0;
 }
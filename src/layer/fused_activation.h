@@ -0,0 +1,99 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef LAYER_FUSED_ACTIVATION_H
+#define LAYER_FUSED_ACTIVATION_H
+
+#include <math.h>
+#include <algorithm>
+#include "layer.h"
+
+namespace ncnn {
+
+// activation applied by a layer to its own output
+// 0 = none
+// 1 = relu
+// 2 = leaky relu, slope = activation_params[0]
+// 3 = clip, min = activation_params[0], max = activation_params[1]
+// 4 = sigmoid
+static inline float activation_ss(float v, int activation_type, const float* activation_params)
+{
+    if (activation_type == 1)
+    {
+        v = std::max(v, 0.f);
+    }
+    else if (activation_type == 2)
+    {
+        v = v > 0.f ? v : v * activation_params[0];
+    }
+    else if (activation_type == 3)
+    {
+        v = std::min(std::max(v, activation_params[0]), activation_params[1]);
+    }
+    else if (activation_type == 4)
+    {
+        v = 1.f / (1.f + exp(-v));
+    }
+
+    return v;
+}
+
+// number of activation_params the activation type reads
+static inline int activation_param_count(int activation_type)
+{
+    if (activation_type == 2)
+        return 1;
+
+    if (activation_type == 3)
+        return 2;
+
+    return 0;
+}
+
+// arguments of the activation loop body run by parallel_for
+struct fused_activation_args
+{
+    Mat* blob;
+    int activation_type;
+    const float* activation_params;
+};
+
+static void fused_activation_channel(int q, void* userdata)
+{
+    const fused_activation_args* args = (const fused_activation_args*)userdata;
+    Mat& blob = *args->blob;
+
+    const int size = blob.w * blob.h;
+
+    float* ptr = blob.channel(q);
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = activation_ss(ptr[i], args->activation_type, args->activation_params);
+    }
+}
+
+// separate activation pass for the paths that cannot fuse it into the kernel
+static void fused_activation_inplace(Mat& blob, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    if (activation_type == 0)
+        return;
+
+    fused_activation_args args = { &blob, activation_type, activation_params };
+    parallel_for(blob.c, fused_activation_channel, &args, opt);
+}
+
+} // namespace ncnn
+
+#endif // LAYER_FUSED_ACTIVATION_H
@@ -14,6 +14,8 @@
 
 #include "innerproduct.h"
 
+#include <stdio.h>
+#include "autotune.h"
 #include "layer_type.h"
 
 namespace ncnn {
@@ -104,13 +106,108 @@ int InnerProduct::load_model(const ModelBin& mb)
     return 0;
 }
 
+// arguments of the output loop body run by parallel_for
+struct innerproduct_args
+{
+    const InnerProduct* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+static void innerproduct_output(int p, void* userdata)
+{
+    const innerproduct_args* args = (const innerproduct_args*)userdata;
+    const InnerProduct* layer = args->layer;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    int channels = bottom_blob.c;
+    int size = bottom_blob.w * bottom_blob.h;
+
+    float sum = 0.f;
+
+    if (layer->bias_term)
+        sum = layer->bias_data[p];
+
+    // channels
+    for (int q=0; q<channels; q++)
+    {
+        const float* w = (const float*)layer->weight_data + size * channels * p + size * q;
+        const float* m = bottom_blob.channel(q);
+
+        for (int i = 0; i < size; i++)
+        {
+            sum += m[i] * w[i];
+        }
+    }
+
+    top_blob[p] = sum;
+}
+
+static void innerproduct_output_int8(int p, void* userdata)
+{
+    const innerproduct_args* args = (const innerproduct_args*)userdata;
+    const InnerProduct* layer = args->layer;
+    const Mat& bottom_blob_int8 = *args->bottom_blob;
+
+    int channels = bottom_blob_int8.c;
+    int size = bottom_blob_int8.w * bottom_blob_int8.h;
+
+    int sum = 0;
+    int* out = *args->top_blob;
+
+    // channels
+    for (int q=0; q<channels; q++)
+    {
+        const signed char* w = (const signed char*)layer->weight_data + size * channels * p + size * q;
+        const signed char* m = bottom_blob_int8.channel(q);
+
+        for (int i = 0; i < size; i++)
+        {
+            sum += m[i] * w[i];
+        }
+    }
+
+    out[p] = sum;
+}
+
+// arguments of the runs timed by autotune
+struct innerproduct_autotune_args
+{
+    const InnerProduct* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// a single algorithm, only the thread count is tuned
+static int innerproduct_run(int /*algo*/, const Option& opt, void* userdata)
+{
+    const innerproduct_autotune_args* args = (const innerproduct_autotune_args*)userdata;
+
+    Option opt_run = opt;
+    opt_run.autotune_cache = 0;
+
+    return args->layer->forward(*args->bottom_blob, *args->top_blob, opt_run);
+}
+
 int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (opt.autotune_cache && !use_int8_inference)
+    {
+        char signature[256];
+        sprintf(signature, "InnerProduct %d %dx%dx%d t%d", num_output, bottom_blob.w, bottom_blob.h, bottom_blob.c, opt.num_threads);
+
+        innerproduct_autotune_args args = { this, &bottom_blob, &top_blob };
+
+        Option opt_tuned;
+        if (autotune(signature, 1, innerproduct_run, &args, opt, opt_tuned) != -1)
+            return innerproduct_run(0, opt_tuned, &args);
+    }
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
     size_t elemsize = bottom_blob.elemsize;
-    int size = w * h;
 
     top_blob.create(num_output, elemsize, opt.blob_allocator);
     if (top_blob.empty())
@@ -134,26 +231,8 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
         }
 
         // num_output
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int p=0; p<num_output; p++)
-        {
-            int sum = 0;
-            int* out = top_blob;
-
-            // channels
-            for (int q=0; q<channels; q++)
-            {
-                const signed char* w = (const signed char*)weight_data + size * channels * p + size * q;
-                const signed char* m = bottom_blob_int8.channel(q);
-
-                for (int i = 0; i < size; i++)
-                {
-                    sum += m[i] * w[i];
-                }
-            }
-
-            out[p] = sum;
-        }
+        innerproduct_args args = { this, &bottom_blob_int8, &top_blob };
+        parallel_for(num_output, innerproduct_output_int8, &args, opt);
 
         // dequantize, reverse scale inplace
         {
@@ -178,28 +257,8 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     }
 
     // num_output
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<num_output; p++)
-    {
-        float sum = 0.f;
-
-        if (bias_term)
-            sum = bias_data[p];
-
-        // channels
-        for (int q=0; q<channels; q++)
-        {
-            const float* w = (const float*)weight_data + size * channels * p + size * q;
-            const float* m = bottom_blob.channel(q);
-
-            for (int i = 0; i < size; i++)
-            {
-                sum += m[i] * w[i];
-            }
-        }
-
-        top_blob[p] = sum;
-    }
+    innerproduct_args args = { this, &bottom_blob, &top_blob };
+    parallel_for(num_output, innerproduct_output, &args, opt);
 
     return 0;
 }
@@ -46,41 +46,53 @@ int InstanceNorm::load_model(const ModelBin& mb)
     return 0;
 }
 
-int InstanceNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct instancenorm_args
 {
-    // x = (x - mean) / (sqrt(var) + eps) * gamma + beta
+    const InstanceNorm* layer;
+    Mat* bottom_top_blob;
+};
+
+// normalize channel q with its own mean and var
+static void instancenorm_channel(int q, void* userdata)
+{
+    const instancenorm_args* args = (const instancenorm_args*)userdata;
+    const InstanceNorm* layer = args->layer;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+
+    int size = bottom_top_blob.w * bottom_top_blob.h;
+
+    float* ptr = bottom_top_blob.channel(q);
+
+    // mean and var
+    float sum = 0.f;
+    float sqsum = 0.f;
+    for (int i=0; i<size; i++)
+    {
+        sum += ptr[i];
+        sqsum += ptr[i] * ptr[i];
+    }
+    float mean = sum / size;
+    float var = sqsum / size - mean * mean;
+
+    float gamma = layer->gamma_data[q];
+    float beta = layer->beta_data[q];
 
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int size = w * h;
+    float a = gamma / (sqrt(var) + layer->eps);
+    float b = - mean * a + beta;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
+    for (int i=0; i<size; i++)
     {
-        float* ptr = bottom_top_blob.channel(q);
-
-        // mean and var
-        float sum = 0.f;
-        float sqsum = 0.f;
-        for (int i=0; i<size; i++)
-        {
-            sum += ptr[i];
-            sqsum += ptr[i] * ptr[i];
-        }
-        float mean = sum / size;
-        float var = sqsum / size - mean * mean;
-
-        float gamma = gamma_data[q];
-        float beta = beta_data[q];
-
-        float a = gamma / (sqrt(var) + eps);
-        float b = - mean * a + beta;
-
-        for (int i=0; i<size; i++)
-        {
-            ptr[i] = ptr[i] * a + b;
-        }
+        ptr[i] = ptr[i] * a + b;
     }
+}
+
+int InstanceNorm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    // x = (x - mean) / (sqrt(var) + eps) * gamma + beta
+
+    instancenorm_args args = { this, &bottom_top_blob };
+    parallel_for(channels, instancenorm_channel, &args, opt);
 
     return 0;
 }
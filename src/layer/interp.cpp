@@ -13,7 +13,13 @@
 // specific language governing permissions and limitations under the License.
 
 #include "interp.h"
+#include <math.h>
 #include <algorithm>
+#include <vector>
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
 
 namespace ncnn {
 
@@ -35,6 +41,211 @@ int Interp::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the resize loop bodies run by parallel_for_2d
+struct interp_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    float height_scale;
+    float width_scale;
+    // bilinear tables
+    const int* xofs;
+    const int* yofs;
+    const float* alpha;
+    const float* beta;
+    // bilinear row buffers, one row per worker
+    Mat* rowsbuf;
+    int workers;
+};
+
+static void interp_nearest_rows(int q, int y0, int y1, void* userdata)
+{
+    const interp_args* args = (const interp_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int ow = top_blob.w;
+
+    const float* ptr = bottom_blob.channel(q);
+    float* output_ptr = top_blob.channel(q);
+    for (int y = y0; y < y1; ++y)
+    {
+        const int in_y = std::min((int) (y / args->height_scale), (h - 1));
+        for (int x = 0; x < ow; ++x)
+        {
+            const int in_x = std::min((int) (x / args->width_scale), (w - 1));
+            output_ptr[ow * y + x] = ptr[in_y * w + in_x];
+        }
+    }
+}
+
+// a vec is broadcast, one element per channel
+static void interp_fill_channel(int q, void* userdata)
+{
+    const interp_args* args = (const interp_args*)userdata;
+
+    Mat top_blob_c = args->top_blob->channel(q);
+    const float* ptr = (const float*)args->bottom_blob->data + q;
+    top_blob_c.fill(*ptr);
+}
+
+// rows [y0, y1) of channel q, rows0 and rows1 hold w floats each
+static void interp_bilinear_rows(int q, int y0, int y1, float* rows0, float* rows1, const interp_args* args)
+{
+    const Mat src = args->bottom_blob->channel(q);
+    Mat dst = args->top_blob->channel(q);
+
+    const int w = dst.w;
+    const int* xofs = args->xofs;
+    const int* yofs = args->yofs;
+
+    // horizontally resized source rows sy and sy+1, reused while sy advances by one
+    int prev_sy1 = -1;
+
+    for (int dy = y0; dy < y1; dy++)
+    {
+        int sy = yofs[dy];
+
+        if (sy == prev_sy1)
+        {
+            // hresize one row
+            std::swap(rows0, rows1);
+
+            const float* S1 = src.row(sy+1);
+            const float* alphap = args->alpha;
+            int dx = 0;
+#if __ARM_NEON
+            for (; dx+1 < w; dx += 2)
+            {
+                float32x4_t _a = vld1q_f32(alphap);
+                float32x4_t _S1S1n = vcombine_f32(vld1_f32(S1 + xofs[dx]), vld1_f32(S1 + xofs[dx+1]));
+                float32x4_t _ms1 = vmulq_f32(_S1S1n, _a);
+                vst1_f32(rows1 + dx, vpadd_f32(vget_low_f32(_ms1), vget_high_f32(_ms1)));
+
+                alphap += 4;
+            }
+#endif // __ARM_NEON
+            for (; dx < w; dx++)
+            {
+                const float* S1p = S1 + xofs[dx];
+                rows1[dx] = S1p[0]*alphap[0] + S1p[1]*alphap[1];
+                alphap += 2;
+            }
+        }
+        else
+        {
+            // hresize two rows
+            const float* S0 = src.row(sy);
+            const float* S1 = src.row(sy+1);
+            const float* alphap = args->alpha;
+            int dx = 0;
+#if __ARM_NEON
+            for (; dx+1 < w; dx += 2)
+            {
+                float32x4_t _a = vld1q_f32(alphap);
+                float32x4_t _S0S0n = vcombine_f32(vld1_f32(S0 + xofs[dx]), vld1_f32(S0 + xofs[dx+1]));
+                float32x4_t _S1S1n = vcombine_f32(vld1_f32(S1 + xofs[dx]), vld1_f32(S1 + xofs[dx+1]));
+                float32x4_t _ms0 = vmulq_f32(_S0S0n, _a);
+                float32x4_t _ms1 = vmulq_f32(_S1S1n, _a);
+                vst1_f32(rows0 + dx, vpadd_f32(vget_low_f32(_ms0), vget_high_f32(_ms0)));
+                vst1_f32(rows1 + dx, vpadd_f32(vget_low_f32(_ms1), vget_high_f32(_ms1)));
+
+                alphap += 4;
+            }
+#endif // __ARM_NEON
+            for (; dx < w; dx++)
+            {
+                const float* S0p = S0 + xofs[dx];
+                const float* S1p = S1 + xofs[dx];
+                rows0[dx] = S0p[0]*alphap[0] + S0p[1]*alphap[1];
+                rows1[dx] = S1p[0]*alphap[0] + S1p[1]*alphap[1];
+                alphap += 2;
+            }
+        }
+
+        prev_sy1 = sy + 1;
+
+        // vresize
+        const float b0 = args->beta[dy*2];
+        const float b1 = args->beta[dy*2 + 1];
+
+        float* Dp = dst.row(dy);
+        int dx = 0;
+#if __ARM_NEON
+        float32x4_t _b0 = vdupq_n_f32(b0);
+        float32x4_t _b1 = vdupq_n_f32(b1);
+        for (; dx+3 < w; dx += 4)
+        {
+            float32x4_t _D = vmulq_f32(vld1q_f32(rows0 + dx), _b0);
+            _D = vmlaq_f32(_D, vld1q_f32(rows1 + dx), _b1);
+            vst1q_f32(Dp + dx, _D);
+        }
+#endif // __ARM_NEON
+        for (; dx < w; dx++)
+        {
+            Dp[dx] = rows0[dx] * b0 + rows1[dx] * b1;
+        }
+    }
+}
+
+// worker t resizes its share of all channel rows with its own row buffers
+static void interp_bilinear_worker(int t, void* userdata)
+{
+    const interp_args* args = (const interp_args*)userdata;
+
+    const int oh = args->top_blob->h;
+    const int w = args->top_blob->w;
+    const int total = args->top_blob->c * oh;
+
+    const int start = (int)((long long)total * t / args->workers);
+    const int end = (int)((long long)total * (t + 1) / args->workers);
+
+    float* rows0 = args->rowsbuf->row(t);
+    float* rows1 = rows0 + w;
+
+    for (int i = start; i < end; )
+    {
+        const int q = i / oh;
+        const int y0 = i % oh;
+        const int y1 = std::min(oh, y0 + end - i);
+
+        interp_bilinear_rows(q, y0, y1, rows0, rows1, args);
+
+        i += y1 - y0;
+    }
+}
+
+// source offsets and weights of bilinear resize, same as resize_bilinear
+static void interp_bilinear_table(int srcsize, int size, int* ofs, float* coeffs)
+{
+    double scale = (double)srcsize / size;
+
+    for (int d = 0; d < size; d++)
+    {
+        float f = (float)((d + 0.5) * scale - 0.5);
+        int s = floor(f);
+        f -= s;
+
+        if (s < 0)
+        {
+            s = 0;
+            f = 0.f;
+        }
+        if (s >= srcsize - 1)
+        {
+            s = srcsize - 2;
+            f = 1.f;
+        }
+
+        ofs[d] = s;
+
+        coeffs[d*2    ] = 1.f - f;
+        coeffs[d*2 + 1] = f;
+    }
+}
+
 int Interp::forward(const Mat &bottom_blob, Mat &top_blob, const Option& opt) const
 {
     int h = bottom_blob.h;
@@ -66,39 +277,43 @@ int Interp::forward(const Mat &bottom_blob, Mat &top_blob, const Option& opt) co
 
     if (bottom_blob.dims == 1)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < c; ++q)
-        {
-            Mat top_blob_c = top_blob.channel(q);
-            const float *ptr = ((const float*)bottom_blob.data + q);
-            top_blob_c.fill(*ptr);
-        }
+        interp_args args = { &bottom_blob, &top_blob, height_scale, width_scale, 0, 0, 0, 0, 0, 0 };
+        parallel_for(c, interp_fill_channel, &args, opt);
         return 0;
     }
 
+    interp_args args = { &bottom_blob, &top_blob, height_scale, width_scale, 0, 0, 0, 0, 0, 0 };
+
     if (resize_type == 1)//nearest
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < c; ++q)
-        {
-            const float *ptr = bottom_blob.channel(q);
-            float *output_ptr = top_blob.channel(q);
-            for (int y = 0; y < oh; ++y)
-            {
-                const int in_y = std::min((int) (y / height_scale), (h - 1));
-                for (int x = 0; x < ow; ++x)
-                {
-                    const int in_x = std::min((int) (x / width_scale), (w - 1));
-                    output_ptr[ow * y + x] = ptr[in_y * w + in_x];
-                }
-            }
-        }
+        parallel_for_2d(c, oh, interp_nearest_rows, &args, opt);
         return 0;
 
     }
     else if (resize_type == 2)// bilinear
     {
-        resize_bilinear(bottom_blob, top_blob, ow, oh);
+        std::vector<int> xofs(ow);
+        std::vector<int> yofs(oh);
+        std::vector<float> alpha(ow * 2);
+        std::vector<float> beta(oh * 2);
+        interp_bilinear_table(w, ow, &xofs[0], &alpha[0]);
+        interp_bilinear_table(h, oh, &yofs[0], &beta[0]);
+
+        // row buffers allocated once per worker, each worker takes a contiguous run of rows
+        const int workers = std::max(1, std::min(opt.num_threads, c * oh));
+
+        Mat rowsbuf(ow * 2, workers, (size_t)4u, opt.workspace_allocator);
+        if (rowsbuf.empty())
+            return -100;
+
+        args.xofs = &xofs[0];
+        args.yofs = &yofs[0];
+        args.alpha = &alpha[0];
+        args.beta = &beta[0];
+        args.rowsbuf = &rowsbuf;
+        args.workers = workers;
+
+        parallel_for(workers, interp_bilinear_worker, &args, opt);
         return 0;
 
     }
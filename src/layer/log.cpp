@@ -34,41 +34,50 @@ int Log::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Log::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct log_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    const Log* layer;
+    Mat* bottom_top_blob;
+};
+
+static void log_rows(int q, int y0, int y1, void* userdata)
+{
+    const log_args* args = (const log_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float base = args->layer->base;
+    const float scale = args->layer->scale;
+    const float shift = args->layer->shift;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
 
     if (base == -1.f)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] = log(shift + ptr[i] * scale);
-            }
+            ptr[i] = log(shift + ptr[i] * scale);
         }
     }
     else
     {
-        float log_base_inv = 1.f / log(base);
+        const float log_base_inv = 1.f / log(base);
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] = log(shift + ptr[i] * scale) * log_base_inv;
-            }
+            ptr[i] = log(shift + ptr[i] * scale) * log_base_inv;
         }
     }
+}
+
+int Log::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+
+    log_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, log_rows, &args, opt);
 
     return 0;
 }
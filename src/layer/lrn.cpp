@@ -36,13 +36,105 @@ int LRN::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct lrn_args
+{
+    const LRN* layer;
+    Mat* bottom_top_blob;
+    // squared values, bordered for the within channel window
+    Mat* square_blob;
+    Mat* square_sum;
+    const int* space_ofs;
+    int maxk;
+    float alpha_div_size;
+};
+
+static void lrn_square_channel(int q, void* userdata)
+{
+    const lrn_args* args = (const lrn_args*)userdata;
+
+    const int size = args->bottom_top_blob->w * args->bottom_top_blob->h;
+
+    const float* ptr = args->bottom_top_blob->channel(q);
+    float* outptr = args->square_blob->channel(q);
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = ptr[i] * ptr[i];
+    }
+}
+
+static void lrn_across_channel(int q, void* userdata)
+{
+    const lrn_args* args = (const lrn_args*)userdata;
+    const LRN* layer = args->layer;
+
+    const int channels = args->bottom_top_blob->c;
+    const int size = args->bottom_top_blob->w * args->bottom_top_blob->h;
+    const int local_size = layer->local_size;
+    const float alpha_div_size = args->alpha_div_size;
+
+    // square sum
+    float* ssptr = args->square_sum->channel(q);
+    for (int p=q - local_size / 2; p<=q + local_size / 2; p++)
+    {
+        if (p < 0 || p >= channels)
+            continue;
+
+        const float* sptr = args->square_blob->channel(p);
+        for (int i=0; i<size; i++)
+        {
+            ssptr[i] += sptr[i];
+        }
+    }
+
+    float* ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = ptr[i] * pow(layer->bias + alpha_div_size * ssptr[i], -layer->beta);
+    }
+}
+
+static void lrn_within_rows(int q, int y0, int y1, void* userdata)
+{
+    const lrn_args* args = (const lrn_args*)userdata;
+    const LRN* layer = args->layer;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = args->bottom_top_blob->w;
+    const int maxk = args->maxk;
+    const float alpha_div_size = args->alpha_div_size;
+
+    float* ptr = args->bottom_top_blob->channel(q).row(y0);
+    const Mat m = args->square_blob->channel(q);
+
+    for (int i = y0; i < y1; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            const float* sptr = m.row(i) + j;
+
+            float ss = 0.f;
+
+            for (int k = 0; k < maxk; k++)
+            {
+                float val = sptr[ space_ofs[k] ];
+                ss += val;
+            }
+
+            ptr[j] = ptr[j] * pow(layer->bias + alpha_div_size * ss, -layer->beta);
+        }
+
+        ptr += outw;
+    }
+}
+
 int LRN::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
     size_t elemsize = bottom_top_blob.elemsize;
-    int size = w * h;
 
     // squared values with local_size padding
     Mat square_blob;
@@ -50,17 +142,8 @@ int LRN::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     if (square_blob.empty())
         return -100;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        const float* ptr = bottom_top_blob.channel(q);
-        float* outptr = square_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            outptr[i] = ptr[i] * ptr[i];
-        }
-    }
+    lrn_args args = { this, &bottom_top_blob, &square_blob, 0, 0, 0, 0.f };
+    parallel_for(channels, lrn_square_channel, &args, opt);
 
     if (region_type == NormRegion_ACROSS_CHANNELS)
     {
@@ -70,35 +153,12 @@ int LRN::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
             return -100;
         square_sum.fill(0.f);
 
-        const float alpha_div_size = alpha / local_size;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            // square sum
-            float* ssptr = square_sum.channel(q);
-            for (int p=q - local_size / 2; p<=q + local_size / 2; p++)
-            {
-                if (p < 0 || p >= channels)
-                    continue;
-
-                const float* sptr = square_blob.channel(p);
-                for (int i=0; i<size; i++)
-                {
-                    ssptr[i] += sptr[i];
-                }
-            }
-
-            float* ptr = bottom_top_blob.channel(q);
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] = ptr[i] * pow(bias + alpha_div_size * ssptr[i], -beta);
-            }
-        }
+        args.square_sum = &square_sum;
+        args.alpha_div_size = alpha / local_size;
+        parallel_for(channels, lrn_across_channel, &args, opt);
     }
     else if (region_type == NormRegion_WITHIN_CHANNEL)
     {
-        int outw = w;
         int outh = h;
 
         Mat square_blob_bordered = square_blob;
@@ -136,32 +196,11 @@ int LRN::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
             }
         }
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            const Mat m = square_blob_bordered.channel(q);
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    const float* sptr = m.row(i) + j;
-
-                    float ss = 0.f;
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = sptr[ space_ofs[k] ];
-                        ss += val;
-                    }
-
-                    ptr[j] = ptr[j] * pow(bias + alpha_div_size * ss, -beta);
-                }
-
-                ptr += outw;
-            }
-        }
+        args.square_blob = &square_blob_bordered;
+        args.space_ofs = space_ofs;
+        args.maxk = maxk;
+        args.alpha_div_size = alpha_div_size;
+        parallel_for_2d(channels, outh, lrn_within_rows, &args, opt);
     }
 
     return 0;
@@ -34,6 +34,93 @@ int MVN::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct mvn_args
+{
+    const MVN* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    Mat* sum;
+    Mat* sqsum;
+    // mean and inverse norm across channels
+    float mean;
+    float norm_var_inv;
+};
+
+static void mvn_sum_channel(int q, void* userdata)
+{
+    const mvn_args* args = (const mvn_args*)userdata;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+
+    float s = 0.f;
+    for (int i=0; i<size; i++)
+    {
+        s += ptr[i];
+    }
+
+    (*args->sum)[q] = s;
+}
+
+// subtract mean
+static void mvn_sub_channel(int q, void* userdata)
+{
+    const mvn_args* args = (const mvn_args*)userdata;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+    float* outptr = args->top_blob->channel(q);
+    float mean = args->layer->across_channels ? args->mean : (*args->sum)[q] / size;
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = ptr[i] - mean;
+    }
+}
+
+static void mvn_sqsum_channel(int q, void* userdata)
+{
+    const mvn_args* args = (const mvn_args*)userdata;
+
+    const int size = args->top_blob->w * args->top_blob->h;
+
+    const float* ptr = args->top_blob->channel(q);
+
+    float s = 0.f;
+    for (int i=0; i<size; i++)
+    {
+        s += ptr[i] * ptr[i];
+    }
+
+    (*args->sqsum)[q] = s;
+}
+
+// apply normalize_variance
+static void mvn_scale_channel(int q, void* userdata)
+{
+    const mvn_args* args = (const mvn_args*)userdata;
+
+    const int size = args->top_blob->w * args->top_blob->h;
+
+    float* outptr = args->top_blob->channel(q);
+
+    float norm_var_inv = args->norm_var_inv;
+    if (!args->layer->across_channels)
+    {
+        float sqmean = (*args->sqsum)[q] / size;
+        float norm_var = sqrt(sqmean) + args->layer->eps;
+        norm_var_inv = 1.f / norm_var;
+    }
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = outptr[i] * norm_var_inv;
+    }
+}
+
 int MVN::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -51,19 +138,8 @@ int MVN::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
     if (sum.empty())
         return -100;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        const float* ptr = bottom_blob.channel(q);
-
-        float s = 0.f;
-        for (int i=0; i<size; i++)
-        {
-            s += ptr[i];
-        }
-
-        sum[q] = s;
-    }
+    mvn_args args = { this, &bottom_blob, &top_blob, &sum, 0, 0.f, 1.f };
+    parallel_for(channels, mvn_sum_channel, &args, opt);
 
     if (across_channels)
     {
@@ -73,37 +149,10 @@ int MVN::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
         {
             mean += sum[q];
         }
-        mean = mean / (channels * size);
-
-        // subtract mean
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = ptr[i] - mean;
-            }
-        }
+        args.mean = mean / (channels * size);
     }
-    else
-    {
-        // subtract mean
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-            float mean = sum[q] / size;
 
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = ptr[i] - mean;
-            }
-        }
-    }
+    parallel_for(channels, mvn_sub_channel, &args, opt);
 
     if (normalize_variance)
     {
@@ -112,19 +161,8 @@ int MVN::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
         if (sqsum.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = top_blob.channel(q);
-
-            float s = 0.f;
-            for (int i=0; i<size; i++)
-            {
-                s += ptr[i] * ptr[i];
-            }
-
-            sqsum[q] = s;
-        }
+        args.sqsum = &sqsum;
+        parallel_for(channels, mvn_sqsum_channel, &args, opt);
 
         if (across_channels)
         {
@@ -138,38 +176,10 @@ int MVN::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 
             // normalize variance
             float norm_var = sqrt(sqmean) + eps;
-            float norm_var_inv = 1.f / norm_var;
-
-            // apply normalize_variance
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                float* outptr = top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = outptr[i] * norm_var_inv;
-                }
-            }
-        }
-        else
-        {
-            // apply normalize_variance
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                float* outptr = top_blob.channel(q);
-                float sqmean = sqsum[q] / size;
-                float norm_var = sqrt(sqmean) + eps;
-                float norm_var_inv = 1.f / norm_var;
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = outptr[i] * norm_var_inv;
-                }
-            }
+            args.norm_var_inv = 1.f / norm_var;
         }
 
+        parallel_for(channels, mvn_scale_channel, &args, opt);
     }
 
     return 0;
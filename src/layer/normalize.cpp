@@ -45,6 +45,130 @@ int Normalize::load_model(const ModelBin& mb)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct normalize_args
+{
+    const Normalize* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    Mat* square_sum_blob;
+    float a;
+};
+
+static void normalize_square_sum_channel(int q, void* userdata)
+{
+    const normalize_args* args = (const normalize_args*)userdata;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+
+    float ssum = 0.f;
+    for (int i=0; i<size; i++)
+    {
+        ssum += ptr[i] * ptr[i];
+    }
+
+    (*args->square_sum_blob)[q] = ssum;
+}
+
+static void normalize_scale_channel(int q, void* userdata)
+{
+    const normalize_args* args = (const normalize_args*)userdata;
+    const Normalize* layer = args->layer;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+    float* outptr = args->top_blob->channel(q);
+    float scale = args->a * (layer->channel_shared ? layer->scale_data[0] : layer->scale_data[q]);
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = ptr[i] * scale;
+    }
+}
+
+static void normalize_spatial_channel(int q, void* userdata)
+{
+    const normalize_args* args = (const normalize_args*)userdata;
+    const Normalize* layer = args->layer;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+    float* outptr = args->top_blob->channel(q);
+
+    float ssum = layer->eps;
+    for (int i=0; i<size; i++)
+    {
+        ssum += ptr[i] * ptr[i];
+    }
+
+    float a = 1.f / sqrt(ssum);
+    float scale = a * (layer->channel_shared ? layer->scale_data[0] : layer->scale_data[q]);
+
+    for (int i=0; i<size; i++)
+    {
+        outptr[i] = ptr[i] * scale;
+    }
+}
+
+// the pixels are split into single element rows
+static void normalize_pixel_rows(int /*q*/, int i0, int i1, void* userdata)
+{
+    const normalize_args* args = (const normalize_args*)userdata;
+    const Normalize* layer = args->layer;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& square_sum_blob = *args->square_sum_blob;
+
+    const int channels = bottom_blob.c;
+
+    for (int i=i0; i<i1; i++)
+    {
+        float ssum = layer->eps;
+        for (int q=0; q<channels; q++)
+        {
+            const float* ptr = bottom_blob.channel(q);
+            ssum += ptr[i] * ptr[i];
+        }
+
+        if (layer->channel_shared)
+            square_sum_blob[i] = 1.f / sqrt(ssum) * layer->scale_data[0];
+        else
+            square_sum_blob[i] = 1.f / sqrt(ssum);
+    }
+}
+
+static void normalize_pixel_scale_channel(int q, void* userdata)
+{
+    const normalize_args* args = (const normalize_args*)userdata;
+    const Normalize* layer = args->layer;
+    const Mat& square_sum_blob = *args->square_sum_blob;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+
+    const float* ptr = args->bottom_blob->channel(q);
+    float* outptr = args->top_blob->channel(q);
+
+    if (layer->channel_shared)
+    {
+        for (int i=0; i<size; i++)
+        {
+            outptr[i] = ptr[i] * square_sum_blob[i];
+        }
+    }
+    else
+    {
+        float scale = layer->scale_data[q];
+
+        for (int i=0; i<size; i++)
+        {
+            outptr[i] = ptr[i] * square_sum_blob[i] * scale;
+        }
+    }
+}
+
 int Normalize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -57,6 +181,8 @@ int Normalize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
     if (top_blob.empty())
         return -100;
 
+    normalize_args args = { this, &bottom_blob, &top_blob, 0, 1.f };
+
     if (across_spatial && across_channel)
     {
         // square
@@ -65,19 +191,8 @@ int Normalize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         if (square_sum_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-
-            float ssum = 0.f;
-            for (int i=0; i<size; i++)
-            {
-                ssum += ptr[i] * ptr[i];
-            }
-
-            square_sum_blob[q] = ssum;
-        }
+        args.square_sum_blob = &square_sum_blob;
+        parallel_for(channels, normalize_square_sum_channel, &args, opt);
 
         // sum + eps
         float ssum = eps;
@@ -87,65 +202,16 @@ int Normalize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         }
 
         // 1 / sqrt(ssum)
-        float a = 1.f / sqrt(ssum);
+        args.a = 1.f / sqrt(ssum);
 
-        if (channel_shared)
-        {
-            float scale = a * scale_data[0];
-
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-                float* outptr = top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] * scale;
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-                float* outptr = top_blob.channel(q);
-                float scale = a * scale_data[q];
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] * scale;
-                }
-            }
-        }
+        parallel_for(channels, normalize_scale_channel, &args, opt);
 
         return 0;
     }
 
     if (across_spatial && !across_channel)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            float ssum = eps;
-            for (int i=0; i<size; i++)
-            {
-                ssum += ptr[i] * ptr[i];
-            }
-
-            float a = 1.f / sqrt(ssum);
-            float scale = a * (channel_shared ? scale_data[0] : scale_data[q]);
-
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = ptr[i] * scale;
-            }
-        }
+        parallel_for(channels, normalize_spatial_channel, &args, opt);
 
         return 0;
     }
@@ -158,63 +224,10 @@ int Normalize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         if (square_sum_blob.empty())
             return -100;
 
-        if (channel_shared)
-        {
-            float scale = scale_data[0];
-
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<size; i++)
-            {
-                float ssum = eps;
-                for (int q=0; q<channels; q++)
-                {
-                    const float* ptr = bottom_blob.channel(q);
-                    ssum += ptr[i] * ptr[i];
-                }
-
-                square_sum_blob[i] = 1.f / sqrt(ssum) * scale;
-            }
-
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-                float* outptr = top_blob.channel(q);
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] * square_sum_blob[i];
-                }
-            }
-        }
-        else
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<size; i++)
-            {
-                float ssum = eps;
-                for (int q=0; q<channels; q++)
-                {
-                    const float* ptr = bottom_blob.channel(q);
-                    ssum += ptr[i] * ptr[i];
-                }
-
-                square_sum_blob[i] = 1.f / sqrt(ssum);
-            }
-
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-                float* outptr = top_blob.channel(q);
-                float scale = scale_data[q];
-
-                for (int i=0; i<size; i++)
-                {
-                    outptr[i] = ptr[i] * square_sum_blob[i] * scale;
-                }
-            }
-        }
+        args.square_sum_blob = &square_sum_blob;
+        parallel_for_2d(1, size, normalize_pixel_rows, &args, opt);
+
+        parallel_for(channels, normalize_pixel_scale_channel, &args, opt);
 
         return 0;
     }
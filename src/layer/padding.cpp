@@ -182,6 +182,31 @@ static void copy_make_border_image(const Mat& src, Mat& dst, int top, int left,
     }
 }
 
+// arguments of the loop body run by parallel_for
+struct padding_args
+{
+    const Padding* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// border of channel q
+static void padding_channel(int q, void* userdata)
+{
+    const padding_args* args = (const padding_args*)userdata;
+    const Padding* layer = args->layer;
+
+    const Mat m = args->bottom_blob->channel(q);
+    Mat borderm = args->top_blob->channel(q);
+
+    size_t elemsize = args->bottom_blob->elemsize;
+
+    if (elemsize == 1)
+        copy_make_border_image<signed char>(m, borderm, layer->top, layer->left, layer->type, layer->value);
+    else if (elemsize == 4)
+        copy_make_border_image<float>(m, borderm, layer->top, layer->left, layer->type, layer->value);
+}
+
 int Padding::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     if (top == 0 && bottom == 0 && left == 0 && right == 0)
@@ -234,17 +259,8 @@ int Padding::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
         if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const Mat m = bottom_blob.channel(q);
-            Mat borderm = top_blob.channel(q);
-
-            if (elemsize == 1)
-                copy_make_border_image<signed char>(m, borderm, top, left, type, value);
-            else if (elemsize == 4)
-                copy_make_border_image<float>(m, borderm, top, left, type, value);
-        }
+        padding_args args = { this, &bottom_blob, &top_blob };
+        parallel_for(channels, padding_channel, &args, opt);
 
         return 0;
     }
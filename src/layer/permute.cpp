@@ -31,134 +31,140 @@ int Permute::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Permute::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct permute_args
+{
+    int order_type;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// fill output channel q
+static void permute_channel(int q, void* userdata)
 {
+    const permute_args* args = (const permute_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
-    size_t elemsize = bottom_blob.elemsize;
 
-    // order_type
-    // 0 = w h c
-    // 1 = h w c
-    // 2 = w c h
-    // 3 = c w h
-    // 4 = h c w
-    // 5 = c h w
+    float* outptr = top_blob.channel(q);
 
-    if (order_type == 0)
-    {
-        top_blob = bottom_blob;
-    }
-    else if (order_type == 1)
+    if (args->order_type == 1)
     {
-        top_blob.create(h, w, channels, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        const float* ptr = bottom_blob.channel(q);
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i = 0; i < w; i++)
         {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < w; i++)
+            for (int j = 0; j < h; j++)
             {
-                for (int j = 0; j < h; j++)
-                {
-                    outptr[i*h + j] = ptr[j*w + i];
-                }
+                outptr[i*h + j] = ptr[j*w + i];
             }
         }
     }
-    else if (order_type == 2)
+    else if (args->order_type == 2)
     {
-        top_blob.create(w, channels, h, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<h; q++)
+        for (int i = 0; i < channels; i++)
         {
-            float* outptr = top_blob.channel(q);
+            const float* ptr = bottom_blob.channel(i).row(q);
 
-            for (int i = 0; i < channels; i++)
+            for (int j = 0; j < w; j++)
             {
-                const float* ptr = bottom_blob.channel(i).row(q);
-
-                for (int j = 0; j < w; j++)
-                {
-                    outptr[i*w + j] = ptr[j];
-                }
+                outptr[i*w + j] = ptr[j];
             }
         }
     }
-    else if (order_type == 3)
+    else if (args->order_type == 3)
     {
-        top_blob.create(channels, w, h, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<h; q++)
+        for (int i = 0; i < w; i++)
         {
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < w; i++)
+            for (int j = 0; j < channels; j++)
             {
-                for (int j = 0; j < channels; j++)
-                {
-                    const float* ptr = bottom_blob.channel(j).row(q);
+                const float* ptr = bottom_blob.channel(j).row(q);
 
-                    outptr[i*channels + j] = ptr[i];
-                }
+                outptr[i*channels + j] = ptr[i];
             }
         }
     }
-    else if (order_type == 4)
+    else if (args->order_type == 4)
     {
-        top_blob.create(h, channels, w, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<w; q++)
+        for (int i = 0; i < channels; i++)
         {
-            float* outptr = top_blob.channel(q);
+            const float* ptr = bottom_blob.channel(i);
 
-            for (int i = 0; i < channels; i++)
+            for (int j = 0; j < h; j++)
             {
-                const float* ptr = bottom_blob.channel(i);
-
-                for (int j = 0; j < h; j++)
-                {
-                    outptr[i*channels + j] = ptr[j*w + q];
-                }
+                outptr[i*channels + j] = ptr[j*w + q];
             }
         }
     }
-    else if (order_type == 5)
+    else if (args->order_type == 5)
     {
-        top_blob.create(channels, h, w, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<w; q++)
+        for (int i = 0; i < h; i++)
         {
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < h; i++)
+            for (int j = 0; j < channels; j++)
             {
-                for (int j = 0; j < channels; j++)
-                {
-                    const float* ptr = bottom_blob.channel(j);
+                const float* ptr = bottom_blob.channel(j);
 
-                    outptr[i*channels + j] = ptr[i*w + q];
-                }
+                outptr[i*channels + j] = ptr[i*w + q];
             }
         }
     }
+}
+
+int Permute::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+
+    // order_type
+    // 0 = w h c
+    // 1 = h w c
+    // 2 = w c h
+    // 3 = c w h
+    // 4 = h c w
+    // 5 = c h w
+
+    if (order_type == 0)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    if (order_type == 1)
+    {
+        top_blob.create(h, w, channels, elemsize, opt.blob_allocator);
+    }
+    else if (order_type == 2)
+    {
+        top_blob.create(w, channels, h, elemsize, opt.blob_allocator);
+    }
+    else if (order_type == 3)
+    {
+        top_blob.create(channels, w, h, elemsize, opt.blob_allocator);
+    }
+    else if (order_type == 4)
+    {
+        top_blob.create(h, channels, w, elemsize, opt.blob_allocator);
+    }
+    else if (order_type == 5)
+    {
+        top_blob.create(channels, h, w, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (top_blob.empty())
+        return -100;
+
+    permute_args args = { order_type, &bottom_blob, &top_blob };
+    parallel_for(top_blob.c, permute_channel, &args, opt);
 
     return 0;
 }
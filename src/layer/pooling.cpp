@@ -43,6 +43,184 @@ int Pooling::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the global pooling loop bodies run by parallel_for
+struct pooling_global_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+static void pooling_global_max_channel(int q, void* userdata)
+{
+    const pooling_global_args* args = (const pooling_global_args*)userdata;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+    const float* ptr = args->bottom_blob->channel(q);
+
+    float max = ptr[0];
+    for (int i=0; i<size; i++)
+    {
+        max = std::max(max, ptr[i]);
+    }
+
+    (*args->top_blob)[q] = max;
+}
+
+static void pooling_global_ave_channel(int q, void* userdata)
+{
+    const pooling_global_args* args = (const pooling_global_args*)userdata;
+
+    const int size = args->bottom_blob->w * args->bottom_blob->h;
+    const float* ptr = args->bottom_blob->channel(q);
+
+    float sum = 0.f;
+    for (int i=0; i<size; i++)
+    {
+        sum += ptr[i];
+    }
+
+    (*args->top_blob)[q] = sum / size;
+}
+
+// arguments of the window loop bodies run by parallel_for_2d
+struct pooling_args
+{
+    const Pooling* layer;
+    const Mat* bottom_blob_bordered;
+    Mat* top_blob;
+    const int* space_ofs;
+    int wtailpad;
+    int htailpad;
+};
+
+static void pooling_max_channel(int q, int y0, int y1, void* userdata)
+{
+    const pooling_args* args = (const pooling_args*)userdata;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int stride_w = args->layer->stride_w;
+    const int stride_h = args->layer->stride_h;
+    const int maxk = args->layer->kernel_w * args->layer->kernel_h;
+
+    int outw = top_blob.w;
+
+    const Mat m = bottom_blob_bordered.channel(q);
+    float* outptr = top_blob.channel(q).row(y0);
+
+    for (int i = y0; i < y1; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            const float* sptr = m.row(i*stride_h) + j*stride_w;
+
+            float max = sptr[0];
+
+            for (int k = 0; k < maxk; k++)
+            {
+                float val = sptr[ space_ofs[k] ];
+                max = std::max(max, val);
+            }
+
+            outptr[j] = max;
+        }
+
+        outptr += outw;
+    }
+}
+
+static void pooling_ave_channel(int q, int y0, int y1, void* userdata)
+{
+    const pooling_args* args = (const pooling_args*)userdata;
+    const Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    Mat& top_blob = *args->top_blob;
+    const int* space_ofs = args->space_ofs;
+
+    const int kernel_w = args->layer->kernel_w;
+    const int kernel_h = args->layer->kernel_h;
+    const int stride_w = args->layer->stride_w;
+    const int stride_h = args->layer->stride_h;
+    const int pad_left = args->layer->pad_left;
+    const int pad_right = args->layer->pad_right;
+    const int pad_top = args->layer->pad_top;
+    const int pad_bottom = args->layer->pad_bottom;
+    const int wtailpad = args->wtailpad;
+    const int htailpad = args->htailpad;
+    const int maxk = kernel_w * kernel_h;
+
+    int outw = top_blob.w;
+    int outh = top_blob.h;
+
+    const Mat m = bottom_blob_bordered.channel(q);
+    float* outptr = top_blob.channel(q).row(y0);
+
+    for (int i = y0; i < y1; i++)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            const float* sptr = m.row(i*stride_h) + j*stride_w;
+
+            float sum = 0;
+
+            for (int k = 0; k < maxk; k++)
+            {
+                float val = sptr[ space_ofs[k] ];
+                sum += val;
+            }
+
+            outptr[j] = sum / maxk;
+        }
+
+        outptr += outw;
+    }
+
+    // fix pad
+    if (pad_top != 0 && y0 == 0)
+    {
+        const float scale = (float)kernel_h / (kernel_h - pad_top);
+
+        outptr = top_blob.channel(q).row(0);
+        for (int i = 0; i < outw; i++)
+        {
+            outptr[i] *= scale;
+        }
+    }
+    if (pad_bottom + htailpad != 0 && y1 == outh)
+    {
+        const float scale = (float)kernel_h / (kernel_h - pad_bottom - htailpad);
+
+        outptr = top_blob.channel(q).row(outh - 1);
+        for (int i = 0; i < outw; i++)
+        {
+            outptr[i] *= scale;
+        }
+    }
+    if (pad_left != 0)
+    {
+        const float scale = (float)kernel_w / (kernel_w - pad_left);
+
+        outptr = top_blob.channel(q).row(y0);
+        for (int i = y0; i < y1; i++)
+        {
+            *outptr *= scale;
+            outptr += outw;
+        }
+    }
+    if (pad_right + wtailpad != 0)
+    {
+        const float scale = (float)kernel_w / (kernel_w - pad_right - wtailpad);
+
+        outptr = top_blob.channel(q).row(y0);
+        outptr += outw - 1;
+        for (int i = y0; i < y1; i++)
+        {
+            *outptr *= scale;
+            outptr += outw;
+        }
+    }
+}
+
 int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // max value in NxN window
@@ -60,39 +238,15 @@ int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
         if (top_blob.empty())
             return -100;
 
-        int size = w * h;
+        pooling_global_args args = { &bottom_blob, &top_blob };
 
         if (pooling_type == PoolMethod_MAX)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-
-                float max = ptr[0];
-                for (int i=0; i<size; i++)
-                {
-                    max = std::max(max, ptr[i]);
-                }
-
-                top_blob[q] = max;
-            }
+            parallel_for(channels, pooling_global_max_channel, &args, opt);
         }
         else if (pooling_type == PoolMethod_AVE)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const float* ptr = bottom_blob.channel(q);
-
-                float sum = 0.f;
-                for (int i=0; i<size; i++)
-                {
-                    sum += ptr[i];
-                }
-
-                top_blob[q] = sum / size;
-            }
+            parallel_for(channels, pooling_global_ave_channel, &args, opt);
         }
 
         return 0;
@@ -182,108 +336,15 @@ int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
         }
     }
 
+    pooling_args args = { this, &bottom_blob_bordered, &top_blob, space_ofs, wtailpad, htailpad };
+
     if (pooling_type == PoolMethod_MAX)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const Mat m = bottom_blob_bordered.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                    float max = sptr[0];
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = sptr[ space_ofs[k] ];
-                        max = std::max(max, val);
-                    }
-
-                    outptr[j] = max;
-                }
-
-                outptr += outw;
-            }
-        }
+        parallel_for_2d(channels, outh, pooling_max_channel, &args, opt);
     }
     else if (pooling_type == PoolMethod_AVE)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const Mat m = bottom_blob_bordered.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < outh; i++)
-            {
-                for (int j = 0; j < outw; j++)
-                {
-                    const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                    float sum = 0;
-
-                    for (int k = 0; k < maxk; k++)
-                    {
-                        float val = sptr[ space_ofs[k] ];
-                        sum += val;
-                    }
-
-                    outptr[j] = sum / maxk;
-                }
-
-                outptr += outw;
-            }
-
-            // fix pad
-            if (pad_top != 0)
-            {
-                const float scale = (float)kernel_h / (kernel_h - pad_top);
-
-                outptr = top_blob.channel(q).row(0);
-                for (int i = 0; i < outw; i++)
-                {
-                    outptr[i] *= scale;
-                }
-            }
-            if (pad_bottom + htailpad != 0)
-            {
-                const float scale = (float)kernel_h / (kernel_h - pad_bottom - htailpad);
-
-                outptr = top_blob.channel(q).row(outh - 1);
-                for (int i = 0; i < outw; i++)
-                {
-                    outptr[i] *= scale;
-                }
-            }
-            if (pad_left != 0)
-            {
-                const float scale = (float)kernel_w / (kernel_w - pad_left);
-
-                outptr = top_blob.channel(q);
-                for (int i = 0; i < outh; i++)
-                {
-                    *outptr *= scale;
-                    outptr += outw;
-                }
-            }
-            if (pad_right + wtailpad != 0)
-            {
-                const float scale = (float)kernel_w / (kernel_w - pad_right - wtailpad);
-
-                outptr = top_blob.channel(q);
-                outptr += outw - 1;
-                for (int i = 0; i < outh; i++)
-                {
-                    *outptr *= scale;
-                    outptr += outw;
-                }
-            }
-        }
+        parallel_for_2d(channels, outh, pooling_ave_channel, &args, opt);
     }
 
     return 0;
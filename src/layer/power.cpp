@@ -34,23 +34,38 @@ int Power::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct power_args
+{
+    const Power* layer;
+    Mat* bottom_top_blob;
+};
+
+static void power_rows(int q, int y0, int y1, void* userdata)
+{
+    const power_args* args = (const power_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float power = args->layer->power;
+    const float scale = args->layer->scale;
+    const float shift = args->layer->shift;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = pow((shift + ptr[i] * scale), power);
+    }
+}
+
 int Power::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
-    int size = w * h;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        float* ptr = bottom_top_blob.channel(q);
-
-        for (int i=0; i<size; i++)
-        {
-            ptr[i] = pow((shift + ptr[i] * scale), power);
-        }
-    }
+    power_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, power_rows, &args, opt);
 
     return 0;
 }
@@ -40,20 +40,30 @@ int PReLU::load_model(const ModelBin& mb)
     return 0;
 }
 
-int PReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct prelu_args
+{
+    const PReLU* layer;
+    Mat* bottom_top_blob;
+};
+
+// a vec is split into single element rows, each with its own slope
+static void prelu_rows(int q, int y0, int y1, void* userdata)
 {
+    const prelu_args* args = (const prelu_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const int num_slope = args->layer->num_slope;
+    const float* slope_data = args->layer->slope_data;
+
     int dims = bottom_top_blob.dims;
 
     if (dims == 1)
     {
-        int w = bottom_top_blob.w;
-
         float* ptr = bottom_top_blob;
 
         if (num_slope > 1)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
+            for (int i=y0; i<y1; i++)
             {
                 if (ptr[i] < 0)
                     ptr[i] *= slope_data[i];
@@ -63,8 +73,7 @@ int PReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
         {
             float slope = slope_data[0];
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
+            for (int i=y0; i<y1; i++)
             {
                 if (ptr[i] < 0)
                     ptr[i] *= slope;
@@ -75,10 +84,8 @@ int PReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     if (dims == 2)
     {
         int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<h; i++)
+        for (int i=y0; i<y1; i++)
         {
             float* ptr = bottom_top_blob.row(i);
             float slope = num_slope > 1 ? slope_data[i] : slope_data[0];
@@ -93,24 +100,39 @@ int PReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 
     if (dims == 3)
     {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-        int channels = bottom_top_blob.c;
-        int size = w * h;
+        const int size = bottom_top_blob.w * (y1 - y0);
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float slope = num_slope > 1 ? slope_data[q] : slope_data[0];
+        float* ptr = bottom_top_blob.channel(q).row(y0);
+        float slope = num_slope > 1 ? slope_data[q] : slope_data[0];
 
-            for (int i=0; i<size; i++)
-            {
-                if (ptr[i] < 0)
-                    ptr[i] *= slope;
-            }
+        for (int i=0; i<size; i++)
+        {
+            if (ptr[i] < 0)
+                ptr[i] *= slope;
         }
     }
+}
+
+int PReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int dims = bottom_top_blob.dims;
+
+    prelu_args args = { this, &bottom_top_blob };
+
+    if (dims == 1)
+    {
+        parallel_for_2d(1, bottom_top_blob.w, prelu_rows, &args, opt);
+    }
+
+    if (dims == 2)
+    {
+        parallel_for_2d(1, bottom_top_blob.h, prelu_rows, &args, opt);
+    }
+
+    if (dims == 3)
+    {
+        parallel_for_2d(bottom_top_blob.c, bottom_top_blob.h, prelu_rows, &args, opt);
+    }
 
     return 0;
 }
@@ -24,6 +24,7 @@ PriorBox::PriorBox()
 {
     one_blob_only = false;
     support_inplace = false;
+    shape_constant = true;
 }
 
 int PriorBox::load_param(const ParamDict& pd)
@@ -46,38 +47,44 @@ int PriorBox::load_param(const ParamDict& pd)
     return 0;
 }
 
-int PriorBox::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct priorbox_args
 {
-    int w = bottom_blobs[0].w;
-    int h = bottom_blobs[0].h;
-
-    int image_w = image_width;
-    int image_h = image_height;
-    if (image_w == -233)
-        image_w = bottom_blobs[1].w;
-    if (image_h == -233)
-        image_h = bottom_blobs[1].h;
-
-    float step_w = step_width;
-    float step_h = step_height;
-    if (step_w == -233)
-        step_w = (float)image_w / w;
-    if (step_h == -233)
-        step_h = (float)image_h / h;
-
-    int num_min_size = min_sizes.w;
-    int num_max_size = max_sizes.w;
-    int num_aspect_ratio = aspect_ratios.w;
-
-    int num_prior = num_min_size * num_aspect_ratio + num_min_size + num_max_size;
-    if (flip)
-        num_prior += num_min_size * num_aspect_ratio;
-
-    Mat& top_blob = top_blobs[0];
-    top_blob.create(4 * w * h * num_prior, 2, 4u, opt.blob_allocator);
-
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int i = 0; i < h; i++)
+    const PriorBox* layer;
+    Mat* top_blob;
+    int w;
+    int num_prior;
+    int image_w;
+    int image_h;
+    float step_w;
+    float step_h;
+};
+
+// prior boxes of feature rows [y0, y1)
+static void priorbox_rows(int /*q*/, int y0, int y1, void* userdata)
+{
+    const priorbox_args* args = (const priorbox_args*)userdata;
+    const PriorBox* layer = args->layer;
+    Mat& top_blob = *args->top_blob;
+
+    const Mat& min_sizes = layer->min_sizes;
+    const Mat& max_sizes = layer->max_sizes;
+    const Mat& aspect_ratios = layer->aspect_ratios;
+    const int flip = layer->flip;
+    const float offset = layer->offset;
+
+    const int w = args->w;
+    const int num_prior = args->num_prior;
+    const int image_w = args->image_w;
+    const int image_h = args->image_h;
+    const float step_w = args->step_w;
+    const float step_h = args->step_h;
+
+    const int num_min_size = min_sizes.w;
+    const int num_max_size = max_sizes.w;
+    const int num_aspect_ratio = aspect_ratios.w;
+
+    for (int i = y0; i < y1; i++)
     {
         float* box = (float*)top_blob + i * w * num_prior * 4;
 
@@ -147,9 +154,41 @@ int PriorBox::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
 
             center_x += step_w;
         }
-
-        center_y += step_h;
     }
+}
+
+int PriorBox::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    int w = bottom_blobs[0].w;
+    int h = bottom_blobs[0].h;
+
+    int image_w = image_width;
+    int image_h = image_height;
+    if (image_w == -233)
+        image_w = bottom_blobs[1].w;
+    if (image_h == -233)
+        image_h = bottom_blobs[1].h;
+
+    float step_w = step_width;
+    float step_h = step_height;
+    if (step_w == -233)
+        step_w = (float)image_w / w;
+    if (step_h == -233)
+        step_h = (float)image_h / h;
+
+    int num_min_size = min_sizes.w;
+    int num_max_size = max_sizes.w;
+    int num_aspect_ratio = aspect_ratios.w;
+
+    int num_prior = num_min_size * num_aspect_ratio + num_min_size + num_max_size;
+    if (flip)
+        num_prior += num_min_size * num_aspect_ratio;
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(4 * w * h * num_prior, 2, 4u, opt.blob_allocator);
+
+    priorbox_args args = { this, &top_blob, w, num_prior, image_w, image_h, step_w, step_h };
+    parallel_for_2d(1, h, priorbox_rows, &args, opt);
 
     if (clip)
     {
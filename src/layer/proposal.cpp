@@ -16,6 +16,7 @@
 #include <math.h>
 #include <algorithm>
 #include <vector>
+#include "nms.h"
 
 namespace ncnn {
 
@@ -92,106 +93,96 @@ int Proposal::load_param(const ParamDict& pd)
     return 0;
 }
 
-struct Rect
+// arguments of the loop body run by parallel_for
+struct proposal_args
 {
-    float x1;
-    float y1;
-    float x2;
-    float y2;
+    const Mat* anchors;
+    const Mat* bbox_blob;
+    Mat* proposals;
+    int w;
+    int h;
+    int feat_stride;
+    float im_w;
+    float im_h;
 };
 
-static inline float intersection_area(const Rect& a, const Rect& b)
+// proposals of anchor q, clipped to the image
+static void proposal_anchor(int q, void* userdata)
 {
-    if (a.x1 > b.x2 || a.x2 < b.x1 || a.y1 > b.y2 || a.y2 < b.y1)
-    {
-        // no intersection
-        return 0.f;
-    }
+    const proposal_args* args = (const proposal_args*)userdata;
+    const Mat& anchors = *args->anchors;
+    const Mat& bbox_blob = *args->bbox_blob;
+    Mat& proposals = *args->proposals;
 
-    float inter_width = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
-    float inter_height = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+    const int w = args->w;
+    const int h = args->h;
+    const float im_w = args->im_w;
+    const float im_h = args->im_h;
 
-    return inter_width * inter_height;
-}
+    const float* bbox_xptr = bbox_blob.channel(q * 4);
+    const float* bbox_yptr = bbox_blob.channel(q * 4 + 1);
+    const float* bbox_wptr = bbox_blob.channel(q * 4 + 2);
+    const float* bbox_hptr = bbox_blob.channel(q * 4 + 3);
 
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right)
-{
-    int i = left;
-    int j = right;
-    float p = scores[(left + right) / 2];
+    Mat pbs = proposals.channel(q);
 
-    while (i <= j)
-    {
-        while (scores[i] > p)
-            i++;
+    const float* anchor = anchors.row(q);
 
-        while (scores[j] < p)
-            j--;
+    // shifted anchor
+    float anchor_y = anchor[1];
 
-        if (i <= j)
-        {
-            // swap
-            std::swap(datas[i], datas[j]);
-            std::swap(scores[i], scores[j]);
+    float anchor_w = anchor[2] - anchor[0];
+    float anchor_h = anchor[3] - anchor[1];
 
-            i++;
-            j--;
-        }
-    }
+    for (int i = 0; i < h; i++)
+    {
+        float anchor_x = anchor[0];
 
-    if (left < j)
-        qsort_descent_inplace(datas, scores, left, j);
+        for (int j = 0; j < w; j++)
+        {
+            float* pb = pbs.row(i*w + j);
 
-    if (i < right)
-        qsort_descent_inplace(datas, scores, i, right);
-}
+            // apply center size
+            float dx = bbox_xptr[j];
+            float dy = bbox_yptr[j];
+            float dw = bbox_wptr[j];
+            float dh = bbox_hptr[j];
 
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores)
-{
-    if (datas.empty() || scores.empty())
-        return;
+            float cx = anchor_x + anchor_w * 0.5f;
+            float cy = anchor_y + anchor_h * 0.5f;
 
-    qsort_descent_inplace(datas, scores, 0, scores.size() - 1);
-}
+            float pb_cx = cx + anchor_w * dx;
+            float pb_cy = cy + anchor_h * dy;
 
-static void nms_sorted_bboxes(const std::vector<Rect>& bboxes, std::vector<int>& picked, float nms_threshold)
-{
-    picked.clear();
+            float pb_w = anchor_w * exp(dw);
+            float pb_h = anchor_h * exp(dh);
 
-    const int n = bboxes.size();
+            pb[0] = pb_cx - pb_w * 0.5f;
+            pb[1] = pb_cy - pb_h * 0.5f;
+            pb[2] = pb_cx + pb_w * 0.5f;
+            pb[3] = pb_cy + pb_h * 0.5f;
 
-    std::vector<float> areas(n);
-    for (int i = 0; i < n; i++)
-    {
-        const Rect& r = bboxes[i];
+            anchor_x += args->feat_stride;
+        }
 
-        float width = r.x2 - r.x1;
-        float height = r.y2 - r.y1;
+        bbox_xptr += w;
+        bbox_yptr += w;
+        bbox_wptr += w;
+        bbox_hptr += w;
 
-        areas[i] = width * height;
+        anchor_y += args->feat_stride;
     }
 
-    for (int i = 0; i < n; i++)
+    // clip predicted boxes to image
+    for (int i = 0; i < w * h; i++)
     {
-        const Rect& a = bboxes[i];
+        float* pb = pbs.row(i);
 
-        int keep = 1;
-        for (int j = 0; j < (int)picked.size(); j++)
-        {
-            const Rect& b = bboxes[picked[j]];
-
-            // intersection over union
-            float inter_area = intersection_area(a, b);
-            float union_area = areas[i] + areas[picked[j]] - inter_area;
-//             float IoU = inter_area / union_area
-            if (inter_area / union_area > nms_threshold)
-                keep = 0;
-        }
-
-        if (keep)
-            picked.push_back(i);
+        // clip box
+        pb[0] = std::max(std::min(pb[0], im_w - 1), 0.f);
+        pb[1] = std::max(std::min(pb[1], im_h - 1), 0.f);
+        pb[2] = std::max(std::min(pb[2], im_w - 1), 0.f);
+        pb[3] = std::max(std::min(pb[3], im_h - 1), 0.f);
     }
 }
 
@@ -210,88 +201,15 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     Mat proposals;
     proposals.create(4, w * h, num_anchors);
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<num_anchors; q++)
-    {
-        const float* bbox_xptr = bbox_blob.channel(q * 4);
-        const float* bbox_yptr = bbox_blob.channel(q * 4 + 1);
-        const float* bbox_wptr = bbox_blob.channel(q * 4 + 2);
-        const float* bbox_hptr = bbox_blob.channel(q * 4 + 3);
-
-        Mat pbs = proposals.channel(q);
-
-        const float* anchor = anchors.row(q);
-
-        // shifted anchor
-        float anchor_y = anchor[1];
-
-        float anchor_w = anchor[2] - anchor[0];
-        float anchor_h = anchor[3] - anchor[1];
-
-        for (int i = 0; i < h; i++)
-        {
-            float anchor_x = anchor[0];
-
-            for (int j = 0; j < w; j++)
-            {
-                float* pb = pbs.row(i*w + j);
-
-                // apply center size
-                float dx = bbox_xptr[j];
-                float dy = bbox_yptr[j];
-                float dw = bbox_wptr[j];
-                float dh = bbox_hptr[j];
-
-                float cx = anchor_x + anchor_w * 0.5f;
-                float cy = anchor_y + anchor_h * 0.5f;
-
-                float pb_cx = cx + anchor_w * dx;
-                float pb_cy = cy + anchor_h * dy;
-
-                float pb_w = anchor_w * exp(dw);
-                float pb_h = anchor_h * exp(dh);
-
-                pb[0] = pb_cx - pb_w * 0.5f;
-                pb[1] = pb_cy - pb_h * 0.5f;
-                pb[2] = pb_cx + pb_w * 0.5f;
-                pb[3] = pb_cy + pb_h * 0.5f;
-
-                anchor_x += feat_stride;
-            }
-
-            bbox_xptr += w;
-            bbox_yptr += w;
-            bbox_wptr += w;
-            bbox_hptr += w;
-
-            anchor_y += feat_stride;
-        }
-    }
-
     // clip predicted boxes to image
     float im_w = im_info_blob[1];
     float im_h = im_info_blob[0];
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<num_anchors; q++)
-    {
-        Mat pbs = proposals.channel(q);
-
-        for (int i = 0; i < w * h; i++)
-        {
-            float* pb = pbs.row(i);
-
-            // clip box
-            pb[0] = std::max(std::min(pb[0], im_w - 1), 0.f);
-            pb[1] = std::max(std::min(pb[1], im_h - 1), 0.f);
-            pb[2] = std::max(std::min(pb[2], im_w - 1), 0.f);
-            pb[3] = std::max(std::min(pb[3], im_h - 1), 0.f);
-        }
-    }
+    proposal_args args = { &anchors, &bbox_blob, &proposals, w, h, feat_stride, im_w, im_h };
+    parallel_for(num_anchors, proposal_anchor, &args, opt);
 
     // remove predicted boxes with either height or width < threshold
-    std::vector<Rect> proposal_boxes;
-    std::vector<float> scores;
+    std::vector<DetectionBox> proposal_boxes;
 
     float im_scale = im_info_blob[2];
     float min_boxsize = min_size * im_scale;
@@ -310,26 +228,19 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
 
             if (pb_w >= min_boxsize && pb_h >= min_boxsize)
             {
-                Rect r = { pb[0], pb[1], pb[2], pb[3] };
+                DetectionBox r = { pb[0], pb[1], pb[2], pb[3], scoreptr[i], 0 };
                 proposal_boxes.push_back(r);
-                scores.push_back(scoreptr[i]);
             }
         }
     }
 
     // sort all (proposal, score) pairs by score from highest to lowest
-    qsort_descent_inplace(proposal_boxes, scores);
-
-    // take top pre_nms_topN
-    if (pre_nms_topN > 0 && pre_nms_topN < (int)proposal_boxes.size())
-    {
-        proposal_boxes.resize(pre_nms_topN);
-        scores.resize(pre_nms_topN);
-    }
+    // and take top pre_nms_topN
+    sort_descent_topk(proposal_boxes, pre_nms_topN);
 
-    // apply nms with nms_thresh
+    // apply nms with nms_thresh, stop at after_nms_topN
     std::vector<int> picked;
-    nms_sorted_bboxes(proposal_boxes, picked, nms_thresh);
+    nms_sorted_bboxes(proposal_boxes, picked, nms_thresh, after_nms_topN);
 
     // take after_nms_topN
     int picked_count = std::min((int)picked.size(), after_nms_topN);
@@ -344,10 +255,10 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     {
         float* outptr = roi_blob.channel(i);
 
-        outptr[0] = proposal_boxes[ picked[i] ].x1;
-        outptr[1] = proposal_boxes[ picked[i] ].y1;
-        outptr[2] = proposal_boxes[ picked[i] ].x2;
-        outptr[3] = proposal_boxes[ picked[i] ].y2;
+        outptr[0] = proposal_boxes[ picked[i] ].xmin;
+        outptr[1] = proposal_boxes[ picked[i] ].ymin;
+        outptr[2] = proposal_boxes[ picked[i] ].xmax;
+        outptr[3] = proposal_boxes[ picked[i] ].ymax;
     }
 
     if (top_blobs.size() > 1)
@@ -360,7 +271,7 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         for (int i=0; i<picked_count; i++)
         {
             float* outptr = roi_score_blob.channel(i);
-            outptr[0] = scores[ picked[i] ];
+            outptr[0] = proposal_boxes[ picked[i] ].score;
         }
     }
 
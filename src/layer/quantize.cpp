@@ -41,6 +41,29 @@ static inline signed char float2int8(float v)
     return (signed char)int32;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct quantize_args
+{
+    float scale;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// a vec is split into single element rows
+static void quantize_rows(int q, int y0, int y1, void* userdata)
+{
+    const quantize_args* args = (const quantize_args*)userdata;
+
+    const int w = args->bottom_blob->dims == 1 ? 1 : args->bottom_blob->w;
+    const float* ptr = args->bottom_blob->channel(q);
+    signed char* outptr = args->top_blob->channel(q);
+
+    for (int i=y0 * w; i<y1 * w; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * args->scale);
+    }
+}
+
 int Quantize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int dims = bottom_blob.dims;
@@ -53,34 +76,21 @@ int Quantize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         if (top_blob.empty())
             return -100;
 
-        const float* ptr = bottom_blob;
-        signed char* outptr = top_blob;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<w; i++)
-        {
-            outptr[i] = float2int8(ptr[i] * scale);
-        }
+        quantize_args args = { scale, &bottom_blob, &top_blob };
+        parallel_for_2d(1, w, quantize_rows, &args, opt);
     }
 
     if (dims == 2)
     {
         int w = bottom_blob.w;
         int h = bottom_blob.h;
-        int size = w * h;
 
         top_blob.create(w, h, (size_t)1u, opt.blob_allocator);
         if (top_blob.empty())
             return -100;
 
-        const float* ptr = bottom_blob;
-        signed char* outptr = top_blob;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int i=0; i<size; i++)
-        {
-            outptr[i] = float2int8(ptr[i] * scale);
-        }
+        quantize_args args = { scale, &bottom_blob, &top_blob };
+        parallel_for_2d(1, h, quantize_rows, &args, opt);
     }
 
     if (dims == 3)
@@ -88,23 +98,13 @@ int Quantize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         int w = bottom_blob.w;
         int h = bottom_blob.h;
         int channels = bottom_blob.c;
-        int size = w * h;
 
         top_blob.create(w, h, channels, (size_t)1u, opt.blob_allocator);
         if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            signed char* outptr = top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                outptr[i] = float2int8(ptr[i] * scale);
-            }
-        }
+        quantize_args args = { scale, &bottom_blob, &top_blob };
+        parallel_for_2d(channels, h, quantize_rows, &args, opt);
     }
 
     return 0;
@@ -38,6 +38,77 @@ int Reduction::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for
+struct reduction_args
+{
+    const Mat* a;
+    // channel sums for dim 0, per row minimums for dim -1, the output otherwise
+    Mat* b;
+    float v0;
+    float coeff;
+    int dim;
+};
+
+template<typename Op>
+static void reduction_channel(int q, void* userdata)
+{
+    const reduction_args* args = (const reduction_args*)userdata;
+    const Mat& a = *args->a;
+    Mat& b = *args->b;
+    const float v0 = args->v0;
+    const float coeff = args->coeff;
+
+    Op op;
+
+    int w = a.w;
+    int h = a.h;
+    int size = w * h;
+
+    const float* ptr = a.channel(q);
+
+    if (args->dim == 0 || args->dim == 1)
+    {
+        float sum = v0;
+        for (int i=0; i<size; i++)
+        {
+            sum = op(sum, ptr[i]);
+        }
+
+        b[q] = args->dim == 0 ? sum : sum * coeff;
+    }
+    else if (args->dim == 2)
+    {
+        float* outptr = b.channel(q);
+
+        for (int i=0; i<h; i++)
+        {
+            float sum = v0;
+            for (int j=0; j<w; j++)
+            {
+                sum = op(sum, ptr[i]);
+            }
+
+            outptr[i] = sum * coeff;
+
+            ptr += w;
+        }
+    }
+    else if (args->dim == -1)
+    {
+        float* mins_ptr = b.channel(q);
+
+        for (int i=0; i<h; i++)
+        {
+            for (int j=0; j<w; j++)
+            {
+                mins_ptr[j] = op(mins_ptr[j], ptr[i]);
+            }
+
+            ptr += w;
+        }
+    }
+}
+
 template<typename Op, typename Op2>
 static int reduction_op(const Mat& a, Mat& b, float v0, int dim, float coeff, const Option& opt)
 {
@@ -84,19 +155,8 @@ static int reduction_op(const Mat& a, Mat& b, float v0, int dim, float coeff, co
         if (sums.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = a.channel(q);
-
-            float sum = v0;
-            for (int i=0; i<size; i++)
-            {
-                sum = op(sum, ptr[i]);
-            }
-
-            sums[q] = sum;
-        }
+        reduction_args args = { &a, &sums, v0, coeff, dim };
+        parallel_for(channels, reduction_channel<Op>, &args, opt);
 
         float sum = v0;
         for (int i=0; i<channels; i++)
@@ -106,43 +166,10 @@ static int reduction_op(const Mat& a, Mat& b, float v0, int dim, float coeff, co
 
         b[0] = sum * coeff;
     }
-    else if (dim == 1)
-    {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = a.channel(q);
-
-            float sum = v0;
-            for (int i=0; i<size; i++)
-            {
-                sum = op(sum, ptr[i]);
-            }
-
-            b[q] = sum * coeff;
-        }
-    }
-    else if (dim == 2)
+    else if (dim == 1 || dim == 2)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = a.channel(q);
-            float* outptr = b.channel(q);
-
-            for (int i=0; i<h; i++)
-            {
-                float sum = v0;
-                for (int j=0; j<w; j++)
-                {
-                    sum = op(sum, ptr[i]);
-                }
-
-                outptr[i] = sum * coeff;
-
-                ptr += w;
-            }
-        }
+        reduction_args args = { &a, &b, v0, coeff, dim };
+        parallel_for(channels, reduction_channel<Op>, &args, opt);
     }
     else if (dim == -1)
     {
@@ -152,22 +179,8 @@ static int reduction_op(const Mat& a, Mat& b, float v0, int dim, float coeff, co
 
         mins.fill(v0);
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = a.channel(q);
-            float* mins_ptr = mins.channel(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (int j=0; j<w; j++)
-                {
-                    mins_ptr[j] = op(mins_ptr[j], ptr[i]);
-                }
-
-                ptr += w;
-            }
-        }
+        reduction_args args = { &a, &mins, v0, coeff, dim };
+        parallel_for(channels, reduction_channel<Op>, &args, opt);
 
         b.fill(v0);
 
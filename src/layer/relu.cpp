@@ -31,41 +31,48 @@ int ReLU::load_param(const ParamDict& pd)
     return 0;
 }
 
-int ReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct relu_args
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
-    int channels = bottom_top_blob.c;
-    int size = w * h;
+    const ReLU* layer;
+    Mat* bottom_top_blob;
+};
+
+static void relu_rows(int q, int y0, int y1, void* userdata)
+{
+    const relu_args* args = (const relu_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const float slope = args->layer->slope;
+
+    const int size = bottom_top_blob.w * (y1 - y0);
+
+    float* ptr = bottom_top_blob.channel(q).row(y0);
 
     if (slope == 0.f)
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                if (ptr[i] < 0)
-                    ptr[i] = 0;
-            }
+            if (ptr[i] < 0)
+                ptr[i] = 0;
         }
     }
     else
     {
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i=0; i<size; i++)
         {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                if (ptr[i] < 0)
-                    ptr[i] *= slope;
-            }
+            if (ptr[i] < 0)
+                ptr[i] *= slope;
         }
     }
+}
+
+int ReLU::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+
+    relu_args args = { this, &bottom_top_blob };
+    parallel_for_2d(channels, h, relu_rows, &args, opt);
 
     return 0;
 }
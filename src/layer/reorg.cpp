@@ -31,6 +31,46 @@ int Reorg::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for
+struct reorg_args
+{
+    int stride;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+static void reorg_channel(int q, void* userdata)
+{
+    const reorg_args* args = (const reorg_args*)userdata;
+    Mat& top_blob = *args->top_blob;
+
+    const int stride = args->stride;
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+
+    const Mat m = args->bottom_blob->channel(q);
+
+    for (int sh = 0; sh < stride; sh++)
+    {
+        for (int sw = 0; sw < stride; sw++)
+        {
+            float* outptr = top_blob.channel(q*stride*stride + sh*stride + sw);
+
+            for (int i = 0; i < outh; i++)
+            {
+                const float* sptr = m.row(i*stride + sh) + sw;
+                for (int j = 0; j < outw; j++)
+                {
+                    outptr[0] = sptr[0];
+
+                    sptr += stride;
+                    outptr++;
+                }
+            }
+        }
+    }
+}
+
 int Reorg::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -46,31 +86,8 @@ int Reorg::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) con
     if (top_blob.empty())
         return -100;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        const Mat m = bottom_blob.channel(q);
-
-        for (int sh = 0; sh < stride; sh++)
-        {
-            for (int sw = 0; sw < stride; sw++)
-            {
-                float* outptr = top_blob.channel(q*stride*stride + sh*stride + sw);
-
-                for (int i = 0; i < outh; i++)
-                {
-                    const float* sptr = m.row(i*stride + sh) + sw;
-                    for (int j = 0; j < outw; j++)
-                    {
-                        outptr[0] = sptr[0];
-
-                        sptr += stride;
-                        outptr++;
-                    }
-                }
-            }
-        }
-    }
+    reorg_args args = { stride, &bottom_blob, &top_blob };
+    parallel_for(channels, reorg_channel, &args, opt);
 
     return 0;
 }
@@ -33,11 +33,76 @@ int ROIPooling::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for
+struct roipooling_args
+{
+    const ROIPooling* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    int roi_x1;
+    int roi_y1;
+    float bin_size_w;
+    float bin_size_h;
+};
+
+static void roipooling_channel(int q, void* userdata)
+{
+    const roipooling_args* args = (const roipooling_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int pooled_width = args->layer->pooled_width;
+    const int pooled_height = args->layer->pooled_height;
+    const int roi_x1 = args->roi_x1;
+    const int roi_y1 = args->roi_y1;
+    const float bin_size_w = args->bin_size_w;
+    const float bin_size_h = args->bin_size_h;
+
+    const float* ptr = bottom_blob.channel(q);
+    float* outptr = top_blob.channel(q);
+
+    for (int ph = 0; ph < pooled_height; ph++)
+    {
+        for (int pw = 0; pw < pooled_width; pw++)
+        {
+            // Compute pooling region for this output unit:
+            //  start (included) = floor(ph * roi_height / pooled_height)
+            //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height)
+            int hstart = roi_y1 + floor((float)(ph) * bin_size_h);
+            int wstart = roi_x1 + floor((float)(pw) * bin_size_w);
+            int hend = roi_y1 + ceil((float)(ph + 1) * bin_size_h);
+            int wend = roi_x1 + ceil((float)(pw + 1) * bin_size_w);
+
+            hstart = std::min(std::max(hstart, 0), h);
+            wstart = std::min(std::max(wstart, 0), w);
+            hend = std::min(std::max(hend, 0), h);
+            wend = std::min(std::max(wend, 0), w);
+
+            bool is_empty = (hend <= hstart) || (wend <= wstart);
+
+            float max = is_empty ? 0.f : ptr[hstart * w + wstart];
+
+            for (int y = hstart; y < hend; y++)
+            {
+                for (int x = wstart; x < wend; x++)
+                {
+                    int index = y * w + x;
+                    max = std::max(max, ptr[index]);
+                }
+            }
+
+            outptr[pw] = max;
+        }
+
+        outptr += pooled_width;
+    }
+}
+
 int ROIPooling::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     const Mat& bottom_blob = bottom_blobs[0];
-    int w = bottom_blob.w;
-    int h = bottom_blob.h;
     size_t elemsize = bottom_blob.elemsize;
     int channels = bottom_blob.c;
 
@@ -62,48 +127,8 @@ int ROIPooling::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
     float bin_size_w = (float)roi_w / (float)pooled_width;
     float bin_size_h = (float)roi_h / (float)pooled_height;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int q=0; q<channels; q++)
-    {
-        const float* ptr = bottom_blob.channel(q);
-        float* outptr = top_blob.channel(q);
-
-        for (int ph = 0; ph < pooled_height; ph++)
-        {
-            for (int pw = 0; pw < pooled_width; pw++)
-            {
-                // Compute pooling region for this output unit:
-                //  start (included) = floor(ph * roi_height / pooled_height)
-                //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height)
-                int hstart = roi_y1 + floor((float)(ph) * bin_size_h);
-                int wstart = roi_x1 + floor((float)(pw) * bin_size_w);
-                int hend = roi_y1 + ceil((float)(ph + 1) * bin_size_h);
-                int wend = roi_x1 + ceil((float)(pw + 1) * bin_size_w);
-
-                hstart = std::min(std::max(hstart, 0), h);
-                wstart = std::min(std::max(wstart, 0), w);
-                hend = std::min(std::max(hend, 0), h);
-                wend = std::min(std::max(wend, 0), w);
-
-                bool is_empty = (hend <= hstart) || (wend <= wstart);
-
-                float max = is_empty ? 0.f : ptr[hstart * w + wstart];
-
-                for (int y = hstart; y < hend; y++)
-                {
-                    for (int x = wstart; x < wend; x++)
-                    {
-                        int index = y * w + x;
-                        max = std::max(max, ptr[index]);
-                    }
-                }
-
-                outptr[pw] = max;
-            }
-
-            outptr += pooled_width;
-        }
-    }
+    roipooling_args args = { this, &bottom_blob, &top_blob, roi_x1, roi_y1, bin_size_w, bin_size_h };
+    parallel_for(channels, roipooling_channel, &args, opt);
 
     return 0;
 }
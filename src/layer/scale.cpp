@@ -54,31 +54,39 @@ int Scale::load_model(const ModelBin& mb)
     return 0;
 }
 
-int Scale::forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt) const
+// arguments of the loop body run by parallel_for_2d
+struct scale_args
 {
-    Mat& bottom_top_blob = bottom_top_blobs[0];
-    const Mat& scale_blob = bottom_top_blobs[1];
+    const Scale* layer;
+    Mat* bottom_top_blob;
+    const Mat* scale_blob;
+};
+
+// a vec is split into single element rows, each with its own scale
+static void scale_rows(int q, int y0, int y1, void* userdata)
+{
+    const scale_args* args = (const scale_args*)userdata;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
+    const Mat& scale_blob = *args->scale_blob;
+    const int bias_term = args->layer->bias_term;
+    const Mat& bias_data = args->layer->bias_data;
 
     int dims = bottom_top_blob.dims;
 
     if (dims == 1)
     {
-        int w = bottom_top_blob.w;
-
         float* ptr = bottom_top_blob;
 
         if (bias_term)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
+            for (int i=y0; i<y1; i++)
             {
                 ptr[i] = ptr[i] * scale_blob[i] + bias_data[i];
             }
         }
         else
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<w; i++)
+            for (int i=y0; i<y1; i++)
             {
                 ptr[i] *= scale_blob[i];
             }
@@ -88,12 +96,10 @@ int Scale::forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt
     if (dims == 2)
     {
         int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
 
         if (bias_term)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
+            for (int i=y0; i<y1; i++)
             {
                 float* ptr = bottom_top_blob.row(i);
                 float s = scale_blob[i];
@@ -107,8 +113,7 @@ int Scale::forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt
         }
         else
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int i=0; i<h; i++)
+            for (int i=y0; i<y1; i++)
             {
                 float* ptr = bottom_top_blob.row(i);
                 float s = scale_blob[i];
@@ -123,43 +128,54 @@ int Scale::forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt
 
     if (dims == 3)
     {
-        int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
-        int channels = bottom_top_blob.c;
-        int size = w * h;
+        const int size = bottom_top_blob.w * (y1 - y0);
+
+        float* ptr = bottom_top_blob.channel(q).row(y0);
+
+        float s = scale_blob[q];
 
         if (bias_term)
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                float* ptr = bottom_top_blob.channel(q);
-
-                float s = scale_blob[q];
-                float bias = bias_data[q];
+            float bias = bias_data[q];
 
-                for (int i=0; i<size; i++)
-                {
-                    ptr[i] = ptr[i] * s + bias;
-                }
+            for (int i=0; i<size; i++)
+            {
+                ptr[i] = ptr[i] * s + bias;
             }
         }
         else
         {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
+            for (int i=0; i<size; i++)
             {
-                float* ptr = bottom_top_blob.channel(q);
-
-                float s = scale_blob[q];
-
-                for (int i=0; i<size; i++)
-                {
-                    ptr[i] *= s;
-                }
+                ptr[i] *= s;
             }
         }
     }
+}
+
+int Scale::forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt) const
+{
+    Mat& bottom_top_blob = bottom_top_blobs[0];
+    const Mat& scale_blob = bottom_top_blobs[1];
+
+    int dims = bottom_top_blob.dims;
+
+    scale_args args = { this, &bottom_top_blob, &scale_blob };
+
+    if (dims == 1)
+    {
+        parallel_for_2d(1, bottom_top_blob.w, scale_rows, &args, opt);
+    }
+
+    if (dims == 2)
+    {
+        parallel_for_2d(1, bottom_top_blob.h, scale_rows, &args, opt);
+    }
+
+    if (dims == 3)
+    {
+        parallel_for_2d(bottom_top_blob.c, bottom_top_blob.h, scale_rows, &args, opt);
+    }
 
     return 0;
 }
@@ -30,6 +30,65 @@ int Slice::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct slice_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    int axis;
+    // first row or column of the slice and its size
+    int offset;
+    int slice;
+};
+
+// columns of a 2d blob, one row each
+static void slice_rows(int /*q*/, int y0, int y1, void* userdata)
+{
+    const slice_args* args = (const slice_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    for (int j=y0; j<y1; j++)
+    {
+        float* outptr = top_blob.row(j);
+        const float* ptr = bottom_blob.row(j) + args->offset;
+        memcpy(outptr, ptr, args->slice * bottom_blob.elemsize);
+    }
+}
+
+// rows or columns of a 3d blob, one channel each
+static void slice_channel(int p, void* userdata)
+{
+    const slice_args* args = (const slice_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int slice = args->slice;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    float* outptr = top_blob.channel(p);
+
+    if (args->axis == 1)
+    {
+        int size = bottom_blob.w * slice;
+
+        const float* ptr = bottom_blob.channel(p).row(args->offset);
+        memcpy(outptr, ptr, size * elemsize);
+    }
+    else
+    {
+        const Mat m = bottom_blob.channel(p);
+
+        for (int j=0; j<bottom_blob.h; j++)
+        {
+            const float* ptr = m.row(j) + args->offset;
+            memcpy(outptr, ptr, slice * elemsize);
+
+            outptr += slice;
+        }
+    }
+}
+
 int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     const Mat& bottom_blob = bottom_blobs[0];
@@ -115,13 +174,8 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
             if (top_blob.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int j=0; j<h; j++)
-            {
-                float* outptr = top_blob.row(j);
-                const float* ptr = bottom_blob.row(j) + q;
-                memcpy(outptr, ptr, slice * elemsize);
-            }
+            slice_args args = { &bottom_blob, &top_blob, axis, q, slice };
+            parallel_for_2d(1, h, slice_rows, &args, opt);
 
             q += slice;
         }
@@ -131,8 +185,6 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
 
     if (dims == 3 && axis == 0)
     {
-        int w = bottom_blob.w;
-        int h = bottom_blob.h;
         int channels = bottom_blob.c;
 
         int q = 0;
@@ -144,16 +196,8 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
                 slice = (channels - q) / (top_blobs.size() - i);
             }
 
-            Mat& top_blob = top_blobs[i];
-            top_blob.create(w, h, slice, elemsize, opt.blob_allocator);
-            if (top_blob.empty())
-                return -100;
-
-            int size = bottom_blob.cstep * slice;
-
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob;
-            memcpy(outptr, ptr, size * elemsize);
+            // channels are contiguous, take a view instead of a copy
+            top_blobs[i] = bottom_blob.channel_range_shared(q, slice);
 
             q += slice;
         }
@@ -181,15 +225,8 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
             if (top_blob.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int p=0; p<channels; p++)
-            {
-                int size = w * slice;
-
-                float* outptr = top_blob.channel(p);
-                const float* ptr = bottom_blob.channel(p).row(q);
-                memcpy(outptr, ptr, size * elemsize);
-            }
+            slice_args args = { &bottom_blob, &top_blob, axis, q, slice };
+            parallel_for(channels, slice_channel, &args, opt);
 
             q += slice;
         }
@@ -217,20 +254,8 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
             if (top_blob.empty())
                 return -100;
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int p=0; p<channels; p++)
-            {
-                float* outptr = top_blob.channel(p);
-                const Mat m = bottom_blob.channel(p);
-
-                for (int j=0; j<h; j++)
-                {
-                    const float* ptr = m.row(j) + q;
-                    memcpy(outptr, ptr, slice * elemsize);
-
-                    outptr += slice;
-                }
-            }
+            slice_args args = { &bottom_blob, &top_blob, axis, q, slice };
+            parallel_for(channels, slice_channel, &args, opt);
 
             q += slice;
         }
@@ -34,6 +34,167 @@ int Softmax::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop bodies run by parallel_for
+struct softmax_args
+{
+    Mat* bottom_top_blob;
+    Mat* max;
+    Mat* sum;
+};
+
+static void softmax_axis0_exp(int q, void* userdata)
+{
+    const softmax_args* args = (const softmax_args*)userdata;
+    const Mat& max = *args->max;
+
+    const int size = args->bottom_top_blob->w * args->bottom_top_blob->h;
+
+    float* ptr = args->bottom_top_blob->channel(q);
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] = exp(ptr[i] - max[i]);
+    }
+}
+
+static void softmax_axis0_div(int q, void* userdata)
+{
+    const softmax_args* args = (const softmax_args*)userdata;
+    const Mat& sum = *args->sum;
+
+    const int size = args->bottom_top_blob->w * args->bottom_top_blob->h;
+
+    float* ptr = args->bottom_top_blob->channel(q);
+
+    for (int i=0; i<size; i++)
+    {
+        ptr[i] /= sum[i];
+    }
+}
+
+// each channel is normalized on its own, all passes run while it is in cache
+static void softmax_axis1_channel(int q, void* userdata)
+{
+    const softmax_args* args = (const softmax_args*)userdata;
+
+    const int w = args->bottom_top_blob->w;
+    const int h = args->bottom_top_blob->h;
+
+    float* ptr = args->bottom_top_blob->channel(q);
+    float* maxptr = args->max->row(q);
+    float* sumptr = args->sum->row(q);
+
+    for (int i=0; i<h; i++)
+    {
+        float max = -FLT_MAX;
+        for (int j=0; j<w; j++)
+        {
+            max = std::max(max, ptr[j]);
+        }
+
+        maxptr[i] = max;
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        float max = maxptr[i];
+        for (int j=0; j<w; j++)
+        {
+            ptr[j] = exp(ptr[j] - max);
+        }
+
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        float sum = 0.f;
+        for (int j=0; j<w; j++)
+        {
+            sum += ptr[j];
+        }
+
+        sumptr[i] = sum;
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        float sum = sumptr[i];
+        for (int j=0; j<w; j++)
+        {
+            ptr[j] /= sum;
+        }
+
+        ptr += w;
+    }
+}
+
+static void softmax_axis2_channel(int q, void* userdata)
+{
+    const softmax_args* args = (const softmax_args*)userdata;
+
+    const int w = args->bottom_top_blob->w;
+    const int h = args->bottom_top_blob->h;
+
+    float* ptr = args->bottom_top_blob->channel(q);
+    float* maxptr = args->max->row(q);
+    float* sumptr = args->sum->row(q);
+
+    for (int j=0; j<w; j++)
+    {
+        maxptr[j] = -FLT_MAX;
+        sumptr[j] = 0.f;
+    }
+
+    for (int i=0; i<h; i++)
+    {
+        for (int j=0; j<w; j++)
+        {
+            maxptr[j] = std::max(maxptr[j], ptr[j]);
+        }
+
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        for (int j=0; j<w; j++)
+        {
+            ptr[j] = exp(ptr[j] - maxptr[j]);
+        }
+
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        for (int j=0; j<w; j++)
+        {
+            sumptr[j] += ptr[j];
+        }
+
+        ptr += w;
+    }
+
+    ptr = args->bottom_top_blob->channel(q);
+    for (int i=0; i<h; i++)
+    {
+        for (int j=0; j<w; j++)
+        {
+            ptr[j] /= sumptr[j];
+        }
+
+        ptr += w;
+    }
+}
+
 int Softmax::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
     // value = exp( value - global max value )
@@ -218,16 +379,8 @@ int Softmax::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
             }
         }
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] = exp(ptr[i] - max[i]);
-            }
-        }
+        softmax_args args = { &bottom_top_blob, &max, 0 };
+        parallel_for(channels, softmax_axis0_exp, &args, opt);
 
         Mat sum;
         sum.create(w, h, elemsize, opt.workspace_allocator);
@@ -244,23 +397,14 @@ int Softmax::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
             }
         }
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-
-            for (int i=0; i<size; i++)
-            {
-                ptr[i] /= sum[i];
-            }
-        }
+        args.sum = &sum;
+        parallel_for(channels, softmax_axis0_div, &args, opt);
 
         return 0;
     }
 
     if (dims == 3 && axis == 1)
     {
-        int w = bottom_top_blob.w;
         int h = bottom_top_blob.h;
         int channels = bottom_top_blob.c;
 
@@ -268,85 +412,14 @@ int Softmax::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
         max.create(h, channels, elemsize, opt.workspace_allocator);
         if (max.empty())
             return -100;
-        max.fill(-FLT_MAX);
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_top_blob.channel(q);
-            float* maxptr = max.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                float max = -FLT_MAX;
-                for (int j=0; j<w; j++)
-                {
-                    max = std::max(max, ptr[j]);
-                }
-
-                maxptr[i] = max;
-                ptr += w;
-            }
-        }
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float* maxptr = max.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                float max = maxptr[i];
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = exp(ptr[j] - max);
-                }
-
-                ptr += w;
-            }
-        }
 
         Mat sum;
         sum.create(h, channels, elemsize, opt.workspace_allocator);
         if (sum.empty())
             return -100;
-        sum.fill(0.f);
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_top_blob.channel(q);
-            float* sumptr = sum.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                float sum = 0.f;
-                for (int j=0; j<w; j++)
-                {
-                    sum += ptr[j];
-                }
-
-                sumptr[i] = sum;
-                ptr += w;
-            }
-        }
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float* sumptr = sum.row(q);
 
-            for (int i=0; i<h; i++)
-            {
-                float sum = sumptr[i];
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] /= sum;
-                }
-
-                ptr += w;
-            }
-        }
+        softmax_args args = { &bottom_top_blob, &max, &sum };
+        parallel_for(channels, softmax_axis1_channel, &args, opt);
 
         return 0;
     }
@@ -354,86 +427,20 @@ int Softmax::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     if (dims == 3 && axis == 2)
     {
         int w = bottom_top_blob.w;
-        int h = bottom_top_blob.h;
         int channels = bottom_top_blob.c;
 
         Mat max;
         max.create(w, channels, elemsize, opt.workspace_allocator);
         if (max.empty())
             return -100;
-        max.fill(-FLT_MAX);
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_top_blob.channel(q);
-            float* maxptr = max.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (int j=0; j<w; j++)
-                {
-                    maxptr[j] = std::max(maxptr[j], ptr[j]);
-                }
-
-                ptr += w;
-            }
-        }
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float* maxptr = max.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] = exp(ptr[j] - maxptr[j]);
-                }
-
-                ptr += w;
-            }
-        }
 
         Mat sum;
         sum.create(w, channels, elemsize, opt.workspace_allocator);
         if (sum.empty())
             return -100;
-        sum.fill(0.f);
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_top_blob.channel(q);
-            float* sumptr = sum.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (int j=0; j<w; j++)
-                {
-                    sumptr[j] += ptr[j];
-                }
 
-                ptr += w;
-            }
-        }
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            float* ptr = bottom_top_blob.channel(q);
-            float* sumptr = sum.row(q);
-
-            for (int i=0; i<h; i++)
-            {
-                for (int j=0; j<w; j++)
-                {
-                    ptr[j] /= sumptr[j];
-                }
-
-                ptr += w;
-            }
-        }
+        softmax_args args = { &bottom_top_blob, &max, &sum };
+        parallel_for(channels, softmax_axis2_channel, &args, opt);
 
         return 0;
     }
@@ -34,6 +34,82 @@ int SPP::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for
+struct spp_args
+{
+    int pooling_type;
+    Mat* bottom_blob_bordered;
+    float* pyramid_ptr;
+    int outw;
+    int outh;
+    int stride_w;
+    int stride_h;
+    const int* space_ofs;
+    int maxk;
+};
+
+// pool the bins of one pyramid level for channel q
+static void spp_channel(int q, void* userdata)
+{
+    const spp_args* args = (const spp_args*)userdata;
+    Mat& bottom_blob_bordered = *args->bottom_blob_bordered;
+    const int* space_ofs = args->space_ofs;
+
+    const int outw = args->outw;
+    const int outh = args->outh;
+    const int stride_w = args->stride_w;
+    const int stride_h = args->stride_h;
+    const int maxk = args->maxk;
+
+    const Mat m(bottom_blob_bordered.w, bottom_blob_bordered.h, bottom_blob_bordered.channel(q));
+    float* outptr = args->pyramid_ptr + outh * outw * q;
+
+    if (args->pooling_type == SPP::PoolMethod_MAX)
+    {
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const float* sptr = m.row(i*stride_h) + j*stride_w;
+
+                float max = sptr[0];
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    float val = sptr[ space_ofs[k] ];
+                    max = std::max(max, val);
+                }
+
+                outptr[j] = max;
+            }
+
+            outptr += outw;
+        }
+    }
+    else if (args->pooling_type == SPP::PoolMethod_AVE)
+    {
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const float* sptr = m.row(i*stride_h) + j*stride_w;
+
+                float sum = 0;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    float val = sptr[ space_ofs[k] ];
+                    sum += val;
+                }
+
+                outptr[j] = sum / maxk;
+            }
+
+            outptr += outw;
+        }
+    }
+}
+
 int SPP::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     size_t elemsize = bottom_blob.elemsize;
@@ -103,64 +179,8 @@ int SPP::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
             }
         }
 
-        if (pooling_type == PoolMethod_MAX)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const Mat m(w, h, bottom_blob_bordered.channel(q));
-                float* outptr = pyramid_ptr + outh * outw * q;
-
-                for (int i = 0; i < outh; i++)
-                {
-                    for (int j = 0; j < outw; j++)
-                    {
-                        const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                        float max = sptr[0];
-
-                        for (int k = 0; k < maxk; k++)
-                        {
-                            float val = sptr[ space_ofs[k] ];
-                            max = std::max(max, val);
-                        }
-
-                        outptr[j] = max;
-                    }
-
-                    outptr += outw;
-                }
-            }
-        }
-        else if (pooling_type == PoolMethod_AVE)
-        {
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q=0; q<channels; q++)
-            {
-                const Mat m(w, h, bottom_blob_bordered.channel(q));
-                float* outptr = pyramid_ptr + outh * outw * q;
-
-                for (int i = 0; i < outh; i++)
-                {
-                    for (int j = 0; j < outw; j++)
-                    {
-                        const float* sptr = m.row(i*stride_h) + j*stride_w;
-
-                        float sum = 0;
-
-                        for (int k = 0; k < maxk; k++)
-                        {
-                            float val = sptr[ space_ofs[k] ];
-                            sum += val;
-                        }
-
-                        outptr[j] = sum / maxk;
-                    }
-
-                    outptr += outw;
-                }
-            }
-        }
+        spp_args args = { pooling_type, &bottom_blob_bordered, pyramid_ptr, outw, outh, stride_w, stride_h, space_ofs, maxk };
+        parallel_for(channels, spp_channel, &args, opt);
 
         pyramid_ptr += channels * outh * outw;
     }
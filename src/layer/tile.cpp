@@ -32,86 +32,107 @@ int Tile::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+// arguments of the loop body run by parallel_for
+struct tile_args
+{
+    const Tile* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// tile p of the channels for dim 0, channel q otherwise
+static void tile_channel(int q, void* userdata)
 {
+    const tile_args* args = (const tile_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int tiles = args->layer->tiles;
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
-    size_t elemsize = bottom_blob.elemsize;
 
-    if (dim == 0)
+    if (args->layer->dim == 0)
     {
-        top_blob.create(w, h, channels * tiles, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
         const float* ptr = bottom_blob;
         int size = bottom_blob.cstep * channels;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int p=0; p<tiles; p++)
+        float* outptr = top_blob.channel(q * channels);
+
+        for (int i=0; i<size; i++)
         {
-            float* outptr = top_blob.channel(p * channels);
+            outptr[i] = ptr[i];
+        }
+    }
+    else if (args->layer->dim == 1)
+    {
+        int size = w * h;
+
+        const float* ptr = bottom_blob.channel(q);
+        float* outptr = top_blob.channel(q);
 
+        for (int p=0; p<tiles; p++)
+        {
             for (int i=0; i<size; i++)
             {
                 outptr[i] = ptr[i];
             }
+
+            outptr += size;
         }
     }
-    else if (dim == 1)
+    else if (args->layer->dim == 2)
     {
-        top_blob.create(w, h * tiles, channels, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        const float* ptr = bottom_blob.channel(q);
+        float* outptr = top_blob.channel(q);
 
-        int size = w * h;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
+        for (int i = 0; i < h; i++)
         {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-
             for (int p=0; p<tiles; p++)
             {
-                for (int i=0; i<size; i++)
+                for (int j = 0; j < w; j++)
                 {
-                    outptr[i] = ptr[i];
+                    outptr[j] = ptr[j];
                 }
 
-                outptr += size;
+                outptr += w;
             }
+
+            ptr += w;
         }
     }
+}
+
+int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+
+    if (dim == 0)
+    {
+        top_blob.create(w, h, channels * tiles, elemsize, opt.blob_allocator);
+    }
+    else if (dim == 1)
+    {
+        top_blob.create(w, h * tiles, channels, elemsize, opt.blob_allocator);
+    }
     else if (dim == 2)
     {
         top_blob.create(w * tiles, h, channels, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const float* ptr = bottom_blob.channel(q);
-            float* outptr = top_blob.channel(q);
-
-            for (int i = 0; i < h; i++)
-            {
-                for (int p=0; p<tiles; p++)
-                {
-                    for (int j = 0; j < w; j++)
-                    {
-                        outptr[j] = ptr[j];
-                    }
+    }
+    else
+    {
+        return 0;
+    }
 
-                    outptr += w;
-                }
+    if (top_blob.empty())
+        return -100;
 
-                ptr += w;
-            }
-        }
-    }
+    tile_args args = { this, &bottom_blob, &top_blob };
+    parallel_for(dim == 0 ? tiles : channels, tile_channel, &args, opt);
 
     return 0;
 }
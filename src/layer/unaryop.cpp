@@ -33,18 +33,40 @@ int UnaryOp::load_param(const ParamDict& pd)
     return 0;
 }
 
+// arguments of the loop body run by parallel_for_2d
+struct unary_op_args
+{
+    Mat* a;
+};
+
+// a vec is split into single element rows
 template<typename Op>
-static int unary_op_inplace(Mat& a, const Option& opt)
+static void unary_op_rows(int q, int y0, int y1, void* userdata)
 {
+    const unary_op_args* args = (const unary_op_args*)userdata;
+    Mat& a = *args->a;
+
     Op op;
 
-    int size = a.total();
+    const int w = a.dims == 1 ? 1 : a.w;
+
+    float* ptr = a.channel(q);
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int i=0; i<size; i++)
+    for (int i=y0 * w; i<y1 * w; i++)
     {
-        a[i] = op(a[i]);
+        ptr[i] = op(ptr[i]);
     }
+}
+
+template<typename Op>
+static int unary_op_inplace(Mat& a, const Option& opt)
+{
+    unary_op_args args = { &a };
+
+    if (a.dims == 1)
+        parallel_for_2d(1, a.w, unary_op_rows<Op>, &args, opt);
+    else
+        parallel_for_2d(a.c, a.h, unary_op_rows<Op>, &args, opt);
 
     return 0;
 }
@@ -12,202 +12,220 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
-static void conv1x1s1_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+static void conv1x1s1_sse_outch(int p, int y0, int y1, void* userdata)
 {
+    const conv_sse_args* args = (const conv_sse_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Mat& _kernel = *args->kernel;
+    const Mat& _bias = *args->bias;
+
     int inch = bottom_blob.c;
 
     int outw = top_blob.w;
-    int outh = top_blob.h;
-    int outch = top_blob.c;
 
     const float* kernel = _kernel;
     const float* bias = _bias;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<outch; p++)
-    {
-        Mat out = top_blob.channel(p);
+    Mat out = top_blob.channel(p);
 
-        const float bias0 = bias ? bias[p] : 0.f;
+    const float bias0 = bias ? bias[p] : 0.f;
 
-        out.fill(bias0);
+    out.row_range(y0, y1 - y0).fill(bias0);
 
-        int q = 0;
-
-        for (; q+3<inch; q+=4)
-        {
-            float* outptr = out;
+    int q = 0;
 
-            const float* img0 = bottom_blob.channel(q);
-            const float* img1 = bottom_blob.channel(q+1);
-            const float* img2 = bottom_blob.channel(q+2);
-            const float* img3 = bottom_blob.channel(q+3);
+    for (; q+3<inch; q+=4)
+    {
+        float* outptr = out.row(y0);
 
-            const float* kernel0 = kernel + p*inch  + q;
-            const float k0 = kernel0[0];
-            const float k1 = kernel0[1];
-            const float k2 = kernel0[2];
-            const float k3 = kernel0[3];
+        const float* img0 = bottom_blob.channel(q);
+        const float* img1 = bottom_blob.channel(q+1);
+        const float* img2 = bottom_blob.channel(q+2);
+        const float* img3 = bottom_blob.channel(q+3);
 
-            const float* r0 = img0;
-            const float* r1 = img1;
-            const float* r2 = img2;
-            const float* r3 = img3;
+        const float* kernel0 = kernel + p*inch  + q;
+        const float k0 = kernel0[0];
+        const float k1 = kernel0[1];
+        const float k2 = kernel0[2];
+        const float k3 = kernel0[3];
 
-            int size = outw * outh;
+        const float* r0 = img0 + outw*y0;
+        const float* r1 = img1 + outw*y0;
+        const float* r2 = img2 + outw*y0;
+        const float* r3 = img3 + outw*y0;
 
-            int remain = size;
+        int size = outw * (y1 - y0);
 
-            for (; remain>0; remain--)
-            {
-                float sum = *r0 * k0;
-                float sum1 = *r1 * k1;
-                float sum2 = *r2 * k2;
-                float sum3 = *r3 * k3;
-
-                *outptr += sum + sum1 + sum2 + sum3;
-
-                r0++;
-                r1++;
-                r2++;
-                r3++;
-                outptr++;
-            }
+        int remain = size;
 
+        for (; remain>0; remain--)
+        {
+            float sum = *r0 * k0;
+            float sum1 = *r1 * k1;
+            float sum2 = *r2 * k2;
+            float sum3 = *r3 * k3;
+
+            *outptr += sum + sum1 + sum2 + sum3;
+
+            r0++;
+            r1++;
+            r2++;
+            r3++;
+            outptr++;
         }
 
-        for (; q<inch; q++)
-        {
-            float* outptr = out;
+    }
 
-            const float* img0 = bottom_blob.channel(q);
+    for (; q<inch; q++)
+    {
+        float* outptr = out.row(y0);
 
-            const float* kernel0 = kernel + p*inch  + q;
-            const float k0 = kernel0[0];
+        const float* img0 = bottom_blob.channel(q);
 
-            const float* r0 = img0;
+        const float* kernel0 = kernel + p*inch  + q;
+        const float k0 = kernel0[0];
 
-            int size = outw * outh;
+        const float* r0 = img0 + outw*y0;
 
-            int remain = size;
+        int size = outw * (y1 - y0);
 
-            for (; remain>0; remain--)
-            {
-                float sum = *r0 * k0;
+        int remain = size;
 
-                *outptr += sum;
+        for (; remain>0; remain--)
+        {
+            float sum = *r0 * k0;
 
-                r0++;
-                outptr++;
-            }
+            *outptr += sum;
 
+            r0++;
+            outptr++;
         }
+
     }
+}
+
+static int conv1x1s1_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+{
+    int outch = top_blob.c;
 
+    conv_sse_args args = { &bottom_blob, &top_blob, &_kernel, &_bias };
+    parallel_for_2d(outch, top_blob.h, conv1x1s1_sse_outch, &args, opt, 1, top_blob.w * sizeof(float));
+
+    return 0;
 }
 
-static void conv1x1s2_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+static void conv1x1s2_sse_outch(int p, int y0, int y1, void* userdata)
 {
+    const conv_sse_args* args = (const conv_sse_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Mat& _kernel = *args->kernel;
+    const Mat& _bias = *args->bias;
+
     int w = bottom_blob.w;
     int inch = bottom_blob.c;
 
     int outw = top_blob.w;
-    int outh = top_blob.h;
-    int outch = top_blob.c;
 
     const int tailstep = w - 2*outw + w;
 
     const float* kernel = _kernel;
     const float* bias = _bias;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<outch; p++)
-    {
-        Mat out = top_blob.channel(p);
+    Mat out = top_blob.channel(p);
 
-        const float bias0 = bias ? bias[p] : 0.f;
+    const float bias0 = bias ? bias[p] : 0.f;
 
-        out.fill(bias0);
+    out.row_range(y0, y1 - y0).fill(bias0);
 
-        int q = 0;
+    int q = 0;
 
-        for (; q+3<inch; q+=4)
-        {
-            float* outptr = out;
+    for (; q+3<inch; q+=4)
+    {
+        float* outptr = out.row(y0);
+
+        const float* img0 = bottom_blob.channel(q);
+        const float* img1 = bottom_blob.channel(q+1);
+        const float* img2 = bottom_blob.channel(q+2);
+        const float* img3 = bottom_blob.channel(q+3);
 
-            const float* img0 = bottom_blob.channel(q);
-            const float* img1 = bottom_blob.channel(q+1);
-            const float* img2 = bottom_blob.channel(q+2);
-            const float* img3 = bottom_blob.channel(q+3);
+        const float* kernel0 = kernel + p*inch + q;
+        const float k0 = kernel0[0];
+        const float k1 = kernel0[1];
+        const float k2 = kernel0[2];
+        const float k3 = kernel0[3];
 
-            const float* kernel0 = kernel + p*inch + q;
-            const float k0 = kernel0[0];
-            const float k1 = kernel0[1];
-            const float k2 = kernel0[2];
-            const float k3 = kernel0[3];
+        const float* r0 = img0 + w*2*y0;
+        const float* r1 = img1 + w*2*y0;
+        const float* r2 = img2 + w*2*y0;
+        const float* r3 = img3 + w*2*y0;
 
-            const float* r0 = img0;
-            const float* r1 = img1;
-            const float* r2 = img2;
-            const float* r3 = img3;
+        for (int i = y0; i < y1; i++)
+        {
+            int remain = outw;
 
-            for (int i = 0; i < outh; i++)
+            for (; remain>0; remain--)
             {
-                int remain = outw;
-
-                for (; remain>0; remain--)
-                {
-                    float sum = *r0 * k0;
-                    float sum1 = *r1 * k1;
-                    float sum2 = *r2 * k2;
-                    float sum3 = *r3 * k3;
-
-                    *outptr += sum + sum1 + sum2 + sum3;
-
-                    r0 += 2;
-                    r1 += 2;
-                    r2 += 2;
-                    r3 += 2;
-                    outptr++;
-                }
-
-                r0 += tailstep;
-                r1 += tailstep;
-                r2 += tailstep;
-                r3 += tailstep;
+                float sum = *r0 * k0;
+                float sum1 = *r1 * k1;
+                float sum2 = *r2 * k2;
+                float sum3 = *r3 * k3;
+
+                *outptr += sum + sum1 + sum2 + sum3;
+
+                r0 += 2;
+                r1 += 2;
+                r2 += 2;
+                r3 += 2;
+                outptr++;
             }
 
+            r0 += tailstep;
+            r1 += tailstep;
+            r2 += tailstep;
+            r3 += tailstep;
         }
 
-        for (; q<inch; q++)
-        {
-            float* outptr = out;
+    }
 
-            const float* img0 = bottom_blob.channel(q);
+    for (; q<inch; q++)
+    {
+        float* outptr = out.row(y0);
 
-            const float* kernel0 = kernel + p*inch + q;
-            const float k0 = kernel0[0];
+        const float* img0 = bottom_blob.channel(q);
 
-            const float* r0 = img0;
+        const float* kernel0 = kernel + p*inch + q;
+        const float k0 = kernel0[0];
 
-            for (int i = 0; i < outh; i++)
-            {
-                int remain = outw;
+        const float* r0 = img0 + w*2*y0;
 
-                for (; remain>0; remain--)
-                {
-                    float sum = *r0 * k0;
+        for (int i = y0; i < y1; i++)
+        {
+            int remain = outw;
 
-                    *outptr += sum;
+            for (; remain>0; remain--)
+            {
+                float sum = *r0 * k0;
 
-                    r0 += 2;
-                    outptr++;
-                }
+                *outptr += sum;
 
-                r0 += tailstep;
+                r0 += 2;
+                outptr++;
             }
 
+            r0 += tailstep;
         }
+
     }
+}
+
+static int conv1x1s2_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+{
+    int outch = top_blob.c;
+
+    conv_sse_args args = { &bottom_blob, &top_blob, &_kernel, &_bias };
+    parallel_for_2d(outch, top_blob.h, conv1x1s2_sse_outch, &args, opt, 1, top_blob.w * sizeof(float));
 
+    return 0;
 }
@@ -12,129 +12,138 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
-static void conv3x3s1_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+static void conv3x3s1_sse_outch(int p, int y0, int y1, void* userdata)
 {
+    const conv_sse_args* args = (const conv_sse_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Mat& _kernel = *args->kernel;
+    const Mat& _bias = *args->bias;
+
     int w = bottom_blob.w;
     int inch = bottom_blob.c;
 
     int outw = top_blob.w;
-    int outh = top_blob.h;
-    int outch = top_blob.c;
 
     const float* kernel = _kernel;
     const float* bias = _bias;
 
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int p=0; p<outch; p++)
-    {
-        Mat out = top_blob.channel(p);
+    Mat out = top_blob.channel(p);
 
-        const float bias0 = bias ? bias[p] : 0.f;
+    const float bias0 = bias ? bias[p] : 0.f;
 
-        out.fill(bias0);
+    out.row_range(y0, y1 - y0).fill(bias0);
 
-        for (int q=0; q<inch; q++)
-        {
-            float* outptr = out;
-            float* outptr2 = outptr + outw;
+    for (int q=0; q<inch; q++)
+    {
+        float* outptr = out.row(y0);
+        float* outptr2 = outptr + outw;
 
-            const float* img0 = bottom_blob.channel(q);
+        const float* img0 = bottom_blob.channel(q);
 
-            const float* kernel0 = kernel + p*inch*9  + q*9;
+        const float* kernel0 = kernel + p*inch*9  + q*9;
 
-            const float* r0 = img0;
-            const float* r1 = img0 + w;
-            const float* r2 = img0 + w*2;
-            const float* r3 = img0 + w*3;
+        const float* r0 = img0 + w*y0;
+        const float* r1 = img0 + w*(y0 + 1);
+        const float* r2 = img0 + w*(y0 + 2);
+        const float* r3 = img0 + w*(y0 + 3);
 
-            const float* k0 = kernel0;
-            const float* k1 = kernel0 + 3;
-            const float* k2 = kernel0 + 6;
+        const float* k0 = kernel0;
+        const float* k1 = kernel0 + 3;
+        const float* k2 = kernel0 + 6;
 
-            int i = 0;
+        int i = y0;
 
-            for (; i+1 < outh; i+=2)
-            {
+        for (; i+1 < y1; i+=2)
+        {
+
+            int remain = outw;
 
-                int remain = outw;
-
-                for (; remain>0; remain--)
-                {
-                    float sum = 0;
-                    float sum2 = 0;
-
-                    sum += r0[0] * k0[0];
-                    sum += r0[1] * k0[1];
-                    sum += r0[2] * k0[2];
-                    sum += r1[0] * k1[0];
-                    sum += r1[1] * k1[1];
-                    sum += r1[2] * k1[2];
-                    sum += r2[0] * k2[0];
-                    sum += r2[1] * k2[1];
-                    sum += r2[2] * k2[2];
-
-                    sum2 += r1[0] * k0[0];
-                    sum2 += r1[1] * k0[1];
-                    sum2 += r1[2] * k0[2];
-                    sum2 += r2[0] * k1[0];
-                    sum2 += r2[1] * k1[1];
-                    sum2 += r2[2] * k1[2];
-                    sum2 += r3[0] * k2[0];
-                    sum2 += r3[1] * k2[1];
-                    sum2 += r3[2] * k2[2];
-
-                    *outptr += sum;
-                    *outptr2 += sum2;
-
-                    r0++;
-                    r1++;
-                    r2++;
-                    r3++;
-                    outptr++;
-                    outptr2++;
-                }
-
-                r0 += 2 + w;
-                r1 += 2 + w;
-                r2 += 2 + w;
-                r3 += 2 + w;
-
-                outptr += outw;
-                outptr2 += outw;
+            for (; remain>0; remain--)
+            {
+                float sum = 0;
+                float sum2 = 0;
+
+                sum += r0[0] * k0[0];
+                sum += r0[1] * k0[1];
+                sum += r0[2] * k0[2];
+                sum += r1[0] * k1[0];
+                sum += r1[1] * k1[1];
+                sum += r1[2] * k1[2];
+                sum += r2[0] * k2[0];
+                sum += r2[1] * k2[1];
+                sum += r2[2] * k2[2];
+
+                sum2 += r1[0] * k0[0];
+                sum2 += r1[1] * k0[1];
+                sum2 += r1[2] * k0[2];
+                sum2 += r2[0] * k1[0];
+                sum2 += r2[1] * k1[1];
+                sum2 += r2[2] * k1[2];
+                sum2 += r3[0] * k2[0];
+                sum2 += r3[1] * k2[1];
+                sum2 += r3[2] * k2[2];
+
+                *outptr += sum;
+                *outptr2 += sum2;
+
+                r0++;
+                r1++;
+                r2++;
+                r3++;
+                outptr++;
+                outptr2++;
             }
 
-            for (; i < outh; i++)
+            r0 += 2 + w;
+            r1 += 2 + w;
+            r2 += 2 + w;
+            r3 += 2 + w;
+
+            outptr += outw;
+            outptr2 += outw;
+        }
+
+        for (; i < y1; i++)
+        {
+            int remain = outw;
+
+            for (; remain>0; remain--)
             {
-                int remain = outw;
-
-                for (; remain>0; remain--)
-                {
-                    float sum = 0;
-
-                    sum += r0[0] * k0[0];
-                    sum += r0[1] * k0[1];
-                    sum += r0[2] * k0[2];
-                    sum += r1[0] * k1[0];
-                    sum += r1[1] * k1[1];
-                    sum += r1[2] * k1[2];
-                    sum += r2[0] * k2[0];
-                    sum += r2[1] * k2[1];
-                    sum += r2[2] * k2[2];
-
-                    *outptr += sum;
-
-                    r0++;
-                    r1++;
-                    r2++;
-                    outptr++;
-                }
-
-                r0 += 2;
-                r1 += 2;
-                r2 += 2;
+                float sum = 0;
+
+                sum += r0[0] * k0[0];
+                sum += r0[1] * k0[1];
+                sum += r0[2] * k0[2];
+                sum += r1[0] * k1[0];
+                sum += r1[1] * k1[1];
+                sum += r1[2] * k1[2];
+                sum += r2[0] * k2[0];
+                sum += r2[1] * k2[1];
+                sum += r2[2] * k2[2];
+
+                *outptr += sum;
+
+                r0++;
+                r1++;
+                r2++;
+                outptr++;
             }
 
+            r0 += 2;
+            r1 += 2;
+            r2 += 2;
         }
+
     }
+}
+
+static int conv3x3s1_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Option& opt)
+{
+    int outch = top_blob.c;
+
+    conv_sse_args args = { &bottom_blob, &top_blob, &_kernel, &_bias };
+    parallel_for_2d(outch, top_blob.h, conv3x3s1_sse_outch, &args, opt, 2, top_blob.w * sizeof(float));
 
+    return 0;
 }
@@ -0,0 +1,430 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// direct convolution for large square kernels, shared by the 5x5 and 7x7 kernels
+//
+// four output channels are computed together over a tile of pixels of one output row,
+// the sums stay in registers for the whole input channel and kernel loop
+// stride 2 input is deinterleaved first, even columns then odd columns of each row,
+// so every tap reads contiguous pixels
+
+// arguments of the direct loop body run by parallel_for_2d
+struct conv_direct_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    // see conv_direct_transform_kernel_sse
+    const Mat* kernel_tm;
+    const Mat* bias;
+    int kernel_size;
+    int stride;
+    // offset of the odd columns in a deinterleaved row, 0 for stride 1
+    int odd_offset;
+};
+
+#if __AVX2__
+// a * b + c, fused only when the target has fma
+static inline __m256 conv_direct_fmadd_avx(__m256 _a, __m256 _b, __m256 _c)
+{
+#if __FMA__
+    return _mm256_fmadd_ps(_a, _b, _c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(_a, _b), _c);
+#endif // __FMA__
+}
+#endif // __AVX2__
+
+static void conv_direct_sse_block(int b, int y0, int y1, void* userdata)
+{
+    const conv_direct_args* args = (const conv_direct_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+
+    const int w = bottom_blob.w;
+    const int inch = bottom_blob.c;
+    const size_t cstep = bottom_blob.cstep;
+
+    const int outw = top_blob.w;
+    const int outch = top_blob.c;
+
+    const int kernel_size = args->kernel_size;
+    const int stride = args->stride;
+    const int maxk = kernel_size * kernel_size;
+
+    // offset of each tap from the output pixel in the (deinterleaved) row
+    int tap_offset[7];
+    for (int kx = 0; kx < kernel_size; kx++)
+    {
+        tap_offset[kx] = stride == 1 ? kx : (kx & 1) ? args->odd_offset + kx / 2 : kx / 2;
+    }
+
+    const float* bias = *args->bias;
+
+    const int nn_outch = outch >> 2;
+
+    if (b < nn_outch)
+    {
+        const int p = b * 4;
+
+        const float bias0 = bias ? bias[p] : 0.f;
+        const float bias1 = bias ? bias[p+1] : 0.f;
+        const float bias2 = bias ? bias[p+2] : 0.f;
+        const float bias3 = bias ? bias[p+3] : 0.f;
+
+        const float* kernel0 = (const float*)args->kernel_tm->data + b * inch * maxk * 4;
+
+        for (int i = y0; i < y1; i++)
+        {
+            float* outptr0 = top_blob.channel(p).row(i);
+            float* outptr1 = top_blob.channel(p+1).row(i);
+            float* outptr2 = top_blob.channel(p+2).row(i);
+            float* outptr3 = top_blob.channel(p+3).row(i);
+
+            int j0 = 0;
+#if __AVX2__
+            for (; j0 + 15 < outw; j0 += 16)
+            {
+                __m256 _sum00 = _mm256_set1_ps(bias0);
+                __m256 _sum01 = _sum00;
+                __m256 _sum10 = _mm256_set1_ps(bias1);
+                __m256 _sum11 = _sum10;
+                __m256 _sum20 = _mm256_set1_ps(bias2);
+                __m256 _sum21 = _sum20;
+                __m256 _sum30 = _mm256_set1_ps(bias3);
+                __m256 _sum31 = _sum30;
+
+                const float* kptr = kernel0;
+
+                for (int q = 0; q < inch; q++)
+                {
+                    const float* img = (const float*)bottom_blob.data + cstep * q + w * i * stride;
+
+                    for (int ky = 0; ky < kernel_size; ky++)
+                    {
+                        const float* row = img + w * ky;
+
+                        for (int kx = 0; kx < kernel_size; kx++)
+                        {
+                            const float* r = row + tap_offset[kx] + j0;
+
+                            __m256 _r0 = _mm256_loadu_ps(r);
+                            __m256 _r1 = _mm256_loadu_ps(r + 8);
+
+                            __m256 _k0 = _mm256_broadcast_ss(kptr);
+                            __m256 _k1 = _mm256_broadcast_ss(kptr + 1);
+                            __m256 _k2 = _mm256_broadcast_ss(kptr + 2);
+                            __m256 _k3 = _mm256_broadcast_ss(kptr + 3);
+
+                            _sum00 = conv_direct_fmadd_avx(_r0, _k0, _sum00);
+                            _sum01 = conv_direct_fmadd_avx(_r1, _k0, _sum01);
+                            _sum10 = conv_direct_fmadd_avx(_r0, _k1, _sum10);
+                            _sum11 = conv_direct_fmadd_avx(_r1, _k1, _sum11);
+                            _sum20 = conv_direct_fmadd_avx(_r0, _k2, _sum20);
+                            _sum21 = conv_direct_fmadd_avx(_r1, _k2, _sum21);
+                            _sum30 = conv_direct_fmadd_avx(_r0, _k3, _sum30);
+                            _sum31 = conv_direct_fmadd_avx(_r1, _k3, _sum31);
+
+                            kptr += 4;
+                        }
+                    }
+                }
+
+                _mm256_storeu_ps(outptr0 + j0, _sum00);
+                _mm256_storeu_ps(outptr0 + j0 + 8, _sum01);
+                _mm256_storeu_ps(outptr1 + j0, _sum10);
+                _mm256_storeu_ps(outptr1 + j0 + 8, _sum11);
+                _mm256_storeu_ps(outptr2 + j0, _sum20);
+                _mm256_storeu_ps(outptr2 + j0 + 8, _sum21);
+                _mm256_storeu_ps(outptr3 + j0, _sum30);
+                _mm256_storeu_ps(outptr3 + j0 + 8, _sum31);
+            }
+#endif // __AVX2__
+#if __SSE2__
+            for (; j0 + 7 < outw; j0 += 8)
+            {
+                __m128 _sum00 = _mm_set1_ps(bias0);
+                __m128 _sum01 = _sum00;
+                __m128 _sum10 = _mm_set1_ps(bias1);
+                __m128 _sum11 = _sum10;
+                __m128 _sum20 = _mm_set1_ps(bias2);
+                __m128 _sum21 = _sum20;
+                __m128 _sum30 = _mm_set1_ps(bias3);
+                __m128 _sum31 = _sum30;
+
+                const float* kptr = kernel0;
+
+                for (int q = 0; q < inch; q++)
+                {
+                    const float* img = (const float*)bottom_blob.data + cstep * q + w * i * stride;
+
+                    for (int ky = 0; ky < kernel_size; ky++)
+                    {
+                        const float* row = img + w * ky;
+
+                        for (int kx = 0; kx < kernel_size; kx++)
+                        {
+                            const float* r = row + tap_offset[kx] + j0;
+
+                            __m128 _r0 = _mm_loadu_ps(r);
+                            __m128 _r1 = _mm_loadu_ps(r + 4);
+
+                            __m128 _k0 = _mm_set1_ps(kptr[0]);
+                            __m128 _k1 = _mm_set1_ps(kptr[1]);
+                            __m128 _k2 = _mm_set1_ps(kptr[2]);
+                            __m128 _k3 = _mm_set1_ps(kptr[3]);
+
+                            _sum00 = _mm_add_ps(_sum00, _mm_mul_ps(_r0, _k0));
+                            _sum01 = _mm_add_ps(_sum01, _mm_mul_ps(_r1, _k0));
+                            _sum10 = _mm_add_ps(_sum10, _mm_mul_ps(_r0, _k1));
+                            _sum11 = _mm_add_ps(_sum11, _mm_mul_ps(_r1, _k1));
+                            _sum20 = _mm_add_ps(_sum20, _mm_mul_ps(_r0, _k2));
+                            _sum21 = _mm_add_ps(_sum21, _mm_mul_ps(_r1, _k2));
+                            _sum30 = _mm_add_ps(_sum30, _mm_mul_ps(_r0, _k3));
+                            _sum31 = _mm_add_ps(_sum31, _mm_mul_ps(_r1, _k3));
+
+                            kptr += 4;
+                        }
+                    }
+                }
+
+                _mm_storeu_ps(outptr0 + j0, _sum00);
+                _mm_storeu_ps(outptr0 + j0 + 4, _sum01);
+                _mm_storeu_ps(outptr1 + j0, _sum10);
+                _mm_storeu_ps(outptr1 + j0 + 4, _sum11);
+                _mm_storeu_ps(outptr2 + j0, _sum20);
+                _mm_storeu_ps(outptr2 + j0 + 4, _sum21);
+                _mm_storeu_ps(outptr3 + j0, _sum30);
+                _mm_storeu_ps(outptr3 + j0 + 4, _sum31);
+            }
+#endif // __SSE2__
+            for (; j0 < outw; j0++)
+            {
+                float sum0 = bias0;
+                float sum1 = bias1;
+                float sum2 = bias2;
+                float sum3 = bias3;
+
+                const float* kptr = kernel0;
+
+                for (int q = 0; q < inch; q++)
+                {
+                    const float* img = (const float*)bottom_blob.data + cstep * q + w * i * stride;
+
+                    for (int ky = 0; ky < kernel_size; ky++)
+                    {
+                        const float* row = img + w * ky;
+
+                        for (int kx = 0; kx < kernel_size; kx++)
+                        {
+                            const float r = row[tap_offset[kx] + j0];
+
+                            sum0 += r * kptr[0];
+                            sum1 += r * kptr[1];
+                            sum2 += r * kptr[2];
+                            sum3 += r * kptr[3];
+
+                            kptr += 4;
+                        }
+                    }
+                }
+
+                outptr0[j0] = sum0;
+                outptr1[j0] = sum1;
+                outptr2[j0] = sum2;
+                outptr3[j0] = sum3;
+            }
+        }
+
+        return;
+    }
+
+    // remaining output channels one by one
+    const int p = nn_outch * 4 + b - nn_outch;
+
+    const float bias0 = bias ? bias[p] : 0.f;
+
+    const float* kernel0 = (const float*)args->kernel_tm->data + p * inch * maxk;
+
+    for (int i = y0; i < y1; i++)
+    {
+        float* outptr = top_blob.channel(p).row(i);
+
+        int j0 = 0;
+#if __SSE2__
+        for (; j0 + 7 < outw; j0 += 8)
+        {
+            __m128 _sum0 = _mm_set1_ps(bias0);
+            __m128 _sum1 = _sum0;
+
+            const float* kptr = kernel0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                const float* img = (const float*)bottom_blob.data + cstep * q + w * i * stride;
+
+                for (int ky = 0; ky < kernel_size; ky++)
+                {
+                    const float* row = img + w * ky;
+
+                    for (int kx = 0; kx < kernel_size; kx++)
+                    {
+                        const float* r = row + tap_offset[kx] + j0;
+
+                        __m128 _k = _mm_set1_ps(kptr[0]);
+
+                        _sum0 = _mm_add_ps(_sum0, _mm_mul_ps(_mm_loadu_ps(r), _k));
+                        _sum1 = _mm_add_ps(_sum1, _mm_mul_ps(_mm_loadu_ps(r + 4), _k));
+
+                        kptr++;
+                    }
+                }
+            }
+
+            _mm_storeu_ps(outptr + j0, _sum0);
+            _mm_storeu_ps(outptr + j0 + 4, _sum1);
+        }
+#endif // __SSE2__
+        for (; j0 < outw; j0++)
+        {
+            float sum = bias0;
+
+            const float* kptr = kernel0;
+
+            for (int q = 0; q < inch; q++)
+            {
+                const float* img = (const float*)bottom_blob.data + cstep * q + w * i * stride;
+
+                for (int ky = 0; ky < kernel_size; ky++)
+                {
+                    const float* row = img + w * ky;
+
+                    for (int kx = 0; kx < kernel_size; kx++)
+                    {
+                        sum += row[tap_offset[kx] + j0] * kptr[0];
+
+                        kptr++;
+                    }
+                }
+            }
+
+            outptr[j0] = sum;
+        }
+    }
+}
+
+// arguments of the deinterleave loop body run by parallel_for
+struct conv_direct_deinterleave_args
+{
+    const Mat* bottom_blob;
+    Mat* bottom_blob_tm;
+};
+
+static void conv_direct_deinterleave_channel(int q, void* userdata)
+{
+    const conv_direct_deinterleave_args* args = (const conv_direct_deinterleave_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& bottom_blob_tm = *args->bottom_blob_tm;
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int odd_offset = (w + 1) / 2;
+
+    const Mat img = bottom_blob.channel(q);
+    Mat img_tm = bottom_blob_tm.channel(q);
+
+    for (int i = 0; i < h; i++)
+    {
+        const float* r = img.row(i);
+        float* even = img_tm.row(i);
+        float* odd = even + odd_offset;
+
+        for (int j = 0; j < w / 2; j++)
+        {
+            even[j] = r[j * 2];
+            odd[j] = r[j * 2 + 1];
+        }
+        if (w & 1)
+        {
+            even[w / 2] = r[w - 1];
+        }
+    }
+}
+
+// 4 output channel blocks first, weight of tap k of input channel q at [q][k][4]
+// the remaining output channels follow in the original layout
+static int conv_direct_transform_kernel_sse(const Mat& _kernel, Mat& kernel_tm, int inch, int outch, int kernel_size, Allocator* allocator)
+{
+    const int maxk = kernel_size * kernel_size;
+
+    const int nn_outch = outch >> 2;
+
+    kernel_tm.create(outch * inch * maxk, 4u, allocator);
+    if (kernel_tm.empty())
+        return -100;
+
+    for (int b = 0; b < nn_outch; b++)
+    {
+        float* ktm = (float*)kernel_tm.data + b * inch * maxk * 4;
+
+        for (int q = 0; q < inch; q++)
+        {
+            for (int k = 0; k < maxk; k++)
+            {
+                for (int u = 0; u < 4; u++)
+                {
+                    ktm[(q * maxk + k) * 4 + u] = _kernel[((b * 4 + u) * inch + q) * maxk + k];
+                }
+            }
+        }
+    }
+
+    for (int i = nn_outch * 4 * inch * maxk; i < outch * inch * maxk; i++)
+    {
+        kernel_tm[i] = _kernel[i];
+    }
+
+    return 0;
+}
+
+static int conv_direct_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& kernel_tm, const Mat& _bias, int kernel_size, int stride, const Option& opt)
+{
+    const int inch = bottom_blob.c;
+    const int outch = top_blob.c;
+
+    const int nn_outch = outch >> 2;
+    const int remain_outch = outch - nn_outch * 4;
+
+    Mat bottom_blob_tm;
+    int odd_offset = 0;
+    if (stride == 1)
+    {
+        bottom_blob_tm = bottom_blob;
+    }
+    else
+    {
+        bottom_blob_tm.create(bottom_blob.w, bottom_blob.h, inch, (size_t)4u, opt.workspace_allocator);
+        if (bottom_blob_tm.empty())
+            return -100;
+
+        conv_direct_deinterleave_args dargs = { &bottom_blob, &bottom_blob_tm };
+        parallel_for(inch, conv_direct_deinterleave_channel, &dargs, opt);
+
+        odd_offset = (bottom_blob.w + 1) / 2;
+    }
+
+    conv_direct_args args = { &bottom_blob_tm, &top_blob, &kernel_tm, &_bias, kernel_size, stride, odd_offset };
+    parallel_for_2d(nn_outch + remain_outch, top_blob.h, conv_direct_sse_block, &args, opt);
+
+    return 0;
+}
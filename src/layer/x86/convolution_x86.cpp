@@ -14,119 +14,170 @@
 
 #include "convolution_x86.h"
 
+#include <stdio.h>
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#if __AVX2__
+#include <immintrin.h>
+#endif // __AVX2__
+#include "autotune.h"
+
 namespace ncnn {
 
+// arguments of the kernel loop bodies run by parallel_for
+struct conv_sse_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    const Mat* kernel;
+    const Mat* bias;
+};
+
 #include "convolution_1x1.h"
 #include "convolution_3x3.h"
+#include "convolution_direct.h"
 #include "convolution_5x5.h"
+#include "convolution_7x7.h"
 
 #include "convolution_1x1_int8.h"
 #include "convolution_3x3_int8.h"
 
 DEFINE_LAYER_CREATOR(Convolution_x86)
 
-int Convolution_x86::forwardDilation(const Mat& bottom_blob, Mat& top_blob, conv_func conv, const Option& opt) const
+// kernel_size x stride
+static const conv_func conv_func_table[7][5] =
 {
-    int w = bottom_blob.w;
-    int h = bottom_blob.h;
-    size_t elemsize = bottom_blob.elemsize;
+    {
+        conv1x1s1_sse,
+        conv1x1s2_sse,
+        0,
+        0,
+        0
+    }, // kernel_size = 1
+    {
+        0,
+        0,
+        0,
+        0,
+        0
+    }, // kernel_size = 2
+    {
+        conv3x3s1_sse,
+        0,
+        0,
+        0,
+        0
+    }, // kernel_size = 3
+    {
+        0,
+        0,
+        0,
+        0,
+        0
+    }, // kernel_size = 4
+    {
+        conv5x5s1_sse,
+        conv5x5s2_sse,
+        0,
+        0,
+        0
+    }, // kernel_size = 5
+    {
+        0,
+        0,
+        0,
+        0,
+        0
+    }, // kernel_size = 6
+    {
+        conv7x7s1_sse,
+        conv7x7s2_sse,
+        0,
+        0,
+        0
+    }  // kernel_size = 7
+};
+
+// the sse kernel of the layer, null if it runs the generic convolution
+static conv_func get_conv_sse_func(const Convolution_x86* layer)
+{
+    if (layer->kernel_w != layer->kernel_h || layer->stride_w != layer->stride_h)
+        return 0;
 
-    const int kernel_size = kernel_w;
-    const int stride = stride_w;
-    const int dilation = dilation_w;
-    const int kernel_extent = dilation * (kernel_size - 1) + 1;
+    if (layer->kernel_w > 7 || layer->stride_w > 5)
+        return 0;
 
-    Mat bottom_blob_bordered = bottom_blob;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_make_border(bottom_blob, bottom_blob_bordered, pad_h, pad_h, pad_w, pad_w, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-        if (bottom_blob_bordered.empty())
-            return -100;
+    // dilation is handled natively by the generic im2col
+    if (layer->dilation_w != 1 || layer->dilation_h != 1)
+        return 0;
 
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
-    else if (pad_w == -233 && pad_h == -233)
+    return conv_func_table[layer->kernel_w-1][layer->stride_w-1];
+}
+
+int Convolution_x86::load_model(const ModelBin& mb)
+{
+    int ret = Convolution::load_model(mb);
+    if (ret != 0)
+        return ret;
+
+    if (use_int8_inference)
+        return 0;
+
+    // the 5x5 and 7x7 direct kernels read 4 output channels interleaved
+    conv_func conv = get_conv_sse_func(this);
+    if (conv && (kernel_w == 5 || kernel_w == 7))
     {
-        int wpad = kernel_extent + (w - 1) / stride * stride - w;
-        int hpad = kernel_extent + (h - 1) / stride * stride - h;
-        if (wpad > 0 || hpad > 0)
+        // a container may have given back the transformed kernel already
+        if (weight_direct_data.empty() || (int)weight_direct_data.total() != weight_data_size)
         {
-            copy_make_border(bottom_blob, bottom_blob_bordered, hpad / 2, hpad - hpad / 2, wpad / 2, wpad - wpad / 2, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-            if (bottom_blob_bordered.empty())
-                return -100;
+            int num_input = weight_data_size / (kernel_w * kernel_h) / num_output;
+            ret = conv_direct_transform_kernel_sse(weight_data, weight_direct_data, num_input, num_output, kernel_w, mb.weight_allocator());
         }
 
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
+        // the generic convolution only runs as an autotune candidate then
+        if (ret == 0 && !get_default_option().autotune_cache)
+            weight_data.release();
     }
 
-    int outw = (w - kernel_extent) / stride + 1;
-    int outh = (h - kernel_extent) / stride + 1;
-
-    top_blob.create(outw, outh, num_output, elemsize, opt.blob_allocator);
-    if (top_blob.empty())
-        return -100;
+    return ret;
+}
 
-    // Make (dilation * dilation) batches
-    Mat inner_bottom_blob;
-    Mat inner_top_blob;
-    for (int x = 0; x < dilation; x ++)
-    {
-        for (int y = 0; y < dilation; y ++)
-        {
-            int inner_w = (w - y + dilation - 1) / dilation;
-            int inner_h = (h - x + dilation - 1) / dilation;
+void Convolution_x86::transformed_weights(std::vector<Mat*>& mats)
+{
+    mats.push_back(&weight_direct_data);
+}
 
-            int inner_outw = (inner_w - kernel_size) / stride + 1;
-            int inner_outh = (inner_h - kernel_size) / stride + 1;
+// arguments of the algorithm runs timed by autotune
+struct convolution_autotune_args
+{
+    const Convolution_x86* layer;
+    const Mat* bottom_blob;
+    Mat* top_blob;
+};
+
+// 0 = sse kernel chosen by kernel size and stride
+// 1 = generic convolution
+static int convolution_x86_run(int algo, const Option& opt, void* userdata)
+{
+    const convolution_autotune_args* args = (const convolution_autotune_args*)userdata;
+    const Convolution_x86* layer = args->layer;
 
-            inner_bottom_blob.create(inner_w, inner_h, bottom_blob.c, elemsize, opt.workspace_allocator);
-            if (inner_bottom_blob.empty())
-                return -100;
+    Option opt_run = opt;
+    opt_run.autotune_cache = 0;
 
-            inner_top_blob.create(inner_outw, inner_outh, num_output, elemsize, opt.workspace_allocator);
-            if (inner_top_blob.empty())
-                return -100;
+    if (algo == 0)
+        return layer->forward(*args->bottom_blob, *args->top_blob, opt_run);
 
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int c = 0; c < bottom_blob.c; c ++)
-            {
-                float *outptr = inner_bottom_blob.channel(c);
-
-                for (int i = 0; i < inner_h; i ++)
-                {
-                    const float* ptr = (const float *)bottom_blob_bordered.channel(c) + dilation * i * w + x * w + y;
-                    for (int j = 0; j < inner_w; j ++)
-                    {
-                        outptr[j] = ptr[j*dilation];
-                    }
-                    outptr += inner_w;
-                }
-            }
+    // nothing to choose from when the sse path falls back to the generic one anyway
+    if (!get_conv_sse_func(layer))
+        return -1;
 
-            ncnn::Option opt_g = opt;
-            opt_g.blob_allocator = inner_top_blob.allocator;
-            conv(inner_bottom_blob, inner_top_blob, weight_data, bias_data, opt_g);
-
-            #pragma omp parallel for num_threads(opt.num_threads)
-            for (int c = 0; c < num_output; c ++)
-            {
-                float *outptr = (float *)top_blob.channel(c) + x * outw + y;
-                for (int i = 0; i < inner_outh; i ++)
-                {
-                    const float* ptr = (const float *)inner_top_blob.channel(c) + i * inner_outw;
-                    for (int j = 0; j < inner_outw; j ++)
-                    {
-                        outptr[j*dilation] = ptr[j];
-                    }
-                    outptr += dilation * outw;
-                }
-            }
-        }
-    }
+    // weight_data released after the direct kernel transform
+    if (layer->weight_data.empty())
+        return -1;
 
-    return 0;
+    return layer->Convolution::forward(*args->bottom_blob, *args->top_blob, opt_run);
 }
 
 int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
@@ -136,9 +187,28 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
 
     if (bottom_blob.dims != 3)
     {
+        // weight_data released after the direct kernel transform, run it on a single channel image
+        if (weight_data.empty())
+            return forward(bottom_blob.reshape(bottom_blob.w, bottom_blob.h, 1), top_blob, opt);
+
         return Convolution::forward(bottom_blob, top_blob, opt);
     }
 
+    if (opt.autotune_cache && !use_int8_inference)
+    {
+        char signature[256];
+        sprintf(signature, "Convolution %d %dx%d %dx%d %dx%d %dx%d %dx%dx%d t%d",
+                num_output, kernel_w, kernel_h, stride_w, stride_h, dilation_w, dilation_h, pad_w, pad_h,
+                bottom_blob.w, bottom_blob.h, bottom_blob.c, opt.num_threads);
+
+        convolution_autotune_args args = { this, &bottom_blob, &top_blob };
+
+        Option opt_tuned;
+        int algo = autotune(signature, 2, convolution_x86_run, &args, opt, opt_tuned);
+        if (algo != -1)
+            return convolution_x86_run(algo, opt_tuned, &args);
+    }
+
     if (kernel_w != kernel_h || stride_w != stride_h)
     {
         return Convolution::forward(bottom_blob, top_blob, opt);
@@ -147,19 +217,20 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     const int kernel_size = kernel_w;
     const int stride = stride_w;
 
-    if (kernel_size > 5 || stride > 5 || dilation_w != dilation_h)
+    // the generic im2col handles dilation natively
+    if (kernel_size > 7 || stride > 5 || dilation_w != 1 || dilation_h != 1)
     {
         return Convolution::forward(bottom_blob, top_blob, opt);
     }
 
-    typedef void (*conv_func)(const Mat&, Mat&, const Mat&, const Mat&, const Option&);
+    typedef void (*conv_int8_func)(const Mat&, Mat&, const Mat&, const Option&);
 
     // kernel_size x stride
-    conv_func conv_func_table[5][5] =
+    conv_int8_func conv_int8_func_table[7][5] =
     {
         {
-            conv1x1s1_sse,
-            conv1x1s2_sse,
+            conv1x1s1_int8_sse,
+            conv1x1s2_int8_sse,
             0,
             0,
             0
@@ -172,8 +243,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
             0
         }, // kernel_size = 2
         {
-            conv3x3s1_sse,
-            0,
+            conv3x3s1_int8_sse,
+            conv3x3s2_int8_sse,
             0,
             0,
             0
@@ -186,54 +257,26 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
             0
         }, // kernel_size = 4
         {
-            conv5x5s1_sse,
             0,
             0,
             0,
-            0
-        }  // kernel_size = 5
-    };
-
-    typedef void (*conv_int8_func)(const Mat&, Mat&, const Mat&, const Option&);
-
-    // kernel_size x stride
-    conv_int8_func conv_int8_func_table[5][5] =
-    {
-        {
-            conv1x1s1_int8_sse,
-            conv1x1s2_int8_sse,
-            0,
-            0,
-            0
-        }, // kernel_size = 1
-        {
-            0,
-            0,
-            0,
-            0,
-            0
-        }, // kernel_size = 2
-        {
-            conv3x3s1_int8_sse,
-            conv3x3s2_int8_sse,
-            0,
             0,
             0
-        }, // kernel_size = 3
+        }, // kernel_size = 5
         {
             0,
             0,
             0,
             0,
             0
-        }, // kernel_size = 4
+        }, // kernel_size = 6
         {
             0,
             0,
             0,
             0,
             0
-        }  // kernel_size = 5
+        }  // kernel_size = 7
     };
 
     conv_func conv = 0;
@@ -254,14 +297,6 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         {
             return Convolution::forward(bottom_blob, top_blob, opt);
         }
-
-        if (dilation_w != 1)
-        {
-            if (stride != 1)
-                return Convolution::forward(bottom_blob, top_blob, opt);
-
-            return forwardDilation(bottom_blob, top_blob, conv, opt);
-        }
     }
 
     int w = bottom_blob.w;
@@ -335,9 +370,9 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         return 0;
     }
 
-    conv(bottom_blob_bordered, top_blob, weight_data, bias_data, opt);
+    const Mat& kernel = (kernel_size == 5 || kernel_size == 7) ? weight_direct_data : weight_data;
 
-    return 0;
+    return conv(bottom_blob_bordered, top_blob, kernel, bias_data, opt);
 }
 
 } // namespace ncnn
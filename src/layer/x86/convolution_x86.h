@@ -19,13 +19,19 @@
 
 namespace ncnn {
 
-typedef void (*conv_func)(const Mat&, Mat&, const Mat&, const Mat&, const Option&);
+typedef int (*conv_func)(const Mat&, Mat&, const Mat&, const Mat&, const Option&);
 
 class Convolution_x86 : public Convolution
 {
 public:
+    virtual int load_model(const ModelBin& mb);
+
+    virtual void transformed_weights(std::vector<Mat*>& mats);
+
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
-    virtual int forwardDilation(const Mat& bottom_blob, Mat &top_blob, conv_func conv, const Option& opt) const;
+
+public:
+    Mat weight_direct_data;
 };
 
 } // namespace ncnn
@@ -0,0 +1,294 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// depth-wise direct convolution for 3x3 and 5x5 kernels at stride 1 and 2
+//
+// a tile of pixels of one output row is summed in registers over all taps,
+// then bias and activation are applied on the way out, in the same pass
+// stride 2 taps pick the even pixels of two loads with a shuffle
+
+#if __SSE2__
+static inline void convdw_store_sse(float* outptr, __m128 _v, int activation_type, const float* activation_params)
+{
+    if (activation_type == 1)
+    {
+        _v = _mm_max_ps(_v, _mm_setzero_ps());
+    }
+    else if (activation_type == 2)
+    {
+        __m128 _zero = _mm_setzero_ps();
+        __m128 _slope = _mm_set1_ps(activation_params[0]);
+        _v = _mm_add_ps(_mm_max_ps(_v, _zero), _mm_mul_ps(_mm_min_ps(_v, _zero), _slope));
+    }
+    else if (activation_type == 3)
+    {
+        _v = _mm_min_ps(_mm_max_ps(_v, _mm_set1_ps(activation_params[0])), _mm_set1_ps(activation_params[1]));
+    }
+
+    _mm_storeu_ps(outptr, _v);
+
+    if (activation_type == 4)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            outptr[c] = activation_ss(outptr[c], activation_type, activation_params);
+        }
+    }
+}
+#endif // __SSE2__
+
+#if __AVX2__
+// a * b + c, fused only when the target has fma
+static inline __m256 convdw_fmadd_avx(__m256 _a, __m256 _b, __m256 _c)
+{
+#if __FMA__
+    return _mm256_fmadd_ps(_a, _b, _c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(_a, _b), _c);
+#endif // __FMA__
+}
+
+static inline void convdw_store_avx(float* outptr, __m256 _v, int activation_type, const float* activation_params)
+{
+    if (activation_type == 1)
+    {
+        _v = _mm256_max_ps(_v, _mm256_setzero_ps());
+    }
+    else if (activation_type == 2)
+    {
+        __m256 _zero = _mm256_setzero_ps();
+        __m256 _slope = _mm256_set1_ps(activation_params[0]);
+        _v = convdw_fmadd_avx(_mm256_min_ps(_v, _zero), _slope, _mm256_max_ps(_v, _zero));
+    }
+    else if (activation_type == 3)
+    {
+        _v = _mm256_min_ps(_mm256_max_ps(_v, _mm256_set1_ps(activation_params[0])), _mm256_set1_ps(activation_params[1]));
+    }
+
+    _mm256_storeu_ps(outptr, _v);
+
+    if (activation_type == 4)
+    {
+        for (int c = 0; c < 8; c++)
+        {
+            outptr[c] = activation_ss(outptr[c], activation_type, activation_params);
+        }
+    }
+}
+#endif // __AVX2__
+
+// input rows [row0, row0 + nrows) of a channel deinterleaved to even columns then odd columns
+template<typename T>
+static void convdw_deinterleave_rows(const T* img0, int w, int row0, int nrows, std::vector<T>& rows)
+{
+    const int odd_offset = (w + 1) / 2;
+
+    rows.resize(nrows * w);
+
+    for (int i = 0; i < nrows; i++)
+    {
+        const T* r = img0 + w * (row0 + i);
+        T* even = &rows[i * w];
+        T* odd = even + odd_offset;
+
+        for (int j = 0; j < w / 2; j++)
+        {
+            even[j] = r[j * 2];
+            odd[j] = r[j * 2 + 1];
+        }
+        if (w & 1)
+        {
+            even[w / 2] = r[w - 1];
+        }
+    }
+}
+
+// offset of each tap from the output pixel in the (deinterleaved) row
+static void convdw_tap_offset(int kernel_size, int stride, int w, int* tap_offset)
+{
+    const int odd_offset = (w + 1) / 2;
+
+    for (int kx = 0; kx < kernel_size; kx++)
+    {
+        tap_offset[kx] = stride == 1 ? kx : (kx & 1) ? odd_offset + kx / 2 : kx / 2;
+    }
+}
+
+// arguments of the direct kernel loop bodies run by parallel_for_2d
+struct convdw_direct_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    const Mat* kernel;
+    const Mat* bias;
+    int stride;
+    int activation_type;
+    const float* activation_params;
+    // int8 only, per channel
+    const Mat* weight_int8_scales;
+    const Mat* bottom_int8_scales;
+};
+
+#if __SSE2__
+// 4 pixels at stride apart, stride 2 picks the even ones of 8
+template<int stride>
+static inline __m128 convdw_load_sse(const float* ptr)
+{
+    if (stride == 1)
+        return _mm_loadu_ps(ptr);
+
+    return _mm_shuffle_ps(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4), _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif // __SSE2__
+
+#if __AVX2__
+// 8 pixels at stride apart, stride 2 picks the even ones of 16
+template<int stride>
+static inline __m256 convdw_load_avx(const float* ptr)
+{
+    if (stride == 1)
+        return _mm256_loadu_ps(ptr);
+
+    __m256 _even = _mm256_shuffle_ps(_mm256_loadu_ps(ptr), _mm256_loadu_ps(ptr + 8), _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_even), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+#endif // __AVX2__
+
+template<int kernel_size, int stride>
+static void convdw_direct_sse_group(int g, int y0, int y1, void* userdata)
+{
+    const convdw_direct_args* args = (const convdw_direct_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Mat& _kernel = *args->kernel;
+    const Mat& _bias = *args->bias;
+
+    const int maxk = kernel_size * kernel_size;
+    const int activation_type = args->activation_type;
+    const float* activation_params = args->activation_params;
+
+    int w = bottom_blob.w;
+
+    int outw = top_blob.w;
+
+    const float* kernel = _kernel;
+    const float* bias = _bias;
+
+    Mat out = top_blob.channel(g);
+
+    const float bias0 = bias ? bias[g] : 0.f;
+
+    const float* kernel0 = kernel + g*maxk;
+
+    const float* img0 = bottom_blob.channel(g);
+
+    // the last stride 2 load reads one pixel past the row, which is still inside the mat
+    for (int i = y0; i < y1; i++)
+    {
+        float* outptr = out.row(i);
+
+        const float* r0 = img0 + w * (i * stride);
+
+        int j = 0;
+#if __AVX2__
+        for (; j + 15 < outw; j += 16)
+        {
+            __m256 _sum0 = _mm256_set1_ps(bias0);
+            __m256 _sum1 = _sum0;
+
+            const float* r = r0 + j * stride;
+            const float* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    __m256 _k = _mm256_broadcast_ss(kptr + kx);
+
+                    _sum0 = convdw_fmadd_avx(convdw_load_avx<stride>(r + kx), _k, _sum0);
+                    _sum1 = convdw_fmadd_avx(convdw_load_avx<stride>(r + kx + 8 * stride), _k, _sum1);
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            convdw_store_avx(outptr + j, _sum0, activation_type, activation_params);
+            convdw_store_avx(outptr + j + 8, _sum1, activation_type, activation_params);
+        }
+#endif // __AVX2__
+#if __SSE2__
+        for (; j + 7 < outw; j += 8)
+        {
+            __m128 _sum0 = _mm_set1_ps(bias0);
+            __m128 _sum1 = _sum0;
+
+            const float* r = r0 + j * stride;
+            const float* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    __m128 _k = _mm_set1_ps(kptr[kx]);
+
+                    _sum0 = _mm_add_ps(_sum0, _mm_mul_ps(convdw_load_sse<stride>(r + kx), _k));
+                    _sum1 = _mm_add_ps(_sum1, _mm_mul_ps(convdw_load_sse<stride>(r + kx + 4 * stride), _k));
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            convdw_store_sse(outptr + j, _sum0, activation_type, activation_params);
+            convdw_store_sse(outptr + j + 4, _sum1, activation_type, activation_params);
+        }
+#endif // __SSE2__
+        for (; j < outw; j++)
+        {
+            float sum = bias0;
+
+            const float* r = r0 + j * stride;
+            const float* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    sum += r[kx] * kptr[kx];
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            outptr[j] = activation_ss(sum, activation_type, activation_params);
+        }
+    }
+}
+
+static void convdw_direct_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, int kernel_size, int stride, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    const int group = bottom_blob.c;
+
+    convdw_direct_args args = { &bottom_blob, &top_blob, &_kernel, &_bias, stride, activation_type, activation_params, 0, 0 };
+    if (kernel_size == 3 && stride == 1)
+        parallel_for_2d(group, top_blob.h, convdw_direct_sse_group<3, 1>, &args, opt);
+    else if (kernel_size == 3 && stride == 2)
+        parallel_for_2d(group, top_blob.h, convdw_direct_sse_group<3, 2>, &args, opt);
+    else if (kernel_size == 5 && stride == 1)
+        parallel_for_2d(group, top_blob.h, convdw_direct_sse_group<5, 1>, &args, opt);
+    else
+        parallel_for_2d(group, top_blob.h, convdw_direct_sse_group<5, 2>, &args, opt);
+}
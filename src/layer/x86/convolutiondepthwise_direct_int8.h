@@ -0,0 +1,172 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// int8 depth-wise direct convolution, same scheme as the float kernel
+//
+// int8 products fit in int16 and are widened to int32 sums,
+// the sums are dequantized with the scales of their own channel,
+// then bias and activation are applied, all in one pass writing float output
+
+template<int kernel_size>
+static void convdw_direct_int8_sse_group(int g, int y0, int y1, void* userdata)
+{
+    const convdw_direct_args* args = (const convdw_direct_args*)userdata;
+    const Mat& bottom_blob = *args->bottom_blob;
+    Mat& top_blob = *args->top_blob;
+    const Mat& _kernel = *args->kernel;
+    const Mat& _bias = *args->bias;
+
+    const int stride = args->stride;
+    const int maxk = kernel_size * kernel_size;
+    const int activation_type = args->activation_type;
+    const float* activation_params = args->activation_params;
+
+    int w = bottom_blob.w;
+
+    int outw = top_blob.w;
+
+    const signed char* kernel = _kernel;
+    const float* bias = _bias;
+
+    Mat out = top_blob.channel(g);
+
+    const float bias0 = bias ? bias[g] : 0.f;
+    const float scale0 = 1.f / ((*args->bottom_int8_scales)[g] * (*args->weight_int8_scales)[g]);
+
+    const signed char* kernel0 = kernel + g*maxk;
+
+    const signed char* img0 = bottom_blob.channel(g);
+
+    std::vector<signed char> rows;
+    if (stride == 2)
+    {
+        const int row0 = y0 * 2;
+        convdw_deinterleave_rows(img0, w, row0, (y1 - 1 - y0) * 2 + kernel_size, rows);
+
+        img0 = &rows[0] - w * row0;
+    }
+
+    int tap_offset[5];
+    convdw_tap_offset(kernel_size, stride, w, tap_offset);
+
+    for (int i = y0; i < y1; i++)
+    {
+        float* outptr = out.row(i);
+
+        const signed char* r0 = img0 + w * (i * stride);
+
+        int j = 0;
+#if __AVX2__
+        for (; j + 15 < outw; j += 16)
+        {
+            __m256i _sum0 = _mm256_setzero_si256();
+            __m256i _sum1 = _mm256_setzero_si256();
+
+            const signed char* r = r0;
+            const signed char* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    const signed char* rx = r + tap_offset[kx] + j;
+
+                    __m256i _r = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)rx));
+                    __m256i _p = _mm256_mullo_epi16(_r, _mm256_set1_epi16(kptr[kx]));
+
+                    _sum0 = _mm256_add_epi32(_sum0, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(_p)));
+                    _sum1 = _mm256_add_epi32(_sum1, _mm256_cvtepi16_epi32(_mm256_extracti128_si256(_p, 1)));
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            __m256 _scale = _mm256_set1_ps(scale0);
+            __m256 _bias = _mm256_set1_ps(bias0);
+
+            convdw_store_avx(outptr + j, convdw_fmadd_avx(_mm256_cvtepi32_ps(_sum0), _scale, _bias), activation_type, activation_params);
+            convdw_store_avx(outptr + j + 8, convdw_fmadd_avx(_mm256_cvtepi32_ps(_sum1), _scale, _bias), activation_type, activation_params);
+        }
+#endif // __AVX2__
+#if __SSE2__
+        for (; j + 7 < outw; j += 8)
+        {
+            __m128i _sum0 = _mm_setzero_si128();
+            __m128i _sum1 = _mm_setzero_si128();
+
+            const signed char* r = r0;
+            const signed char* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    const signed char* rx = r + tap_offset[kx] + j;
+
+                    // sign extend 8 int8 to int16
+                    __m128i _r = _mm_loadl_epi64((const __m128i*)rx);
+                    _r = _mm_srai_epi16(_mm_unpacklo_epi8(_r, _r), 8);
+
+                    __m128i _p = _mm_mullo_epi16(_r, _mm_set1_epi16(kptr[kx]));
+
+                    // sign extend int16 products to int32
+                    _sum0 = _mm_add_epi32(_sum0, _mm_srai_epi32(_mm_unpacklo_epi16(_p, _p), 16));
+                    _sum1 = _mm_add_epi32(_sum1, _mm_srai_epi32(_mm_unpackhi_epi16(_p, _p), 16));
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            __m128 _scale = _mm_set1_ps(scale0);
+            __m128 _bias = _mm_set1_ps(bias0);
+
+            convdw_store_sse(outptr + j, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_sum0), _scale), _bias), activation_type, activation_params);
+            convdw_store_sse(outptr + j + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_sum1), _scale), _bias), activation_type, activation_params);
+        }
+#endif // __SSE2__
+        for (; j < outw; j++)
+        {
+            int sum = 0;
+
+            const signed char* r = r0;
+            const signed char* kptr = kernel0;
+
+            for (int ky = 0; ky < kernel_size; ky++)
+            {
+                for (int kx = 0; kx < kernel_size; kx++)
+                {
+                    sum += (int)r[tap_offset[kx] + j] * (int)kptr[kx];
+                }
+
+                r += w;
+                kptr += kernel_size;
+            }
+
+            outptr[j] = activation_ss(sum * scale0 + bias0, activation_type, activation_params);
+        }
+    }
+}
+
+static void convdw_direct_int8_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& _kernel, const Mat& _bias, const Mat& weight_int8_scales, const Mat& bottom_int8_scales, int kernel_size, int stride, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    const int group = bottom_blob.c;
+
+    convdw_direct_args args = { &bottom_blob, &top_blob, &_kernel, &_bias, stride, activation_type, activation_params, &weight_int8_scales, &bottom_int8_scales };
+    if (kernel_size == 3)
+        parallel_for_2d(group, top_blob.h, convdw_direct_int8_sse_group<3>, &args, opt);
+    else
+        parallel_for_2d(group, top_blob.h, convdw_direct_int8_sse_group<5>, &args, opt);
+}
@@ -17,14 +17,31 @@
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#if __AVX2__
+#include <immintrin.h>
+#endif // __AVX2__
 
 #include "layer_type.h"
+#include "fused_activation.h"
 
 namespace ncnn {
 
+// arguments of the kernel loop bodies run by parallel_for
+struct conv_sse_args
+{
+    const Mat* bottom_blob;
+    Mat* top_blob;
+    const Mat* kernel;
+    const Mat* bias;
+};
+
+#include "convolutiondepthwise_direct.h"
 #include "convolutiondepthwise_3x3.h"
 
-#include "convolutiondepthwise_3x3_int8.h"
+#include "convolutiondepthwise_direct_int8.h"
 
 DEFINE_LAYER_CREATOR(ConvolutionDepthWise_x86)
 
@@ -57,14 +74,8 @@ int ConvolutionDepthWise_x86::load_model(const ModelBin& mb)
 
     if (channels == group && group == num_output)
     {
-        // depth-wise specific
-        if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1)
-        {
-            if ((stride_w == 1 && stride_h == 1) || (stride_w == 2 && stride_h == 2))
-            {
-                return 0;
-            }
-        }
+        // depth-wise runs the sse kernels or the generic one, no group op
+        return 0;
     }
 
     const int channels_g = channels / group;
@@ -117,6 +128,33 @@ int ConvolutionDepthWise_x86::load_model(const ModelBin& mb)
     return 0;
 }
 
+// arguments of the int8 quantize loop body run by parallel_for
+struct convdw_quantize_args
+{
+    const ConvolutionDepthWise_x86* layer;
+    const Mat* bottom_blob;
+    Mat* bottom_blob_int8;
+    const Option* opt;
+};
+
+static void convdw_quantize_group(int g, void* userdata)
+{
+    const convdw_quantize_args* args = (const convdw_quantize_args*)userdata;
+    const ConvolutionDepthWise_x86* layer = args->layer;
+
+    const int channels_g = args->bottom_blob->c / layer->group;
+
+    // each group runs on one thread of the outer loop
+    ncnn::Option opt_g = *args->opt;
+    opt_g.num_threads = 1;
+    opt_g.thread_pool = 0;
+    opt_g.blob_allocator = args->bottom_blob_int8->allocator;
+
+    const Mat bottom_blob_g = layer->shuffle_group ? args->bottom_blob->channel_range(layer->bottom_channel(g), 1) : args->bottom_blob->channel_range(channels_g * g, channels_g);
+    Mat bottom_blob_int8_g = args->bottom_blob_int8->channel_range(channels_g * g, channels_g);
+    layer->quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
+}
+
 int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     // convolv with NxN kernel
@@ -133,9 +171,34 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         return -100;
     }
 
+    if (shuffle_group && (channels != group || channels % shuffle_group != 0))
+    {
+        // the fused shuffle is only gathered for depth-wise input
+        return -100;
+    }
+
+    // depth-wise without sse kernel runs the generic one, which handles any kernel size and dilation
+    if (channels == group && group == num_output)
+    {
+        bool sse_kernel = (kernel_w == 3 || kernel_w == 5) && kernel_h == kernel_w && ((stride_w == 1 && stride_h == 1) || (stride_w == 2 && stride_h == 2));
+
+        // only the float 3x3 kernel supports dilation
+        if (dilation_w != 1 || dilation_h != 1)
+        {
+            if (use_int8_inference || kernel_w != 3 || dilation_w != dilation_h)
+                sse_kernel = false;
+        }
+
+        if (!sse_kernel)
+            return ConvolutionDepthWise::forward(bottom_blob, top_blob, opt);
+    }
+
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
+    // channels of the fused shuffle are gathered once, by the quantize or padding copy
+    bool gather = shuffle_group != 0;
+
     Mat bottom_blob_unbordered = bottom_blob;
     if (use_int8_inference && elemsize != 1)
     {
@@ -144,53 +207,27 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         if (bottom_blob_int8.empty())
             return -100;
 
-        const int channels_g = channels / group;
-
         // quantize, scale and round to nearest
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
-        {
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = bottom_blob_int8.allocator;
-
-            const Mat bottom_blob_g = bottom_blob.channel_range(channels_g * g, channels_g);
-            Mat bottom_blob_int8_g = bottom_blob_int8.channel_range(channels_g * g, channels_g);
-            quantize_ops[g]->forward(bottom_blob_g, bottom_blob_int8_g, opt_g);
-        }
+        convdw_quantize_args args = { this, &bottom_blob, &bottom_blob_int8, &opt };
+        parallel_for(group, convdw_quantize_group, &args, opt);
 
         bottom_blob_unbordered = bottom_blob_int8;
+        gather = false;
     }
 
-    Mat bottom_blob_bordered = bottom_blob_unbordered;
-    if (pad_w > 0 || pad_h > 0)
-    {
-        copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, pad_h, pad_h, pad_w, pad_w, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-        if (bottom_blob_bordered.empty())
-            return -100;
-
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
-    else if (pad_w == -233 && pad_h == -233)
-    {
-        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
-        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
-        if (wpad > 0 || hpad > 0)
-        {
-            copy_make_border(bottom_blob_unbordered, bottom_blob_bordered, hpad / 2, hpad - hpad / 2, wpad / 2, wpad - wpad / 2, BORDER_CONSTANT, 0.f, opt.workspace_allocator, opt.num_threads);
-            if (bottom_blob_bordered.empty())
-                return -100;
-        }
+    Mat bottom_blob_bordered;
+    int ret = make_padding(bottom_blob_unbordered, bottom_blob_bordered, gather, opt);
+    if (ret != 0)
+        return ret;
 
-        w = bottom_blob_bordered.w;
-        h = bottom_blob_bordered.h;
-    }
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
 
     int outw = (w - kernel_extent_w) / stride_w + 1;
     int outh = (h - kernel_extent_h) / stride_h + 1;
 
-    top_blob.create(outw, outh, num_output, elemsize, opt.blob_allocator);
+    // int8 output is dequantized to float in the kernel
+    top_blob.create(outw, outh, num_output, use_int8_inference ? (size_t)4u : elemsize, opt.blob_allocator);
     if (top_blob.empty())
         return -100;
 
@@ -199,66 +236,15 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
     {
         if (use_int8_inference)
         {
-            if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1)
-            {
-                if ((stride_w == 1 && stride_h == 1) || (stride_w == 2 && stride_h == 2))
-                {
-                    if (stride_w == 1 && stride_h == 1)
-                    {
-                        convdw3x3s1_int8_sse(bottom_blob_bordered, top_blob, weight_data, opt);
-                    }
-                    else if (stride_w == 2 && stride_h == 2)
-                    {
-                        convdw3x3s2_int8_sse(bottom_blob_bordered, top_blob, weight_data, opt);
-                    }
-
-                    // dequantize, reverse scale inplace
-                    #pragma omp parallel for num_threads(opt.num_threads)
-                    for (int g=0; g<group; g++)
-                    {
-                        ncnn::Option opt_g = opt;
-                        opt_g.num_threads = 1;
-                        opt_g.blob_allocator = top_blob.allocator;
-
-                        Mat top_blob_g = top_blob.channel(g);
-                        dequantize_ops[g]->forward_inplace(top_blob_g, opt_g);
-                    }
-
-                    return 0;
-                }
-            }
+            convdw_direct_int8_sse(bottom_blob_bordered, top_blob, weight_data, bias_data, weight_data_int8_scales, bottom_blob_int8_scales, kernel_w, stride_w, activation_type, activation_params, opt);
         }
-        else
+        else if (dilation_w != 1)
         {
-            if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1)
-            {
-                if (stride_w == 1 && stride_h == 1)
-                {
-                    convdw3x3s1_sse(bottom_blob_bordered, top_blob, weight_data, bias_data, opt);
-                    return 0;
-                }
-                else if (stride_w == 2 && stride_h == 2)
-                {
-                    convdw3x3s2_sse(bottom_blob_bordered, top_blob, weight_data, bias_data, opt);
-                    return 0;
-                }
-            }
+            convdw3x3_dilation_sse(bottom_blob_bordered, top_blob, weight_data, bias_data, dilation_w, stride_w, activation_type, activation_params, opt);
         }
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int g=0; g<group; g++)
+        else
         {
-            const Mat bottom_blob_bordered_g = bottom_blob_bordered.channel_range(g, 1);
-            Mat top_blob_g = top_blob.channel_range(g, 1);
-
-            const ncnn::Layer* op = group_ops[g];
-
-            ncnn::Option opt_g = opt;
-            opt_g.num_threads = 1;
-            opt_g.blob_allocator = top_blob.allocator;
-
-            // forward
-            op->forward(bottom_blob_bordered_g, top_blob_g, opt_g);
+            convdw_direct_sse(bottom_blob_bordered, top_blob, weight_data, bias_data, kernel_w, stride_w, activation_type, activation_params, opt);
         }
 
         return 0;
@@ -281,6 +267,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         op->forward(bottom_blob_bordered_g, top_blob_g, opt_g);
     }
 
+    fused_activation_inplace(top_blob, activation_type, activation_params, opt);
+
     return 0;
 }
 
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <math.h>
 #include "layer_type.h"
+#include "nms.h"
 
 namespace ncnn {
 
@@ -51,119 +52,101 @@ int YoloDetectionOutput::load_param(const ParamDict& pd)
     return 0;
 }
 
-struct BBoxRect
-{
-    float xmin;
-    float ymin;
-    float xmax;
-    float ymax;
-    int label;
-};
-
-static inline float intersection_area(const BBoxRect& a, const BBoxRect& b)
+static inline float sigmoid(float x)
 {
-    if (a.xmin > b.xmax || a.xmax < b.xmin || a.ymin > b.ymax || a.ymax < b.ymin)
-    {
-        // no intersection
-        return 0.f;
-    }
-
-    float inter_width = std::min(a.xmax, b.xmax) - std::max(a.xmin, b.xmin);
-    float inter_height = std::min(a.ymax, b.ymax) - std::max(a.ymin, b.ymin);
-
-    return inter_width * inter_height;
+    return 1.f / (1.f + exp(-x));
 }
 
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right)
+// arguments of the loop body run by parallel_for
+struct yolodetectionoutput_args
 {
-    int i = left;
-    int j = right;
-    float p = scores[(left + right) / 2];
-
-    while (i <= j)
-    {
-        while (scores[i] > p)
-            i++;
-
-        while (scores[j] < p)
-            j--;
-
-        if (i <= j)
-        {
-            // swap
-            std::swap(datas[i], datas[j]);
-            std::swap(scores[i], scores[j]);
+    const YoloDetectionOutput* layer;
+    Mat* bottom_top_blob;
+    std::vector< std::vector<DetectionBox> >* all_box_bbox_rects;
+    const Option* opt;
+};
 
-            i++;
-            j--;
-        }
-    }
+// decode the region boxes of anchor pp
+static void yolodetectionoutput_box(int pp, void* userdata)
+{
+    const yolodetectionoutput_args* args = (const yolodetectionoutput_args*)userdata;
+    const YoloDetectionOutput* layer = args->layer;
+    Mat& bottom_top_blob = *args->bottom_top_blob;
 
-    if (left < j)
-        qsort_descent_inplace(datas, scores, left, j);
+    const int w = bottom_top_blob.w;
+    const int h = bottom_top_blob.h;
+    const int num_class = layer->num_class;
+    const float confidence_threshold = layer->confidence_threshold;
+    const int channels_per_box = bottom_top_blob.c / layer->num_box;
 
-    if (i < right)
-        qsort_descent_inplace(datas, scores, i, right);
-}
+    int p = pp * channels_per_box;
 
-template <typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores)
-{
-    if (datas.empty() || scores.empty())
-        return;
+    const float bias_w = layer->biases[pp*2];
+    const float bias_h = layer->biases[pp*2+1];
 
-    qsort_descent_inplace(datas, scores, 0, scores.size() - 1);
-}
+    const float* xptr = bottom_top_blob.channel(p);
+    const float* yptr = bottom_top_blob.channel(p+1);
+    const float* wptr = bottom_top_blob.channel(p+2);
+    const float* hptr = bottom_top_blob.channel(p+3);
 
-static void nms_sorted_bboxes(const std::vector<BBoxRect>& bboxes, std::vector<int>& picked, float nms_threshold)
-{
-    picked.clear();
+    const float* box_score_ptr = bottom_top_blob.channel(p+4);
 
-    const int n = bboxes.size();
+    // softmax class scores
+    Mat scores = bottom_top_blob.channel_range(p+5, num_class);
+    layer->softmax->forward_inplace(scores, *args->opt);
 
-    std::vector<float> areas(n);
-    for (int i = 0; i < n; i++)
+    for (int i = 0; i < h; i++)
     {
-        const BBoxRect& r = bboxes[i];
+        for (int j = 0; j < w; j++)
+        {
+            // region box
+            float bbox_cx = (j + sigmoid(xptr[0])) / w;
+            float bbox_cy = (i + sigmoid(yptr[0])) / h;
+            float bbox_w = exp(wptr[0]) * bias_w / w;
+            float bbox_h = exp(hptr[0]) * bias_h / h;
+
+            float bbox_xmin = bbox_cx - bbox_w * 0.5f;
+            float bbox_ymin = bbox_cy - bbox_h * 0.5f;
+            float bbox_xmax = bbox_cx + bbox_w * 0.5f;
+            float bbox_ymax = bbox_cy + bbox_h * 0.5f;
+
+            // box score
+            float box_score = sigmoid(box_score_ptr[0]);
+
+            // find class index with max class score
+            int class_index = 0;
+            float class_score = 0.f;
+            for (int q = 0; q < num_class; q++)
+            {
+                float score = scores.channel(q).row(i)[j];
+                if (score > class_score)
+                {
+                    class_index = q;
+                    class_score = score;
+                }
+            }
 
-        float width = r.xmax - r.xmin;
-        float height = r.ymax - r.ymin;
+//             fprintf(stderr, "%d %f %f\n", class_index, box_score, class_score);
 
-        areas[i] = width * height;
-    }
+            float confidence = box_score * class_score;
+            if (confidence >= confidence_threshold)
+            {
+                DetectionBox c = { bbox_xmin, bbox_ymin, bbox_xmax, bbox_ymax, confidence, class_index };
+                (*args->all_box_bbox_rects)[pp].push_back(c);
+            }
 
-    for (int i = 0; i < n; i++)
-    {
-        const BBoxRect& a = bboxes[i];
+            xptr++;
+            yptr++;
+            wptr++;
+            hptr++;
 
-        int keep = 1;
-        for (int j = 0; j < (int)picked.size(); j++)
-        {
-            const BBoxRect& b = bboxes[picked[j]];
-
-            // intersection over union
-            float inter_area = intersection_area(a, b);
-            float union_area = areas[i] + areas[picked[j]] - inter_area;
-//             float IoU = inter_area / union_area
-            if (inter_area / union_area > nms_threshold)
-                keep = 0;
+            box_score_ptr++;
         }
-
-        if (keep)
-            picked.push_back(i);
     }
 }
 
-static inline float sigmoid(float x)
-{
-    return 1.f / (1.f + exp(-x));
-}
-
 int YoloDetectionOutput::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    int w = bottom_top_blob.w;
-    int h = bottom_top_blob.h;
     int channels = bottom_top_blob.c;
 
     const int channels_per_box = channels / num_box;
@@ -172,111 +155,22 @@ int YoloDetectionOutput::forward_inplace(Mat& bottom_top_blob, const Option& opt
     if (channels_per_box != 4 + 1 + num_class)
         return -1;
 
-    std::vector< std::vector<BBoxRect> > all_box_bbox_rects;
-    std::vector< std::vector<float> > all_box_bbox_scores;
+    std::vector< std::vector<DetectionBox> > all_box_bbox_rects;
     all_box_bbox_rects.resize(num_box);
-    all_box_bbox_scores.resize(num_box);
-
-    #pragma omp parallel for num_threads(opt.num_threads)
-    for (int pp = 0; pp < num_box; pp++)
-    {
-        int p = pp * channels_per_box;
 
-        const float bias_w = biases[pp*2];
-        const float bias_h = biases[pp*2+1];
-
-        const float* xptr = bottom_top_blob.channel(p);
-        const float* yptr = bottom_top_blob.channel(p+1);
-        const float* wptr = bottom_top_blob.channel(p+2);
-        const float* hptr = bottom_top_blob.channel(p+3);
-
-        const float* box_score_ptr = bottom_top_blob.channel(p+4);
-
-        // softmax class scores
-        Mat scores = bottom_top_blob.channel_range(p+5, num_class);
-        softmax->forward_inplace(scores, opt);
-
-        for (int i = 0; i < h; i++)
-        {
-            for (int j = 0; j < w; j++)
-            {
-                // region box
-                float bbox_cx = (j + sigmoid(xptr[0])) / w;
-                float bbox_cy = (i + sigmoid(yptr[0])) / h;
-                float bbox_w = exp(wptr[0]) * bias_w / w;
-                float bbox_h = exp(hptr[0]) * bias_h / h;
-
-                float bbox_xmin = bbox_cx - bbox_w * 0.5f;
-                float bbox_ymin = bbox_cy - bbox_h * 0.5f;
-                float bbox_xmax = bbox_cx + bbox_w * 0.5f;
-                float bbox_ymax = bbox_cy + bbox_h * 0.5f;
-
-                // box score
-                float box_score = sigmoid(box_score_ptr[0]);
-
-                // find class index with max class score
-                int class_index = 0;
-                float class_score = 0.f;
-                for (int q = 0; q < num_class; q++)
-                {
-                    float score = scores.channel(q).row(i)[j];
-                    if (score > class_score)
-                    {
-                        class_index = q;
-                        class_score = score;
-                    }
-                }
-
-//                 fprintf(stderr, "%d %f %f\n", class_index, box_score, class_score);
-
-                float confidence = box_score * class_score;
-                if (confidence >= confidence_threshold)
-                {
-                    BBoxRect c = { bbox_xmin, bbox_ymin, bbox_xmax, bbox_ymax, class_index };
-                    all_box_bbox_rects[pp].push_back(c);
-                    all_box_bbox_scores[pp].push_back(confidence);
-                }
-
-                xptr++;
-                yptr++;
-                wptr++;
-                hptr++;
-
-                box_score_ptr++;
-            }
-        }
-    }
+    yolodetectionoutput_args args = { this, &bottom_top_blob, &all_box_bbox_rects, &opt };
+    parallel_for(num_box, yolodetectionoutput_box, &args, opt);
 
     // gather all box
-    std::vector<BBoxRect> all_bbox_rects;
-    std::vector<float> all_bbox_scores;
+    std::vector<DetectionBox> bbox_rects;
 
     for (int i = 0; i < num_box; i++)
     {
-        const std::vector<BBoxRect>& box_bbox_rects = all_box_bbox_rects[i];
-        const std::vector<float>& box_bbox_scores = all_box_bbox_scores[i];
-
-        all_bbox_rects.insert(all_bbox_rects.end(), box_bbox_rects.begin(), box_bbox_rects.end());
-        all_bbox_scores.insert(all_bbox_scores.end(), box_bbox_scores.begin(), box_bbox_scores.end());
+        bbox_rects.insert(bbox_rects.end(), all_box_bbox_rects[i].begin(), all_box_bbox_rects[i].end());
     }
 
-    // global sort inplace
-    qsort_descent_inplace(all_bbox_rects, all_bbox_scores);
-
-    // apply nms
-    std::vector<int> picked;
-    nms_sorted_bboxes(all_bbox_rects, picked, nms_threshold);
-
-    // select
-    std::vector<BBoxRect> bbox_rects;
-    std::vector<float> bbox_scores;
-
-    for (int i = 0; i < (int)picked.size(); i++)
-    {
-        int z = picked[i];
-        bbox_rects.push_back(all_bbox_rects[z]);
-        bbox_scores.push_back(all_bbox_scores[z]);
-    }
+    // global sort and nms
+    nms_topk(bbox_rects, nms_threshold, 0);
 
     // fill result
     int num_detected = bbox_rects.size();
@@ -287,12 +181,11 @@ int YoloDetectionOutput::forward_inplace(Mat& bottom_top_blob, const Option& opt
 
     for (int i = 0; i < num_detected; i++)
     {
-        const BBoxRect& r = bbox_rects[i];
-        float score = bbox_scores[i];
+        const DetectionBox& r = bbox_rects[i];
         float* outptr = bottom_top_blob.row(i);
 
         outptr[0] = r.label + 1;// +1 for prepend background class
-        outptr[1] = score;
+        outptr[1] = r.score;
         outptr[2] = r.xmin;
         outptr[3] = r.ymin;
         outptr[4] = r.xmax;
@@ -26,214 +26,240 @@
 
 namespace ncnn {
 
-void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_vals)
+// arguments of the loop bodies run by parallel_for
+struct substract_mean_normalize_args
 {
-    int size = w * h;
+    Mat* m;
+    const float* mean_vals;
+    const float* norm_vals;
+};
 
-    if (mean_vals && !norm_vals)
-    {
-        // substract mean only
-        #pragma omp parallel for
-        for (int q=0; q<c; q++)
-        {
-            float* ptr = channel(q);//data + cstep * q;
-            const float mean = mean_vals[q];
+// substract mean only
+static void substract_mean_channel(int q, void* userdata)
+{
+    const substract_mean_normalize_args* args = (const substract_mean_normalize_args*)userdata;
+    Mat& m = *args->m;
+
+    int size = m.w * m.h;
+
+    float* ptr = m.channel(q);//data + cstep * q;
+    const float mean = args->mean_vals[q];
 
 #if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-            if (nn > 0)
-            {
-            asm volatile(
-                "dup        v1.4s, %w4            \n"
-                "0:                               \n"
-                "prfm       pldl1keep, [%1, #128] \n"
-                "ld1        {v0.4s}, [%1]         \n"
-                "fsub       v0.4s, v0.4s, v1.4s   \n"
-                "subs       %w0, %w0, #1          \n"
-                "st1        {v0.4s}, [%1], #16    \n"
-                "bne        0b                    \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(mean)     // %4
-                : "cc", "memory", "v0", "v1"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "dup        v1.4s, %w4            \n"
+        "0:                               \n"
+        "prfm       pldl1keep, [%1, #128] \n"
+        "ld1        {v0.4s}, [%1]         \n"
+        "fsub       v0.4s, v0.4s, v1.4s   \n"
+        "subs       %w0, %w0, #1          \n"
+        "st1        {v0.4s}, [%1], #16    \n"
+        "bne        0b                    \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(mean)     // %4
+        : "cc", "memory", "v0", "v1"
+    );
+    }
 #else
-            if (nn > 0)
-            {
-            asm volatile(
-                "vdup.f32   q1, %4              \n"
-                "0:                             \n"
-                "pld        [%1, #128]          \n"
-                "vld1.f32   {d0-d1}, [%1 :128]  \n"
-                "vsub.f32   q0, q0, q1          \n"
-                "subs       %0, #1              \n"
-                "vst1.f32   {d0-d1}, [%1 :128]! \n"
-                "bne        0b                  \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(mean)     // %4
-                : "cc", "memory", "q0", "q1"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "vdup.f32   q1, %4              \n"
+        "0:                             \n"
+        "pld        [%1, #128]          \n"
+        "vld1.f32   {d0-d1}, [%1 :128]  \n"
+        "vsub.f32   q0, q0, q1          \n"
+        "subs       %0, #1              \n"
+        "vst1.f32   {d0-d1}, [%1 :128]! \n"
+        "bne        0b                  \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(mean)     // %4
+        : "cc", "memory", "q0", "q1"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-            for (; remain>0; remain--)
-            {
-                *ptr -= mean;
-                ptr++;
-            }
-        }
-    }
-    else if (!mean_vals && norm_vals)
+    for (; remain>0; remain--)
     {
-        // normalize only
-        #pragma omp parallel for
-        for (int q=0; q<c; q++)
-        {
-            float* ptr = channel(q);//data + cstep * q;
-            const float norm = norm_vals[q];
+        *ptr -= mean;
+        ptr++;
+    }
+}
+
+// normalize only
+static void normalize_channel(int q, void* userdata)
+{
+    const substract_mean_normalize_args* args = (const substract_mean_normalize_args*)userdata;
+    Mat& m = *args->m;
+
+    int size = m.w * m.h;
+
+    float* ptr = m.channel(q);//data + cstep * q;
+    const float norm = args->norm_vals[q];
 
 #if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-            if (nn > 0)
-            {
-            asm volatile(
-                "dup        v1.4s, %w4            \n"
-                "0:                               \n"
-                "prfm       pldl1keep, [%1, #128] \n"
-                "ld1        {v0.4s}, [%1]         \n"
-                "fmul       v0.4s, v0.4s, v1.4s   \n"
-                "subs       %w0, %w0, #1          \n"
-                "st1        {v0.4s}, [%1], #16    \n"
-                "bne        0b                    \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(norm)     // %4
-                : "cc", "memory", "v0", "v1"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "dup        v1.4s, %w4            \n"
+        "0:                               \n"
+        "prfm       pldl1keep, [%1, #128] \n"
+        "ld1        {v0.4s}, [%1]         \n"
+        "fmul       v0.4s, v0.4s, v1.4s   \n"
+        "subs       %w0, %w0, #1          \n"
+        "st1        {v0.4s}, [%1], #16    \n"
+        "bne        0b                    \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(norm)     // %4
+        : "cc", "memory", "v0", "v1"
+    );
+    }
 #else
-            if (nn > 0)
-            {
-            asm volatile(
-                "vdup.f32   q1, %4              \n"
-                "0:                             \n"
-                "pld        [%1, #128]          \n"
-                "vld1.f32   {d0-d1}, [%1 :128]  \n"
-                "vmul.f32   q0, q0, q1          \n"
-                "subs       %0, #1              \n"
-                "vst1.f32   {d0-d1}, [%1 :128]! \n"
-                "bne        0b                  \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(norm)     // %4
-                : "cc", "memory", "q0", "q1"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "vdup.f32   q1, %4              \n"
+        "0:                             \n"
+        "pld        [%1, #128]          \n"
+        "vld1.f32   {d0-d1}, [%1 :128]  \n"
+        "vmul.f32   q0, q0, q1          \n"
+        "subs       %0, #1              \n"
+        "vst1.f32   {d0-d1}, [%1 :128]! \n"
+        "bne        0b                  \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(norm)     // %4
+        : "cc", "memory", "q0", "q1"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-            for (; remain>0; remain--)
-            {
-                *ptr *= norm;
-                ptr++;
-            }
-        }
-    }
-    else if (mean_vals && norm_vals)
+    for (; remain>0; remain--)
     {
-        // substract mean and normalize
-        #pragma omp parallel for
-        for (int q=0; q<c; q++)
-        {
-            float* ptr = channel(q);//data + cstep * q;
-            const float mean = mean_vals[q];
-            const float norm = norm_vals[q];
+        *ptr *= norm;
+        ptr++;
+    }
+}
+
+// substract mean and normalize
+static void substract_mean_normalize_channel(int q, void* userdata)
+{
+    const substract_mean_normalize_args* args = (const substract_mean_normalize_args*)userdata;
+    Mat& m = *args->m;
+
+    int size = m.w * m.h;
+
+    float* ptr = m.channel(q);//data + cstep * q;
+    const float mean = args->mean_vals[q];
+    const float norm = args->norm_vals[q];
 
 #if __ARM_NEON
-            int nn = size >> 2;
-            int remain = size - (nn << 2);
+    int nn = size >> 2;
+    int remain = size - (nn << 2);
 #else
-            int remain = size;
+    int remain = size;
 #endif // __ARM_NEON
 
 #if __ARM_NEON
 #if __aarch64__
-            if (nn > 0)
-            {
-            asm volatile(
-                "dup        v1.4s, %w4            \n"
-                "dup        v2.4s, %w5            \n"
-                "0:                               \n"
-                "prfm       pldl1keep, [%1, #128] \n"
-                "ld1        {v0.4s}, [%1]         \n"
-                "fsub       v0.4s, v0.4s, v1.4s   \n"
-                "fmul       v0.4s, v0.4s, v2.4s   \n"
-                "subs       %w0, %w0, #1          \n"
-                "st1        {v0.4s}, [%1], #16    \n"
-                "bne        0b                    \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(mean),    // %4
-                  "r"(norm)     // %5
-                : "cc", "memory", "v0", "v1", "v2"
-            );  
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "dup        v1.4s, %w4            \n"
+        "dup        v2.4s, %w5            \n"
+        "0:                               \n"
+        "prfm       pldl1keep, [%1, #128] \n"
+        "ld1        {v0.4s}, [%1]         \n"
+        "fsub       v0.4s, v0.4s, v1.4s   \n"
+        "fmul       v0.4s, v0.4s, v2.4s   \n"
+        "subs       %w0, %w0, #1          \n"
+        "st1        {v0.4s}, [%1], #16    \n"
+        "bne        0b                    \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(mean),    // %4
+          "r"(norm)     // %5
+        : "cc", "memory", "v0", "v1", "v2"
+    );  
+    }
 #else
-            if (nn > 0)
-            {
-            asm volatile(
-                "vdup.f32   q1, %4              \n"
-                "vdup.f32   q2, %5              \n"
-                "0:                             \n"
-                "pld        [%1, #128]          \n"
-                "vld1.f32   {d0-d1}, [%1 :128]  \n"
-                "vsub.f32   q0, q0, q1          \n"
-                "vmul.f32   q0, q0, q2          \n"
-                "subs       %0, #1              \n"
-                "vst1.f32   {d0-d1}, [%1 :128]! \n"
-                "bne        0b                  \n"
-                : "=r"(nn),     // %0
-                  "=r"(ptr)     // %1
-                : "0"(nn),
-                  "1"(ptr),
-                  "r"(mean),    // %4
-                  "r"(norm)     // %5
-                : "cc", "memory", "q0", "q1", "q2"
-            );
-            }
+    if (nn > 0)
+    {
+    asm volatile(
+        "vdup.f32   q1, %4              \n"
+        "vdup.f32   q2, %5              \n"
+        "0:                             \n"
+        "pld        [%1, #128]          \n"
+        "vld1.f32   {d0-d1}, [%1 :128]  \n"
+        "vsub.f32   q0, q0, q1          \n"
+        "vmul.f32   q0, q0, q2          \n"
+        "subs       %0, #1              \n"
+        "vst1.f32   {d0-d1}, [%1 :128]! \n"
+        "bne        0b                  \n"
+        : "=r"(nn),     // %0
+          "=r"(ptr)     // %1
+        : "0"(nn),
+          "1"(ptr),
+          "r"(mean),    // %4
+          "r"(norm)     // %5
+        : "cc", "memory", "q0", "q1", "q2"
+    );
+    }
 #endif // __aarch64__
 #endif // __ARM_NEON
-            for (; remain>0; remain--)
-            {
-                *ptr = (*ptr - mean) * norm;
-                ptr++;
-            }
-        }
+    for (; remain>0; remain--)
+    {
+        *ptr = (*ptr - mean) * norm;
+        ptr++;
+    }
+}
+
+void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_vals)
+{
+    substract_mean_normalize_args args = { this, mean_vals, norm_vals };
+
+    if (mean_vals && !norm_vals)
+    {
+        parallel_for(c, substract_mean_channel, &args, get_default_option());
+    }
+    else if (!mean_vals && norm_vals)
+    {
+        parallel_for(c, normalize_channel, &args, get_default_option());
+    }
+    else if (mean_vals && norm_vals)
+    {
+        parallel_for(c, substract_mean_normalize_channel, &args, get_default_option());
     }
 }
 
@@ -289,9 +315,9 @@ static float half2float(unsigned short value)
     return tmp.f;
 }
 
-Mat Mat::from_float16(const unsigned short* data, int size)
+Mat Mat::from_float16(const unsigned short* data, int size, Allocator* allocator)
 {
-    Mat m(size);
+    Mat m(size, 4u, allocator);
     if (m.empty())
         return m;
 
@@ -406,6 +432,25 @@ static void copy_cut_border_image(const Mat& src, Mat& dst, int top, int left)
     }
 }
 
+// arguments of the loop body run by parallel_for
+struct copy_cut_border_args
+{
+    const Mat* src;
+    Mat* dst;
+    int top;
+    int left;
+};
+
+static void copy_cut_border_channel(int q, void* userdata)
+{
+    const copy_cut_border_args* args = (const copy_cut_border_args*)userdata;
+
+    const Mat m = args->src->channel(q);
+    Mat cutm = args->dst->channel(q);
+
+    copy_cut_border_image(m, cutm, args->top, args->left);
+}
+
 void copy_cut_border(const Mat& src, Mat& dst, int top, int bottom, int left, int right, Allocator* allocator, int num_threads)
 {
     int w = src.w - left - right;
@@ -434,15 +479,12 @@ void copy_cut_border(const Mat& src, Mat& dst, int top, int bottom, int left, in
         if (dst.empty())
             return;
 
-        // unroll image channel
-        #pragma omp parallel for num_threads(num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const Mat m = src.channel(q);
-            Mat cutm = dst.channel(q);
+        ncnn::Option opt = ncnn::get_default_option();
+        opt.num_threads = num_threads;
 
-            copy_cut_border_image(m, cutm, top, left);
-        }
+        // unroll image channel
+        copy_cut_border_args args = { &src, &dst, top, left };
+        parallel_for(channels, copy_cut_border_channel, &args, opt);
     }
 }
 
@@ -675,6 +717,23 @@ static void resize_bilinear_image(const Mat& src, Mat& dst, int w, int h)
     delete[] buf;
 }
 
+// arguments of the loop body run by parallel_for
+struct resize_bilinear_args
+{
+    const Mat* src;
+    Mat* dst;
+};
+
+static void resize_bilinear_channel(int q, void* userdata)
+{
+    const resize_bilinear_args* args = (const resize_bilinear_args*)userdata;
+
+    const Mat m = args->src->channel(q);
+    Mat resizem = args->dst->channel(q);
+
+    resize_bilinear_image(m, resizem, resizem.w, resizem.h);
+}
+
 void resize_bilinear(const Mat& src, Mat& dst, int w, int h, Allocator* allocator, int num_threads)
 {
     if (w == src.w && h == src.h)
@@ -701,15 +760,12 @@ void resize_bilinear(const Mat& src, Mat& dst, int w, int h, Allocator* allocato
         if (dst.empty())
             return;
 
-        // unroll image channel
-        #pragma omp parallel for num_threads(num_threads)
-        for (int q=0; q<channels; q++)
-        {
-            const Mat m = src.channel(q);
-            Mat resizem = dst.channel(q);
+        ncnn::Option opt = ncnn::get_default_option();
+        opt.num_threads = num_threads;
 
-            resize_bilinear_image(m, resizem, w, h);
-        }
+        // unroll image channel
+        resize_bilinear_args args = { &src, &dst };
+        parallel_for(channels, resize_bilinear_channel, &args, opt);
     }
 }
 
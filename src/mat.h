@@ -17,6 +17,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif
@@ -91,6 +92,9 @@ public:
     Mat range(int x, int n);
     const Mat range(int x, int n) const;
 
+    // range reference sharing the ownership, keeps the whole data alive
+    Mat channel_range_shared(int c, int channels) const;
+
     // access raw data
     template<typename T> operator T*();
     template<typename T> operator const T*() const;
@@ -111,6 +115,13 @@ public:
         PIXEL_GRAY      = (1 << 2),
         PIXEL_RGBA      = (1 << 3),
 
+        // yuv420 camera frames, the luma plane followed by quarter resolution chroma
+        // NV21 has interleaved v u, NV12 has interleaved u v, I420 has a u plane then a v plane
+        // only usable with conversion to RGB, BGR or GRAY, bt.601 video range
+        PIXEL_NV21      = (1 << 4),
+        PIXEL_NV12      = (1 << 5),
+        PIXEL_I420      = (1 << 6),
+
         PIXEL_RGB2BGR   = PIXEL_RGB | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
         PIXEL_RGB2GRAY  = PIXEL_RGB | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
 
@@ -123,11 +134,41 @@ public:
         PIXEL_RGBA2RGB  = PIXEL_RGBA | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
         PIXEL_RGBA2BGR  = PIXEL_RGBA | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
         PIXEL_RGBA2GRAY = PIXEL_RGBA | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_NV212RGB  = PIXEL_NV21 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV212BGR  = PIXEL_NV21 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV212GRAY = PIXEL_NV21 | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_NV122RGB  = PIXEL_NV12 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV122BGR  = PIXEL_NV12 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV122GRAY = PIXEL_NV12 | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_I4202RGB  = PIXEL_I420 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_I4202BGR  = PIXEL_I420 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+        PIXEL_I4202GRAY = PIXEL_I420 | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
     };
     // convenient construct from pixel data
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, Allocator* allocator = 0);
     // convenient construct from pixel data and resize to specific size
     static Mat from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, Allocator* allocator = 0);
+    // convenient construct from pixel data, resize to specific size, then substract_mean_normalize
+    // yuv420 frames are converted, resized and normalized in a single pass
+    static Mat from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, const float* mean_vals, const float* norm_vals, Allocator* allocator = 0);
+    // convenient construct from the roi of pixel data in exif orientation, resize to specific size, then substract_mean_normalize
+    // roi is in source pixel coordinates before orientation, target size is after orientation
+    // orientation 1 to 8 as exif, 1 is unchanged, 2 flips horizontally, 3 rotates 180, 4 flips vertically,
+    // 5 transposes, 6 rotates 90 clockwise, 7 transverses, 8 rotates 90 counter-clockwise
+    // crop, orientation, resize, color conversion and normalize run in a single pass on num_threads threads
+    // return empty Mat for any other orientation
+    static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int roi_x, int roi_y, int roi_w, int roi_h, int orientation, int target_width, int target_height, const float* mean_vals = 0, const float* norm_vals = 0, Allocator* allocator = 0, int num_threads = 1);
+    // from_pixels_roi_resize for roi_count rois of x, y, w, h, sharing one allocation
+    // mats is left empty on error
+    static void from_pixels_roi_resize_batch(const unsigned char* pixels, int type, int w, int h, const int* rois, int roi_count, int orientation, int target_width, int target_height, std::vector<Mat>& mats, const float* mean_vals = 0, const float* norm_vals = 0, Allocator* allocator = 0, int num_threads = 1);
+    // convenient construct from pixel data warped by the 2x3 affine matrix tm from source to destination,
+    // then substract_mean_normalize, border_type and border_value as in warpaffine_bilinear_c1
+    static Mat from_pixels_warpaffine(const unsigned char* pixels, int type, int w, int h, const float* tm, int target_width, int target_height, int border_type, unsigned int border_value, const float* mean_vals = 0, const float* norm_vals = 0, Allocator* allocator = 0, int num_threads = 1);
+    // same with the 3x3 perspective matrix tm
+    static Mat from_pixels_warpperspective(const unsigned char* pixels, int type, int w, int h, const float* tm, int target_width, int target_height, int border_type, unsigned int border_value, const float* mean_vals = 0, const float* norm_vals = 0, Allocator* allocator = 0, int num_threads = 1);
 
     // convenient export to pixel data
     void to_pixels(unsigned char* pixels, int type) const;
@@ -139,7 +180,7 @@ public:
     void substract_mean_normalize(const float* mean_vals, const float* norm_vals);
 
     // convenient construct from half precisoin floating point data
-    static Mat from_float16(const unsigned short* data, int size);
+    static Mat from_float16(const unsigned short* data, int size, Allocator* allocator = 0);
 
     // pointer to the data
     void* data;
@@ -185,6 +226,22 @@ enum
 void copy_make_border(const Mat& src, Mat& dst, int top, int bottom, int left, int right, int type, float v, Allocator* allocator = 0, int num_threads = 1);
 void copy_cut_border(const Mat& src, Mat& dst, int top, int bottom, int left, int right, Allocator* allocator = 0, int num_threads = 1);
 void resize_bilinear(const Mat& src, Mat& dst, int w, int h, Allocator* allocator = 0, int num_threads = 1);
+// bilinear warp of each channel of a float Mat, tm is the 2x3 affine or 3x3 perspective matrix from source to destination
+// destination pixels mapped outside the source take the border, v is the constant border value
+// dst is left empty for a Mat whose elemsize is not 4
+void warpaffine_bilinear(const Mat& src, Mat& dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, float v = 0.f, Allocator* allocator = 0, int num_threads = 1);
+void warpperspective_bilinear(const Mat& src, Mat& dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, float v = 0.f, Allocator* allocator = 0, int num_threads = 1);
+
+#if NCNN_PIXEL
+// image pixel bilinear warp, tm is the 2x3 affine or 3x3 perspective matrix from source to destination
+// destination pixels mapped outside the source take the border, v holds the constant border byte of each channel
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+void warpperspective_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+void warpperspective_bilinear_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+void warpperspective_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = BORDER_CONSTANT, unsigned int v = 0, int num_threads = 1);
+#endif // NCNN_PIXEL
 
 inline Mat::Mat()
     : data(0), refcount(0), elemsize(0), allocator(0), dims(0), w(0), h(0), c(0), cstep(0)
@@ -549,12 +606,14 @@ inline void Mat::create(int _w, size_t _elemsize, Allocator* _allocator)
 
     if (total() > 0)
     {
-        size_t totalsize = alignSize(total() * elemsize, 4);
+        // the allocation origin is stored in front of the reference counter
+        size_t totalsize = alignSize(total() * elemsize, sizeof(void*));
         if (allocator)
-            data = allocator->fastMalloc(totalsize + (int)sizeof(*refcount));
+            data = allocator->fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
         else
-            data = fastMalloc(totalsize + (int)sizeof(*refcount));
-        refcount = (int*)(((unsigned char*)data) + totalsize);
+            data = fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
+        *(void**)(((unsigned char*)data) + totalsize) = data;
+        refcount = (int*)(((unsigned char*)data) + totalsize + sizeof(void*));
         *refcount = 1;
     }
 }
@@ -578,12 +637,14 @@ inline void Mat::create(int _w, int _h, size_t _elemsize, Allocator* _allocator)
 
     if (total() > 0)
     {
-        size_t totalsize = alignSize(total() * elemsize, 4);
+        // the allocation origin is stored in front of the reference counter
+        size_t totalsize = alignSize(total() * elemsize, sizeof(void*));
         if (allocator)
-            data = allocator->fastMalloc(totalsize + (int)sizeof(*refcount));
+            data = allocator->fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
         else
-            data = fastMalloc(totalsize + (int)sizeof(*refcount));
-        refcount = (int*)(((unsigned char*)data) + totalsize);
+            data = fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
+        *(void**)(((unsigned char*)data) + totalsize) = data;
+        refcount = (int*)(((unsigned char*)data) + totalsize + sizeof(void*));
         *refcount = 1;
     }
 }
@@ -607,12 +668,14 @@ inline void Mat::create(int _w, int _h, int _c, size_t _elemsize, Allocator* _al
 
     if (total() > 0)
     {
-        size_t totalsize = alignSize(total() * elemsize, 4);
+        // the allocation origin is stored in front of the reference counter
+        size_t totalsize = alignSize(total() * elemsize, sizeof(void*));
         if (allocator)
-            data = allocator->fastMalloc(totalsize + (int)sizeof(*refcount));
+            data = allocator->fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
         else
-            data = fastMalloc(totalsize + (int)sizeof(*refcount));
-        refcount = (int*)(((unsigned char*)data) + totalsize);
+            data = fastMalloc(totalsize + sizeof(void*) + (int)sizeof(*refcount));
+        *(void**)(((unsigned char*)data) + totalsize) = data;
+        refcount = (int*)(((unsigned char*)data) + totalsize + sizeof(void*));
         *refcount = 1;
     }
 }
@@ -627,10 +690,13 @@ inline void Mat::release()
 {
     if (refcount && NCNN_XADD(refcount, -1) == 1)
     {
+        // a shared range points into the middle, free from the origin
+        void* origin = *((void**)refcount - 1);
+
         if (allocator)
-            allocator->fastFree(data);
+            allocator->fastFree(origin);
         else
-            fastFree(data);
+            fastFree(origin);
     }
 
     data = 0;
@@ -699,6 +765,14 @@ inline const Mat Mat::channel_range(int _c, int channels) const
     return Mat(w, h, channels, (unsigned char*)data + cstep * _c * elemsize, elemsize, allocator);
 }
 
+inline Mat Mat::channel_range_shared(int _c, int channels) const
+{
+    Mat m(w, h, channels, (unsigned char*)data + cstep * _c * elemsize, elemsize, allocator);
+    m.refcount = refcount;
+    m.addref();
+    return m;
+}
+
 inline Mat Mat::row_range(int y, int rows)
 {
     return Mat(w, rows, (unsigned char*)data + w * y * elemsize, elemsize, allocator);
@@ -14,12 +14,18 @@
 
 #include "mat.h"
 #include <limits.h>
+#include <stdio.h>
 #include <math.h>
 #include <algorithm>
+#include <vector>
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
 #include "platform.h"
+#include "layer.h"
 
 namespace ncnn {
 
@@ -1972,6 +1978,686 @@ void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned c
     delete[] buf;
 }
 
+// general pixel sampler for crop, orientation, resize and color conversion in one pass
+//
+// an output row blends two source lines, each line is first resampled along the output row
+// the two axes of the output map to the two axes of the source, swapped for transposed orientations,
+// so both resampling steps read the source through per-column and per-row offset tables
+// channels are converted with an affine matrix, then clamped for yuv, normalized and stored as float
+//
+// yuv420 camera frames have the full resolution luma plane followed by quarter resolution chroma,
+// sampling y, u and v bilinearly equals blending the rgb of the four source pixels
+struct pixel_sampler
+{
+    // source
+    const unsigned char* pixels;
+    const unsigned char* uptr;
+    const unsigned char* vptr;
+    int w;
+    int h;
+    bool yuv;
+    // source channels, 3 for yuv
+    int cin;
+    // bytes from one pixel to the next along x and y, luma for yuv
+    int pixel_step;
+    int row_step;
+    int chroma_step;
+    int chroma_row_step;
+
+    // out = clamp(matrix * in + bias) for each output channel
+    int cout;
+    float matrix[4][4];
+    float bias[4];
+    bool clamp;
+    // the input channel an output channel is a plain copy of, -1 if not
+    int copy_of[4];
+};
+
+static void init_pixel_sampler_copy_of(pixel_sampler& s)
+{
+    for (int q = 0; q < s.cout; q++)
+    {
+        s.copy_of[q] = -1;
+
+        if (s.clamp || s.bias[q] != 0.f)
+            continue;
+
+        int nonzero = 0;
+        for (int k = 0; k < s.cin; k++)
+        {
+            if (s.matrix[q][k] != 0.f)
+            {
+                s.copy_of[q] = k;
+                nonzero++;
+            }
+        }
+
+        if (nonzero != 1 || s.matrix[q][s.copy_of[q]] != 1.f)
+            s.copy_of[q] = -1;
+    }
+}
+
+static bool init_pixel_sampler_matrix(pixel_sampler& s, const unsigned char* pixels, int type, int w, int h)
+{
+    const int type_from = type & Mat::PIXEL_FORMAT_MASK;
+    const int type_to = (type & Mat::PIXEL_CONVERT_MASK) ? (type >> Mat::PIXEL_CONVERT_SHIFT) : type_from;
+
+    s.pixels = pixels;
+    s.uptr = 0;
+    s.vptr = 0;
+    s.w = w;
+    s.h = h;
+    s.yuv = type_from == Mat::PIXEL_NV21 || type_from == Mat::PIXEL_NV12 || type_from == Mat::PIXEL_I420;
+    s.clamp = s.yuv;
+    s.chroma_step = 0;
+    s.chroma_row_step = 0;
+
+    // position of r g b in the source channels
+    int rgb[3] = { 0, 1, 2 };
+
+    if (type_from == Mat::PIXEL_RGB)
+    {
+        s.cin = 3;
+    }
+    else if (type_from == Mat::PIXEL_BGR)
+    {
+        s.cin = 3;
+        rgb[0] = 2;
+        rgb[2] = 0;
+    }
+    else if (type_from == Mat::PIXEL_GRAY)
+    {
+        s.cin = 1;
+        rgb[1] = 0;
+        rgb[2] = 0;
+    }
+    else if (type_from == Mat::PIXEL_RGBA)
+    {
+        s.cin = 4;
+    }
+    else if (s.yuv)
+    {
+        s.cin = 3;
+
+        // chroma layout
+        const int chroma_w = (w + 1) / 2;
+        const int chroma_h = (h + 1) / 2;
+
+        s.uptr = pixels + w * h;
+        s.vptr = s.uptr + 1;
+        s.chroma_step = 2;
+        if (type_from == Mat::PIXEL_NV21)
+        {
+            s.vptr = pixels + w * h;
+            s.uptr = s.vptr + 1;
+        }
+        else if (type_from == Mat::PIXEL_I420)
+        {
+            s.vptr = s.uptr + chroma_w * chroma_h;
+            s.chroma_step = 1;
+        }
+        s.chroma_row_step = chroma_w * s.chroma_step;
+
+        // yuv frames always convert
+        if (!(type & Mat::PIXEL_CONVERT_MASK))
+            return false;
+    }
+    else
+    {
+        return false;
+    }
+
+    s.pixel_step = s.yuv ? 1 : s.cin;
+    s.row_step = w * s.pixel_step;
+
+    memset(s.matrix, 0, sizeof(s.matrix));
+    memset(s.bias, 0, sizeof(s.bias));
+
+    if (type_to == type_from && !s.yuv)
+    {
+        // keep the source channels
+        s.cout = s.cin;
+        for (int q = 0; q < s.cin; q++)
+        {
+            s.matrix[q][q] = 1.f;
+        }
+
+        return true;
+    }
+
+    if (type_to != Mat::PIXEL_RGB && type_to != Mat::PIXEL_BGR && type_to != Mat::PIXEL_GRAY)
+        return false;
+
+    // rgb of the source, bt.601 video range for yuv
+    float to_rgb[3][4];
+    float to_rgb_bias[3] = { 0.f, 0.f, 0.f };
+    memset(to_rgb, 0, sizeof(to_rgb));
+    if (s.yuv)
+    {
+        to_rgb[0][0] = 1.164f;
+        to_rgb[0][2] = 1.596f;
+        to_rgb[1][0] = 1.164f;
+        to_rgb[1][1] = -0.391f;
+        to_rgb[1][2] = -0.813f;
+        to_rgb[2][0] = 1.164f;
+        to_rgb[2][1] = 2.018f;
+        to_rgb_bias[0] = -16.f * 1.164f - 128.f * 1.596f;
+        to_rgb_bias[1] = -16.f * 1.164f + 128.f * 0.391f + 128.f * 0.813f;
+        to_rgb_bias[2] = -16.f * 1.164f - 128.f * 2.018f;
+    }
+    else
+    {
+        to_rgb[0][rgb[0]] = 1.f;
+        to_rgb[1][rgb[1]] = 1.f;
+        to_rgb[2][rgb[2]] = 1.f;
+    }
+
+    if (type_to == Mat::PIXEL_GRAY)
+    {
+        // same weights as from_rgb2gray
+        const float gray_weights[3] = { 77 / 256.f, 150 / 256.f, 29 / 256.f };
+
+        s.cout = 1;
+        for (int k = 0; k < 3; k++)
+        {
+            for (int q = 0; q < s.cin; q++)
+            {
+                s.matrix[0][q] += gray_weights[k] * to_rgb[k][q];
+            }
+            s.bias[0] += gray_weights[k] * to_rgb_bias[k];
+        }
+
+        // a gray source stays as is
+        if (type_from == Mat::PIXEL_GRAY)
+            s.matrix[0][0] = 1.f;
+
+        if (s.yuv)
+        {
+            // luma only
+            s.matrix[0][0] = 1.164f;
+            s.matrix[0][1] = 0.f;
+            s.matrix[0][2] = 0.f;
+            s.bias[0] = -16.f * 1.164f;
+        }
+
+        return true;
+    }
+
+    s.cout = 3;
+    for (int k = 0; k < 3; k++)
+    {
+        int q = type_to == Mat::PIXEL_BGR ? 2 - k : k;
+        memcpy(s.matrix[q], to_rgb[k], sizeof(to_rgb[k]));
+        s.bias[q] = to_rgb_bias[k];
+    }
+
+    return true;
+}
+
+static bool init_pixel_sampler(pixel_sampler& s, const unsigned char* pixels, int type, int w, int h)
+{
+    if (!init_pixel_sampler_matrix(s, pixels, type, w, h))
+        return false;
+
+    init_pixel_sampler_copy_of(s);
+
+    return true;
+}
+
+// number of float channels the pixel type converts to, 0 if not supported
+static int pixel_sampler_channels(int type)
+{
+    static const unsigned char dummy[4] = { 0, 0, 0, 0 };
+
+    pixel_sampler s;
+    if (!init_pixel_sampler(s, dummy, type, 1, 1))
+        return 0;
+
+    return s.cout;
+}
+
+// the two source lines and weight of each output index along one axis
+// roi is in source coordinates, flip walks the roi backwards, taps outside the image are clamped
+static void pixel_sampler_taps(int outn, int roi_origin, int roi_extent, int src_extent, bool flip, int* taps, float* weights)
+{
+    const double scale = (double)roi_extent / outn;
+
+    for (int d = 0; d < outn; d++)
+    {
+        float f = (float)((d + 0.5) * scale - 0.5);
+        int i = floor(f);
+        f -= i;
+
+        if (i < 0)
+        {
+            i = 0;
+            f = 0.f;
+        }
+        if (i >= roi_extent - 1)
+        {
+            i = roi_extent - 1;
+            f = 0.f;
+        }
+
+        int i1 = std::min(i + 1, roi_extent - 1);
+
+        if (flip)
+        {
+            i = roi_extent - 1 - i;
+            i1 = roi_extent - 1 - i1;
+        }
+
+        taps[d * 2] = std::min(std::max(roi_origin + i, 0), src_extent - 1);
+        taps[d * 2 + 1] = std::min(std::max(roi_origin + i1, 0), src_extent - 1);
+        weights[d] = f;
+    }
+}
+
+// out = v0 + (v1 - v0) * a for 4 lanes
+static inline void pixel_sampler_lerp4(const float* v0, const float* v1, const float* a, float* out)
+{
+#if __SSE2__
+    __m128 _v0 = _mm_loadu_ps(v0);
+    _mm_storeu_ps(out, _mm_add_ps(_v0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(v1), _v0), _mm_loadu_ps(a))));
+#elif __ARM_NEON
+    float32x4_t _v0 = vld1q_f32(v0);
+    vst1q_f32(out, vmlaq_f32(_v0, vsubq_f32(vld1q_f32(v1), _v0), vld1q_f32(a)));
+#else
+    for (int i = 0; i < 4; i++)
+    {
+        out[i] = v0[i] + (v1[i] - v0[i]) * a[i];
+    }
+#endif // __SSE2__
+}
+
+template<int cin>
+static void pixel_sampler_line_packed(const unsigned char* line, const int* ofs, const float* weights, int outw, float* rows)
+{
+    int dx = 0;
+
+    // the taps are gathered, the blend runs 4 output pixels at a time
+    for (; dx + 3 < outw; dx += 4)
+    {
+        for (int k = 0; k < cin; k++)
+        {
+            float v0[4];
+            float v1[4];
+            for (int i = 0; i < 4; i++)
+            {
+                v0[i] = line[ofs[(dx + i) * 2] + k];
+                v1[i] = line[ofs[(dx + i) * 2 + 1] + k];
+            }
+
+            pixel_sampler_lerp4(v0, v1, weights + dx, rows + k * outw + dx);
+        }
+    }
+
+    for (; dx < outw; dx++)
+    {
+        const unsigned char* p0 = line + ofs[dx * 2];
+        const unsigned char* p1 = line + ofs[dx * 2 + 1];
+        float a = weights[dx];
+
+        for (int k = 0; k < cin; k++)
+        {
+            rows[k * outw + dx] = p0[k] + (p1[k] - p0[k]) * a;
+        }
+    }
+}
+
+// resample one source line along the output row into cin planes of outw
+static void pixel_sampler_line(const pixel_sampler& s, int line_ofs, int line_chroma_ofs, const int* ofs, const int* chroma_ofs, const float* weights, int outw, float* rows)
+{
+    if (s.yuv)
+    {
+        const unsigned char* yline = s.pixels + line_ofs;
+        const unsigned char* uline = s.uptr + line_chroma_ofs;
+        const unsigned char* vline = s.vptr + line_chroma_ofs;
+
+        float* ry = rows;
+        float* ru = rows + outw;
+        float* rv = rows + outw * 2;
+
+        int dx = 0;
+        for (; dx + 3 < outw; dx += 4)
+        {
+            float y0[4];
+            float y1[4];
+            float u0[4];
+            float u1[4];
+            float v0[4];
+            float v1[4];
+            for (int i = 0; i < 4; i++)
+            {
+                int p0 = ofs[(dx + i) * 2];
+                int p1 = ofs[(dx + i) * 2 + 1];
+                int c0 = chroma_ofs[(dx + i) * 2];
+                int c1 = chroma_ofs[(dx + i) * 2 + 1];
+
+                y0[i] = yline[p0];
+                y1[i] = yline[p1];
+                u0[i] = uline[c0];
+                u1[i] = uline[c1];
+                v0[i] = vline[c0];
+                v1[i] = vline[c1];
+            }
+
+            pixel_sampler_lerp4(y0, y1, weights + dx, ry + dx);
+            pixel_sampler_lerp4(u0, u1, weights + dx, ru + dx);
+            pixel_sampler_lerp4(v0, v1, weights + dx, rv + dx);
+        }
+
+        for (; dx < outw; dx++)
+        {
+            int p0 = ofs[dx * 2];
+            int p1 = ofs[dx * 2 + 1];
+            int c0 = chroma_ofs[dx * 2];
+            int c1 = chroma_ofs[dx * 2 + 1];
+            float a = weights[dx];
+
+            ry[dx] = yline[p0] + (yline[p1] - yline[p0]) * a;
+            ru[dx] = uline[c0] + (uline[c1] - uline[c0]) * a;
+            rv[dx] = vline[c0] + (vline[c1] - vline[c0]) * a;
+        }
+
+        return;
+    }
+
+    const unsigned char* line = s.pixels + line_ofs;
+
+    if (s.cin == 1)
+        pixel_sampler_line_packed<1>(line, ofs, weights, outw, rows);
+    else if (s.cin == 3)
+        pixel_sampler_line_packed<3>(line, ofs, weights, outw, rows);
+    else
+        pixel_sampler_line_packed<4>(line, ofs, weights, outw, rows);
+}
+
+// per output channel mean and norm, 0 and 1 when not given
+static void pixel_sampler_mean_norm(const pixel_sampler& s, const float* mean_vals, const float* norm_vals, float* mean, float* norm)
+{
+    for (int q = 0; q < 4; q++)
+    {
+        mean[q] = mean_vals && q < s.cout ? mean_vals[q] : 0.f;
+        norm[q] = norm_vals && q < s.cout ? norm_vals[q] : 1.f;
+    }
+}
+
+// convert, clamp, normalize one output row from cin planes of outw and store it to row dy of m
+static void pixel_sampler_store_row(const pixel_sampler& s, const float* blend, int outw, Mat& m, int dy, const float* mean, const float* norm)
+{
+    for (int q = 0; q < s.cout; q++)
+    {
+        float* outptr = m.channel(q).row(dy);
+
+        const float* matrix = s.matrix[q];
+        const float bias = s.bias[q];
+        const float mean_q = mean[q];
+        const float norm_q = norm[q];
+
+        if (s.copy_of[q] != -1)
+        {
+            const float* ptr = blend + s.copy_of[q] * outw;
+
+            int dx = 0;
+#if __SSE2__
+            __m128 _mean = _mm_set1_ps(mean_q);
+            __m128 _norm = _mm_set1_ps(norm_q);
+            for (; dx + 3 < outw; dx += 4)
+            {
+                _mm_storeu_ps(outptr + dx, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(ptr + dx), _mean), _norm));
+            }
+#elif __ARM_NEON
+            float32x4_t _mean = vdupq_n_f32(mean_q);
+            for (; dx + 3 < outw; dx += 4)
+            {
+                vst1q_f32(outptr + dx, vmulq_n_f32(vsubq_f32(vld1q_f32(ptr + dx), _mean), norm_q));
+            }
+#endif // __SSE2__
+            for (; dx < outw; dx++)
+            {
+                outptr[dx] = (ptr[dx] - mean_q) * norm_q;
+            }
+
+            continue;
+        }
+
+        int dx = 0;
+#if __SSE2__
+        __m128 _bias = _mm_set1_ps(bias);
+        __m128 _mean = _mm_set1_ps(mean_q);
+        __m128 _norm = _mm_set1_ps(norm_q);
+        __m128 _zero = _mm_setzero_ps();
+        __m128 _255 = _mm_set1_ps(255.f);
+        for (; dx + 3 < outw; dx += 4)
+        {
+            __m128 _v = _bias;
+            for (int k = 0; k < s.cin; k++)
+            {
+                _v = _mm_add_ps(_v, _mm_mul_ps(_mm_loadu_ps(blend + k * outw + dx), _mm_set1_ps(matrix[k])));
+            }
+            if (s.clamp)
+            {
+                _v = _mm_min_ps(_mm_max_ps(_v, _zero), _255);
+            }
+            _mm_storeu_ps(outptr + dx, _mm_mul_ps(_mm_sub_ps(_v, _mean), _norm));
+        }
+#elif __ARM_NEON
+        float32x4_t _bias = vdupq_n_f32(bias);
+        float32x4_t _mean = vdupq_n_f32(mean_q);
+        float32x4_t _zero = vdupq_n_f32(0.f);
+        float32x4_t _255 = vdupq_n_f32(255.f);
+        for (; dx + 3 < outw; dx += 4)
+        {
+            float32x4_t _v = _bias;
+            for (int k = 0; k < s.cin; k++)
+            {
+                _v = vmlaq_n_f32(_v, vld1q_f32(blend + k * outw + dx), matrix[k]);
+            }
+            if (s.clamp)
+            {
+                _v = vminq_f32(vmaxq_f32(_v, _zero), _255);
+            }
+            vst1q_f32(outptr + dx, vmulq_n_f32(vsubq_f32(_v, _mean), norm_q));
+        }
+#endif // __SSE2__
+        for (; dx < outw; dx++)
+        {
+            float v = bias;
+            for (int k = 0; k < s.cin; k++)
+            {
+                v += blend[k * outw + dx] * matrix[k];
+            }
+            if (s.clamp)
+            {
+                v = std::min(std::max(v, 0.f), 255.f);
+            }
+            outptr[dx] = (v - mean_q) * norm_q;
+        }
+    }
+}
+
+// arguments of the sampling loop body run by parallel_for
+struct pixel_sampler_args
+{
+    const pixel_sampler* s;
+    Mat* m;
+    // source offsets and weights of the two taps of each output column, see pixel_sampler_line
+    const int* ofs;
+    const int* chroma_ofs;
+    const float* col_weights;
+    // source lines and weights of the two taps of each output row
+    const int* row_taps;
+    const float* row_weights;
+    int line_step;
+    int line_chroma_step;
+    const float* mean;
+    const float* norm;
+    // two resampled lines and their blend, one row per worker
+    Mat* rowsbuf;
+    int workers;
+};
+
+// worker t samples a contiguous run of output rows with its own line buffers
+static void pixel_sampler_worker(int t, void* userdata)
+{
+    const pixel_sampler_args* args = (const pixel_sampler_args*)userdata;
+    const pixel_sampler& s = *args->s;
+    Mat& m = *args->m;
+
+    const int outw = m.w;
+    const int outh = m.h;
+
+    const int start = (int)((long long)outh * t / args->workers);
+    const int end = (int)((long long)outh * (t + 1) / args->workers);
+
+    // resampled lines of the two source taps, reused while the taps stay
+    float* rows0 = args->rowsbuf->row(t);
+    float* rows1 = rows0 + outw * s.cin;
+    float* blend = rows1 + outw * s.cin;
+    int prev_line0 = -1;
+    int prev_line1 = -1;
+
+    for (int dy = start; dy < end; dy++)
+    {
+        const int line0 = args->row_taps[dy * 2];
+        const int line1 = args->row_taps[dy * 2 + 1];
+        const float b = args->row_weights[dy];
+
+        if (line0 != prev_line0 || line1 != prev_line1)
+        {
+            if (line0 == prev_line1)
+            {
+                std::swap(rows0, rows1);
+            }
+            else
+            {
+                pixel_sampler_line(s, line0 * args->line_step, (line0 >> 1) * args->line_chroma_step, args->ofs, args->chroma_ofs, args->col_weights, outw, rows0);
+            }
+
+            pixel_sampler_line(s, line1 * args->line_step, (line1 >> 1) * args->line_chroma_step, args->ofs, args->chroma_ofs, args->col_weights, outw, rows1);
+
+            prev_line0 = line0;
+            prev_line1 = line1;
+        }
+
+        // blend the two lines
+        {
+            const int size = outw * s.cin;
+
+            int i = 0;
+#if __SSE2__
+            __m128 _b = _mm_set1_ps(b);
+            for (; i + 3 < size; i += 4)
+            {
+                __m128 _r0 = _mm_loadu_ps(rows0 + i);
+                _mm_storeu_ps(blend + i, _mm_add_ps(_r0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(rows1 + i), _r0), _b)));
+            }
+#elif __ARM_NEON
+            float32x4_t _b = vdupq_n_f32(b);
+            for (; i + 3 < size; i += 4)
+            {
+                float32x4_t _r0 = vld1q_f32(rows0 + i);
+                vst1q_f32(blend + i, vmlaq_f32(_r0, vsubq_f32(vld1q_f32(rows1 + i), _r0), _b));
+            }
+#endif // __SSE2__
+            for (; i < size; i++)
+            {
+                blend[i] = rows0[i] + (rows1[i] - rows0[i]) * b;
+            }
+        }
+
+        pixel_sampler_store_row(s, blend, outw, m, dy, args->mean, args->norm);
+    }
+}
+
+// sample roi (x, y, w, h) of the source in the given exif orientation into m, allocated with the output shape
+// return 0 if success
+static int pixel_sampler_run(const pixel_sampler& s, const int* roi, int orientation, Mat& m, const float* mean_vals, const float* norm_vals, int num_threads)
+{
+    const int outw = m.w;
+    const int outh = m.h;
+
+    // exif orientation 1 to 8, transposed from 5 on
+    const bool transpose = orientation >= 5 && orientation <= 8;
+    const bool flip_x = orientation == 2 || orientation == 3 || orientation == 6 || orientation == 7;
+    const bool flip_y = orientation == 3 || orientation == 4 || orientation == 7 || orientation == 8;
+
+    // output x walks source x, or source y when transposed
+    std::vector<int> col_taps(outw * 2);
+    std::vector<float> col_weights(outw);
+    std::vector<int> row_taps(outh * 2);
+    std::vector<float> row_weights(outh);
+
+    if (!transpose)
+    {
+        pixel_sampler_taps(outw, roi[0], roi[2], s.w, flip_x, &col_taps[0], &col_weights[0]);
+        pixel_sampler_taps(outh, roi[1], roi[3], s.h, flip_y, &row_taps[0], &row_weights[0]);
+    }
+    else
+    {
+        pixel_sampler_taps(outw, roi[1], roi[3], s.h, flip_x, &col_taps[0], &col_weights[0]);
+        pixel_sampler_taps(outh, roi[0], roi[2], s.w, flip_y, &row_taps[0], &row_weights[0]);
+    }
+
+    const int col_step = transpose ? s.row_step : s.pixel_step;
+    const int col_chroma_step = transpose ? s.chroma_row_step : s.chroma_step;
+    const int line_step = transpose ? s.pixel_step : s.row_step;
+    const int line_chroma_step = transpose ? s.chroma_step : s.chroma_row_step;
+
+    std::vector<int> ofs(outw * 2);
+    std::vector<int> chroma_ofs(outw * 2);
+    for (int i = 0; i < outw * 2; i++)
+    {
+        ofs[i] = col_taps[i] * col_step;
+        chroma_ofs[i] = (col_taps[i] >> 1) * col_chroma_step;
+    }
+
+    float mean[4];
+    float norm[4];
+    pixel_sampler_mean_norm(s, mean_vals, norm_vals, mean, norm);
+
+    Option opt = get_default_option();
+    opt.num_threads = num_threads;
+
+    // line buffers allocated once per worker, each worker takes a contiguous run of rows
+    const int workers = std::max(1, std::min(num_threads, outh));
+
+    Mat rowsbuf(outw * s.cin * 3, workers, 4u, opt.workspace_allocator);
+    if (rowsbuf.empty())
+        return -100;
+
+    pixel_sampler_args args = { &s, &m, &ofs[0], &chroma_ofs[0], &col_weights[0], &row_taps[0], &row_weights[0], line_step, line_chroma_step, mean, norm, &rowsbuf, workers };
+    parallel_for(workers, pixel_sampler_worker, &args, opt);
+
+    return 0;
+}
+
+static Mat from_pixels_sampled(const unsigned char* pixels, int type, int w, int h, const int* roi, int orientation, int target_width, int target_height, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    if (roi[2] <= 0 || roi[3] <= 0 || target_width <= 0 || target_height <= 0)
+        return Mat();
+
+    if (orientation < 1 || orientation > 8)
+    {
+        fprintf(stderr, "invalid exif orientation %d\n", orientation);
+        return Mat();
+    }
+
+    pixel_sampler s;
+    if (!init_pixel_sampler(s, pixels, type, w, h))
+        return Mat();
+
+    Mat m(target_width, target_height, s.cout, 4u, allocator);
+    if (m.empty())
+        return m;
+
+    if (pixel_sampler_run(s, roi, orientation, m, mean_vals, norm_vals, num_threads) != 0)
+        return Mat();
+
+    return m;
+}
+
 Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, Allocator* allocator)
 {
     if (type & PIXEL_CONVERT_MASK)
@@ -1996,6 +2682,13 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, Alloca
 
         if (type == PIXEL_RGBA2GRAY)
             return from_rgba2gray(pixels, w, h, allocator);
+
+        int type_from = type & PIXEL_FORMAT_MASK;
+        if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+        {
+            const int roi[4] = { 0, 0, w, h };
+            return from_pixels_sampled(pixels, type, w, h, roi, 1, w, h, 0, 0, allocator, 1);
+        }
     }
     else
     {
@@ -2015,12 +2708,18 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, Alloca
 Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, Allocator* allocator)
 {
     if (w == target_width && h == target_height)
-        return Mat::from_pixels(pixels, type, w, h);
+        return Mat::from_pixels(pixels, type, w, h, allocator);
 
     Mat m;
 
     int type_from = type & PIXEL_FORMAT_MASK;
 
+    if (type_from == PIXEL_NV21 || type_from == PIXEL_NV12 || type_from == PIXEL_I420)
+    {
+        const int roi[4] = { 0, 0, w, h };
+        return from_pixels_sampled(pixels, type, w, h, roi, 1, target_width, target_height, 0, 0, allocator, 1);
+    }
+
     if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
     {
         unsigned char* dst = new unsigned char[target_width * target_height * 3];
@@ -2055,14 +2754,68 @@ Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h,
     return m;
 }
 
-void Mat::to_pixels(unsigned char* pixels, int type) const
+Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, const float* mean_vals, const float* norm_vals, Allocator* allocator)
 {
-    if (type & PIXEL_CONVERT_MASK)
-    {
-        if (type == PIXEL_RGB2BGR || type == PIXEL_BGR2RGB)
-            return to_bgr2rgb(*this, pixels);
-    }
-    else
+    const int roi[4] = { 0, 0, w, h };
+    return from_pixels_sampled(pixels, type, w, h, roi, 1, target_width, target_height, mean_vals, norm_vals, allocator, 1);
+}
+
+Mat Mat::from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int roi_x, int roi_y, int roi_w, int roi_h, int orientation, int target_width, int target_height, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    const int roi[4] = { roi_x, roi_y, roi_w, roi_h };
+    return from_pixels_sampled(pixels, type, w, h, roi, orientation, target_width, target_height, mean_vals, norm_vals, allocator, num_threads);
+}
+
+void Mat::from_pixels_roi_resize_batch(const unsigned char* pixels, int type, int w, int h, const int* rois, int roi_count, int orientation, int target_width, int target_height, std::vector<Mat>& mats, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    mats.clear();
+
+    const int channels = pixel_sampler_channels(type);
+    if (channels == 0 || roi_count <= 0 || target_width <= 0 || target_height <= 0)
+        return;
+
+    if (orientation < 1 || orientation > 8)
+    {
+        fprintf(stderr, "invalid exif orientation %d\n", orientation);
+        return;
+    }
+
+    pixel_sampler s;
+    init_pixel_sampler(s, pixels, type, w, h);
+
+    // one allocation for all crops, each crop is a channel range of it
+    Mat m(target_width, target_height, channels * roi_count, 4u, allocator);
+    if (m.empty())
+        return;
+
+    mats.resize(roi_count);
+    for (int i = 0; i < roi_count; i++)
+    {
+        const int* roi = rois + i * 4;
+
+        mats[i] = m.channel_range_shared(i * channels, channels);
+        if (roi[2] <= 0 || roi[3] <= 0)
+        {
+            mats[i].fill(0.f);
+            continue;
+        }
+
+        if (pixel_sampler_run(s, roi, orientation, mats[i], mean_vals, norm_vals, num_threads) != 0)
+        {
+            mats.clear();
+            return;
+        }
+    }
+}
+
+void Mat::to_pixels(unsigned char* pixels, int type) const
+{
+    if (type & PIXEL_CONVERT_MASK)
+    {
+        if (type == PIXEL_RGB2BGR || type == PIXEL_BGR2RGB)
+            return to_bgr2rgb(*this, pixels);
+    }
+    else
     {
         if (type == PIXEL_RGB || type == PIXEL_BGR)
             return to_rgb(*this, pixels);
@@ -2115,4 +2868,822 @@ void Mat::to_pixels_resize(unsigned char* pixels, int type, int target_width, in
 }
 #endif // NCNN_PIXEL
 
+// bilinear warp with fixed point coordinates of warp_inter_bits fraction bits
+//
+// the horizontal blend is kept at 16 bits so both blends map to madd on simd,
+// a sampled channel value is scaled by 1 << 16
+static const int warp_inter_bits = 10;
+static const int warp_inter_scale = 1 << warp_inter_bits;
+
+// coordinates are clamped far outside any image, which keeps the fixed point values in int
+static const float warp_coord_limit = (float)(1 << 19);
+
+// source of destination pixel (x, y) is (m0 x + m1 y + m2, m3 x + m4 y + m5) / (m6 x + m7 y + m8)
+static bool invert_warp_matrix(const float* tm, bool perspective, float* m)
+{
+    if (!perspective)
+    {
+        double d = (double)tm[0] * tm[4] - (double)tm[1] * tm[3];
+        if (d == 0)
+            return false;
+
+        d = 1.0 / d;
+
+        m[0] = (float)(tm[4] * d);
+        m[1] = (float)(-tm[1] * d);
+        m[2] = (float)(((double)tm[1] * tm[5] - (double)tm[2] * tm[4]) * d);
+        m[3] = (float)(-tm[3] * d);
+        m[4] = (float)(tm[0] * d);
+        m[5] = (float)(((double)tm[2] * tm[3] - (double)tm[0] * tm[5]) * d);
+        m[6] = 0.f;
+        m[7] = 0.f;
+        m[8] = 1.f;
+
+        return true;
+    }
+
+    double a[9];
+    for (int i = 0; i < 9; i++)
+    {
+        a[i] = tm[i];
+    }
+
+    double c0 = a[4] * a[8] - a[5] * a[7];
+    double c1 = a[5] * a[6] - a[3] * a[8];
+    double c2 = a[3] * a[7] - a[4] * a[6];
+
+    double d = a[0] * c0 + a[1] * c1 + a[2] * c2;
+    if (d == 0)
+        return false;
+
+    d = 1.0 / d;
+
+    m[0] = (float)(c0 * d);
+    m[1] = (float)((a[2] * a[7] - a[1] * a[8]) * d);
+    m[2] = (float)((a[1] * a[5] - a[2] * a[4]) * d);
+    m[3] = (float)(c1 * d);
+    m[4] = (float)((a[0] * a[8] - a[2] * a[6]) * d);
+    m[5] = (float)((a[2] * a[3] - a[0] * a[5]) * d);
+    m[6] = (float)(c2 * d);
+    m[7] = (float)((a[1] * a[6] - a[0] * a[7]) * d);
+    m[8] = (float)((a[0] * a[4] - a[1] * a[3]) * d);
+
+    return true;
+}
+
+
+// fixed point source coordinates of destination row y
+static void warp_row_coords(const float* m, bool perspective, int y, int outw, int* xs, int* ys)
+{
+    const float bx = m[1] * y + m[2];
+    const float by = m[4] * y + m[5];
+    const float bw = m[7] * y + m[8];
+
+    int x = 0;
+#if __SSE2__
+    __m128 _x = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+    __m128 _four = _mm_set1_ps(4.f);
+    __m128 _m0 = _mm_set1_ps(m[0]);
+    __m128 _m3 = _mm_set1_ps(m[3]);
+    __m128 _m6 = _mm_set1_ps(m[6]);
+    __m128 _bx = _mm_set1_ps(bx);
+    __m128 _by = _mm_set1_ps(by);
+    __m128 _bw = _mm_set1_ps(bw);
+    __m128 _zero = _mm_setzero_ps();
+    __m128 _one = _mm_set1_ps(1.f);
+    __m128 _half = _mm_set1_ps(0.5f);
+    __m128 _lo = _mm_set1_ps(-warp_coord_limit);
+    __m128 _hi = _mm_set1_ps(warp_coord_limit);
+    __m128 _scale = _mm_set1_ps((float)warp_inter_scale);
+    for (; x + 3 < outw; x += 4)
+    {
+        __m128 _sx = _mm_add_ps(_bx, _mm_mul_ps(_m0, _x));
+        __m128 _sy = _mm_add_ps(_by, _mm_mul_ps(_m3, _x));
+        if (perspective)
+        {
+            // points at infinity go far outside, as in the scalar path
+            __m128 _sw = _mm_add_ps(_bw, _mm_mul_ps(_m6, _x));
+            __m128 _finite = _mm_cmpneq_ps(_sw, _zero);
+            __m128 _rw = _mm_div_ps(_one, _sw);
+            _sx = _mm_or_ps(_mm_and_ps(_finite, _mm_mul_ps(_sx, _rw)), _mm_andnot_ps(_finite, _lo));
+            _sy = _mm_or_ps(_mm_and_ps(_finite, _mm_mul_ps(_sy, _rw)), _mm_andnot_ps(_finite, _lo));
+        }
+        _sx = _mm_min_ps(_mm_max_ps(_sx, _lo), _hi);
+        _sy = _mm_min_ps(_mm_max_ps(_sy, _lo), _hi);
+
+        // floor(v + 0.5), the truncating convert is one too high for negative fractions
+        __m128 _tx = _mm_add_ps(_mm_mul_ps(_sx, _scale), _half);
+        __m128 _ty = _mm_add_ps(_mm_mul_ps(_sy, _scale), _half);
+        __m128i _ix = _mm_cvttps_epi32(_tx);
+        __m128i _iy = _mm_cvttps_epi32(_ty);
+        _ix = _mm_add_epi32(_ix, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(_ix), _tx)));
+        _iy = _mm_add_epi32(_iy, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(_iy), _ty)));
+        _mm_storeu_si128((__m128i*)(xs + x), _ix);
+        _mm_storeu_si128((__m128i*)(ys + x), _iy);
+        _x = _mm_add_ps(_x, _four);
+    }
+#elif __ARM_NEON
+    const float x0123[4] = { 0.f, 1.f, 2.f, 3.f };
+    float32x4_t _x = vld1q_f32(x0123);
+    float32x4_t _four = vdupq_n_f32(4.f);
+    float32x4_t _bx = vdupq_n_f32(bx);
+    float32x4_t _by = vdupq_n_f32(by);
+    float32x4_t _bw = vdupq_n_f32(bw);
+    float32x4_t _zero = vdupq_n_f32(0.f);
+    float32x4_t _half = vdupq_n_f32(0.5f);
+    float32x4_t _lo = vdupq_n_f32(-warp_coord_limit);
+    float32x4_t _hi = vdupq_n_f32(warp_coord_limit);
+    for (; x + 3 < outw; x += 4)
+    {
+        float32x4_t _sx = vmlaq_n_f32(_bx, _x, m[0]);
+        float32x4_t _sy = vmlaq_n_f32(_by, _x, m[3]);
+        if (perspective)
+        {
+            // points at infinity go far outside, as in the scalar path
+            float32x4_t _sw = vmlaq_n_f32(_bw, _x, m[6]);
+#if __aarch64__
+            float32x4_t _rw = vdivq_f32(vdupq_n_f32(1.f), _sw);
+#else
+            float32x4_t _rw = vrecpeq_f32(_sw);
+            _rw = vmulq_f32(vrecpsq_f32(_sw, _rw), _rw);
+            _rw = vmulq_f32(vrecpsq_f32(_sw, _rw), _rw);
+#endif // __aarch64__
+            uint32x4_t _infinite = vceqq_f32(_sw, _zero);
+            _sx = vbslq_f32(_infinite, _lo, vmulq_f32(_sx, _rw));
+            _sy = vbslq_f32(_infinite, _lo, vmulq_f32(_sy, _rw));
+        }
+        _sx = vminq_f32(vmaxq_f32(_sx, _lo), _hi);
+        _sy = vminq_f32(vmaxq_f32(_sy, _lo), _hi);
+
+        // floor(v + 0.5)
+        float32x4_t _tx = vmlaq_n_f32(_half, _sx, (float)warp_inter_scale);
+        float32x4_t _ty = vmlaq_n_f32(_half, _sy, (float)warp_inter_scale);
+#if __aarch64__
+        int32x4_t _ix = vcvtmq_s32_f32(_tx);
+        int32x4_t _iy = vcvtmq_s32_f32(_ty);
+#else
+        // the truncating convert is one too high for negative fractions
+        int32x4_t _ix = vcvtq_s32_f32(_tx);
+        int32x4_t _iy = vcvtq_s32_f32(_ty);
+        _ix = vaddq_s32(_ix, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(_ix), _tx)));
+        _iy = vaddq_s32(_iy, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(_iy), _ty)));
+#endif // __aarch64__
+        vst1q_s32(xs + x, _ix);
+        vst1q_s32(ys + x, _iy);
+        _x = vaddq_f32(_x, _four);
+    }
+#endif // __SSE2__
+    for (; x < outw; x++)
+    {
+        float sx = bx + m[0] * x;
+        float sy = by + m[3] * x;
+
+        if (perspective)
+        {
+            float sw = bw + m[6] * x;
+            sw = sw != 0.f ? 1.f / sw : 0.f;
+            sx = sw != 0.f ? sx * sw : -warp_coord_limit;
+            sy = sw != 0.f ? sy * sw : -warp_coord_limit;
+        }
+
+        sx = std::min(std::max(sx, -warp_coord_limit), warp_coord_limit);
+        sy = std::min(std::max(sy, -warp_coord_limit), warp_coord_limit);
+
+        xs[x] = (int)floor(sx * warp_inter_scale + 0.5f);
+        ys[x] = (int)floor(sy * warp_inter_scale + 0.5f);
+    }
+}
+
+#if NCNN_PIXEL
+// the bytes of one pixel packed into an int, the fourth is zero for 3 channels
+template<int cin>
+static inline unsigned int warp_load_pixel(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (cin == 4 ? (unsigned int)p[3] << 24 : 0u);
+}
+
+// channel values of source position (X, Y) in fixed point, scaled by 1 << 16
+template<int cin>
+static inline void warp_sample_pixel(const unsigned char* src, int srcw, int srch, int X, int Y, int border_type, const unsigned char* border, int* sums)
+{
+    const int sx = X >> warp_inter_bits;
+    const int sy = Y >> warp_inter_bits;
+    const int fx = X & (warp_inter_scale - 1);
+    const int fy = Y & (warp_inter_scale - 1);
+
+    const unsigned char* p00;
+    const unsigned char* p01;
+    const unsigned char* p10;
+    const unsigned char* p11;
+
+    if (sx >= 0 && sy >= 0 && sx < srcw - 1 && sy < srch - 1)
+    {
+        p00 = src + (sy * srcw + sx) * cin;
+        p01 = p00 + cin;
+        p10 = p00 + srcw * cin;
+        p11 = p10 + cin;
+
+#if __SSE2__
+        if (cin == 3 || cin == 4)
+        {
+            __m128i _zero = _mm_setzero_si128();
+            __m128i _wx = _mm_set_epi16(fx, warp_inter_scale - fx, fx, warp_inter_scale - fx, fx, warp_inter_scale - fx, fx, warp_inter_scale - fx);
+            __m128i _wy = _mm_set_epi16(fy, warp_inter_scale - fy, fy, warp_inter_scale - fy, fy, warp_inter_scale - fy, fy, warp_inter_scale - fy);
+
+            // interleave the two taps of each channel, then blend pairs with madd
+            __m128i _r0 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(warp_load_pixel<cin>(p00)), _mm_cvtsi32_si128(warp_load_pixel<cin>(p01))), _zero);
+            __m128i _r1 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(warp_load_pixel<cin>(p10)), _mm_cvtsi32_si128(warp_load_pixel<cin>(p11))), _zero);
+            __m128i _h0 = _mm_srai_epi32(_mm_madd_epi16(_r0, _wx), 4);
+            __m128i _h1 = _mm_srai_epi32(_mm_madd_epi16(_r1, _wx), 4);
+
+            __m128i _h = _mm_packs_epi32(_h0, _h1);
+            _h = _mm_unpacklo_epi16(_h, _mm_srli_si128(_h, 8));
+            __m128i _sum = _mm_madd_epi16(_h, _wy);
+
+            if (cin == 4)
+            {
+                _mm_storeu_si128((__m128i*)sums, _sum);
+            }
+            else
+            {
+                int tmp[4];
+                _mm_storeu_si128((__m128i*)tmp, _sum);
+                sums[0] = tmp[0];
+                sums[1] = tmp[1];
+                sums[2] = tmp[2];
+            }
+            return;
+        }
+#elif __ARM_NEON
+        if (cin == 3 || cin == 4)
+        {
+            // the two taps of a row in one vector, low half left tap
+            uint16x8_t _r0 = vmovl_u8(vcreate_u8(warp_load_pixel<cin>(p00) | ((uint64_t)warp_load_pixel<cin>(p01) << 32)));
+            uint16x8_t _r1 = vmovl_u8(vcreate_u8(warp_load_pixel<cin>(p10) | ((uint64_t)warp_load_pixel<cin>(p11) << 32)));
+            uint32x4_t _h0 = vshrq_n_u32(vmlal_n_u16(vmull_n_u16(vget_low_u16(_r0), warp_inter_scale - fx), vget_high_u16(_r0), fx), 4);
+            uint32x4_t _h1 = vshrq_n_u32(vmlal_n_u16(vmull_n_u16(vget_low_u16(_r1), warp_inter_scale - fx), vget_high_u16(_r1), fx), 4);
+            int32x4_t _sum = vreinterpretq_s32_u32(vmlaq_n_u32(vmulq_n_u32(_h0, warp_inter_scale - fy), _h1, fy));
+
+            if (cin == 4)
+            {
+                vst1q_s32(sums, _sum);
+            }
+            else
+            {
+                int tmp[4];
+                vst1q_s32(tmp, _sum);
+                sums[0] = tmp[0];
+                sums[1] = tmp[1];
+                sums[2] = tmp[2];
+            }
+            return;
+        }
+#endif // __SSE2__
+    }
+    else
+    {
+        if (border_type == BORDER_CONSTANT && (sx < -1 || sy < -1 || sx >= srcw || sy >= srch))
+        {
+            for (int k = 0; k < cin; k++)
+            {
+                sums[k] = border[k] << 16;
+            }
+            return;
+        }
+
+        const int sx1 = sx + 1;
+        const int sy1 = sy + 1;
+
+        if (border_type == BORDER_REPLICATE)
+        {
+            const int cx0 = std::min(std::max(sx, 0), srcw - 1);
+            const int cx1 = std::min(std::max(sx1, 0), srcw - 1);
+            const int cy0 = std::min(std::max(sy, 0), srch - 1);
+            const int cy1 = std::min(std::max(sy1, 0), srch - 1);
+
+            p00 = src + (cy0 * srcw + cx0) * cin;
+            p01 = src + (cy0 * srcw + cx1) * cin;
+            p10 = src + (cy1 * srcw + cx0) * cin;
+            p11 = src + (cy1 * srcw + cx1) * cin;
+        }
+        else
+        {
+            const bool x0in = sx >= 0 && sx < srcw;
+            const bool x1in = sx1 >= 0 && sx1 < srcw;
+            const bool y0in = sy >= 0 && sy < srch;
+            const bool y1in = sy1 >= 0 && sy1 < srch;
+
+            p00 = x0in && y0in ? src + (sy * srcw + sx) * cin : border;
+            p01 = x1in && y0in ? src + (sy * srcw + sx1) * cin : border;
+            p10 = x0in && y1in ? src + (sy1 * srcw + sx) * cin : border;
+            p11 = x1in && y1in ? src + (sy1 * srcw + sx1) * cin : border;
+        }
+    }
+
+    for (int k = 0; k < cin; k++)
+    {
+        int h0 = (p00[k] * (warp_inter_scale - fx) + p01[k] * fx) >> 4;
+        int h1 = (p10[k] * (warp_inter_scale - fx) + p11[k] * fx) >> 4;
+
+        sums[k] = h0 * (warp_inter_scale - fy) + h1 * fy;
+    }
+}
+
+// channel values of a destination row, cin per pixel, see warp_sample_pixel
+template<int cin>
+static void warp_sample_row(const unsigned char* src, int srcw, int srch, const int* xs, const int* ys, int outw, int border_type, const unsigned char* border, int* sums)
+{
+    int x = 0;
+#if __SSE2__ || __ARM_NEON
+    if (cin == 1)
+    {
+        // 4 pixels at a time, when all their taps are inside the source
+        for (; x + 3 < outw; x += 4)
+        {
+            int ofs[4];
+            int fx[4];
+            int fy[4];
+
+            int i = 0;
+            for (; i < 4; i++)
+            {
+                const int sx = xs[x + i] >> warp_inter_bits;
+                const int sy = ys[x + i] >> warp_inter_bits;
+                if (sx < 0 || sy < 0 || sx >= srcw - 1 || sy >= srch - 1)
+                    break;
+
+                ofs[i] = sy * srcw + sx;
+                fx[i] = xs[x + i] & (warp_inter_scale - 1);
+                fy[i] = ys[x + i] & (warp_inter_scale - 1);
+            }
+
+            if (i < 4)
+            {
+                for (i = 0; i < 4; i++)
+                {
+                    warp_sample_pixel<1>(src, srcw, srch, xs[x + i], ys[x + i], border_type, border, sums + x + i);
+                }
+                continue;
+            }
+
+            const unsigned char* r0 = src;
+            const unsigned char* r1 = src + srcw;
+#if __SSE2__
+            __m128i _r0 = _mm_setr_epi16(r0[ofs[0]], r0[ofs[0] + 1], r0[ofs[1]], r0[ofs[1] + 1], r0[ofs[2]], r0[ofs[2] + 1], r0[ofs[3]], r0[ofs[3] + 1]);
+            __m128i _r1 = _mm_setr_epi16(r1[ofs[0]], r1[ofs[0] + 1], r1[ofs[1]], r1[ofs[1] + 1], r1[ofs[2]], r1[ofs[2] + 1], r1[ofs[3]], r1[ofs[3] + 1]);
+            __m128i _wx = _mm_setr_epi16(warp_inter_scale - fx[0], fx[0], warp_inter_scale - fx[1], fx[1], warp_inter_scale - fx[2], fx[2], warp_inter_scale - fx[3], fx[3]);
+            __m128i _wy = _mm_setr_epi16(warp_inter_scale - fy[0], fy[0], warp_inter_scale - fy[1], fy[1], warp_inter_scale - fy[2], fy[2], warp_inter_scale - fy[3], fy[3]);
+
+            __m128i _h0 = _mm_srai_epi32(_mm_madd_epi16(_r0, _wx), 4);
+            __m128i _h1 = _mm_srai_epi32(_mm_madd_epi16(_r1, _wx), 4);
+
+            __m128i _h = _mm_packs_epi32(_h0, _h1);
+            _h = _mm_unpacklo_epi16(_h, _mm_srli_si128(_h, 8));
+            _mm_storeu_si128((__m128i*)(sums + x), _mm_madd_epi16(_h, _wy));
+#else
+            unsigned short p00[4];
+            unsigned short p01[4];
+            unsigned short p10[4];
+            unsigned short p11[4];
+            unsigned short wx0[4];
+            unsigned short wx1[4];
+            unsigned int wy0[4];
+            unsigned int wy1[4];
+            for (i = 0; i < 4; i++)
+            {
+                p00[i] = r0[ofs[i]];
+                p01[i] = r0[ofs[i] + 1];
+                p10[i] = r1[ofs[i]];
+                p11[i] = r1[ofs[i] + 1];
+                wx0[i] = warp_inter_scale - fx[i];
+                wx1[i] = fx[i];
+                wy0[i] = warp_inter_scale - fy[i];
+                wy1[i] = fy[i];
+            }
+
+            uint16x4_t _wx0 = vld1_u16(wx0);
+            uint16x4_t _wx1 = vld1_u16(wx1);
+            uint32x4_t _h0 = vshrq_n_u32(vmlal_u16(vmull_u16(vld1_u16(p00), _wx0), vld1_u16(p01), _wx1), 4);
+            uint32x4_t _h1 = vshrq_n_u32(vmlal_u16(vmull_u16(vld1_u16(p10), _wx0), vld1_u16(p11), _wx1), 4);
+            uint32x4_t _sum = vmlaq_u32(vmulq_u32(_h0, vld1q_u32(wy0)), _h1, vld1q_u32(wy1));
+            vst1q_s32(sums + x, vreinterpretq_s32_u32(_sum));
+#endif // __SSE2__
+        }
+    }
+#endif // __SSE2__ || __ARM_NEON
+    for (; x < outw; x++)
+    {
+        warp_sample_pixel<cin>(src, srcw, srch, xs[x], ys[x], border_type, border, sums + x * cin);
+    }
+}
+
+// arguments of the loop bodies run by parallel_for
+struct warp_bilinear_args
+{
+    const unsigned char* src;
+    int srcw;
+    int srch;
+    unsigned char* dst;
+    int w;
+    int h;
+    const float* m;
+    bool perspective;
+    int type;
+    const unsigned char* border;
+    // source coordinates and fixed point sums of a row, one row per worker
+    Mat* rowsbuf;
+    int workers;
+};
+
+// worker t warps a contiguous run of rows with its own row buffers
+template<int cin>
+static void warp_bilinear_worker(int t, void* userdata)
+{
+    const warp_bilinear_args* args = (const warp_bilinear_args*)userdata;
+    const int w = args->w;
+
+    const int start = (int)((long long)args->h * t / args->workers);
+    const int end = (int)((long long)args->h * (t + 1) / args->workers);
+
+    int* xs = args->rowsbuf->row<int>(t);
+    int* ys = xs + w;
+    int* sums = ys + w;
+
+    for (int y = start; y < end; y++)
+    {
+        warp_row_coords(args->m, args->perspective, y, w, xs, ys);
+
+        warp_sample_row<cin>(args->src, args->srcw, args->srch, xs, ys, w, args->type, args->border, sums);
+
+        // round the fixed point sums to bytes
+        unsigned char* outptr = args->dst + y * w * cin;
+
+        const int size = w * cin;
+
+        int i = 0;
+#if __SSE2__
+        __m128i _round = _mm_set1_epi32(1 << 15);
+        for (; i + 7 < size; i += 8)
+        {
+            __m128i _s0 = _mm_srai_epi32(_mm_add_epi32(_mm_loadu_si128((const __m128i*)(sums + i)), _round), 16);
+            __m128i _s1 = _mm_srai_epi32(_mm_add_epi32(_mm_loadu_si128((const __m128i*)(sums + i + 4)), _round), 16);
+            __m128i _s = _mm_packs_epi32(_s0, _s1);
+            _mm_storel_epi64((__m128i*)(outptr + i), _mm_packus_epi16(_s, _s));
+        }
+#elif __ARM_NEON
+        for (; i + 7 < size; i += 8)
+        {
+            uint16x4_t _s0 = vqrshrun_n_s32(vld1q_s32(sums + i), 16);
+            uint16x4_t _s1 = vqrshrun_n_s32(vld1q_s32(sums + i + 4), 16);
+            vst1_u8(outptr + i, vqmovn_u16(vcombine_u16(_s0, _s1)));
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            outptr[i] = (unsigned char)((sums[i] + (1 << 15)) >> 16);
+        }
+    }
+}
+
+template<int cin>
+static void warp_bilinear(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, bool perspective, int type, unsigned int v, int num_threads)
+{
+    float m[9];
+    if (!invert_warp_matrix(tm, perspective, m))
+        return;
+
+    const unsigned char border[4] = { (unsigned char)(v & 0xff), (unsigned char)((v >> 8) & 0xff), (unsigned char)((v >> 16) & 0xff), (unsigned char)((v >> 24) & 0xff) };
+
+    Option opt = get_default_option();
+    opt.num_threads = num_threads;
+
+    // row buffers allocated once per worker, each worker takes a contiguous run of rows
+    const int workers = std::max(1, std::min(num_threads, h));
+
+    Mat rowsbuf(w * (2 + cin), workers, 4u, opt.workspace_allocator);
+    if (rowsbuf.empty())
+        return;
+
+    warp_bilinear_args args = { src, srcw, srch, dst, w, h, m, perspective, type, border, &rowsbuf, workers };
+    parallel_for(workers, warp_bilinear_worker<cin>, &args, opt);
+}
+
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<1>(src, srcw, srch, dst, w, h, tm, false, type, v, num_threads);
+}
+
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<3>(src, srcw, srch, dst, w, h, tm, false, type, v, num_threads);
+}
+
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<4>(src, srcw, srch, dst, w, h, tm, false, type, v, num_threads);
+}
+
+void warpperspective_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<1>(src, srcw, srch, dst, w, h, tm, true, type, v, num_threads);
+}
+
+void warpperspective_bilinear_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<3>(src, srcw, srch, dst, w, h, tm, true, type, v, num_threads);
+}
+
+void warpperspective_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v, int num_threads)
+{
+    warp_bilinear<4>(src, srcw, srch, dst, w, h, tm, true, type, v, num_threads);
+}
+
+
+// arguments of the loop body run by parallel_for
+struct warp_pixel_sampler_args
+{
+    const pixel_sampler* s;
+    const float* m;
+    bool perspective;
+    int border_type;
+    const unsigned char* border;
+    Mat* out;
+    const float* mean;
+    const float* norm;
+    // source coordinates, fixed point sums and float planes of a row, one row per worker
+    Mat* rowsbuf;
+    int workers;
+};
+
+// worker t warps a contiguous run of rows into cin float planes, then converts and normalizes them through the pixel sampler
+template<int cin>
+static void warp_pixel_sampler_worker(int t, void* userdata)
+{
+    const warp_pixel_sampler_args* args = (const warp_pixel_sampler_args*)userdata;
+    const pixel_sampler& s = *args->s;
+    Mat& out = *args->out;
+
+    const int outw = out.w;
+
+    const int start = (int)((long long)out.h * t / args->workers);
+    const int end = (int)((long long)out.h * (t + 1) / args->workers);
+
+    int* xs = args->rowsbuf->row<int>(t);
+    int* ys = xs + outw;
+    int* sums = ys + outw;
+    float* blend = (float*)(sums + outw * cin);
+
+    for (int y = start; y < end; y++)
+    {
+        warp_row_coords(args->m, args->perspective, y, outw, xs, ys);
+
+        warp_sample_row<cin>(s.pixels, s.w, s.h, xs, ys, outw, args->border_type, args->border, sums);
+
+        for (int x = 0; x < outw; x++)
+        {
+            for (int k = 0; k < cin; k++)
+            {
+                blend[k * outw + x] = sums[x * cin + k] * (1.f / 65536);
+            }
+        }
+
+        pixel_sampler_store_row(s, blend, outw, out, y, args->mean, args->norm);
+    }
+}
+
+// return 0 if success
+template<int cin>
+static int warp_pixel_sampler(const pixel_sampler& s, const float* m, bool perspective, int border_type, const unsigned char* border, Mat& out, const float* mean, const float* norm, int num_threads)
+{
+    Option opt = get_default_option();
+    opt.num_threads = num_threads;
+
+    // row buffers allocated once per worker, each worker takes a contiguous run of rows
+    const int workers = std::max(1, std::min(num_threads, out.h));
+
+    Mat rowsbuf(out.w * (2 + cin * 2), workers, 4u, opt.workspace_allocator);
+    if (rowsbuf.empty())
+        return -100;
+
+    warp_pixel_sampler_args args = { &s, m, perspective, border_type, border, &out, mean, norm, &rowsbuf, workers };
+    parallel_for(workers, warp_pixel_sampler_worker<cin>, &args, opt);
+
+    return 0;
+}
+
+static Mat from_pixels_warp(const unsigned char* pixels, int type, int w, int h, const float* tm, bool perspective, int target_width, int target_height, int border_type, unsigned int border_value, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    if (target_width <= 0 || target_height <= 0)
+        return Mat();
+
+    pixel_sampler s;
+    if (!init_pixel_sampler(s, pixels, type, w, h) || s.yuv)
+        return Mat();
+
+    float m[9];
+    if (!invert_warp_matrix(tm, perspective, m))
+        return Mat();
+
+    Mat out(target_width, target_height, s.cout, 4u, allocator);
+    if (out.empty())
+        return out;
+
+    float mean[4];
+    float norm[4];
+    pixel_sampler_mean_norm(s, mean_vals, norm_vals, mean, norm);
+
+    // border bytes are in source channel order
+    const unsigned char border[4] = { (unsigned char)(border_value & 0xff), (unsigned char)((border_value >> 8) & 0xff), (unsigned char)((border_value >> 16) & 0xff), (unsigned char)((border_value >> 24) & 0xff) };
+
+    int ret;
+    if (s.cin == 1)
+        ret = warp_pixel_sampler<1>(s, m, perspective, border_type, border, out, mean, norm, num_threads);
+    else if (s.cin == 3)
+        ret = warp_pixel_sampler<3>(s, m, perspective, border_type, border, out, mean, norm, num_threads);
+    else
+        ret = warp_pixel_sampler<4>(s, m, perspective, border_type, border, out, mean, norm, num_threads);
+
+    if (ret != 0)
+        return Mat();
+
+    return out;
+}
+
+Mat Mat::from_pixels_warpaffine(const unsigned char* pixels, int type, int w, int h, const float* tm, int target_width, int target_height, int border_type, unsigned int border_value, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    return from_pixels_warp(pixels, type, w, h, tm, false, target_width, target_height, border_type, border_value, mean_vals, norm_vals, allocator, num_threads);
+}
+
+Mat Mat::from_pixels_warpperspective(const unsigned char* pixels, int type, int w, int h, const float* tm, int target_width, int target_height, int border_type, unsigned int border_value, const float* mean_vals, const float* norm_vals, Allocator* allocator, int num_threads)
+{
+    return from_pixels_warp(pixels, type, w, h, tm, true, target_width, target_height, border_type, border_value, mean_vals, norm_vals, allocator, num_threads);
+}
+#endif // NCNN_PIXEL
+
+// arguments of the loop body run by parallel_for
+struct warp_bilinear_mat_args
+{
+    const Mat* src;
+    Mat* dst;
+    const float* m;
+    bool perspective;
+    int type;
+    float v;
+    // source coordinates of a row, one row per worker
+    Mat* rowsbuf;
+    int workers;
+};
+
+// worker t warps a contiguous run of rows of each channel with the fixed point source coordinates of the pixel warp
+static void warp_bilinear_mat_worker(int t, void* userdata)
+{
+    const warp_bilinear_mat_args* args = (const warp_bilinear_mat_args*)userdata;
+    const Mat& src = *args->src;
+    Mat& dst = *args->dst;
+    const int type = args->type;
+    const float v = args->v;
+
+    const int srcw = src.w;
+    const int srch = src.h;
+    const int outw = dst.w;
+    const int channels = dst.c;
+
+    const int start = (int)((long long)dst.h * t / args->workers);
+    const int end = (int)((long long)dst.h * (t + 1) / args->workers);
+
+    int* xs = args->rowsbuf->row<int>(t);
+    int* ys = xs + outw;
+
+    for (int y = start; y < end; y++)
+    {
+        warp_row_coords(args->m, args->perspective, y, outw, xs, ys);
+
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = src.channel(q);
+            float* outptr = dst.channel(q).row(y);
+
+            for (int x = 0; x < outw; x++)
+            {
+                const int sx = xs[x] >> warp_inter_bits;
+                const int sy = ys[x] >> warp_inter_bits;
+                const float fx = (xs[x] & (warp_inter_scale - 1)) * (1.f / warp_inter_scale);
+                const float fy = (ys[x] & (warp_inter_scale - 1)) * (1.f / warp_inter_scale);
+
+                float v00;
+                float v01;
+                float v10;
+                float v11;
+
+                if (sx >= 0 && sy >= 0 && sx < srcw - 1 && sy < srch - 1)
+                {
+                    const float* p = ptr + sy * srcw + sx;
+
+                    v00 = p[0];
+                    v01 = p[1];
+                    v10 = p[srcw];
+                    v11 = p[srcw + 1];
+                }
+                else if (type == BORDER_CONSTANT && (sx < -1 || sy < -1 || sx >= srcw || sy >= srch))
+                {
+                    outptr[x] = v;
+                    continue;
+                }
+                else if (type == BORDER_REPLICATE)
+                {
+                    const int cx0 = std::min(std::max(sx, 0), srcw - 1);
+                    const int cx1 = std::min(std::max(sx + 1, 0), srcw - 1);
+                    const int cy0 = std::min(std::max(sy, 0), srch - 1);
+                    const int cy1 = std::min(std::max(sy + 1, 0), srch - 1);
+
+                    v00 = ptr[cy0 * srcw + cx0];
+                    v01 = ptr[cy0 * srcw + cx1];
+                    v10 = ptr[cy1 * srcw + cx0];
+                    v11 = ptr[cy1 * srcw + cx1];
+                }
+                else
+                {
+                    const bool x0in = sx >= 0 && sx < srcw;
+                    const bool x1in = sx + 1 >= 0 && sx + 1 < srcw;
+                    const bool y0in = sy >= 0 && sy < srch;
+                    const bool y1in = sy + 1 >= 0 && sy + 1 < srch;
+
+                    v00 = x0in && y0in ? ptr[sy * srcw + sx] : v;
+                    v01 = x1in && y0in ? ptr[sy * srcw + sx + 1] : v;
+                    v10 = x0in && y1in ? ptr[(sy + 1) * srcw + sx] : v;
+                    v11 = x1in && y1in ? ptr[(sy + 1) * srcw + sx + 1] : v;
+                }
+
+                outptr[x] = (v00 * (1.f - fx) + v01 * fx) * (1.f - fy) + (v10 * (1.f - fx) + v11 * fx) * fy;
+            }
+        }
+    }
+}
+
+// return 0 if success
+static int warp_bilinear_mat(const Mat& src, Mat& dst, const float* m, bool perspective, int type, float v, int num_threads)
+{
+    Option opt = get_default_option();
+    opt.num_threads = num_threads;
+
+    // row buffers allocated once per worker, each worker takes a contiguous run of rows
+    const int workers = std::max(1, std::min(num_threads, dst.h));
+
+    Mat rowsbuf(dst.w * 2, workers, 4u, opt.workspace_allocator);
+    if (rowsbuf.empty())
+        return -100;
+
+    warp_bilinear_mat_args args = { &src, &dst, m, perspective, type, v, &rowsbuf, workers };
+    parallel_for(workers, warp_bilinear_mat_worker, &args, opt);
+
+    return 0;
+}
+
+static void warp_mat(const Mat& src, Mat& dst, int w, int h, const float* tm, bool perspective, int type, float v, Allocator* allocator, int num_threads)
+{
+    if (src.elemsize != 4)
+    {
+        fprintf(stderr, "warp of elemsize %d is not supported, float Mat only\n", (int)src.elemsize);
+        dst.release();
+        return;
+    }
+
+    float m[9];
+    if (!invert_warp_matrix(tm, perspective, m))
+    {
+        dst.release();
+        return;
+    }
+
+    if (src.dims == 2)
+    {
+        dst.create(w, h, src.elemsize, allocator);
+    }
+    else if (src.dims == 3)
+    {
+        dst.create(w, h, src.c, src.elemsize, allocator);
+    }
+    else
+    {
+        dst.release();
+        return;
+    }
+
+    if (dst.empty())
+        return;
+
+    if (warp_bilinear_mat(src, dst, m, perspective, type, v, num_threads) != 0)
+        dst.release();
+}
+
+void warpaffine_bilinear(const Mat& src, Mat& dst, int w, int h, const float* tm, int type, float v, Allocator* allocator, int num_threads)
+{
+    warp_mat(src, dst, w, h, tm, false, type, v, allocator, num_threads);
+}
+
+void warpperspective_bilinear(const Mat& src, Mat& dst, int w, int h, const float* tm, int type, float v, Allocator* allocator, int num_threads)
+{
+    warp_mat(src, dst, w, h, tm, true, type, v, allocator, num_threads);
+}
+
 } // namespace ncnn
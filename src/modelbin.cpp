@@ -39,9 +39,19 @@ Mat ModelBin::load(int w, int h, int c, int type) const
     return m.reshape(w, h, c);
 }
 
+Allocator* ModelBin::weight_allocator() const
+{
+    return 0;
+}
+
 #if NCNN_STDIO
-ModelBinFromStdio::ModelBinFromStdio(FILE* _binfp) : binfp(_binfp)
+ModelBinFromStdio::ModelBinFromStdio(FILE* _binfp, Allocator* _allocator) : binfp(_binfp), allocator(_allocator)
+{
+}
+
+Allocator* ModelBinFromStdio::weight_allocator() const
 {
+    return allocator;
 }
 
 Mat ModelBinFromStdio::load(int w, int type) const
@@ -87,7 +97,7 @@ Mat ModelBinFromStdio::load(int w, int type) const
                 return Mat();
             }
 
-            return Mat::from_float16(float16_weights.data(), w);
+            return Mat::from_float16(float16_weights.data(), w, allocator);
         }
         else if (flag_struct.tag == 0x000D4B38)
         {
@@ -102,7 +112,7 @@ Mat ModelBinFromStdio::load(int w, int type) const
                 return Mat();
             }
 
-            Mat m(w, (size_t)1u);
+            Mat m(w, (size_t)1u, allocator);
             if (m.empty())
                 return m;
 
@@ -112,7 +122,7 @@ Mat ModelBinFromStdio::load(int w, int type) const
         }
         else if (flag_struct.tag == 0x0002C056)
         {
-            Mat m(w);
+            Mat m(w, 4u, allocator);
             if (m.empty())
                 return m;
 
@@ -127,7 +137,7 @@ Mat ModelBinFromStdio::load(int w, int type) const
             return m;
         }
 
-        Mat m(w);
+        Mat m(w, 4u, allocator);
         if (m.empty())
             return m;
 
@@ -173,7 +183,7 @@ Mat ModelBinFromStdio::load(int w, int type) const
     }
     else if (type == 1)
     {
-        Mat m(w);
+        Mat m(w, 4u, allocator);
         if (m.empty())
             return m;
 
@@ -197,10 +207,15 @@ Mat ModelBinFromStdio::load(int w, int type) const
 }
 #endif // NCNN_STDIO
 
-ModelBinFromMemory::ModelBinFromMemory(const unsigned char*& _mem) : mem(_mem)
+ModelBinFromMemory::ModelBinFromMemory(const unsigned char*& _mem, Allocator* _allocator) : mem(_mem), allocator(_allocator)
 {
 }
 
+Allocator* ModelBinFromMemory::weight_allocator() const
+{
+    return allocator;
+}
+
 Mat ModelBinFromMemory::load(int w, int type) const
 {
     if (!mem)
@@ -228,7 +243,7 @@ Mat ModelBinFromMemory::load(int w, int type) const
         if (flag_struct.tag == 0x01306B47)
         {
             // half-precision data
-            Mat m = Mat::from_float16((unsigned short*)mem, w);
+            Mat m = Mat::from_float16((unsigned short*)mem, w, allocator);
             mem += alignSize(w * sizeof(unsigned short), 4);
             return m;
         }
@@ -256,7 +271,7 @@ Mat ModelBinFromMemory::load(int w, int type) const
             const unsigned char* index_array = (const unsigned char*)mem;
             mem += alignSize(w * sizeof(unsigned char), 4);
 
-            Mat m(w);
+            Mat m(w, 4u, allocator);
             if (m.empty())
                 return m;
 
@@ -294,6 +309,12 @@ Mat ModelBinFromMemory::load(int w, int type) const
 
 ModelBinFromMatArray::ModelBinFromMatArray(const Mat* _weights) : weights(_weights)
 {
+    allocator = weights[0].allocator;
+}
+
+Allocator* ModelBinFromMatArray::weight_allocator() const
+{
+    return allocator;
 }
 
 Mat ModelBinFromMatArray::load(int /*w*/, int /*type*/) const
@@ -36,6 +36,10 @@ public:
     virtual Mat load(int w, int h, int type) const;
     // load dim
     virtual Mat load(int w, int h, int c, int type) const;
+
+    // allocator of the weight data, kernels transformed at load time use it too
+    // null for the plain fastMalloc
+    virtual Allocator* weight_allocator() const;
 };
 
 #if NCNN_STDIO
@@ -43,12 +47,16 @@ class ModelBinFromStdio : public ModelBin
 {
 public:
     // construct from file
-    ModelBinFromStdio(FILE* binfp);
+    // weight data is allocated from allocator, pass 0 for the plain fastMalloc
+    ModelBinFromStdio(FILE* binfp, Allocator* allocator = 0);
 
     virtual Mat load(int w, int type) const;
 
+    virtual Allocator* weight_allocator() const;
+
 protected:
     FILE* binfp;
+    Allocator* allocator;
 };
 #endif // NCNN_STDIO
 
@@ -56,24 +64,32 @@ class ModelBinFromMemory : public ModelBin
 {
 public:
     // construct from external memory
-    ModelBinFromMemory(const unsigned char*& mem);
+    // converted weight data is allocated from allocator, pass 0 for the plain fastMalloc
+    ModelBinFromMemory(const unsigned char*& mem, Allocator* allocator = 0);
 
     virtual Mat load(int w, int type) const;
 
+    virtual Allocator* weight_allocator() const;
+
 protected:
     const unsigned char*& mem;
+    Allocator* allocator;
 };
 
 class ModelBinFromMatArray : public ModelBin
 {
 public:
     // construct from weight blob array
+    // transformed kernels follow the allocator of the first weight
     ModelBinFromMatArray(const Mat* weights);
 
     virtual Mat load(int w, int type) const;
 
+    virtual Allocator* weight_allocator() const;
+
 protected:
     mutable const Mat* weights;
+    Allocator* allocator;
 };
 
 } // namespace ncnn
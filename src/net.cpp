@@ -13,17 +13,39 @@
 // specific language governing permissions and limitations under the License.
 
 #include "net.h"
+#include "cpu.h"
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
 
+#include "layer/clip.h"
+#include "layer/concat.h"
+#include "layer/convolution.h"
+#include "layer/convolutiondepthwise.h"
+#include "layer/relu.h"
+#include "layer/shufflechannel.h"
+
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif // _OPENMP
 
+#if NCNN_STDIO
+#if defined __linux__ || defined __ANDROID__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined _WIN32
+#include <windows.h>
+#else
+#include <stdlib.h>
+#endif
+#endif // NCNN_STDIO
+
 #if NCNN_BENCHMARK
 #include "benchmark.h"
 #endif // NCNN_BENCHMARK
@@ -35,6 +57,13 @@ Net::Net()
     use_winograd_convolution = 1;
     use_sgemm_convolution = 1;
     use_int8_inference = 1;
+    use_layer_fusion = 1;
+    weight_allocator = 0;
+    use_numa_replication = 0;
+    thread_pool = 0;
+    autotune_cache = 0;
+    container_data = 0;
+    container_size = 0;
 }
 
 Net::~Net()
@@ -97,6 +126,72 @@ int Net::register_custom_layer(int index, layer_creator_func creator)
     return 0;
 }
 
+#if NCNN_STRING
+static const std::string& entry_name(const Blob& blob)
+{
+    return blob.name;
+}
+
+static const std::string& entry_name(const Layer* layer)
+{
+    return layer->name;
+}
+
+// fnv-1a
+static unsigned int name_hash(const char* name)
+{
+    unsigned int h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++)
+    {
+        h = (h ^ *p) * 16777619u;
+    }
+
+    return h;
+}
+
+// open addressing table of entry indexes, -1 for empty slots, at most half full
+static void init_name_index(std::vector<int>& index, int count)
+{
+    size_t size = 16;
+    while (size < (size_t)count * 2)
+        size *= 2;
+
+    index.assign(size, -1);
+}
+
+template<typename T>
+static int find_name_index(const std::vector<int>& index, const std::vector<T>& entries, const char* name)
+{
+    if (index.empty())
+        return -1;
+
+    const size_t mask = index.size() - 1;
+    for (size_t slot = name_hash(name) & mask; index[slot] != -1; slot = (slot + 1) & mask)
+    {
+        if (entry_name(entries[index[slot]]) == name)
+            return index[slot];
+    }
+
+    return -1;
+}
+
+// the first entry of a duplicated name wins, as with a linear scan
+template<typename T>
+static void insert_name_index(std::vector<int>& index, const std::vector<T>& entries, int i)
+{
+    const char* name = entry_name(entries[i]).c_str();
+    if (find_name_index(index, entries, name) != -1)
+        return;
+
+    const size_t mask = index.size() - 1;
+    size_t slot = name_hash(name) & mask;
+    while (index[slot] != -1)
+        slot = (slot + 1) & mask;
+
+    index[slot] = i;
+}
+#endif // NCNN_STRING
+
 #if NCNN_STDIO
 #if NCNN_STRING
 int Net::load_param(FILE* fp)
@@ -117,6 +212,8 @@ int Net::load_param(FILE* fp)
     layers.resize(layer_count);
     blobs.resize(blob_count);
 
+    init_name_index(blob_name_index, blob_count);
+
     ParamDict pd;
     pd.use_winograd_convolution = use_winograd_convolution;
     pd.use_sgemm_convolution = use_sgemm_convolution;
@@ -174,6 +271,8 @@ int Net::load_param(FILE* fp)
                 blob.name = std::string(bottom_name);
 //                 fprintf(stderr, "new blob %s\n", bottom_name);
 
+                insert_name_index(blob_name_index, blobs, bottom_blob_index);
+
                 blob_index++;
             }
 
@@ -199,6 +298,8 @@ int Net::load_param(FILE* fp)
             blob.name = std::string(blob_name);
 //             fprintf(stderr, "new blob %s\n", blob_name);
 
+            insert_name_index(blob_name_index, blobs, blob_index);
+
             blob.producer = i;
 
             layer->tops[j] = blob_index;
@@ -222,8 +323,23 @@ int Net::load_param(FILE* fp)
         }
 
         layers[i] = layer;
+
+        if (use_numa_replication && create_layer_replicas(i, pd) != 0)
+        {
+            clear();
+            return -1;
+        }
+    }
+
+    init_name_index(layer_name_index, layer_count);
+    for (int i=0; i<layer_count; i++)
+    {
+        if (layers[i])
+            insert_name_index(layer_name_index, layers, i);
     }
 
+    fuse_network();
+
     return 0;
 }
 
@@ -247,6 +363,8 @@ int Net::load_param_mem(const char* _mem){
     layers.resize(layer_count);
     blobs.resize(blob_count);
 
+    init_name_index(blob_name_index, blob_count);
+
     ParamDict pd;
     pd.use_winograd_convolution = use_winograd_convolution;
     pd.use_sgemm_convolution = use_sgemm_convolution;
@@ -304,6 +422,8 @@ int Net::load_param_mem(const char* _mem){
                 blob.name = std::string(bottom_name);
 //                 fprintf(stderr, "new blob %s\n", bottom_name);
 
+                insert_name_index(blob_name_index, blobs, bottom_blob_index);
+
                 blob_index++;
             }
 
@@ -329,6 +449,8 @@ int Net::load_param_mem(const char* _mem){
             blob.name = std::string(blob_name);
 //             fprintf(stderr, "new blob %s\n", blob_name);
 
+            insert_name_index(blob_name_index, blobs, blob_index);
+
             blob.producer = i;
 
             layer->tops[j] = blob_index;
@@ -352,8 +474,23 @@ int Net::load_param_mem(const char* _mem){
         }
 
         layers[i] = layer;
+
+        if (use_numa_replication && create_layer_replicas(i, pd) != 0)
+        {
+            clear();
+            return -1;
+        }
+    }
+
+    init_name_index(layer_name_index, layer_count);
+    for (int i=0; i<layer_count; i++)
+    {
+        if (layers[i])
+            insert_name_index(layer_name_index, layers, i);
     }
 
+    fuse_network();
+
     return 0;
 }
 int Net::load_param(const char* protopath)
@@ -470,8 +607,16 @@ int Net::load_param_bin(FILE* fp)
         }
 
         layers[i] = layer;
+
+        if (use_numa_replication && create_layer_replicas(i, pd) != 0)
+        {
+            clear();
+            return -1;
+        }
     }
 
+    fuse_network();
+
     return 0;
 }
 
@@ -502,20 +647,36 @@ int Net::load_model(FILE* fp)
     // load file
     int ret = 0;
 
-    ModelBinFromStdio mb(fp);
-    for (size_t i=0; i<layers.size(); i++)
+    // numa replicas read the same weight data again, onto their own node
+    create_numa_allocators();
+
+    const long model_offset = ftell(fp);
+
+    for (size_t n=0; n<=replica_layers.size() && ret == 0; n++)
     {
-        Layer* layer = layers[i];
+        if (n > 0)
+            fseek(fp, model_offset, SEEK_SET);
 
-        int lret = layer->load_model(mb);
-        if (lret != 0)
+        const std::vector<Layer*>& node_layers = n == 0 ? layers : replica_layers[n - 1];
+
+        ModelBinFromStdio mb(fp, numa_allocators.empty() ? weight_allocator : numa_allocators[n]);
+        for (size_t i=0; i<node_layers.size(); i++)
         {
-            fprintf(stderr, "layer load_model %d failed\n", (int)i);
-            ret = -1;
-            break;
+            Layer* layer = node_layers[i];
+
+            int lret = layer->load_model(mb);
+            if (lret != 0)
+            {
+                fprintf(stderr, "layer load_model %d failed\n", (int)i);
+                ret = -1;
+                break;
+            }
         }
     }
 
+    if (ret == 0)
+        fold_constants();
+
     return ret;
 }
 
@@ -643,184 +804,1097 @@ int Net::load_param(const unsigned char* _mem)
         }
 
         layers[i] = layer;
+
+        if (use_numa_replication && create_layer_replicas(i, pd) != 0)
+        {
+            clear();
+            return 0;
+        }
     }
 
+    fuse_network();
+
     return mem - _mem;
 }
 
-int Net::load_model(const unsigned char* _mem)
+// container written by Net::save_container
+// header of magic, version, target and flags, then offset and size of the binary param, names,
+// model, transformed weight and blob shape sections, all 16 byte aligned
+static const int container_magic = 7767518;
+// bump on any change of the header, the sections or a transformed weight layout
+static const int container_version = 2;
+static const int container_header_size = 64;
+static const int container_section_count = 5;
+
+// layer implementations and instruction sets the transformed weight data is laid out for
+static int container_target()
 {
-    if (layers.empty())
+#if __aarch64__
+    int target = 3;
+#elif __arm__
+    int target = 2;
+#else
+    int target = 1;
+#endif
+
+#if __ARM_NEON
+    target |= 1 << 8;
+#endif
+#if __AVX__
+    target |= 1 << 9;
+#endif
+#if __FMA__
+    target |= 1 << 10;
+#endif
+
+    return target;
+}
+
+// options the layers choose and lay out their transformed weight data by
+static int container_flags(const Net* net)
+{
+    return (net->use_winograd_convolution ? 1 : 0)
+        | (net->use_sgemm_convolution ? 2 : 0)
+        | (net->use_int8_inference ? 4 : 0)
+        | (net->use_layer_fusion ? 8 : 0);
+}
+
+// check the header and the bounds of every section
+// return 0 if success
+static int check_container(const unsigned char* mem, size_t size)
+{
+    if (size < (size_t)container_header_size)
     {
-        fprintf(stderr, "network graph not ready\n");
-        return 0;
+        fprintf(stderr, "container of %lu bytes truncated\n", (unsigned long)size);
+        return -1;
     }
 
-    if ((unsigned long)_mem & 0x3)
+    const int* header = (const int*)mem;
+    if (header[0] != container_magic)
     {
-        // reject unaligned memory
-        fprintf(stderr, "memory not 32-bit aligned at %p\n", _mem);
-        return 0;
+        fprintf(stderr, "container magic %d mismatch\n", header[0]);
+        return -1;
     }
 
-    const unsigned char* mem = _mem;
-    ModelBinFromMemory mb(mem);
-    for (size_t i=0; i<layers.size(); i++)
+    if (header[1] != container_version)
     {
-        Layer* layer = layers[i];
+        fprintf(stderr, "container version %d mismatch, %d expected\n", header[1], container_version);
+        return -1;
+    }
 
-        int lret = layer->load_model(mb);
-        if (lret != 0)
+    // reserved, zero until a new version gives them a meaning
+    for (int i=4 + container_section_count * 2; i<container_header_size / (int)sizeof(int); i++)
+    {
+        if (header[i] != 0)
         {
-            fprintf(stderr, "layer load_model failed\n");
+            fprintf(stderr, "container reserved header field %d not zero\n", i);
             return -1;
         }
     }
 
-    return mem - _mem;
+    for (int i=0; i<container_section_count; i++)
+    {
+        int offset = header[4 + i * 2];
+        int section_size = header[5 + i * 2];
+
+        if (offset < container_header_size || offset % 16 != 0 || section_size < 0 || (size_t)offset + section_size > size)
+        {
+            fprintf(stderr, "container section %d of %d bytes at %d out of bounds\n", i, section_size, offset);
+            return -1;
+        }
+    }
+
+    return 0;
 }
 
-void Net::clear()
+#if NCNN_STDIO
+// read only view of the whole file
+static void* map_file(const char* path, size_t* size)
 {
-    blobs.clear();
-    for (size_t i=0; i<layers.size(); i++)
+#if defined __linux__ || defined __ANDROID__ || defined __APPLE__
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
     {
-        delete layers[i];
+        close(fd);
+        return 0;
     }
-    layers.clear();
+
+    void* data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return 0;
+
+    *size = st.st_size;
+    return data;
+#elif defined _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE)
+        return 0;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return 0;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    CloseHandle(file);
+    if (!mapping)
+        return 0;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (!data)
+        return 0;
+
+    *size = (size_t)file_size.QuadPart;
+    return data;
+#else
+    // no mapping, read into aligned memory
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return 0;
+
+    fseek(fp, 0, SEEK_END);
+    long file_size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    void* data = file_size > 0 ? fastMalloc(file_size) : 0;
+    if (!data || fread(data, 1, file_size, fp) != (size_t)file_size)
+    {
+        if (data)
+            fastFree(data);
+        fclose(fp);
+        return 0;
+    }
+
+    fclose(fp);
+
+    *size = file_size;
+    return data;
+#endif
 }
 
-Extractor Net::create_extractor() const
+static void unmap_file(void* data, size_t size)
 {
-    return Extractor(this, blobs.size());
+#if defined __linux__ || defined __ANDROID__ || defined __APPLE__
+    munmap(data, size);
+#elif defined _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    (void)size;
+    fastFree(data);
+#endif
 }
 
-#if NCNN_STRING
-int Net::find_blob_index_by_name(const char* name) const
+int Net::load_container(const char* path)
 {
-    for (size_t i=0; i<blobs.size(); i++)
+    // the weight data of a previous container is referenced by its layers
+    if (container_data)
+        clear();
+
+    size_t size = 0;
+    void* data = map_file(path, &size);
+    if (!data)
     {
-        const Blob& blob = blobs[i];
-        if (blob.name == name)
-        {
-            return i;
-        }
+        fprintf(stderr, "map container %s failed\n", path);
+        return -1;
     }
 
-    fprintf(stderr, "find_blob_index_by_name %s failed\n", name);
-    return -1;
+    // the header and sections are checked against the file size
+    if (load_container((const unsigned char*)data, size) != 0)
+    {
+        fprintf(stderr, "invalid container %s\n", path);
+        clear();
+        unmap_file(data, size);
+        return -1;
+    }
+
+    container_data = data;
+    container_size = size;
+
+    return 0;
 }
 
-int Net::find_layer_index_by_name(const char* name) const
+// pad the file to the next 16 byte boundary
+// return the offset
+static int align_container_section(FILE* fp)
 {
-    for (size_t i=0; i<layers.size(); i++)
+    int offset = ftell(fp);
+    while (offset % 16)
     {
-        const Layer* layer = layers[i];
-        if (layer->name == name)
-        {
-            return i;
-        }
+        fputc(0, fp);
+        offset++;
     }
 
-    fprintf(stderr, "find_layer_index_by_name %s failed\n", name);
-    return -1;
+    return offset;
 }
 
-int Net::custom_layer_to_index(const char* type)
+int Net::save_container(const char* path, const unsigned char* parambin, int parambin_size, const unsigned char* model, int model_size, Extractor* ex) const
 {
-    const int custom_layer_registry_entry_count = custom_layer_registry.size();
-    for (int i=0; i<custom_layer_registry_entry_count; i++)
+    if (ex && ex->opt.lightmode)
     {
-        if (strcmp(type, custom_layer_registry[i].name) == 0)
-            return i;
+        fprintf(stderr, "blob shapes need an extractor with light mode off\n");
+        return -1;
     }
 
-    return -1;
-}
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
 
-Layer* Net::create_custom_layer(const char* type)
-{
-    int index = custom_layer_to_index(type);
-    if (index == -1)
-        return 0;
+    int header[16] = { container_magic, container_version, container_target(), container_flags(this) };
+    fwrite(header, sizeof(int), 16, fp);
 
-    return create_custom_layer(index);
-}
+    header[4] = align_container_section(fp);
+    fwrite(parambin, 1, parambin_size, fp);
+    header[5] = parambin_size;
+
+    // layer names, then blob names, each null terminated
+    header[6] = align_container_section(fp);
+#if NCNN_STRING
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        fwrite(layers[i]->name.c_str(), 1, layers[i]->name.size() + 1, fp);
+    }
+    for (size_t i=0; i<blobs.size(); i++)
+    {
+        fwrite(blobs[i].name.c_str(), 1, blobs[i].name.size() + 1, fp);
+    }
 #endif // NCNN_STRING
+    header[7] = ftell(fp) - header[6];
 
-Layer* Net::create_custom_layer(int index)
-{
-    const int custom_layer_registry_entry_count = custom_layer_registry.size();
-    if (index < 0 || index >= custom_layer_registry_entry_count)
-        return 0;
+    header[8] = align_container_section(fp);
+    fwrite(model, 1, model_size, fp);
+    header[9] = model_size;
 
-    layer_creator_func layer_creator = custom_layer_registry[index].creator;
-    if (!layer_creator)
-        return 0;
+    // layer index and mat count, then dims w h c elemsize and the 16 byte aligned data of each mat
+    header[10] = align_container_section(fp);
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        std::vector<Mat*> mats;
+        layers[i]->transformed_weights(mats);
+        if (mats.empty())
+            continue;
 
-    return layer_creator();
-}
+        int record[2] = { (int)i, (int)mats.size() };
+        fwrite(record, sizeof(int), 2, fp);
 
-int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt) const
-{
-    const Layer* layer = layers[layer_index];
+        for (size_t j=0; j<mats.size(); j++)
+        {
+            const Mat& m = *mats[j];
 
-//     fprintf(stderr, "forward_layer %d %s\n", layer_index, layer->name.c_str());
+            int shape[5] = { m.dims, m.w, m.h, m.c, (int)m.elemsize };
+            fwrite(shape, sizeof(int), 5, fp);
+            align_container_section(fp);
 
-    if (layer->one_blob_only)
-    {
-        // load bottom blob
-        int bottom_blob_index = layer->bottoms[0];
-        int top_blob_index = layer->tops[0];
+            if (m.dims == 0)
+                continue;
 
-        if (blob_mats[bottom_blob_index].dims == 0)
-        {
-            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
-            if (ret != 0)
-                return ret;
-        }
+            // channels at the cstep a Mat of the same shape has
+            const size_t cstep = m.dims == 3 ? alignSize((size_t)m.w * m.h * m.elemsize, 16) / m.elemsize : (size_t)m.w * m.h;
+            for (int q=0; q<m.c; q++)
+            {
+                const Mat channel = m.channel(q);
+                fwrite(channel.data, m.elemsize, (size_t)m.w * m.h, fp);
 
-        Mat bottom_blob = blob_mats[bottom_blob_index];
+                for (size_t k=(size_t)m.w * m.h * m.elemsize; k<cstep * m.elemsize; k++)
+                {
+                    fputc(0, fp);
+                }
+            }
+            align_container_section(fp);
+        }
+    }
+    header[11] = ftell(fp) - header[10];
 
-        if (opt.lightmode)
+    // input shapes of ex and the shape of each blob its outputs needed
+    header[12] = align_container_section(fp);
+    if (ex)
+    {
+        for (size_t i=0; i<blobs.size(); i++)
         {
-            // delete after taken in light mode
-            blob_mats[bottom_blob_index].release();
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob.refcount != 1)
+            if (blobs[i].consumers.empty() && blobs[i].producer >= 0)
             {
-                bottom_blob = bottom_blob.clone();
+                Mat m;
+                ex->extract(i, m);
             }
         }
 
-        // forward
-        if (opt.lightmode && layer->support_inplace)
-        {
-            Mat& bottom_top_blob = bottom_blob;
-#if NCNN_BENCHMARK
-            double start = get_current_time();
-            int ret = layer->forward_inplace(bottom_top_blob, opt);
-            double end = get_current_time();
-            benchmark(layer, bottom_top_blob, bottom_top_blob, start, end);
-#else
-            int ret = layer->forward_inplace(bottom_top_blob, opt);
-#endif // NCNN_BENCHMARK
-            if (ret != 0)
-                return ret;
+        int input_shape_count = ex->input_shapes.size();
+        fwrite(&input_shape_count, sizeof(int), 1, fp);
+        if (input_shape_count > 0)
+            fwrite(&ex->input_shapes[0], sizeof(int), input_shape_count, fp);
 
-            // store top blob
-            blob_mats[top_blob_index] = bottom_top_blob;
-        }
-        else
+        int blob_count = blobs.size();
+        fwrite(&blob_count, sizeof(int), 1, fp);
+        for (size_t i=0; i<blobs.size(); i++)
         {
-            Mat top_blob;
-#if NCNN_BENCHMARK
+            const Mat& m = ex->blob_mats[i];
+            int shape[5] = { m.dims, m.w, m.h, m.c, (int)m.elemsize };
+            fwrite(shape, sizeof(int), 5, fp);
+        }
+    }
+    header[13] = ftell(fp) - header[12];
+
+    fseek(fp, 0, SEEK_SET);
+    fwrite(header, sizeof(int), 16, fp);
+
+    int ret = ferror(fp) ? -1 : 0;
+    fclose(fp);
+
+    if (ret != 0)
+        fprintf(stderr, "write container %s failed\n", path);
+
+    return ret;
+}
+#endif // NCNN_STDIO
+
+int Net::load_container(const unsigned char* _mem, size_t size)
+{
+    if ((unsigned long)_mem & 15)
+    {
+        // reject unaligned memory, the transformed weight data is read with aligned loads
+        fprintf(stderr, "memory not 16 byte aligned at %p\n", _mem);
+        return -1;
+    }
+
+    if (check_container(_mem, size) != 0)
+        return -1;
+
+    const int* header = (const int*)_mem;
+    const int target = header[2];
+    const int flags = header[3];
+    const int param_offset = header[4];
+    const int param_size = header[5];
+    const int names_offset = header[6];
+    const int names_size = header[7];
+    const int model_offset = header[8];
+    const int model_size = header[9];
+    const int weights_offset = header[10];
+    const int weights_size = header[11];
+    const int shapes_offset = header[12];
+    const int shapes_size = header[13];
+
+    // the binary param is read without bound, what it consumed is checked after
+    int consumed = load_param(_mem + param_offset);
+    if (consumed == 0 || consumed > param_size)
+    {
+        fprintf(stderr, "container param section of %d bytes overrun\n", param_size);
+        return -1;
+    }
+
+#if NCNN_STRING
+    // names are optional, the binary param has none
+    if (names_size > 0)
+    {
+        const char* p = (const char*)(_mem + names_offset);
+        const char* end = p + names_size;
+
+        // every name must end inside the section
+        for (size_t i=0; i<layers.size() + blobs.size(); i++)
+        {
+            const char* nul = p < end ? (const char*)memchr(p, 0, end - p) : 0;
+            if (!nul)
+            {
+                fprintf(stderr, "container name section truncated\n");
+                return -1;
+            }
+
+            if (i < layers.size())
+                layers[i]->name = std::string(p, nul);
+            else
+                blobs[i - layers.size()].name = std::string(p, nul);
+
+            p = nul + 1;
+        }
+
+        init_name_index(layer_name_index, layers.size());
+        for (size_t i=0; i<layers.size(); i++)
+        {
+            insert_name_index(layer_name_index, layers, i);
+        }
+
+        init_name_index(blob_name_index, blobs.size());
+        for (size_t i=0; i<blobs.size(); i++)
+        {
+            insert_name_index(blob_name_index, blobs, i);
+        }
+    }
+#else
+    (void)names_offset;
+    (void)names_size;
+#endif // NCNN_STRING
+
+    // transformed weight data of another target or other options is left to load_model
+    if (weights_size > 0 && target == container_target() && flags == container_flags(this))
+    {
+        if (load_transformed_weights(_mem + weights_offset, weights_size) != 0)
+        {
+            fprintf(stderr, "container transformed weight section invalid\n");
+            return -1;
+        }
+    }
+
+    consumed = load_model(_mem + model_offset);
+    if (layers.empty() || consumed > model_size)
+    {
+        fprintf(stderr, "container model section of %d bytes overrun\n", model_size);
+        return -1;
+    }
+
+    if (shapes_size > 0 && load_blob_shapes(_mem + shapes_offset, shapes_size) != 0)
+    {
+        fprintf(stderr, "container blob shape section invalid\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int Net::load_transformed_weights(const unsigned char* mem, int size)
+{
+    // records of layer index and mat count, then shape and data of each mat
+    const unsigned char* p = mem;
+    while (p - mem < size)
+    {
+        int remain = size - (int)(p - mem);
+        if (remain < 8)
+            return -1;
+
+        const int* record = (const int*)p;
+        const int layer_index = record[0];
+        const int count = record[1];
+        p += 8;
+
+        if (layer_index < 0 || layer_index >= (int)layers.size() || !layers[layer_index])
+            return -1;
+
+        // the numa replicas transform their own copy on their node
+        std::vector<Mat*> mats;
+        layers[layer_index]->transformed_weights(mats);
+        if (count != (int)mats.size())
+            return -1;
+
+        for (int i=0; i<count; i++)
+        {
+            remain = size - (int)(p - mem);
+            if (remain < 20)
+                return -1;
+
+            const int* shape = (const int*)p;
+            const int dims = shape[0];
+            const int w = shape[1];
+            const int h = shape[2];
+            const int c = shape[3];
+            const int elemsize = shape[4];
+
+            // data starts 16 byte aligned
+            p = mem + alignSize(p - mem + 20, 16);
+
+            if (dims == 0)
+                continue;
+
+            if (dims < 0 || dims > 3 || w <= 0 || h <= 0 || c <= 0 || elemsize <= 0 || (dims < 3 && c != 1) || (dims < 2 && h != 1))
+                return -1;
+
+            // every factor is checked before the product is taken
+            remain = size - (int)(p - mem);
+            if (remain < 0 || (double)w * h * c * elemsize > remain)
+                return -1;
+
+            const size_t cstep = dims == 3 ? alignSize((size_t)w * h * elemsize, 16) / elemsize : (size_t)w * h;
+            const size_t bytes = cstep * c * elemsize;
+            if (bytes > (size_t)remain)
+                return -1;
+
+            void* data = (void*)p;
+            if (dims == 1)
+                *mats[i] = Mat(w, data, (size_t)elemsize);
+            else if (dims == 2)
+                *mats[i] = Mat(w, h, data, (size_t)elemsize);
+            else
+                *mats[i] = Mat(w, h, c, data, (size_t)elemsize);
+
+            p += std::min(alignSize(bytes, 16), (size_t)remain);
+        }
+    }
+
+    return 0;
+}
+
+int Net::load_blob_shapes(const unsigned char* mem, int size)
+{
+    // input shapes as in Extractor::input_shapes, blob count, then dims w h c elemsize of each blob
+    const int* p = (const int*)mem;
+    const int count = size / sizeof(int);
+
+    if (count < 1 || p[0] < 0 || p[0] % 6 != 0 || p[0] + 2 > count)
+        return -1;
+
+    std::vector<int> input_shapes(p + 1, p + 1 + p[0]);
+
+    const int blob_count = p[1 + p[0]];
+    const int* blob_shapes = p + 2 + p[0];
+    if (blob_count < 0 || blob_count > (count - 2 - p[0]) / 5)
+        return -1;
+
+    // shapes of another graph are no use
+    if (blob_count != (int)blobs.size())
+        return 0;
+
+    // the channel concat outputs are preallocated from the first forward of these input shapes on
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+        if (!layer || layer->typeindex != LayerType::Concat)
+            continue;
+
+        std::vector<int> bottom_shapes;
+        for (size_t j=0; j<layer->bottoms.size(); j++)
+        {
+            const int* shape = blob_shapes + layer->bottoms[j] * 5;
+            bottom_shapes.insert(bottom_shapes.end(), shape, shape + 5);
+        }
+
+        record_concat_shape(i, bottom_shapes, input_shapes);
+    }
+
+    return 0;
+}
+
+int Net::load_model(const unsigned char* _mem)
+{
+    if (layers.empty())
+    {
+        fprintf(stderr, "network graph not ready\n");
+        return 0;
+    }
+
+    if ((unsigned long)_mem & 0x3)
+    {
+        // reject unaligned memory
+        fprintf(stderr, "memory not 32-bit aligned at %p\n", _mem);
+        return 0;
+    }
+
+    // numa replicas read the same weight data again, onto their own node
+    create_numa_allocators();
+
+    int ret = 0;
+
+    const unsigned char* mem = _mem;
+    for (size_t n=0; n<=replica_layers.size() && ret == 0; n++)
+    {
+        mem = _mem;
+
+        const std::vector<Layer*>& node_layers = n == 0 ? layers : replica_layers[n - 1];
+
+        ModelBinFromMemory mb(mem, numa_allocators.empty() ? weight_allocator : numa_allocators[n]);
+        for (size_t i=0; i<node_layers.size(); i++)
+        {
+            Layer* layer = node_layers[i];
+
+            int lret = layer->load_model(mb);
+            if (lret != 0)
+            {
+                fprintf(stderr, "layer load_model failed\n");
+                ret = -1;
+                break;
+            }
+        }
+    }
+
+    // the constants are forwarded with the loaded weight only
+    if (ret != 0)
+        return -1;
+
+    fold_constants();
+
+    return mem - _mem;
+}
+
+void Net::clear()
+{
+    blobs.clear();
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        delete layers[i];
+    }
+    layers.clear();
+
+    for (size_t n=0; n<replica_layers.size(); n++)
+    {
+        for (size_t i=0; i<replica_layers[n].size(); i++)
+        {
+            delete replica_layers[n][i];
+        }
+    }
+    replica_layers.clear();
+
+    // after the weight data placed by them is gone
+    for (size_t n=0; n<numa_allocators.size(); n++)
+    {
+        delete numa_allocators[n];
+    }
+    numa_allocators.clear();
+
+#if NCNN_STRING
+    blob_name_index.clear();
+    layer_name_index.clear();
+#endif // NCNN_STRING
+
+    shape_constant_outputs.clear();
+    constant_blobs.clear();
+    shared_blobs.clear();
+
+#if NCNN_STDIO
+    // after the layers referencing its weight data are gone
+    if (container_data)
+    {
+        unmap_file(container_data, container_size);
+        container_data = 0;
+        container_size = 0;
+    }
+#endif // NCNN_STDIO
+}
+
+void Net::fuse_network()
+{
+    concat_shapes.clear();
+
+    // shape constant outputs are cached regardless of fusion
+    shape_constant_outputs.clear();
+    shape_constant_outputs.resize(layers.size());
+
+    constant_blobs.clear();
+    update_shared_blobs();
+
+    if (!use_layer_fusion)
+        return;
+
+    // channel concat outputs are preallocated from the shapes of an earlier forward of the same input shapes
+    concat_shapes.resize(layers.size());
+
+    // ShuffleChannel feeding a single convolution is skipped,
+    // the convolution reads the unshuffled blob through a channel remap instead
+    // the shuffle layer stays for extracting its own output
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+        if (!layer || layer->typeindex != LayerType::ShuffleChannel)
+            continue;
+
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+        if (blobs[top_blob_index].consumers.size() != 1)
+            continue;
+
+        int j = blobs[top_blob_index].consumers[0];
+        Layer* consumer = layers[j];
+        if (!consumer)
+            continue;
+
+        int group = ((const ShuffleChannel*)layer)->group;
+        if (group <= 1)
+            continue;
+
+        if (consumer->typeindex == LayerType::Convolution)
+        {
+            Convolution* convolution = (Convolution*)consumer;
+            if (convolution->shuffle_group)
+                continue;
+
+            convolution->shuffle_group = group;
+        }
+        else if (consumer->typeindex == LayerType::ConvolutionDepthWise)
+        {
+            ConvolutionDepthWise* convolutiondepthwise = (ConvolutionDepthWise*)consumer;
+            if (convolutiondepthwise->shuffle_group)
+                continue;
+
+            // depth-wise only, each output channel reads one input channel
+            const int maxk = convolutiondepthwise->kernel_w * convolutiondepthwise->kernel_h;
+            const int num_output = convolutiondepthwise->num_output;
+            if (convolutiondepthwise->group != num_output || convolutiondepthwise->weight_data_size != num_output * maxk || num_output % group != 0)
+                continue;
+
+            convolutiondepthwise->shuffle_group = group;
+        }
+        else
+        {
+            continue;
+        }
+
+        // the numa replicas run the same fused convolution
+        for (size_t n=0; n<replica_layers.size(); n++)
+        {
+            Layer* replica = replica_layers[n][j];
+            if (replica->typeindex == LayerType::Convolution)
+                ((Convolution*)replica)->shuffle_group = group;
+            else
+                ((ConvolutionDepthWise*)replica)->shuffle_group = group;
+        }
+
+        consumer->bottoms[0] = bottom_blob_index;
+        blobs[top_blob_index].consumers.clear();
+
+        std::vector<int>& consumers = blobs[bottom_blob_index].consumers;
+        std::replace(consumers.begin(), consumers.end(), (int)i, j);
+    }
+
+    // ReLU or Clip after a depth-wise convolution is applied by the convolution at its store
+    // the consumers of the activation output read the convolution output instead
+    // the activation layer stays for extracting its own output, applying it again changes nothing
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+        if (!layer || (layer->typeindex != LayerType::ReLU && layer->typeindex != LayerType::Clip))
+            continue;
+
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+        if (blobs[bottom_blob_index].consumers.size() != 1)
+            continue;
+
+        int j = blobs[bottom_blob_index].producer;
+        if (j < 0 || !layers[j] || layers[j]->typeindex != LayerType::ConvolutionDepthWise)
+            continue;
+
+        if (((const ConvolutionDepthWise*)layers[j])->activation_type != 0)
+            continue;
+
+        int activation_type;
+        Mat activation_params;
+        if (layer->typeindex == LayerType::ReLU)
+        {
+            // leaky relu applied twice is not leaky relu
+            if (((const ReLU*)layer)->slope != 0.f)
+                continue;
+
+            activation_type = 1;
+        }
+        else
+        {
+            activation_type = 3;
+            activation_params.create(2);
+            activation_params[0] = ((const Clip*)layer)->min;
+            activation_params[1] = ((const Clip*)layer)->max;
+        }
+
+        ((ConvolutionDepthWise*)layers[j])->activation_type = activation_type;
+        ((ConvolutionDepthWise*)layers[j])->activation_params = activation_params;
+
+        // the numa replicas run the same fused convolution
+        for (size_t n=0; n<replica_layers.size(); n++)
+        {
+            ConvolutionDepthWise* replica = (ConvolutionDepthWise*)replica_layers[n][j];
+            replica->activation_type = activation_type;
+            replica->activation_params = activation_params;
+        }
+
+        std::vector<int>& consumers = blobs[top_blob_index].consumers;
+        for (size_t k=0; k<consumers.size(); k++)
+        {
+            std::vector<int>& bottoms = layers[consumers[k]]->bottoms;
+            std::replace(bottoms.begin(), bottoms.end(), top_blob_index, bottom_blob_index);
+        }
+
+        blobs[bottom_blob_index].consumers = consumers;
+        consumers.clear();
+    }
+}
+
+void Net::fold_constants()
+{
+    constant_blobs.clear();
+
+    update_shared_blobs();
+
+    if (!use_layer_fusion)
+        return;
+
+    // layers fed by MemoryData only give the same output on every forward
+    std::vector<char> constant_layers(layers.size(), 0);
+    for (size_t i=0; i<layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+        if (!layer)
+            continue;
+
+        if (layer->bottoms.empty())
+        {
+            constant_layers[i] = layer->typeindex == LayerType::MemoryData;
+            continue;
+        }
+
+        char constant = 1;
+        for (size_t j=0; j<layer->bottoms.size(); j++)
+        {
+            int producer = blobs[layer->bottoms[j]].producer;
+            if (producer < 0 || !constant_layers[producer])
+                constant = 0;
+        }
+
+        constant_layers[i] = constant;
+    }
+
+    // forward them once, keep the blobs read by the rest of the network
+    Extractor ex = create_extractor();
+    ex.set_light_mode(false);
+    ex.set_blob_allocator(0);
+    ex.set_workspace_allocator(0);
+
+    for (size_t i=0; i<blobs.size(); i++)
+    {
+        const Blob& blob = blobs[i];
+        if (blob.producer < 0 || !constant_layers[blob.producer])
+            continue;
+
+        bool read_by_network = blob.consumers.empty();
+        for (size_t j=0; j<blob.consumers.size(); j++)
+        {
+            if (!constant_layers[blob.consumers[j]])
+                read_by_network = true;
+        }
+
+        if (!read_by_network)
+            continue;
+
+        Mat m;
+        if (ex.extract(i, m) != 0)
+            continue;
+
+        constant_blobs.push_back(std::make_pair((int)i, m));
+    }
+
+    update_shared_blobs();
+}
+
+void Net::update_shared_blobs()
+{
+    shared_blobs.assign(blobs.size(), 0);
+
+    // outputs of shape constant layers are cached by the net
+    for (size_t i=0; i<blobs.size(); i++)
+    {
+        int producer = blobs[i].producer;
+        if (producer != -1 && layers[producer] && layers[producer]->shape_constant)
+            shared_blobs[i] = 1;
+    }
+
+    for (size_t i=0; i<constant_blobs.size(); i++)
+    {
+        shared_blobs[constant_blobs[i].first] = 1;
+    }
+}
+
+Extractor Net::create_extractor() const
+{
+    return Extractor(this, blobs.size());
+}
+
+#if NCNN_STRING
+int Net::find_blob_index_by_name(const char* name) const
+{
+    return find_name_index(blob_name_index, blobs, name);
+}
+
+int Net::find_layer_index_by_name(const char* name) const
+{
+    return find_name_index(layer_name_index, layers, name);
+}
+
+int Net::custom_layer_to_index(const char* type)
+{
+    const int custom_layer_registry_entry_count = custom_layer_registry.size();
+    for (int i=0; i<custom_layer_registry_entry_count; i++)
+    {
+        if (strcmp(type, custom_layer_registry[i].name) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+Layer* Net::create_custom_layer(const char* type)
+{
+    int index = custom_layer_to_index(type);
+    if (index == -1)
+        return 0;
+
+    return create_custom_layer(index);
+}
+#endif // NCNN_STRING
+
+Layer* Net::create_custom_layer(int index)
+{
+    const int custom_layer_registry_entry_count = custom_layer_registry.size();
+    if (index < 0 || index >= custom_layer_registry_entry_count)
+        return 0;
+
+    layer_creator_func layer_creator = custom_layer_registry[index].creator;
+    if (!layer_creator)
+        return 0;
+
+    Layer* layer = layer_creator();
+    layer->typeindex = LayerType::CustomBit | index;
+    return layer;
+}
+
+void Net::create_numa_allocators()
+{
+    if (!use_numa_replication || !numa_allocators.empty())
+        return;
+
+    const int node_count = get_numa_node_count();
+    for (int n=0; n<node_count; n++)
+    {
+        numa_allocators.push_back(new NumaAllocator(n));
+    }
+}
+
+int Net::create_layer_replicas(int layer_index, const ParamDict& pd)
+{
+    const Layer* layer = layers[layer_index];
+
+    const int node_count = get_numa_node_count();
+
+    replica_layers.resize(node_count - 1);
+    for (int n=1; n<node_count; n++)
+    {
+        std::vector<Layer*>& node_layers = replica_layers[n - 1];
+        node_layers.resize(layers.size(), 0);
+
+        Layer* replica = create_layer(layer->typeindex);
+        if (!replica)
+        {
+            replica = create_custom_layer(layer->typeindex & ~LayerType::CustomBit);
+        }
+        if (!replica)
+        {
+            fprintf(stderr, "layer %d replica not created\n", layer->typeindex);
+            return -1;
+        }
+
+        replica->type = layer->type;
+        replica->name = layer->name;
+        replica->bottoms = layer->bottoms;
+        replica->tops = layer->tops;
+
+        int lr = replica->load_param(pd);
+        if (lr != 0)
+        {
+            fprintf(stderr, "layer replica load_param failed\n");
+            delete replica;
+            return -1;
+        }
+
+        node_layers[layer_index] = replica;
+    }
+
+    return 0;
+}
+
+int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<Mat>& blob_alias_mats, const std::vector<int>& blob_keeps, const std::vector<int>& input_shapes, Option& opt, int numa_node) const
+{
+    const Layer* layer = layers[layer_index];
+
+    // the weight replica of the numa node runs the layer, the graph is the same
+    const Layer* op = numa_node > 0 ? replica_layers[numa_node - 1][layer_index] : layer;
+
+#if NCNN_STRING
+    const char* layer_name = layer->name.c_str();
+#else
+    const char* layer_name = 0;
+#endif // NCNN_STRING
+
+    // attribute allocations to this layer
+    set_current_layer(layer_index, layer_name);
+
+//     fprintf(stderr, "forward_layer %d %s\n", layer_index, layer->name.c_str());
+
+    if (layer->one_blob_only)
+    {
+        // load bottom blob
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+
+        if (blob_mats[bottom_blob_index].dims == 0)
+        {
+            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, blob_alias_mats, blob_keeps, input_shapes, opt, numa_node);
+            if (ret != 0)
+                return ret;
+
+            set_current_layer(layer_index, layer_name);
+        }
+
+        Mat bottom_blob = blob_mats[bottom_blob_index];
+
+        if (opt.lightmode)
+        {
+            // delete after taken in light mode, unless extracted later
+            if (!blob_keeps[bottom_blob_index])
+                blob_mats[bottom_blob_index].release();
+            // deep copy for inplace forward if data is shared or external
+            // a range of the concat output written in place belongs to this layer alone
+            if (layer->support_inplace && (blob_keeps[bottom_blob_index] || ((!bottom_blob.refcount || *bottom_blob.refcount != 1) && bottom_blob.data != blob_alias_mats[bottom_blob_index].data)))
+            {
+                bottom_blob = bottom_blob.clone();
+            }
+        }
+        blob_alias_mats[bottom_blob_index].release();
+
+        // forward
+        if (layer->shape_constant)
+        {
+            std::vector<Mat> bottom_blobs(1, bottom_blob);
+            std::vector<Mat> top_blobs(1);
+            int ret = forward_shape_constant(layer_index, bottom_blobs, top_blobs, opt);
+            if (ret != 0)
+                return ret;
+
+            // store top blob
+            blob_mats[top_blob_index] = top_blobs[0];
+        }
+        else if (opt.lightmode && layer->support_inplace)
+        {
+            Mat& bottom_top_blob = bottom_blob;
+#if NCNN_BENCHMARK
+            double start = get_current_time();
+            int ret = op->forward_inplace(bottom_top_blob, opt);
+            double end = get_current_time();
+            benchmark(layer, bottom_top_blob, bottom_top_blob, start, end);
+#else
+            int ret = op->forward_inplace(bottom_top_blob, opt);
+#endif // NCNN_BENCHMARK
+            if (ret != 0)
+                return ret;
+
+            // store top blob
+            blob_mats[top_blob_index] = bottom_top_blob;
+        }
+        else
+        {
+            // write into the concat output if planned, see alias_concat_inputs
+            Mat top_blob = blob_alias_mats[top_blob_index];
+#if NCNN_BENCHMARK
             double start = get_current_time();
-            int ret = layer->forward(bottom_blob, top_blob, opt);
+            int ret = op->forward(bottom_blob, top_blob, opt);
             double end = get_current_time();
             benchmark(layer, bottom_blob, top_blob, start, end);
 #else
-            int ret = layer->forward(bottom_blob, top_blob, opt);
+            int ret = op->forward(bottom_blob, top_blob, opt);
 #endif // NCNN_BENCHMARK
             if (ret != 0)
                 return ret;
@@ -828,10 +1902,14 @@ int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt
             // store top blob
             blob_mats[top_blob_index] = top_blob;
         }
-
     }
     else
     {
+        if (layer->typeindex == LayerType::Concat)
+        {
+            alias_concat_inputs(layer_index, blob_mats, blob_alias_mats, blob_keeps, input_shapes, opt);
+        }
+
         // load bottom blobs
         std::vector<Mat> bottom_blobs;
         bottom_blobs.resize(layer->bottoms.size());
@@ -841,36 +1919,55 @@ int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt
 
             if (blob_mats[bottom_blob_index].dims == 0)
             {
-                int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
+                int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, blob_alias_mats, blob_keeps, input_shapes, opt, numa_node);
                 if (ret != 0)
                     return ret;
+
+                set_current_layer(layer_index, layer_name);
             }
 
             bottom_blobs[i] = blob_mats[bottom_blob_index];
 
             if (opt.lightmode)
             {
-                // delete after taken in light mode
-                blob_mats[bottom_blob_index].release();
-                // deep copy for inplace forward if data is shared
-                if (layer->support_inplace && *bottom_blobs[i].refcount != 1)
+                // delete after taken in light mode, unless extracted later
+                if (!blob_keeps[bottom_blob_index])
+                    blob_mats[bottom_blob_index].release();
+                // deep copy for inplace forward if data is shared or external
+                if (layer->support_inplace && (blob_keeps[bottom_blob_index] || ((!bottom_blobs[i].refcount || *bottom_blobs[i].refcount != 1) && bottom_blobs[i].data != blob_alias_mats[bottom_blob_index].data)))
                 {
                     bottom_blobs[i] = bottom_blobs[i].clone();
                 }
             }
+            blob_alias_mats[bottom_blob_index].release();
         }
 
         // forward
-        if (opt.lightmode && layer->support_inplace)
+        if (layer->shape_constant)
+        {
+            std::vector<Mat> top_blobs(layer->tops.size());
+            int ret = forward_shape_constant(layer_index, bottom_blobs, top_blobs, opt);
+            if (ret != 0)
+                return ret;
+
+            // store top blobs
+            for (size_t i=0; i<layer->tops.size(); i++)
+            {
+                int top_blob_index = layer->tops[i];
+
+                blob_mats[top_blob_index] = top_blobs[i];
+            }
+        }
+        else if (opt.lightmode && layer->support_inplace)
         {
             std::vector<Mat>& bottom_top_blobs = bottom_blobs;
 #if NCNN_BENCHMARK
             double start = get_current_time();
-            int ret = layer->forward_inplace(bottom_top_blobs, opt);
+            int ret = op->forward_inplace(bottom_top_blobs, opt);
             double end = get_current_time();
             benchmark(layer, start, end);
 #else
-            int ret = layer->forward_inplace(bottom_top_blobs, opt);
+            int ret = op->forward_inplace(bottom_top_blobs, opt);
 #endif // NCNN_BENCHMARK
             if (ret != 0)
                 return ret;
@@ -887,13 +1984,17 @@ int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt
         {
             std::vector<Mat> top_blobs;
             top_blobs.resize(layer->tops.size());
+            for (size_t i=0; i<layer->tops.size(); i++)
+            {
+                top_blobs[i] = blob_alias_mats[layer->tops[i]];
+            }
 #if NCNN_BENCHMARK
             double start = get_current_time();
-            int ret = layer->forward(bottom_blobs, top_blobs, opt);
+            int ret = op->forward(bottom_blobs, top_blobs, opt);
             double end = get_current_time();
             benchmark(layer, start, end);
 #else
-            int ret = layer->forward(bottom_blobs, top_blobs, opt);
+            int ret = op->forward(bottom_blobs, top_blobs, opt);
 #endif // NCNN_BENCHMARK
             if (ret != 0)
                 return ret;
@@ -906,6 +2007,22 @@ int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt
                 blob_mats[top_blob_index] = top_blobs[i];
             }
         }
+
+        if (layer->typeindex == LayerType::Concat)
+        {
+            std::vector<int> bottom_shapes(bottom_blobs.size() * 5);
+            for (size_t i=0; i<bottom_blobs.size(); i++)
+            {
+                const Mat& m = bottom_blobs[i];
+                bottom_shapes[i * 5] = m.dims;
+                bottom_shapes[i * 5 + 1] = m.w;
+                bottom_shapes[i * 5 + 2] = m.h;
+                bottom_shapes[i * 5 + 3] = m.c;
+                bottom_shapes[i * 5 + 4] = (int)m.elemsize;
+            }
+
+            record_concat_shape(layer_index, bottom_shapes, input_shapes);
+        }
     }
 
 //     fprintf(stderr, "forward_layer %d %s done\n", layer_index, layer->name.c_str());
@@ -915,10 +2032,220 @@ int Net::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt
     return 0;
 }
 
+// concat shapes are kept for this many input shapes
+static const int concat_shape_cache_size = 4;
+
+void Net::alias_concat_inputs(int layer_index, std::vector<Mat>& blob_mats, std::vector<Mat>& blob_alias_mats, const std::vector<int>& blob_keeps, const std::vector<int>& input_shapes, const Option& opt) const
+{
+    if (layer_index >= (int)concat_shapes.size())
+        return;
+
+    const Concat* concat = (const Concat*)layers[layer_index];
+    if (concat->axis != 0)
+        return;
+
+    // w, h, elemsize, then the channels of each input
+    // only known from a forward with the same input shapes, nothing is preallocated otherwise
+    std::vector<int> shape;
+    concat_shapes_lock.lock();
+    const std::vector< std::pair< std::vector<int>, std::vector<int> > >& shapes = concat_shapes[layer_index];
+    for (size_t i=0; i<shapes.size(); i++)
+    {
+        if (shapes[i].first == input_shapes)
+        {
+            shape = shapes[i].second;
+            break;
+        }
+    }
+    concat_shapes_lock.unlock();
+
+    if (shape.size() != concat->bottoms.size() + 3)
+        return;
+
+    int channels = 0;
+    for (size_t i=3; i<shape.size(); i++)
+    {
+        channels += shape[i];
+    }
+
+    // may be a range of an outer concat output already
+    Mat& top_blob = blob_alias_mats[concat->tops[0]];
+    top_blob.create(shape[0], shape[1], channels, (size_t)shape[2], opt.blob_allocator);
+    if (top_blob.empty())
+        return;
+
+    // the producers create their top blob with the same shape, which keeps the range
+    // a shape change just falls back to the copy in Concat
+    int q = 0;
+    for (size_t i=0; i<concat->bottoms.size(); i++)
+    {
+        int blob_index = concat->bottoms[i];
+        int channels_i = shape[3 + i];
+
+        // extracted blobs keep their own storage
+        if (blob_mats[blob_index].dims == 0 && blobs[blob_index].consumers.size() == 1 && !blob_keeps[blob_index])
+        {
+            Mat m = top_blob.channel_range_shared(q, channels_i);
+            blob_alias_mats[blob_index] = m;
+
+            // inplace layers in light mode write to their bottom blob, hand the range down
+            while (opt.lightmode)
+            {
+                int producer = blobs[blob_index].producer;
+                if (producer < 0 || !layers[producer] || !layers[producer]->one_blob_only || !layers[producer]->support_inplace)
+                    break;
+
+                // the Input layer has no bottom to follow
+                if (layers[producer]->bottoms.empty())
+                    break;
+
+                blob_index = layers[producer]->bottoms[0];
+                if (blob_mats[blob_index].dims != 0 || blobs[blob_index].consumers.size() != 1 || blob_keeps[blob_index])
+                    break;
+
+                blob_alias_mats[blob_index] = m;
+            }
+        }
+
+        q += channels_i;
+    }
+}
+
+void Net::record_concat_shape(int layer_index, const std::vector<int>& bottom_shapes, const std::vector<int>& input_shapes) const
+{
+    if (layer_index >= (int)concat_shapes.size())
+        return;
+
+    const Concat* concat = (const Concat*)layers[layer_index];
+
+    // dims w h c elemsize of each input
+    std::vector<int> shape;
+    if (concat->axis == 0 && !bottom_shapes.empty() && bottom_shapes[0] == 3)
+    {
+        const int* s0 = &bottom_shapes[0];
+        shape.push_back(s0[1]);
+        shape.push_back(s0[2]);
+        shape.push_back(s0[4]);
+
+        for (size_t i=0; i<bottom_shapes.size(); i+=5)
+        {
+            const int* si = &bottom_shapes[i];
+            if (si[0] != 3 || si[1] != s0[1] || si[2] != s0[2] || si[4] != s0[4])
+            {
+                shape.clear();
+                break;
+            }
+
+            shape.push_back(si[3]);
+        }
+    }
+
+    concat_shapes_lock.lock();
+    std::vector< std::pair< std::vector<int>, std::vector<int> > >& shapes = concat_shapes[layer_index];
+    size_t i = 0;
+    for (; i<shapes.size(); i++)
+    {
+        if (shapes[i].first == input_shapes)
+            break;
+    }
+    if (i < shapes.size())
+    {
+        shapes[i].second = shape;
+    }
+    else
+    {
+        if ((int)shapes.size() >= concat_shape_cache_size)
+            shapes.erase(shapes.begin());
+        shapes.push_back(std::make_pair(input_shapes, shape));
+    }
+    concat_shapes_lock.unlock();
+}
+
+// cached outputs of a shape constant layer are kept for this many input shapes
+static const int shape_constant_cache_size = 4;
+
+int Net::forward_shape_constant(int layer_index, const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    std::vector<int> shape;
+    for (size_t i=0; i<bottom_blobs.size(); i++)
+    {
+        const Mat& m = bottom_blobs[i];
+        shape.push_back(m.dims);
+        shape.push_back(m.w);
+        shape.push_back(m.h);
+        shape.push_back(m.c);
+    }
+
+    std::vector< std::pair< std::vector<int>, std::vector<Mat> > >& outputs = shape_constant_outputs[layer_index];
+
+    shape_constant_outputs_lock.lock();
+    for (size_t i=0; i<outputs.size(); i++)
+    {
+        if (outputs[i].first == shape)
+        {
+            top_blobs = outputs[i].second;
+            shape_constant_outputs_lock.unlock();
+            return 0;
+        }
+    }
+    shape_constant_outputs_lock.unlock();
+
+    // the cached blobs outlive the extractor and its allocators
+    Option opt_cache = opt;
+    opt_cache.blob_allocator = 0;
+
+#if NCNN_BENCHMARK
+    double start = get_current_time();
+#endif // NCNN_BENCHMARK
+    int ret = 0;
+    if (layer->one_blob_only)
+        ret = layer->forward(bottom_blobs[0], top_blobs[0], opt_cache);
+    else
+        ret = layer->forward(bottom_blobs, top_blobs, opt_cache);
+#if NCNN_BENCHMARK
+    double end = get_current_time();
+    benchmark(layer, start, end);
+#endif // NCNN_BENCHMARK
+    if (ret != 0)
+        return ret;
+
+    // consumers forwarding inplace see the extra reference and copy
+    shape_constant_outputs_lock.lock();
+    if ((int)outputs.size() >= shape_constant_cache_size)
+        outputs.erase(outputs.begin());
+    outputs.push_back(std::make_pair(shape, top_blobs));
+    shape_constant_outputs_lock.unlock();
+
+    return 0;
+}
+
+bool Net::is_shared_blob(int blob_index) const
+{
+    return blob_index < (int)shared_blobs.size() && shared_blobs[blob_index];
+}
+
 Extractor::Extractor(const Net* _net, int blob_count) : net(_net)
 {
     blob_mats.resize(blob_count);
+    blob_alias_mats.resize(blob_count);
+    blob_keeps.resize(blob_count, 0);
+
+    // start from the folded constants
+    for (size_t i=0; i<net->constant_blobs.size(); i++)
+    {
+        blob_mats[net->constant_blobs[i].first] = net->constant_blobs[i].second;
+    }
     opt = get_default_option();
+
+    if (net->thread_pool)
+        opt.thread_pool = net->thread_pool;
+
+    if (net->autotune_cache)
+        opt.autotune_cache = net->autotune_cache;
+
+    numa_node = -1;
 }
 
 void Extractor::set_light_mode(bool enable)
@@ -941,6 +2268,32 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     opt.workspace_allocator = allocator;
 }
 
+void Extractor::set_thread_pool(ThreadPool* thread_pool)
+{
+    opt.thread_pool = thread_pool;
+}
+
+void Extractor::set_numa_node(int node)
+{
+    numa_node = node;
+}
+
+int Extractor::resolve_numa_node() const
+{
+    if (net->replica_layers.empty())
+        return 0;
+
+    int node = numa_node;
+    if (node == -1)
+        node = get_cpu_numa_node(get_current_cpu());
+
+    // unknown cpu or invalid node, run node 0
+    if (node < 0 || node > (int)net->replica_layers.size())
+        return 0;
+
+    return node;
+}
+
 int Extractor::input(int blob_index, const Mat& in)
 {
     if (blob_index < 0 || blob_index >= (int)blob_mats.size())
@@ -948,9 +2301,47 @@ int Extractor::input(int blob_index, const Mat& in)
 
     blob_mats[blob_index] = in;
 
+    // replace the shape of an input set before
+    size_t i = 0;
+    for (; i<input_shapes.size(); i+=6)
+    {
+        if (input_shapes[i] == blob_index)
+            break;
+    }
+    if (i == input_shapes.size())
+        input_shapes.resize(i + 6);
+
+    input_shapes[i] = blob_index;
+    input_shapes[i + 1] = in.dims;
+    input_shapes[i + 2] = in.w;
+    input_shapes[i + 3] = in.h;
+    input_shapes[i + 4] = in.c;
+    input_shapes[i + 5] = (int)in.elemsize;
+
     return 0;
 }
 
+int Extractor::input(int blob_index, const float* data, int w, int h, int c, int channel_step)
+{
+    if (blob_index < 0 || blob_index >= (int)blob_mats.size())
+        return -1;
+
+    if (!data || w <= 0 || h <= 0 || c <= 0)
+        return -1;
+
+    // the layers read channels at cstep and load them with aligned simd
+    if (channel_step < w * h || channel_step % 4 != 0 || ((size_t)data & 15) != 0)
+    {
+        fprintf(stderr, "input channel step %d of %dx%d data at %p cannot be read in place\n", channel_step, w, h, data);
+        return -1;
+    }
+
+    Mat view(w, h, c, (void*)data, 4u);
+    view.cstep = channel_step;
+
+    return input(blob_index, view);
+}
+
 int Extractor::extract(int blob_index, Mat& feat)
 {
     if (blob_index < 0 || blob_index >= (int)blob_mats.size())
@@ -961,43 +2352,166 @@ int Extractor::extract(int blob_index, Mat& feat)
     if (blob_mats[blob_index].dims == 0)
     {
         int layer_index = net->blobs[blob_index].producer;
-        ret = net->forward_layer(layer_index, blob_mats, opt);
+        ret = net->forward_layer(layer_index, blob_mats, blob_alias_mats, blob_keeps, input_shapes, opt, resolve_numa_node());
+
+        set_current_layer(-1, 0);
     }
 
     feat = blob_mats[blob_index];
 
+    // keep the blobs shared by all extractors read-only
+    if (net->is_shared_blob(blob_index))
+        feat = feat.clone();
+
     return ret;
 }
 
+int Extractor::extract(const std::vector<int>& blob_indexes, std::vector<Mat>& feats)
+{
+    const int count = blob_indexes.size();
+
+    for (int i=0; i<count; i++)
+    {
+        if (blob_indexes[i] < 0 || blob_indexes[i] >= (int)blob_mats.size())
+            return -1;
+    }
+
+    feats.resize(count);
+
+    // keep all the outputs alive until the last one is done
+    // and let their producers write into the given mats
+    for (int i=0; i<count; i++)
+    {
+        int blob_index = blob_indexes[i];
+
+        blob_keeps[blob_index] = 1;
+
+        if (feats[i].empty() || blob_mats[blob_index].dims != 0 || blob_alias_mats[blob_index].dims != 0)
+            continue;
+
+        Mat m = feats[i];
+
+        // external data is never freed, match the allocator so create() keeps it
+        if (!m.refcount)
+            m.allocator = opt.blob_allocator;
+
+        blob_alias_mats[blob_index] = m;
+    }
+
+    int ret = 0;
+
+    for (int i=0; i<count; i++)
+    {
+        int blob_index = blob_indexes[i];
+
+        if (blob_mats[blob_index].dims == 0)
+        {
+            int layer_index = net->blobs[blob_index].producer;
+            ret = net->forward_layer(layer_index, blob_mats, blob_alias_mats, blob_keeps, input_shapes, opt, resolve_numa_node());
+
+            set_current_layer(-1, 0);
+
+            if (ret != 0)
+                break;
+        }
+    }
+
+    // a given mat of another shape is left untouched
+    int shape_ret = 0;
+
+    for (int i=0; i<count; i++)
+    {
+        int blob_index = blob_indexes[i];
+
+        blob_keeps[blob_index] = 0;
+        blob_alias_mats[blob_index].release();
+
+        if (ret != 0)
+            continue;
+
+        const Mat& m = blob_mats[blob_index];
+        Mat& feat = feats[i];
+
+        if (m.data == feat.data)
+            continue;
+
+        // copy into the given mat when the producer could not write there
+        if (!feat.empty())
+        {
+            if (feat.dims != m.dims || feat.w != m.w || feat.h != m.h || feat.c != m.c || feat.elemsize != m.elemsize)
+            {
+                fprintf(stderr, "extract blob %d of %d %dx%dx%d into mat of %d %dx%dx%d failed\n", blob_index, (int)m.elemsize, m.w, m.h, m.c, (int)feat.elemsize, feat.w, feat.h, feat.c);
+                shape_ret = -1;
+                continue;
+            }
+
+            for (int q=0; q<m.c; q++)
+            {
+                memcpy(feat.channel(q).data, m.channel(q).data, (size_t)m.w * m.h * m.elemsize);
+            }
+            continue;
+        }
+
+        feat = m;
+
+        // keep the blobs shared by all extractors read-only
+        if (net->is_shared_blob(blob_index))
+            feat = feat.clone();
+    }
+
+    return ret != 0 ? ret : shape_ret;
+}
+
 #if NCNN_STRING
 int Extractor::input(const char* blob_name, const Mat& in)
 {
     int blob_index = net->find_blob_index_by_name(blob_name);
     if (blob_index == -1)
+    {
+        fprintf(stderr, "find_blob_index_by_name %s failed\n", blob_name);
         return -1;
+    }
 
-    blob_mats[blob_index] = in;
-
-    return 0;
+    return input(blob_index, in);
 }
 
-int Extractor::extract(const char* blob_name, Mat& feat)
+int Extractor::input(const char* blob_name, const float* data, int w, int h, int c, int channel_step)
 {
     int blob_index = net->find_blob_index_by_name(blob_name);
     if (blob_index == -1)
+    {
+        fprintf(stderr, "find_blob_index_by_name %s failed\n", blob_name);
         return -1;
+    }
 
-    int ret = 0;
+    return input(blob_index, data, w, h, c, channel_step);
+}
 
-    if (blob_mats[blob_index].dims == 0)
+int Extractor::extract(const char* blob_name, Mat& feat)
+{
+    int blob_index = net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
     {
-        int layer_index = net->blobs[blob_index].producer;
-        ret = net->forward_layer(layer_index, blob_mats, opt);
+        fprintf(stderr, "find_blob_index_by_name %s failed\n", blob_name);
+        return -1;
     }
 
-    feat = blob_mats[blob_index];
+    return extract(blob_index, feat);
+}
+int Extractor::extract(const std::vector<const char*>& blob_names, std::vector<Mat>& feats)
+{
+    std::vector<int> blob_indexes(blob_names.size());
+    for (size_t i=0; i<blob_names.size(); i++)
+    {
+        blob_indexes[i] = net->find_blob_index_by_name(blob_names[i]);
+        if (blob_indexes[i] == -1)
+        {
+            fprintf(stderr, "find_blob_index_by_name %s failed\n", blob_names[i]);
+            return -1;
+        }
+    }
 
-    return ret;
+    return extract(blob_indexes, feats);
 }
 #endif // NCNN_STRING
 
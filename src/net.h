@@ -17,6 +17,7 @@
 
 #include <stdio.h>
 #include <vector>
+#include "autotune.h"
 #include "blob.h"
 #include "layer.h"
 #include "mat.h"
@@ -73,12 +74,43 @@ public:
     // return bytes consumed
     int load_model(const unsigned char* mem);
 
+#if NCNN_STDIO
+    // load network structure and weight data from one container file written by save_container
+    // the file is memory mapped and weight data is referenced in place until clear()
+    // return 0 if success
+    int load_container(const char* path);
+
+    // write a container of this network for load_container, see ncnn2mem
+    // parambin and model are the binary param and weight data the network was loaded from
+    // the weight data transformed by the layers of this build is stored for the same target and options
+    // with ex, run with light mode off, the blob shapes of its inputs are stored too,
+    // channel concat outputs are then preallocated from the first forward of those shapes
+    // return 0 if success
+    int save_container(const char* path, const unsigned char* parambin, int parambin_size, const unsigned char* model, int model_size, Extractor* ex = 0) const;
+#endif // NCNN_STDIO
+
+    // load network structure and weight data from a container of size bytes in external memory
+    // weight data, transformed weight data included, is referenced in place,
+    // so external memory should be retained when used
+    // transformed weight data of another target or other options is transformed again by the layers
+    // memory pointer must be 16 byte aligned
+    // return 0 if success
+    int load_container(const unsigned char* mem, size_t size);
+
     // unload network structure and weight data
     void clear();
 
     // construct an Extractor from network
     Extractor create_extractor() const;
 
+#if NCNN_STRING
+    // resolve names to the indexes taken by Extractor input and extract
+    // resolve once after loading and reuse the index on every request
+    // return -1 if not found
+    int find_blob_index_by_name(const char* name) const;
+    int find_layer_index_by_name(const char* name) const;
+#endif // NCNN_STRING
+
 public:
     // enable winograd convolution optimization
     // improve convolution 3x3 stride1 performace, may consume more memory
@@ -98,22 +130,107 @@ public:
     // enabled by default
     int use_int8_inference;
 
+    // fuse layers while loading network structure
+    // a ShuffleChannel feeding a single convolution or depth-wise convolution
+    // is folded into the channel order the convolution reads, so no data moves
+    // ReLU or Clip after a depth-wise convolution is applied by the convolution,
+    // the convolution output then holds the activated values
+    // inputs of channel concat are written into the concat output in place,
+    // from the second forward of the same input shapes on, once the shapes are known
+    // layers computed only from MemoryData are forwarded once after loading weight,
+    // extractors start from their outputs and skip them
+    // changes should be applied before loading network structure
+    // enabled by default
+    int use_layer_fusion;
+
+    // weight data allocator
+    // weight data loaded from model file is placed in it, such as HugePageAllocator
+    // the allocator must outlive the network
+    // changes should be applied before loading network weight
+    // default is null for the plain fastMalloc
+    Allocator* weight_allocator;
+
+    // replicate weight data on every numa node
+    // layers are created and loaded once per node, with weight data and transformed kernels
+    // placed by a NumaAllocator of the node, weight_allocator is not used then
+    // weight data referenced in place from memory is shared, its transformed kernels are replicated
+    // an extractor runs the replica of its numa node, see Extractor::set_numa_node
+    // changes should be applied before loading network structure
+    // disabled by default
+    int use_numa_replication;
+
+    // thread pool for extractors created from this network
+    // the pool must outlive the extractors
+    // default is null for the global default option
+    ThreadPool* thread_pool;
+
+    // kernel autotuning for extractors created from this network
+    // convolution and innerproduct time their algorithms and thread counts
+    // on the first run of each input shape, the fastest is kept in the cache
+    // load and save the cache to skip tuning on later runs on the same cpu model
+    // the cache must outlive the extractors
+    // default is null for the built-in heuristic
+    AutotuneCache* autotune_cache;
+
 protected:
     friend class Extractor;
 #if NCNN_STRING
-    int find_blob_index_by_name(const char* name) const;
-    int find_layer_index_by_name(const char* name) const;
     int custom_layer_to_index(const char* type);
     Layer* create_custom_layer(const char* type);
 #endif // NCNN_STRING
     Layer* create_custom_layer(int index);
-    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, Option& opt) const;
+    void create_numa_allocators();
+    int create_layer_replicas(int layer_index, const ParamDict& pd);
+    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<Mat>& blob_alias_mats, const std::vector<int>& blob_keeps, const std::vector<int>& input_shapes, Option& opt, int numa_node) const;
+    void fuse_network();
+    void fold_constants();
+    void update_shared_blobs();
+    void alias_concat_inputs(int layer_index, std::vector<Mat>& blob_mats, std::vector<Mat>& blob_alias_mats, const std::vector<int>& blob_keeps, const std::vector<int>& input_shapes, const Option& opt) const;
+    // bottom_shapes holds dims w h c elemsize of each input
+    void record_concat_shape(int layer_index, const std::vector<int>& bottom_shapes, const std::vector<int>& input_shapes) const;
+    // container sections, see load_container
+    int load_transformed_weights(const unsigned char* mem, int size);
+    int load_blob_shapes(const unsigned char* mem, int size);
+    int forward_shape_constant(int layer_index, const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+    bool is_shared_blob(int blob_index) const;
 
 protected:
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
+    // layers of numa nodes 1 ~ n-1 for use_numa_replication, node 0 runs layers
+    // the graph is read from layers, replicas only forward
+    std::vector< std::vector<Layer*> > replica_layers;
+    // weight allocators of all numa nodes for use_numa_replication
+    std::vector<NumaAllocator*> numa_allocators;
+
     std::vector<layer_registry_entry> custom_layer_registry;
+
+#if NCNN_STRING
+    // hash tables of blob and layer names, see find_blob_index_by_name
+    std::vector<int> blob_name_index;
+    std::vector<int> layer_name_index;
+#endif // NCNN_STRING
+
+    // channel concat shapes for the last input shapes, [layer] = (input shapes, w h elemsize and input channels)
+    // see Extractor::input_shapes
+    mutable std::vector< std::vector< std::pair< std::vector<int>, std::vector<int> > > > concat_shapes;
+    mutable Mutex concat_shapes_lock;
+
+    // top blobs of shape constant layers for the last input shapes, [layer] = (bottom shapes, top blobs)
+    // shared read-only by all extractors
+    mutable std::vector< std::vector< std::pair< std::vector<int>, std::vector<Mat> > > > shape_constant_outputs;
+    mutable Mutex shape_constant_outputs_lock;
+
+    // folded constant blobs read by the rest of the network, (blob index, data)
+    std::vector< std::pair<int, Mat> > constant_blobs;
+    // [blob] = 1 for the folded constants and outputs of shape constant layers,
+    // shared by all extractors and cloned on extract, see is_shared_blob
+    std::vector<char> shared_blobs;
+
+    // container file mapped by load_container, unmapped in clear()
+    void* container_data;
+    size_t container_size;
 };
 
 class Extractor
@@ -135,32 +252,76 @@ public:
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // run parallel loops on thread pool instead of openmp
+    // the thread count is still limited by set_num_threads
+    // pass null to switch back to openmp
+    void set_thread_pool(ThreadPool* thread_pool);
+
+    // run the weight replica of the numa node, see Net::use_numa_replication
+    // -1 picks the node of the cpu the extracting thread is running on
+    // default node is -1
+    void set_numa_node(int node);
+
 #if NCNN_STRING
     // set input by blob name
     // return 0 if success
     int input(const char* blob_name, const Mat& in);
 
+    // set input by blob name from external planar float data without copy
+    // return 0 if success
+    int input(const char* blob_name, const float* data, int w, int h, int c, int channel_step);
+
     // get result by blob name
     // return 0 if success
     int extract(const char* blob_name, Mat& feat);
+
+    // get several results by blob name in one pass
+    // return 0 if success
+    int extract(const std::vector<const char*>& blob_names, std::vector<Mat>& feats);
 #endif // NCNN_STRING
 
     // set input by blob index
     // return 0 if success
     int input(int blob_index, const Mat& in);
 
+    // set input by blob index from external planar float data without copy
+    // element (x, y, q) is data[x + y * w + q * channel_step], the layers read it in place
+    // data is 16 byte aligned, spans c * channel_step floats and must outlive the extraction
+    // channel_step is a multiple of 4 and at least w * h, interleaved or row padded data is not accepted
+    // return -1 for any other layout, which has to be copied into a Mat for input(blob_index, Mat)
+    // return 0 if success
+    int input(int blob_index, const float* data, int w, int h, int c, int channel_step);
+
     // get result by blob index
     // return 0 if success
     int extract(int blob_index, Mat& feat);
 
+    // get several results by blob index in one pass
+    // the outputs stay alive in light mode until all are done, so shared layers run once
+    // a non-empty mat in feats is filled in place, written directly by the producer if possible
+    // it must have the shape and elemsize of its blob, otherwise it is left untouched and -1 returned
+    // return 0 if success
+    int extract(const std::vector<int>& blob_indexes, std::vector<Mat>& feats);
+
 protected:
+    friend class Net;
     friend Extractor Net::create_extractor() const;
     Extractor(const Net* net, int blob_count);
 
+    // the numa node whose weight replica runs this extraction
+    int resolve_numa_node() const;
+
 private:
     const Net* net;
     std::vector<Mat> blob_mats;
+    // ranges of concat outputs the producers of these blobs write into
+    std::vector<Mat> blob_alias_mats;
+    // blobs not released in light mode while extracting several at once
+    std::vector<int> blob_keeps;
+    // blob index, dims, w, h, c and elemsize of each input set, the concat shapes are looked up by it
+    std::vector<int> input_shapes;
     Option opt;
+    int numa_node;
 };
 
 } // namespace ncnn
@@ -0,0 +1,340 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "nms.h"
+
+#include <math.h>
+#include <algorithm>
+#include "layer.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+// (score, index) ordered by descending score, ties by ascending index
+static bool score_index_descent(const std::pair<float, int>& a, const std::pair<float, int>& b)
+{
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+void sort_descent_topk(std::vector<DetectionBox>& boxes, int top_k)
+{
+    const int n = (int)boxes.size();
+
+    std::vector< std::pair<float, int> > order(n);
+    for (int i = 0; i < n; i++)
+    {
+        order[i] = std::make_pair(boxes[i].score, i);
+    }
+
+    if (top_k > 0 && top_k < n)
+    {
+        std::nth_element(order.begin(), order.begin() + top_k, order.end(), score_index_descent);
+        order.resize(top_k);
+    }
+
+    std::sort(order.begin(), order.end(), score_index_descent);
+
+    std::vector<DetectionBox> sorted(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        sorted[i] = boxes[order[i].second];
+    }
+
+    boxes.swap(sorted);
+}
+
+// picked boxes laid out for vector compare
+struct nms_picked_boxes
+{
+    std::vector<float> xmin;
+    std::vector<float> ymin;
+    std::vector<float> xmax;
+    std::vector<float> ymax;
+    std::vector<float> area;
+
+    void push_back(const DetectionBox& b, float b_area)
+    {
+        xmin.push_back(b.xmin);
+        ymin.push_back(b.ymin);
+        xmax.push_back(b.xmax);
+        ymax.push_back(b.ymax);
+        area.push_back(b_area);
+    }
+};
+
+static inline bool iou_above(const DetectionBox& a, float a_area, float b_xmin, float b_ymin, float b_xmax, float b_ymax, float b_area, float nms_threshold)
+{
+    float inter_width = std::min(a.xmax, b_xmax) - std::max(a.xmin, b_xmin);
+    float inter_height = std::min(a.ymax, b_ymax) - std::max(a.ymin, b_ymin);
+
+    float inter_area = std::max(inter_width, 0.f) * std::max(inter_height, 0.f);
+    float union_area = a_area + b_area - inter_area;
+
+    return inter_area / union_area > nms_threshold;
+}
+
+// whether box a overlaps any of the picked boxes by more than nms_threshold IoU
+static bool overlaps_picked(const DetectionBox& a, float a_area, const nms_picked_boxes& picked, float nms_threshold)
+{
+    const int count = picked.area.size();
+    if (count == 0)
+        return false;
+
+    const float* xmin = &picked.xmin[0];
+    const float* ymin = &picked.ymin[0];
+    const float* xmax = &picked.xmax[0];
+    const float* ymax = &picked.ymax[0];
+    const float* area = &picked.area[0];
+
+    int j = 0;
+#if __SSE2__
+    __m128 _a_xmin = _mm_set1_ps(a.xmin);
+    __m128 _a_ymin = _mm_set1_ps(a.ymin);
+    __m128 _a_xmax = _mm_set1_ps(a.xmax);
+    __m128 _a_ymax = _mm_set1_ps(a.ymax);
+    __m128 _a_area = _mm_set1_ps(a_area);
+    __m128 _threshold = _mm_set1_ps(nms_threshold);
+    __m128 _zero = _mm_setzero_ps();
+
+    for (; j + 3 < count; j += 4)
+    {
+        __m128 _inter_width = _mm_sub_ps(_mm_min_ps(_a_xmax, _mm_loadu_ps(xmax + j)), _mm_max_ps(_a_xmin, _mm_loadu_ps(xmin + j)));
+        __m128 _inter_height = _mm_sub_ps(_mm_min_ps(_a_ymax, _mm_loadu_ps(ymax + j)), _mm_max_ps(_a_ymin, _mm_loadu_ps(ymin + j)));
+
+        __m128 _inter_area = _mm_mul_ps(_mm_max_ps(_inter_width, _zero), _mm_max_ps(_inter_height, _zero));
+        __m128 _union_area = _mm_sub_ps(_mm_add_ps(_a_area, _mm_loadu_ps(area + j)), _inter_area);
+
+        if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_div_ps(_inter_area, _union_area), _threshold)))
+            return true;
+    }
+#elif __ARM_NEON
+    float32x4_t _a_xmin = vdupq_n_f32(a.xmin);
+    float32x4_t _a_ymin = vdupq_n_f32(a.ymin);
+    float32x4_t _a_xmax = vdupq_n_f32(a.xmax);
+    float32x4_t _a_ymax = vdupq_n_f32(a.ymax);
+    float32x4_t _zero = vdupq_n_f32(0.f);
+
+    for (; j + 3 < count; j += 4)
+    {
+        float32x4_t _inter_width = vsubq_f32(vminq_f32(_a_xmax, vld1q_f32(xmax + j)), vmaxq_f32(_a_xmin, vld1q_f32(xmin + j)));
+        float32x4_t _inter_height = vsubq_f32(vminq_f32(_a_ymax, vld1q_f32(ymax + j)), vmaxq_f32(_a_ymin, vld1q_f32(ymin + j)));
+
+        // most pairs do not intersect, the exact division is only done for those that do
+        // a disjoint pair has zero IoU, which only passes a negative threshold
+        uint32x4_t _intersect = vandq_u32(vcgtq_f32(_inter_width, _zero), vcgtq_f32(_inter_height, _zero));
+        uint32x2_t _any = vorr_u32(vget_low_u32(_intersect), vget_high_u32(_intersect));
+        if (nms_threshold >= 0.f && vget_lane_u32(vpmax_u32(_any, _any), 0) == 0)
+            continue;
+
+        for (int k = j; k < j + 4; k++)
+        {
+            if (iou_above(a, a_area, xmin[k], ymin[k], xmax[k], ymax[k], area[k], nms_threshold))
+                return true;
+        }
+    }
+#endif // __SSE2__
+    for (; j < count; j++)
+    {
+        if (iou_above(a, a_area, xmin[j], ymin[j], xmax[j], ymax[j], area[j], nms_threshold))
+            return true;
+    }
+
+    return false;
+}
+
+// uniform grid over the candidates, each picked box is stored in every cell it covers
+// with a non-negative threshold only intersecting boxes suppress each other,
+// and intersecting boxes always share a cell
+struct nms_grid
+{
+    float xmin;
+    float ymin;
+    float cell_w;
+    float cell_h;
+    int grid_w;
+    int grid_h;
+    std::vector<nms_picked_boxes> cells;
+
+    int cell_x(float x) const
+    {
+        float fx = (x - xmin) / cell_w;
+        return fx >= 0.f ? std::min((int)fx, grid_w - 1) : 0;
+    }
+
+    int cell_y(float y) const
+    {
+        float fy = (y - ymin) / cell_h;
+        return fy >= 0.f ? std::min((int)fy, grid_h - 1) : 0;
+    }
+};
+
+// the grid pays off for long candidate lists only
+static const int nms_grid_min_count = 256;
+static const int nms_grid_max_size = 32;
+
+static bool init_grid(const std::vector<DetectionBox>& boxes, nms_grid& grid)
+{
+    const int n = boxes.size();
+
+    float xmin = boxes[0].xmin;
+    float ymin = boxes[0].ymin;
+    float xmax = boxes[0].xmax;
+    float ymax = boxes[0].ymax;
+    double sum_size = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        const DetectionBox& b = boxes[i];
+
+        // inverted or nan boxes intersect in ways the grid cannot see
+        if (!(b.xmin <= b.xmax && b.ymin <= b.ymax))
+            return false;
+
+        xmin = std::min(xmin, b.xmin);
+        ymin = std::min(ymin, b.ymin);
+        xmax = std::max(xmax, b.xmax);
+        ymax = std::max(ymax, b.ymax);
+
+        sum_size += std::max(b.xmax - b.xmin, b.ymax - b.ymin);
+    }
+
+    // cells about the size of an average box
+    float cell_size = (float)(sum_size / n);
+    if (!(cell_size > 0.f))
+        return false;
+
+    grid.xmin = xmin;
+    grid.ymin = ymin;
+    grid.grid_w = std::max(std::min((int)((xmax - xmin) / cell_size), nms_grid_max_size), 1);
+    grid.grid_h = std::max(std::min((int)((ymax - ymin) / cell_size), nms_grid_max_size), 1);
+    grid.cell_w = std::max((xmax - xmin) / grid.grid_w, 1e-20f);
+    grid.cell_h = std::max((ymax - ymin) / grid.grid_h, 1e-20f);
+
+    if (grid.grid_w == 1 && grid.grid_h == 1)
+        return false;
+
+    grid.cells.resize(grid.grid_w * grid.grid_h);
+
+    return true;
+}
+
+void nms_sorted_bboxes(const std::vector<DetectionBox>& boxes, std::vector<int>& picked, float nms_threshold, int max_picked)
+{
+    picked.clear();
+
+    const int n = boxes.size();
+    if (n == 0)
+        return;
+
+    nms_grid grid;
+    bool use_grid = n >= nms_grid_min_count && nms_threshold >= 0.f && init_grid(boxes, grid);
+
+    nms_picked_boxes picked_boxes;
+
+    for (int i = 0; i < n; i++)
+    {
+        const DetectionBox& a = boxes[i];
+
+        float a_area = (a.xmax - a.xmin) * (a.ymax - a.ymin);
+
+        if (!use_grid)
+        {
+            if (overlaps_picked(a, a_area, picked_boxes, nms_threshold))
+                continue;
+
+            picked_boxes.push_back(a, a_area);
+        }
+        else
+        {
+            const int x0 = grid.cell_x(a.xmin);
+            const int x1 = grid.cell_x(a.xmax);
+            const int y0 = grid.cell_y(a.ymin);
+            const int y1 = grid.cell_y(a.ymax);
+
+            bool keep = true;
+            for (int y = y0; keep && y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    if (overlaps_picked(a, a_area, grid.cells[y * grid.grid_w + x], nms_threshold))
+                    {
+                        keep = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!keep)
+                continue;
+
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    grid.cells[y * grid.grid_w + x].push_back(a, a_area);
+                }
+            }
+        }
+
+        picked.push_back(i);
+
+        if (max_picked > 0 && (int)picked.size() >= max_picked)
+            break;
+    }
+}
+
+void nms_topk(std::vector<DetectionBox>& boxes, float nms_threshold, int top_k, int max_picked)
+{
+    sort_descent_topk(boxes, top_k);
+
+    std::vector<int> picked;
+    nms_sorted_bboxes(boxes, picked, nms_threshold, max_picked);
+
+    // picked indices are ascending, compact in place
+    for (int i = 0; i < (int)picked.size(); i++)
+    {
+        boxes[i] = boxes[picked[i]];
+    }
+
+    boxes.resize(picked.size());
+}
+
+// arguments of the per-class nms loop body run by parallel_for
+struct nms_topk_per_class_args
+{
+    std::vector< std::vector<DetectionBox> >* class_boxes;
+    float nms_threshold;
+    int top_k;
+};
+
+static void nms_topk_class(int i, void* userdata)
+{
+    const nms_topk_per_class_args* args = (const nms_topk_per_class_args*)userdata;
+
+    nms_topk((*args->class_boxes)[i], args->nms_threshold, args->top_k);
+}
+
+void nms_topk_per_class(std::vector< std::vector<DetectionBox> >& class_boxes, float nms_threshold, int top_k, const Option& opt)
+{
+    nms_topk_per_class_args args = { &class_boxes, nms_threshold, top_k };
+    parallel_for(class_boxes.size(), nms_topk_class, &args, opt);
+}
+
+} // namespace ncnn
@@ -0,0 +1,56 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_NMS_H
+#define NCNN_NMS_H
+
+#include <vector>
+#include "platform.h"
+
+namespace ncnn {
+
+// detection candidate for post-processing
+struct DetectionBox
+{
+    float xmin;
+    float ymin;
+    float xmax;
+    float ymax;
+    float score;
+    int label;
+};
+
+// sort boxes by descending score and keep the first top_k, all if top_k <= 0
+// only the kept boxes are sorted, the rest are partitioned away
+// boxes of equal score keep their order, so the result does not depend on the sort implementation
+void sort_descent_topk(std::vector<DetectionBox>& boxes, int top_k);
+
+// greedy non maximum suppression of boxes sorted by descending score
+// a box is dropped when its IoU with a higher scored picked box exceeds nms_threshold
+// picked holds the indices of the kept boxes in score order,
+// stops after max_picked boxes, all if max_picked <= 0
+// large candidate lists only compare boxes sharing cells of a coarse grid
+void nms_sorted_bboxes(const std::vector<DetectionBox>& boxes, std::vector<int>& picked, float nms_threshold, int max_picked = 0);
+
+// keep the top_k boxes by score, then apply nms, boxes is replaced by the picked ones in score order
+void nms_topk(std::vector<DetectionBox>& boxes, float nms_threshold, int top_k, int max_picked = 0);
+
+class Option;
+
+// nms_topk on each class independently, classes run in parallel with opt.num_threads
+void nms_topk_per_class(std::vector< std::vector<DetectionBox> >& class_boxes, float nms_threshold, int top_k, const Option& opt);
+
+} // namespace ncnn
+
+#endif // NCNN_NMS_H
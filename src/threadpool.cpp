@@ -0,0 +1,388 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "threadpool.h"
+
+#include <stdio.h>
+#include "cpu.h"
+
+namespace ncnn {
+
+struct ThreadPool::Worker
+{
+    ThreadPool* pool;
+    int index;
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+};
+
+// one parallel_for call, lives on the stack of the calling thread
+struct ThreadPool::Job
+{
+    parallel_for_func func;
+    void* userdata;
+    int threads;
+    // workers joined so far, the calling thread takes the last slice
+    int joined;
+    // workers still running the loop body, guarded by state_lock
+    int active;
+    // per thread slice, next index and end index
+    std::vector<int> next;
+    std::vector<int> end;
+};
+
+// marks threads running a loop body, nested parallel_for runs serially
+#ifdef _WIN32
+static DWORD g_parallel_nested_tls = TlsAlloc();
+
+static bool is_parallel_nested()
+{
+    return TlsGetValue(g_parallel_nested_tls) != 0;
+}
+
+static void set_parallel_nested(bool nested)
+{
+    TlsSetValue(g_parallel_nested_tls, nested ? (LPVOID)1 : 0);
+}
+#else
+static pthread_key_t create_parallel_nested_key()
+{
+    pthread_key_t key;
+    pthread_key_create(&key, 0);
+    return key;
+}
+
+static pthread_key_t g_parallel_nested_key = create_parallel_nested_key();
+
+static bool is_parallel_nested()
+{
+    return pthread_getspecific(g_parallel_nested_key) != 0;
+}
+
+static void set_parallel_nested(bool nested)
+{
+    pthread_setspecific(g_parallel_nested_key, nested ? (void*)1 : 0);
+}
+#endif // _WIN32
+
+#ifdef _WIN32
+DWORD WINAPI ThreadPool::worker_entry(LPVOID ptr)
+#else
+void* ThreadPool::worker_entry(void* ptr)
+#endif
+{
+    Worker* worker = (Worker*)ptr;
+    set_parallel_nested(true);
+    worker->pool->run_worker(worker->index);
+    return 0;
+}
+
+void ThreadPool::lock_state()
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&state_lock);
+#else
+    pthread_mutex_lock(&state_lock);
+#endif
+}
+
+void ThreadPool::unlock_state()
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&state_lock);
+#else
+    pthread_mutex_unlock(&state_lock);
+#endif
+}
+
+#ifdef _WIN32
+#define THREADPOOL_WAIT(cond) SleepConditionVariableSRW(&cond, &state_lock, INFINITE, 0)
+#define THREADPOOL_BROADCAST(cond) WakeAllConditionVariable(&cond)
+#else
+#define THREADPOOL_WAIT(cond) pthread_cond_wait(&cond, &state_lock)
+#define THREADPOOL_BROADCAST(cond) pthread_cond_broadcast(&cond)
+#endif
+
+ThreadPool::ThreadPool(int _num_threads)
+{
+    num_threads = _num_threads < 1 ? 1 : _num_threads;
+    spin_count = 20000;
+
+    job_count = 0;
+
+    affinity_ret.resize(num_threads);
+    affinity_generation = 0;
+    affinity_done_count = 0;
+
+    quit = 0;
+
+#ifdef _WIN32
+    InitializeSRWLock(&state_lock);
+    InitializeConditionVariable(&job_cond);
+    InitializeConditionVariable(&done_cond);
+#else
+    pthread_mutex_init(&state_lock, 0);
+    pthread_cond_init(&job_cond, 0);
+    pthread_cond_init(&done_cond, 0);
+#endif
+
+    workers.resize(num_threads - 1);
+    for (int i=0; i<num_threads - 1; i++)
+    {
+        Worker* worker = new Worker;
+        worker->pool = this;
+        worker->index = i;
+#ifdef _WIN32
+        worker->thread = CreateThread(0, 0, worker_entry, worker, 0, 0);
+#else
+        pthread_create(&worker->thread, 0, worker_entry, worker);
+#endif
+        workers[i] = worker;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    lock_state();
+    quit = 1;
+    THREADPOOL_BROADCAST(job_cond);
+    unlock_state();
+
+    for (size_t i=0; i<workers.size(); i++)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(workers[i]->thread, INFINITE);
+        CloseHandle(workers[i]->thread);
+#else
+        pthread_join(workers[i]->thread, 0);
+#endif
+        delete workers[i];
+    }
+
+#ifndef _WIN32
+    pthread_cond_destroy(&done_cond);
+    pthread_cond_destroy(&job_cond);
+    pthread_mutex_destroy(&state_lock);
+#endif
+}
+
+int ThreadPool::get_num_threads() const
+{
+    return num_threads;
+}
+
+void ThreadPool::set_spin_count(int _spin_count)
+{
+    spin_count = _spin_count < 0 ? 0 : _spin_count;
+}
+
+int ThreadPool::set_affinity(const std::vector<int>& cpuids)
+{
+    if (cpuids.empty())
+        return -1;
+
+    affinity_lock.lock();
+
+    // each worker binds itself once it sees the new generation
+    lock_state();
+
+    affinity_cpuids = cpuids;
+    affinity_done_count = 0;
+    affinity_generation++;
+
+    THREADPOOL_BROADCAST(job_cond);
+
+    while (affinity_done_count != num_threads - 1)
+        THREADPOOL_WAIT(done_cond);
+
+    unlock_state();
+
+    int ret = 0;
+    for (int i=0; i<num_threads - 1; i++)
+    {
+        if (affinity_ret[i] != 0)
+            ret = -1;
+    }
+
+    affinity_lock.unlock();
+
+    return ret;
+}
+
+void ThreadPool::parallel_for(int count, parallel_for_func func, void* userdata, int _num_threads)
+{
+    int nt = _num_threads <= 0 || _num_threads > num_threads ? num_threads : _num_threads;
+    if (nt > count)
+        nt = count;
+
+    if (nt <= 1 || is_parallel_nested())
+    {
+        for (int i=0; i<count; i++)
+        {
+            func(i, userdata);
+        }
+        return;
+    }
+
+    Job job;
+    job.func = func;
+    job.userdata = userdata;
+    job.threads = nt;
+    job.joined = 0;
+    job.active = 0;
+    job.next.resize(nt);
+    job.end.resize(nt);
+
+    // contiguous slices, the first ones take the remainder
+    {
+        int start = 0;
+        for (int i=0; i<nt; i++)
+        {
+            int slice = count / nt + (i < count % nt ? 1 : 0);
+            job.next[i] = start;
+            job.end[i] = start + slice;
+            start += slice;
+        }
+    }
+
+    // publish the job under lock, so that idle workers never see a torn one
+    lock_state();
+    jobs.push_back(&job);
+    job_count = (int)jobs.size();
+    THREADPOOL_BROADCAST(job_cond);
+    unlock_state();
+
+    // the calling thread takes the last slice and steals the slices nobody joined for
+    set_parallel_nested(true);
+    run_job(&job, nt - 1);
+    set_parallel_nested(false);
+
+    // close the job, all indices are taken by now
+    lock_state();
+    for (size_t i=0; i<jobs.size(); i++)
+    {
+        if (jobs[i] == &job)
+        {
+            jobs.erase(jobs.begin() + i);
+            break;
+        }
+    }
+    job_count = (int)jobs.size();
+    unlock_state();
+
+    // spin then sleep until the workers that joined finished
+    for (int i=0; i<spin_count && *(volatile int*)&job.active != 0; i++)
+    {
+    }
+
+    lock_state();
+    while (job.active != 0)
+        THREADPOOL_WAIT(done_cond);
+    unlock_state();
+}
+
+void ThreadPool::run_job(Job* job, int index)
+{
+    const int nt = job->threads;
+
+    // own slice first
+    for (;;)
+    {
+        int i = NCNN_XADD(&job->next[index], 1);
+        if (i >= job->end[index])
+            break;
+
+        job->func(i, job->userdata);
+    }
+
+    // then steal from the others
+    for (int j=1; j<nt; j++)
+    {
+        const int victim = (index + j) % nt;
+
+        for (;;)
+        {
+            int i = NCNN_XADD(&job->next[victim], 1);
+            if (i >= job->end[victim])
+                break;
+
+            job->func(i, job->userdata);
+        }
+    }
+}
+
+void ThreadPool::run_worker(int index)
+{
+    int generation = 0;
+
+    for (;;)
+    {
+        // spin then sleep until a job or an affinity request arrives
+        for (int i=0; i<spin_count && job_count == 0 && affinity_generation == generation && !quit; i++)
+        {
+        }
+
+        lock_state();
+
+        while (jobs.empty() && affinity_generation == generation && !quit)
+            THREADPOOL_WAIT(job_cond);
+
+        if (quit)
+        {
+            unlock_state();
+            break;
+        }
+
+        if (affinity_generation != generation)
+        {
+            generation = affinity_generation;
+            std::vector<int> cpuid(1, affinity_cpuids[index % affinity_cpuids.size()]);
+            unlock_state();
+
+            int ret = set_cpu_thread_affinity(cpuid);
+
+            lock_state();
+            affinity_ret[index] = ret;
+            affinity_done_count++;
+            THREADPOOL_BROADCAST(done_cond);
+            unlock_state();
+            continue;
+        }
+
+        // join the oldest job, which stops taking workers once all its slices are owned
+        Job* job = jobs[0];
+        const int slot = job->joined++;
+        if (job->joined == job->threads - 1)
+        {
+            jobs.erase(jobs.begin());
+            job_count = (int)jobs.size();
+        }
+        job->active++;
+
+        unlock_state();
+
+        run_job(job, slot);
+
+        lock_state();
+        job->active--;
+        if (job->active == 0)
+            THREADPOOL_BROADCAST(done_cond);
+        unlock_state();
+    }
+}
+
+} // namespace ncnn
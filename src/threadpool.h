@@ -0,0 +1,112 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_THREADPOOL_H
+#define NCNN_THREADPOOL_H
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <vector>
+#include "allocator.h"
+
+namespace ncnn {
+
+// loop body of parallel_for, called once for each index
+typedef void (*parallel_for_func)(int i, void* userdata);
+
+// thread pool with persistent workers
+// an alternative to openmp that does not spin between layers
+// and does not conflict with the threading of the host application
+class ThreadPool
+{
+public:
+    // spawn num_threads - 1 workers, the calling thread takes part as the last one
+    ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    int get_num_threads() const;
+
+    // busy-wait iterations of idle workers before sleeping
+    // small value saves cpu between layers, large value reduces wakeup latency
+    // default count = 20000
+    void set_spin_count(int spin_count);
+
+    // bind worker i to cpu cpuids[i % cpuids.size()]
+    // the calling thread is not affected
+    // return 0 if success
+    int set_affinity(const std::vector<int>& cpuids);
+
+    // run func(i, userdata) for i in [0, count) and wait for completion
+    // each thread starts with a contiguous slice and steals from others when done
+    // num_threads limits the threads taking part, 0 = all
+    // calls from several threads run concurrently, sharing the idle workers
+    // nested call from the loop body runs serially
+    void parallel_for(int count, parallel_for_func func, void* userdata, int num_threads = 0);
+
+public:
+    struct Worker;
+    struct Job;
+
+private:
+    void run_worker(int index);
+    static void run_job(Job* job, int index);
+#ifdef _WIN32
+    static DWORD WINAPI worker_entry(LPVOID ptr);
+#else
+    static void* worker_entry(void* ptr);
+#endif
+
+    void lock_state();
+    void unlock_state();
+
+private:
+    int num_threads;
+    int spin_count;
+
+    std::vector<Worker*> workers;
+
+    // jobs still open for workers to join, oldest first
+    // each caller tracks the completion of its own job,
+    // so that extractors sharing the pool run their loops concurrently
+    std::vector<Job*> jobs;
+    volatile int job_count;
+
+    // cpu binding requested by set_affinity, one request at a time
+    Mutex affinity_lock;
+    std::vector<int> affinity_cpuids;
+    std::vector<int> affinity_ret;
+    volatile int affinity_generation;
+    int affinity_done_count;
+
+    volatile int quit;
+
+#ifdef _WIN32
+    SRWLOCK state_lock;
+    CONDITION_VARIABLE job_cond;
+    CONDITION_VARIABLE done_cond;
+#else
+    pthread_mutex_t state_lock;
+    pthread_cond_t job_cond;
+    pthread_cond_t done_cond;
+#endif
+};
+
+} // namespace ncnn
+
+#endif // NCNN_THREADPOOL_H
@@ -14,11 +14,13 @@
 
 #include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <cstddef>
 #include <string>
 #include <vector>
 #include "layer.h"
+#include "net.h"
 
 static std::vector<std::string> layer_names;
 static std::vector<std::string> blob_names;
@@ -310,11 +312,62 @@ static int write_memcpp(const char* parambinpath, const char* modelpath, const c
     return 0;
 }
 
+static int read_file(const char* path, std::vector<unsigned char>& data)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    data.clear();
+
+    unsigned char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        data.insert(data.end(), buf, buf + n);
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+
+// load the network with the layers of this build and write it with its transformed weight data
+// input_name, w, h, c give the input shape the blob shapes are found for, none if input_name is null
+// see Net::save_container
+static int write_container(const char* parampath, const char* parambinpath, const char* modelpath, const char* containerpath, const char* input_name, int w, int h, int c)
+{
+    std::vector<unsigned char> parambin;
+    std::vector<unsigned char> model;
+    if (read_file(parambinpath, parambin) != 0 || read_file(modelpath, model) != 0)
+        return -1;
+
+    ncnn::Net net;
+    if (net.load_param(parampath) != 0 || net.load_model(modelpath) != 0)
+        return -1;
+
+    const unsigned char* parambin_data = parambin.empty() ? 0 : &parambin[0];
+    const unsigned char* model_data = model.empty() ? 0 : &model[0];
+
+    if (!input_name)
+        return net.save_container(containerpath, parambin_data, parambin.size(), model_data, model.size());
+
+    ncnn::Mat in(w, h, c);
+    in.fill(0.f);
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_light_mode(false);
+    if (ex.input(input_name, in) != 0)
+        return -1;
+
+    return net.save_container(containerpath, parambin_data, parambin.size(), model_data, model.size(), &ex);
+}
+
 int main(int argc, char** argv)
 {
-    if (argc != 5)
+    if (argc != 5 && argc != 6 && argc != 10)
     {
-        fprintf(stderr, "Usage: %s [ncnnproto] [ncnnbin] [idcpppath] [memcpppath]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [ncnnproto] [ncnnbin] [idcpppath] [memcpppath] [containerpath] [inputname w h c]\n", argv[0]);
         return -1;
     }
 
@@ -332,5 +385,17 @@ int main(int argc, char** argv)
 
     write_memcpp(parambinpath.c_str(), modelpath, memcpppath);
 
+    // single file of graph, names, weight data and transformed weight data for Net::load_container
+    // built for the cpu of this ncnn2mem, the blob shapes are found for the given input shape
+    const char* input_name = argc == 10 ? argv[6] : 0;
+    int w = argc == 10 ? atoi(argv[7]) : 0;
+    int h = argc == 10 ? atoi(argv[8]) : 0;
+    int c = argc == 10 ? atoi(argv[9]) : 0;
+    if (argc >= 6 && write_container(parampath, parambinpath.c_str(), modelpath, argv[5], input_name, w, h, c) != 0)
+    {
+        fprintf(stderr, "write container %s failed\n", argv[5]);
+        return -1;
+    }
+
     return 0;
 }